@@ -22,10 +22,15 @@ public class AdvancedControlFlow : ModuleRules
 		});
 
 		PrivateDependencyModuleNames.AddRange(new string[]{
+			"AdvancedControlFlowRuntime",
+			"AssetRegistry",
 			"BlueprintGraph",
 			"EditorStyle",
 			"GraphEditor",
+			"Json",
+			"Kismet",
 			"KismetCompiler",
+			"PropertyEditor",
 			"Slate",
 			"SlateCore",
 			"ToolMenus",
@@ -0,0 +1,166 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowAssetRegistryTags.h"
+
+#include "Engine/Blueprint.h"
+#include "K2Node_CasePairedPinsNode.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Misc/EngineVersionComparison.h"
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+#include "AssetRegistryModule.h"
+#else
+#include "AssetRegistry/AssetRegistryModule.h"
+#endif
+
+const FName FAdvancedControlFlowAssetRegistryTags::NodeCountTagName(TEXT("AdvancedControlFlowNodeCount"));
+const FName FAdvancedControlFlowAssetRegistryTags::MaxCaseCountTagName(TEXT("AdvancedControlFlowMaxCaseCount"));
+const FName FAdvancedControlFlowAssetRegistryTags::NodeCountsPerTypeTagName(TEXT("AdvancedControlFlowNodeCountsPerType"));
+FDelegateHandle FAdvancedControlFlowAssetRegistryTags::OnGetExtraObjectTagsHandle;
+
+namespace
+{
+void AddNodeStatisticsTags(const UObject* Object, TArray<UObject::FAssetRegistryTag>& OutTags)
+{
+	const UBlueprint* Blueprint = Cast<UBlueprint>(Object);
+	if (Blueprint == nullptr)
+	{
+		return;
+	}
+
+	// The Blueprints which do not use the nodes have no tags.
+	const FAdvancedControlFlowNodeStatistics Statistics = FAdvancedControlFlowAssetRegistryTags::GetNodeStatistics(Blueprint);
+	if (Statistics.NodeCount == 0)
+	{
+		return;
+	}
+
+	OutTags.Add(UObject::FAssetRegistryTag(FAdvancedControlFlowAssetRegistryTags::NodeCountTagName,
+		FString::FromInt(Statistics.NodeCount), UObject::FAssetRegistryTag::TT_Numerical));
+	OutTags.Add(UObject::FAssetRegistryTag(FAdvancedControlFlowAssetRegistryTags::MaxCaseCountTagName,
+		FString::FromInt(Statistics.MaxCaseCount), UObject::FAssetRegistryTag::TT_Numerical));
+	OutTags.Add(UObject::FAssetRegistryTag(FAdvancedControlFlowAssetRegistryTags::NodeCountsPerTypeTagName,
+		Statistics.GetNodeCountsPerTypeString(), UObject::FAssetRegistryTag::TT_Hidden));
+}
+
+#if !UE_VERSION_OLDER_THAN(5, 4, 0)
+void AddNodeStatisticsTagsWithContext(FAssetRegistryTagsContext Context)
+{
+	TArray<UObject::FAssetRegistryTag> Tags;
+	AddNodeStatisticsTags(Context.GetObject(), Tags);
+	for (const UObject::FAssetRegistryTag& Tag : Tags)
+	{
+		Context.AddTag(Tag);
+	}
+}
+#endif
+}	 // namespace
+
+FString FAdvancedControlFlowNodeStatistics::GetNodeCountsPerTypeString() const
+{
+	TArray<FString> Types;
+	NodeCountsPerType.GetKeys(Types);
+	Types.Sort();
+
+	TArray<FString> Entries;
+	for (const FString& Type : Types)
+	{
+		Entries.Add(FString::Printf(TEXT("%s=%d"), *Type, NodeCountsPerType[Type]));
+	}
+
+	return FString::Join(Entries, TEXT(","));
+}
+
+void FAdvancedControlFlowAssetRegistryTags::Register()
+{
+#if UE_VERSION_OLDER_THAN(5, 4, 0)
+	OnGetExtraObjectTagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTags.AddStatic(&AddNodeStatisticsTags);
+#else
+	OnGetExtraObjectTagsHandle =
+		UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.AddStatic(&AddNodeStatisticsTagsWithContext);
+#endif
+}
+
+void FAdvancedControlFlowAssetRegistryTags::Unregister()
+{
+	if (!OnGetExtraObjectTagsHandle.IsValid())
+	{
+		return;
+	}
+
+#if UE_VERSION_OLDER_THAN(5, 4, 0)
+	UObject::FAssetRegistryTag::OnGetExtraObjectTags.Remove(OnGetExtraObjectTagsHandle);
+#else
+	UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.Remove(OnGetExtraObjectTagsHandle);
+#endif
+	OnGetExtraObjectTagsHandle.Reset();
+}
+
+FAdvancedControlFlowNodeStatistics FAdvancedControlFlowAssetRegistryTags::GetNodeStatistics(const UBlueprint* Blueprint)
+{
+	FAdvancedControlFlowNodeStatistics Statistics;
+
+	TArray<UK2Node_CasePairedPinsNode*> Nodes;
+	FBlueprintEditorUtils::GetAllNodesOfClass(Blueprint, Nodes);
+	for (const UK2Node_CasePairedPinsNode* Node : Nodes)
+	{
+		// "K2Node_MultiBranch" -> "MultiBranch"
+		FString Type = Node->GetClass()->GetName();
+		Type.RemoveFromStart(TEXT("K2Node_"));
+
+		++Statistics.NodeCount;
+		Statistics.MaxCaseCount = FMath::Max(Statistics.MaxCaseCount, Node->GetCasePinCount());
+		Statistics.NodeCountsPerType.FindOrAdd(Type)++;
+	}
+
+	return Statistics;
+}
+
+void FAdvancedControlFlowAssetRegistryTags::FindBlueprints(const TArray<FString>& Paths, const TArray<FString>& PackageNames,
+	TArray<FAssetData>& OutTaggedAssets, TArray<FAssetData>& OutUntaggedAssets)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+	Filter.ClassNames.Add(UBlueprint::StaticClass()->GetFName());
+#else
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+#endif
+	Filter.bRecursiveClasses = true;
+	for (const FString& Path : Paths)
+	{
+		Filter.PackagePaths.Add(FName(*Path));
+	}
+	Filter.bRecursivePaths = true;
+	for (const FString& PackageName : PackageNames)
+	{
+		Filter.PackageNames.Add(FName(*PackageName));
+	}
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+	for (const FAssetData& Asset : Assets)
+	{
+		FString NodeCount;
+		if (Asset.GetTagValue(NodeCountTagName, NodeCount))
+		{
+			OutTaggedAssets.Add(Asset);
+		}
+		else
+		{
+			OutUntaggedAssets.Add(Asset);
+		}
+	}
+
+	auto ByPackageName = [](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); };
+	OutTaggedAssets.Sort(ByPackageName);
+	OutUntaggedAssets.Sort(ByPackageName);
+}
@@ -0,0 +1,144 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowBenchmarkUtils.h"
+
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_FunctionResult.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+
+UBlueprint* FAdvancedControlFlowBenchmarkUtils::CreateTransientBlueprint(const FString& BaseName)
+{
+	UPackage* Package = GetTransientPackage();
+
+	return FKismetEditorUtilities::CreateBlueprint(UObject::StaticClass(), Package,
+		MakeUniqueObjectName(Package, UBlueprint::StaticClass(), FName(*BaseName)), BPTYPE_Normal, UBlueprint::StaticClass(),
+		UBlueprintGeneratedClass::StaticClass());
+}
+
+UEdGraph* FAdvancedControlFlowBenchmarkUtils::AddFunctionGraph(
+	UBlueprint* Blueprint, const FName& FunctionName, UK2Node_FunctionEntry*& OutEntryNode, UK2Node_FunctionResult*& OutResultNode)
+{
+	UEdGraph* Graph =
+		FBlueprintEditorUtils::CreateNewGraph(Blueprint, FunctionName, UEdGraph::StaticClass(), UEdGraphSchema_K2::StaticClass());
+	FBlueprintEditorUtils::AddFunctionGraph<UClass>(Blueprint, Graph, true, nullptr);
+
+	TArray<UK2Node_FunctionEntry*> EntryNodes;
+	Graph->GetNodesOfClass(EntryNodes);
+	check(EntryNodes.Num() == 1);
+	OutEntryNode = EntryNodes[0];
+
+	TArray<UK2Node_FunctionResult*> ResultNodes;
+	Graph->GetNodesOfClass(ResultNodes);
+	if (ResultNodes.Num() > 0)
+	{
+		OutResultNode = ResultNodes[0];
+	}
+	else
+	{
+		OutResultNode = SpawnNode<UK2Node_FunctionResult>(Graph);
+	}
+
+	return Graph;
+}
+
+UK2Node_CallFunction* FAdvancedControlFlowBenchmarkUtils::SpawnCallFunctionNode(
+	UEdGraph* Graph, UClass* FunctionClass, const FName& FunctionName)
+{
+	UFunction* Function = FunctionClass->FindFunctionByName(FunctionName);
+	check(Function != nullptr);
+
+	UK2Node_CallFunction* Node = NewObject<UK2Node_CallFunction>(Graph);
+	Graph->AddNode(Node, false, false);
+	Node->CreateNewGuid();
+	Node->SetFromFunction(Function);
+	Node->PostPlacedNewNode();
+	Node->AllocateDefaultPins();
+
+	return Node;
+}
+
+FEdGraphPinType FAdvancedControlFlowBenchmarkUtils::MakePinType(
+	const FName& PinCategory, UObject* PinSubCategoryObject, EPinContainerType ContainerType)
+{
+	FEdGraphPinType PinType;
+	PinType.PinCategory = PinCategory;
+	PinType.PinSubCategoryObject = PinSubCategoryObject;
+	PinType.ContainerType = ContainerType;
+
+	return PinType;
+}
+
+void FAdvancedControlFlowBenchmarkUtils::DiscardBlueprint(UBlueprint* Blueprint)
+{
+	Blueprint->ClearFlags(RF_Standalone | RF_Public);
+	if (Blueprint->GeneratedClass != nullptr)
+	{
+		Blueprint->GeneratedClass->ClearFlags(RF_Standalone | RF_Public);
+	}
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+TArray<int32> FAdvancedControlFlowBenchmarkUtils::ParseIntList(
+	const FString& Params, const TCHAR* Key, const TArray<int32>& DefaultValues)
+{
+	FString Value;
+	if (!FParse::Value(*Params, Key, Value))
+	{
+		return DefaultValues;
+	}
+
+	TArray<FString> Items;
+	Value.ParseIntoArray(Items, TEXT(","));
+
+	TArray<int32> Values;
+	for (const FString& Item : Items)
+	{
+		Values.Add(FCString::Atoi(*Item));
+	}
+
+	return Values;
+}
+
+TArray<FString> FAdvancedControlFlowBenchmarkUtils::ParseStringList(
+	const FString& Params, const TCHAR* Key, const TArray<FString>& DefaultValues)
+{
+	FString Value;
+	if (!FParse::Value(*Params, Key, Value))
+	{
+		return DefaultValues;
+	}
+
+	TArray<FString> Values;
+	Value.ParseIntoArray(Values, TEXT(","));
+
+	return Values;
+}
+
+double FAdvancedControlFlowBenchmarkUtils::GetMedian(TArray<double> Values)
+{
+	if (Values.Num() == 0)
+	{
+		return 0.0;
+	}
+
+	Values.Sort();
+
+	return Values[Values.Num() / 2];
+}
+
+FString FAdvancedControlFlowBenchmarkUtils::EscapeCsvField(const FString& Field)
+{
+	return FString::Printf(TEXT("\"%s\""), *Field.Replace(TEXT("\""), TEXT("\"\"")));
+}
@@ -0,0 +1,145 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowBitmaskUtils.h"
+
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CasePairedPinsNode.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+const FName FAdvancedControlFlowBitmaskUtils::BitmaskPinName(TEXT("Bitmask"));
+
+UEdGraphPin* FAdvancedControlFlowBitmaskUtils::CreateBitmaskPin(UEdGraphNode* Node, int32 PinIndex)
+{
+	FCreatePinParams Params;
+	Params.Index = PinIndex;
+	return Node->CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, BitmaskPinName, Params);
+}
+
+UEdGraphPin* FAdvancedControlFlowBitmaskUtils::CreateCaseBitPin(UEdGraphNode* Node, const FString& PinName,
+	const FString& PinFriendlyName, int32 PinIndex, const TArray<FCasePinPairEntry>& CasePinPairEntries,
+	bool bReallocatingCasePinPairs)
+{
+	FCreatePinParams Params;
+	Params.Index = PinIndex;
+	UEdGraphPin* Pin = Node->CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Int, *PinName, Params);
+	Pin->PinFriendlyName = FText::AsCultureInvariant(PinFriendlyName);
+
+	// Give the lowest unused bit within the width of the bitmask. The old value is restored during the reconstruction.
+	if (!bReallocatingCasePinPairs)
+	{
+		// Integer is assumed while the type is undetermined, so that the bit is valid for both types.
+		const UEdGraphPin* BitmaskPin = Node->FindPin(BitmaskPinName);
+		const int32 BitCount = ((BitmaskPin != nullptr) && (GetBitCount(BitmaskPin) > 0)) ? GetBitCount(BitmaskPin) : 32;
+		const uint64 ValidBits = (BitCount == 64) ? ~0ull : ((1ull << BitCount) - 1);
+
+		uint64 UsedBits = 0;
+		for (const FCasePinPairEntry& Entry : CasePinPairEntries)
+		{
+			int32 Bit;
+			if ((Entry.KeyPin != nullptr) && GetCaseBit(Entry.KeyPin, Bit))
+			{
+				UsedBits |= 1ull << Bit;
+			}
+		}
+		const uint64 UnusedBits = ~UsedBits & ValidBits;
+		const int32 UnusedBit = (UnusedBits == 0) ? 0 : static_cast<int32>(FMath::CountTrailingZeros64(UnusedBits));
+		Pin->DefaultValue = FString::FromInt(UnusedBit);
+	}
+
+	// The bit positions must be known at compile time.
+	Pin->bNotConnectable = true;
+
+	return Pin;
+}
+
+void FAdvancedControlFlowBitmaskUtils::RestoreBitmaskPinType(UEdGraphPin* BitmaskPin, const TArray<UEdGraphPin*>& OldPins)
+{
+	for (UEdGraphPin* Pin : OldPins)
+	{
+		if (Pin->GetFName() == BitmaskPinName)
+		{
+			BitmaskPin->PinType = Pin->PinType;
+			return;
+		}
+	}
+}
+
+bool FAdvancedControlFlowBitmaskUtils::ResolveBitmaskPinType(UEdGraphPin* BitmaskPin)
+{
+	if ((BitmaskPin->LinkedTo.Num() == 0) || (BitmaskPin->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard))
+	{
+		// Ignore the disconnection event, and keep the type which has already fixed.
+		return false;
+	}
+
+	const UEdGraphPin* LinkedPin = BitmaskPin->LinkedTo[0];
+	if (LinkedPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+	{
+		return false;
+	}
+
+	// Keep the Bitmask enum (PinSubCategoryObject) to show the enum on the pin.
+	FEdGraphPinType PinType = LinkedPin->PinType;
+	PinType.ContainerType = EPinContainerType::None;
+	PinType.bIsReference = false;
+	BitmaskPin->PinType = PinType;
+
+	return true;
+}
+
+bool FAdvancedControlFlowBitmaskUtils::IsBitmaskConnectionDisallowed(
+	const UEdGraphPin* BitmaskPin, const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason)
+{
+	if ((MyPin != BitmaskPin) || (OtherPin == nullptr))
+	{
+		return false;
+	}
+
+	const FName& PinCategory = OtherPin->PinType.PinCategory;
+	if (OtherPin->PinType.IsContainer() ||
+		((PinCategory != UEdGraphSchema_K2::PC_Int) && (PinCategory != UEdGraphSchema_K2::PC_Int64) &&
+			(PinCategory != UEdGraphSchema_K2::PC_Wildcard)))
+	{
+		OutReason = LOCTEXT("BitmaskConnectionDisallowed", "Only Integer, Integer64 or Bitmask can be connected.").ToString();
+		return true;
+	}
+
+	return false;
+}
+
+int32 FAdvancedControlFlowBitmaskUtils::GetBitCount(const UEdGraphPin* BitmaskPin)
+{
+	if (BitmaskPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Int)
+	{
+		return 32;
+	}
+	else if (BitmaskPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Int64)
+	{
+		return 64;
+	}
+
+	return 0;
+}
+
+bool FAdvancedControlFlowBitmaskUtils::GetCaseBit(const UEdGraphPin* CaseKeyPin, int32& OutBit)
+{
+	const FString& DefaultValue = CaseKeyPin->DefaultValue;
+	if (DefaultValue.IsEmpty() || !DefaultValue.IsNumeric())
+	{
+		return false;
+	}
+
+	OutBit = FCString::Atoi(*DefaultValue);
+	return (OutBit >= 0) && (OutBit < 64);
+}
+
+#undef LOCTEXT_NAMESPACE
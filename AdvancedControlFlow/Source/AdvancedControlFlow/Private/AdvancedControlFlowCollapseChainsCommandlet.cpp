@@ -0,0 +1,153 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowCollapseChainsCommandlet.h"
+
+#include "AdvancedControlFlowBenchmarkUtils.h"
+#include "AdvancedControlFlowGraphRefactoring.h"
+#include "Engine/Blueprint.h"
+#include "FileHelpers.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+#include "AssetRegistryModule.h"
+#else
+#include "AssetRegistry/AssetRegistryModule.h"
+#endif
+
+DEFINE_LOG_CATEGORY_STATIC(LogAdvancedControlFlowCollapseChains, Log, All);
+
+namespace
+{
+struct FCollapseChainsResult
+{
+	FString PackageName;
+	FString Status;
+	FAdvancedControlFlowCollapseResult Collapse;
+};
+}	 // namespace
+
+UAdvancedControlFlowCollapseChainsCommandlet::UAdvancedControlFlowCollapseChainsCommandlet(
+	const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAdvancedControlFlowCollapseChainsCommandlet::Main(const FString& Params)
+{
+	FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AdvancedControlFlow"), TEXT("CollapseChains.csv"));
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	const TArray<FString> Paths = FAdvancedControlFlowBenchmarkUtils::ParseStringList(Params, TEXT("Paths="), {});
+	const bool bSave = FParse::Param(*Params, TEXT("Save"));
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	FARFilter Filter;
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+	Filter.ClassNames.Add(UBlueprint::StaticClass()->GetFName());
+#else
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+#endif
+	Filter.bRecursiveClasses = true;
+	for (const FString& Path : Paths)
+	{
+		Filter.PackagePaths.Add(FName(*Path));
+	}
+	Filter.bRecursivePaths = true;
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+	Assets.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+	UE_LOG(LogAdvancedControlFlowCollapseChains, Display, TEXT("Found %d Blueprints%s"), Assets.Num(),
+		bSave ? TEXT("") : TEXT(" (dry run)"));
+
+	TArray<FCollapseChainsResult> Results;
+	for (int32 Index = 0; Index < Assets.Num(); ++Index)
+	{
+		FCollapseChainsResult Result;
+		Result.PackageName = Assets[Index].PackageName.ToString();
+
+		UBlueprint* Blueprint = Cast<UBlueprint>(Assets[Index].GetAsset());
+		if (Blueprint == nullptr)
+		{
+			Result.Status = TEXT("Error");
+			UE_LOG(LogAdvancedControlFlowCollapseChains, Error, TEXT("%s: Failed to load"), *Result.PackageName);
+			Results.Add(MoveTemp(Result));
+			continue;
+		}
+
+		TArray<TArray<UEdGraphNode*>> Chains;
+		FAdvancedControlFlowGraphRefactoring::FindChains(Blueprint, Chains);
+		if (Chains.Num() > 0)
+		{
+			Result.Collapse = FAdvancedControlFlowGraphRefactoring::CollapseChains(Blueprint, Chains);
+			if (Result.Collapse.After.BytecodeSize < 0)
+			{
+				Result.Status = TEXT("Error");
+				UE_LOG(LogAdvancedControlFlowCollapseChains, Error, TEXT("%s: Failed to compile after collapsing the chains"),
+					*Result.PackageName);
+			}
+			else if (bSave)
+			{
+				const bool bSaved = UEditorLoadingAndSavingUtils::SavePackages({Blueprint->GetOutermost()}, false);
+				Result.Status = bSaved ? TEXT("Saved") : TEXT("Error");
+			}
+			else
+			{
+				Result.Status = TEXT("Collapsed");
+			}
+			Results.Add(MoveTemp(Result));
+		}
+
+		// Loading all Blueprints at once may run out of memory.
+		if ((Index % 32) == 31)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+	}
+
+	// Report
+	int32 ErrorCount = 0;
+	int32 TotalBytecodeBefore = 0;
+	int32 TotalBytecodeAfter = 0;
+	TArray<FString> Lines;
+	Lines.Add(TEXT("Asset,Status,BranchChains,SelectChains,NodesBefore,NodesAfter,BytecodeBefore,BytecodeAfter"));
+	for (const FCollapseChainsResult& Result : Results)
+	{
+		if (Result.Status == TEXT("Error"))
+		{
+			++ErrorCount;
+		}
+		else if (Result.Collapse.Before.BytecodeSize >= 0)
+		{
+			TotalBytecodeBefore += Result.Collapse.Before.BytecodeSize;
+			TotalBytecodeAfter += Result.Collapse.After.BytecodeSize;
+		}
+		Lines.Add(FString::Printf(TEXT("%s,%s,%d,%d,%d,%d,%d,%d"),
+			*FAdvancedControlFlowBenchmarkUtils::EscapeCsvField(Result.PackageName), *Result.Status,
+			Result.Collapse.BranchChainCount, Result.Collapse.SelectChainCount, Result.Collapse.Before.NodeCount,
+			Result.Collapse.After.NodeCount, Result.Collapse.Before.BytecodeSize, Result.Collapse.After.BytecodeSize));
+	}
+	if (!FFileHelper::SaveStringToFile(FString::Join(Lines, TEXT("\n")) + TEXT("\n"), *OutputPath))
+	{
+		UE_LOG(LogAdvancedControlFlowCollapseChains, Error, TEXT("Failed to write the result to %s"), *OutputPath);
+		return 1;
+	}
+	UE_LOG(LogAdvancedControlFlowCollapseChains, Display,
+		TEXT("Collapsed the chains of %d Blueprints (%d failed, Bytecode: %d -> %d bytes). The result is written to %s"),
+		Results.Num(), ErrorCount, TotalBytecodeBefore, TotalBytecodeAfter, *OutputPath);
+
+	return (ErrorCount > 0) ? 1 : 0;
+}
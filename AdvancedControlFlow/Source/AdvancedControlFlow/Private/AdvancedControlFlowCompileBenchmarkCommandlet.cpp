@@ -0,0 +1,278 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowCompileBenchmarkCommandlet.h"
+
+#include "AdvancedControlFlowBenchmarkUtils.h"
+#include "Dom/JsonObject.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "K2Node_ConditionalSequence.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_FunctionResult.h"
+#include "K2Node_MultiBranch.h"
+#include "K2Node_MultiConditionalSelect.h"
+#include "Kismet2/CompilerResultsLog.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAdvancedControlFlowCompileBenchmark, Log, All);
+
+namespace
+{
+const FName BenchmarkFunctionName(TEXT("Benchmark"));
+
+// Build the function graph below.
+//   Multi-Branch/Conditional Sequence:
+//     Entry -> Node 1 -> Node 2 -> ... -> Node N -> Result
+//     All case execution pins and the default execution pin are linked to the next node.
+//   Multi-Conditional Select:
+//     Entry (Value) -> Node 1 (Default) -> Node 2 (Default) -> ... -> Node N -> Result (ReturnValue)
+//   All condition pins are linked to the Condition parameter.
+UBlueprint* CreateBenchmarkBlueprint(UClass* NodeClass, int32 CaseCount, int32 NodeCount)
+{
+	UBlueprint* Blueprint = FAdvancedControlFlowBenchmarkUtils::CreateTransientBlueprint(TEXT("ACFCompileBenchmark"));
+	UK2Node_FunctionEntry* EntryNode = nullptr;
+	UK2Node_FunctionResult* ResultNode = nullptr;
+	UEdGraph* Graph = FAdvancedControlFlowBenchmarkUtils::AddFunctionGraph(Blueprint, BenchmarkFunctionName, EntryNode, ResultNode);
+
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+	UEdGraphPin* ConditionPin = EntryNode->CreateUserDefinedPin(
+		TEXT("Condition"), FAdvancedControlFlowBenchmarkUtils::MakePinType(UEdGraphSchema_K2::PC_Boolean), EGPD_Output);
+	UEdGraphPin* ValuePin = EntryNode->CreateUserDefinedPin(
+		TEXT("Value"), FAdvancedControlFlowBenchmarkUtils::MakePinType(UEdGraphSchema_K2::PC_Int), EGPD_Output);
+	UEdGraphPin* ReturnValuePin = ResultNode->CreateUserDefinedPin(
+		TEXT("ReturnValue"), FAdvancedControlFlowBenchmarkUtils::MakePinType(UEdGraphSchema_K2::PC_Int), EGPD_Input);
+
+	if (NodeClass == UK2Node_MultiConditionalSelect::StaticClass())
+	{
+		Schema->TryCreateConnection(EntryNode->FindPinChecked(UEdGraphSchema_K2::PN_Then), ResultNode->GetExecPin());
+
+		UEdGraphPin* PrevValuePin = ValuePin;
+		for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex)
+		{
+			UK2Node_MultiConditionalSelect* Node =
+				FAdvancedControlFlowBenchmarkUtils::SpawnNode<UK2Node_MultiConditionalSelect>(Graph);
+			Node->SetCasePinCount(CaseCount);
+
+			Schema->TryCreateConnection(PrevValuePin, Node->GetDefaultOptionPin());
+			TArray<CasePinPair> CasePairs = Node->GetCasePinPairs();
+			for (int32 CaseIndex = 0; CaseIndex < CasePairs.Num(); ++CaseIndex)
+			{
+				Schema->TrySetDefaultValue(*CasePairs[CaseIndex].Key, FString::FromInt(CaseIndex));
+				Schema->TryCreateConnection(ConditionPin, CasePairs[CaseIndex].Value);
+			}
+			PrevValuePin = Node->GetReturnValuePin();
+		}
+		Schema->TryCreateConnection(PrevValuePin, ReturnValuePin);
+	}
+	else
+	{
+		Schema->TryCreateConnection(ValuePin, ReturnValuePin);
+
+		TArray<UEdGraphPin*> PrevExecPins = {EntryNode->FindPinChecked(UEdGraphSchema_K2::PN_Then)};
+		for (int32 NodeIndex = 0; NodeIndex < NodeCount; ++NodeIndex)
+		{
+			UK2Node_CasePairedPinsNode* Node =
+				FAdvancedControlFlowBenchmarkUtils::SpawnNode<UK2Node_CasePairedPinsNode>(Graph, NodeClass);
+			Node->SetCasePinCount(CaseCount);
+
+			for (UEdGraphPin* PrevExecPin : PrevExecPins)
+			{
+				Schema->TryCreateConnection(PrevExecPin, Node->GetExecPin());
+			}
+
+			PrevExecPins.Reset();
+			for (const CasePinPair& Pair : Node->GetCasePinPairs())
+			{
+				Schema->TryCreateConnection(ConditionPin, Pair.Key);
+				PrevExecPins.Add(Pair.Value);
+			}
+			PrevExecPins.Add(Node->FindPinChecked(DefaultExecPinName));
+		}
+
+		for (UEdGraphPin* PrevExecPin : PrevExecPins)
+		{
+			Schema->TryCreateConnection(PrevExecPin, ResultNode->GetExecPin());
+		}
+	}
+
+	return Blueprint;
+}
+
+int32 CountSourceNodes(UBlueprint* Blueprint)
+{
+	for (UEdGraph* Graph : Blueprint->FunctionGraphs)
+	{
+		if (Graph->GetFName() == BenchmarkFunctionName)
+		{
+			return Graph->Nodes.Num();
+		}
+	}
+
+	return 0;
+}
+
+int32 CountIntermediateNodes(UBlueprint* Blueprint)
+{
+	int32 Count = 0;
+	for (UEdGraph* Graph : Blueprint->IntermediateGeneratedGraphs)
+	{
+		if (Graph->GetFName() == BenchmarkFunctionName)
+		{
+			return Graph->Nodes.Num();
+		}
+		Count += Graph->Nodes.Num();
+	}
+
+	return Count;
+}
+
+int32 GetBytecodeSize(UBlueprint* Blueprint)
+{
+	int32 Size = 0;
+	for (TFieldIterator<UFunction> It(Blueprint->GeneratedClass, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+	{
+		Size += It->Script.Num();
+	}
+
+	return Size;
+}
+
+}	 // namespace
+
+UAdvancedControlFlowCompileBenchmarkCommandlet::UAdvancedControlFlowCompileBenchmarkCommandlet(
+	const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAdvancedControlFlowCompileBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AdvancedControlFlow"), TEXT("CompileBenchmark.json"));
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	const TArray<FString> NodeTypes = FAdvancedControlFlowBenchmarkUtils::ParseStringList(
+		Params, TEXT("NodeTypes="), {TEXT("MultiBranch"), TEXT("ConditionalSequence"), TEXT("MultiConditionalSelect")});
+	const TArray<int32> CaseCounts =
+		FAdvancedControlFlowBenchmarkUtils::ParseIntList(Params, TEXT("CaseCounts="), {2, 8, 32, 128, 512});
+	const TArray<int32> NodeCounts =
+		FAdvancedControlFlowBenchmarkUtils::ParseIntList(Params, TEXT("NodeCounts="), {1, 10, 100, 1000});
+	int32 Iterations = 5;
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	Iterations = FMath::Max(Iterations, 1);
+	int32 MaxCasesPerGraph = 65536;
+	FParse::Value(*Params, TEXT("MaxCasesPerGraph="), MaxCasesPerGraph);
+
+	const TMap<FString, UClass*> NodeClasses = {
+		{TEXT("MultiBranch"), UK2Node_MultiBranch::StaticClass()},
+		{TEXT("ConditionalSequence"), UK2Node_ConditionalSequence::StaticClass()},
+		{TEXT("MultiConditionalSelect"), UK2Node_MultiConditionalSelect::StaticClass()},
+	};
+
+	TArray<TSharedPtr<FJsonValue>> Results;
+	for (const FString& NodeType : NodeTypes)
+	{
+		UClass* const* NodeClass = NodeClasses.Find(NodeType);
+		if (NodeClass == nullptr)
+		{
+			UE_LOG(LogAdvancedControlFlowCompileBenchmark, Error, TEXT("Unknown node type: %s"), *NodeType);
+			return 1;
+		}
+
+		for (int32 CaseCount : CaseCounts)
+		{
+			for (int32 NodeCount : NodeCounts)
+			{
+				if ((MaxCasesPerGraph > 0) && (CaseCount * NodeCount > MaxCasesPerGraph))
+				{
+					UE_LOG(LogAdvancedControlFlowCompileBenchmark, Display, TEXT("Skip %s (Cases=%d, Nodes=%d)"), *NodeType,
+						CaseCount, NodeCount);
+					continue;
+				}
+
+				UBlueprint* Blueprint = CreateBenchmarkBlueprint(*NodeClass, CaseCount, NodeCount);
+
+				// Collect the statistics at first, because the intermediate products are not saved while measuring.
+				FCompilerResultsLog ResultsLog;
+				FKismetEditorUtilities::CompileBlueprint(Blueprint,
+					EBlueprintCompileOptions::SkipGarbageCollection | EBlueprintCompileOptions::SaveIntermediateProducts,
+					&ResultsLog);
+				const bool bSucceeded = (Blueprint->Status != BS_Error);
+				const int32 SourceNodeCount = CountSourceNodes(Blueprint);
+				const int32 ExpandedNodeCount = CountIntermediateNodes(Blueprint);
+				const int32 IntermediateNodeCount = FMath::Max(ExpandedNodeCount - SourceNodeCount, 0);
+				const int32 BytecodeSize = GetBytecodeSize(Blueprint);
+
+				TArray<double> FullCompileSeconds;
+				TArray<double> SkeletonCompileSeconds;
+				for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+				{
+					double StartTime = FPlatformTime::Seconds();
+					FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+					FullCompileSeconds.Add(FPlatformTime::Seconds() - StartTime);
+
+					StartTime = FPlatformTime::Seconds();
+					FKismetEditorUtilities::GenerateBlueprintSkeleton(Blueprint, true);
+					SkeletonCompileSeconds.Add(FPlatformTime::Seconds() - StartTime);
+				}
+
+				const double FullCompileMedianSeconds = FAdvancedControlFlowBenchmarkUtils::GetMedian(FullCompileSeconds);
+				const double SkeletonCompileMedianSeconds = FAdvancedControlFlowBenchmarkUtils::GetMedian(SkeletonCompileSeconds);
+
+				TSharedRef<FJsonObject> Result = MakeShared<FJsonObject>();
+				Result->SetStringField(TEXT("NodeType"), NodeType);
+				Result->SetNumberField(TEXT("CaseCount"), CaseCount);
+				Result->SetNumberField(TEXT("NodeCount"), NodeCount);
+				Result->SetBoolField(TEXT("Succeeded"), bSucceeded);
+				Result->SetNumberField(TEXT("SourceNodeCount"), SourceNodeCount);
+				Result->SetNumberField(TEXT("ExpandedNodeCount"), ExpandedNodeCount);
+				Result->SetNumberField(TEXT("IntermediateNodeCount"), IntermediateNodeCount);
+				Result->SetNumberField(TEXT("BytecodeSize"), BytecodeSize);
+				Result->SetNumberField(TEXT("FullCompileMinSeconds"), FMath::Min(FullCompileSeconds));
+				Result->SetNumberField(TEXT("FullCompileMedianSeconds"), FullCompileMedianSeconds);
+				Result->SetNumberField(TEXT("SkeletonCompileMinSeconds"), FMath::Min(SkeletonCompileSeconds));
+				Result->SetNumberField(TEXT("SkeletonCompileMedianSeconds"), SkeletonCompileMedianSeconds);
+				Results.Add(MakeShared<FJsonValueObject>(Result));
+
+				UE_LOG(LogAdvancedControlFlowCompileBenchmark, Display,
+					TEXT("%s (Cases=%d, Nodes=%d): Full=%.6fs, Skeleton=%.6fs, IntermediateNodes=%d, Bytecode=%d bytes%s"),
+					*NodeType, CaseCount, NodeCount, FullCompileMedianSeconds, SkeletonCompileMedianSeconds,
+					IntermediateNodeCount, BytecodeSize, bSucceeded ? TEXT("") : TEXT(" (Error)"));
+
+				FAdvancedControlFlowBenchmarkUtils::DiscardBlueprint(Blueprint);
+			}
+		}
+	}
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("EngineVersion"), FEngineVersion::Current().ToString());
+	Root->SetNumberField(TEXT("Iterations"), Iterations);
+	Root->SetArrayField(TEXT("Results"), Results);
+
+	FString OutputString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	FJsonSerializer::Serialize(Root, Writer);
+	if (!FFileHelper::SaveStringToFile(OutputString, *OutputPath))
+	{
+		UE_LOG(LogAdvancedControlFlowCompileBenchmark, Error, TEXT("Failed to write the result to %s"), *OutputPath);
+		return 1;
+	}
+	UE_LOG(LogAdvancedControlFlowCompileBenchmark, Display, TEXT("The result is written to %s"), *OutputPath);
+
+	return 0;
+}
@@ -0,0 +1,193 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowCompileCheckCommandlet.h"
+
+#include "AdvancedControlFlowAssetRegistryTags.h"
+#include "AdvancedControlFlowBenchmarkUtils.h"
+#include "BlueprintCompilationManager.h"
+#include "Engine/Blueprint.h"
+#include "HAL/PlatformTime.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAdvancedControlFlowCompileCheck, Log, All);
+
+namespace
+{
+struct FCompileCheckResult
+{
+	FString PackageName;
+	FString Status;
+	double LoadSeconds = 0.0;
+	int32 BatchIndex = 0;
+	double BatchCompileSeconds = 0.0;
+	TArray<FString> Errors;
+	int32 WarningCount = 0;
+	FAdvancedControlFlowNodeStatistics Statistics;
+};
+
+void CollectCompilerMessages(UBlueprint* Blueprint, FCompileCheckResult& OutResult)
+{
+	TArray<UEdGraphNode*> Nodes;
+	FBlueprintEditorUtils::GetAllNodesOfClass(Blueprint, Nodes);
+	for (const UEdGraphNode* Node : Nodes)
+	{
+		if (!Node->bHasCompilerMessage)
+		{
+			continue;
+		}
+
+		if (Node->ErrorType <= EMessageSeverity::Error)
+		{
+			OutResult.Errors.Add(FString::Printf(
+				TEXT("%s: %s"), *Node->GetNodeTitle(ENodeTitleType::ListView).ToString(), *Node->ErrorMsg.TrimStartAndEnd()));
+		}
+		else if (Node->ErrorType == EMessageSeverity::Warning)
+		{
+			++OutResult.WarningCount;
+		}
+	}
+}
+
+FString GetStatusString(const UBlueprint* Blueprint, const FCompileCheckResult& Result)
+{
+	if ((Blueprint->Status == BS_Error) || (Result.Errors.Num() > 0))
+	{
+		return TEXT("Error");
+	}
+	else if (Blueprint->Status == BS_UpToDateWithWarnings)
+	{
+		return TEXT("Warning");
+	}
+
+	return TEXT("Succeeded");
+}
+}	 // namespace
+
+UAdvancedControlFlowCompileCheckCommandlet::UAdvancedControlFlowCompileCheckCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAdvancedControlFlowCompileCheckCommandlet::Main(const FString& Params)
+{
+	FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AdvancedControlFlow"), TEXT("CompileCheck.csv"));
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	const TArray<FString> Paths = FAdvancedControlFlowBenchmarkUtils::ParseStringList(Params, TEXT("Paths="), {});
+	int32 BatchSize = 32;
+	FParse::Value(*Params, TEXT("BatchSize="), BatchSize);
+	BatchSize = FMath::Max(BatchSize, 1);
+	const bool bIncludeUntagged = FParse::Param(*Params, TEXT("IncludeUntagged"));
+
+	// Find the Blueprints from the asset registry tags.
+	TArray<FAssetData> TargetAssets;
+	TArray<FAssetData> UntaggedAssets;
+	FAdvancedControlFlowAssetRegistryTags::FindBlueprints(Paths, {}, TargetAssets, UntaggedAssets);
+	const int32 BlueprintCount = TargetAssets.Num() + UntaggedAssets.Num();
+	const int32 UntaggedCount = bIncludeUntagged ? UntaggedAssets.Num() : 0;
+	if (bIncludeUntagged)
+	{
+		TargetAssets.Append(UntaggedAssets);
+		TargetAssets.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+	}
+	UE_LOG(LogAdvancedControlFlowCompileCheck, Display, TEXT("Found %d Blueprints (%d untagged) in %d Blueprints"),
+		TargetAssets.Num(), UntaggedCount, BlueprintCount);
+
+	// Compile the Blueprints in batches.
+	TArray<FCompileCheckResult> Results;
+	for (int32 BatchStart = 0; BatchStart < TargetAssets.Num(); BatchStart += BatchSize)
+	{
+		const int32 BatchIndex = BatchStart / BatchSize;
+		const int32 BatchEnd = FMath::Min(BatchStart + BatchSize, TargetAssets.Num());
+
+		TArray<TPair<UBlueprint*, int32>> Batch;
+		for (int32 Index = BatchStart; Index < BatchEnd; ++Index)
+		{
+			FCompileCheckResult Result;
+			Result.PackageName = TargetAssets[Index].PackageName.ToString();
+			Result.BatchIndex = BatchIndex;
+
+			const double LoadStartTime = FPlatformTime::Seconds();
+			UBlueprint* Blueprint = Cast<UBlueprint>(TargetAssets[Index].GetAsset());
+			Result.LoadSeconds = FPlatformTime::Seconds() - LoadStartTime;
+			if (Blueprint == nullptr)
+			{
+				Result.Status = TEXT("Error");
+				Result.Errors.Add(TEXT("Failed to load"));
+				Results.Add(MoveTemp(Result));
+				continue;
+			}
+
+			Result.Statistics = FAdvancedControlFlowAssetRegistryTags::GetNodeStatistics(Blueprint);
+			if (Result.Statistics.NodeCount == 0)
+			{
+				// Untagged Blueprint which does not use the nodes.
+				continue;
+			}
+
+			FBlueprintCompilationManager::QueueForCompilation(Blueprint);
+			Batch.Add(TPair<UBlueprint*, int32>(Blueprint, Results.Add(MoveTemp(Result))));
+		}
+
+		const double CompileStartTime = FPlatformTime::Seconds();
+		FBlueprintCompilationManager::FlushCompilationQueueAndReinstance();
+		const double BatchCompileSeconds = FPlatformTime::Seconds() - CompileStartTime;
+
+		for (const TPair<UBlueprint*, int32>& Entry : Batch)
+		{
+			FCompileCheckResult& Result = Results[Entry.Value];
+			Result.BatchCompileSeconds = BatchCompileSeconds;
+			CollectCompilerMessages(Entry.Key, Result);
+			Result.Status = GetStatusString(Entry.Key, Result);
+
+			UE_LOG(LogAdvancedControlFlowCompileCheck, Display, TEXT("[Batch %d] %s: %s (Nodes=%d, MaxCases=%d)"), BatchIndex,
+				*Result.PackageName, *Result.Status, Result.Statistics.NodeCount, Result.Statistics.MaxCaseCount);
+			for (const FString& Error : Result.Errors)
+			{
+				UE_LOG(LogAdvancedControlFlowCompileCheck, Error, TEXT("%s: %s"), *Result.PackageName, *Error);
+			}
+		}
+
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	// Report
+	int32 ErrorCount = 0;
+	TArray<FString> Lines;
+	Lines.Add(TEXT("Asset,Status,LoadSeconds,BatchIndex,BatchCompileSeconds,Errors,Warnings,NodeCount,MaxCaseCount,")
+				  TEXT("NodeCountsPerType,FirstError"));
+	for (const FCompileCheckResult& Result : Results)
+	{
+		if (Result.Status == TEXT("Error"))
+		{
+			++ErrorCount;
+		}
+		Lines.Add(FString::Printf(TEXT("%s,%s,%.6f,%d,%.6f,%d,%d,%d,%d,%s,%s"),
+			*FAdvancedControlFlowBenchmarkUtils::EscapeCsvField(Result.PackageName), *Result.Status, Result.LoadSeconds,
+			Result.BatchIndex, Result.BatchCompileSeconds, Result.Errors.Num(), Result.WarningCount, Result.Statistics.NodeCount,
+			Result.Statistics.MaxCaseCount,
+			*FAdvancedControlFlowBenchmarkUtils::EscapeCsvField(Result.Statistics.GetNodeCountsPerTypeString()),
+			*FAdvancedControlFlowBenchmarkUtils::EscapeCsvField(Result.Errors.Num() > 0 ? Result.Errors[0] : FString())));
+	}
+	if (!FFileHelper::SaveStringToFile(FString::Join(Lines, TEXT("\n")) + TEXT("\n"), *OutputPath))
+	{
+		UE_LOG(LogAdvancedControlFlowCompileCheck, Error, TEXT("Failed to write the result to %s"), *OutputPath);
+		return 1;
+	}
+	UE_LOG(LogAdvancedControlFlowCompileCheck, Display, TEXT("Compiled %d Blueprints (%d failed). The result is written to %s"),
+		Results.Num(), ErrorCount, *OutputPath);
+
+	return (ErrorCount > 0) ? 1 : 0;
+}
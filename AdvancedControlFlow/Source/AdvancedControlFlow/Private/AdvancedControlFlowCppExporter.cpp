@@ -0,0 +1,1118 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowCppExporter.h"
+
+#include "AdvancedControlFlowBitmaskUtils.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Engine/UserDefinedEnum.h"
+#include "K2Node_BatchMultiConditionalSelect.h"
+#include "K2Node_BitmaskConditionalSequence.h"
+#include "K2Node_BitmaskMultiBranch.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_ConditionalSequence.h"
+#include "K2Node_ExecutionSequence.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_FunctionResult.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_Knot.h"
+#include "K2Node_MultiBranch.h"
+#include "K2Node_MultiConditionalSelect.h"
+#include "K2Node_SwitchExec.h"
+#include "K2Node_SwitchStringExec.h"
+#include "Misc/EngineVersionComparison.h"
+
+namespace
+{
+// The round trip test calls the functions with all combinations of the candidate values up to this number.
+// Random combinations are used if the number of the combinations exceeds this number.
+const int32 MaxRoundTripSampleCount = 256;
+
+FString MakeIdentifier(const FString& Name)
+{
+	FString Identifier;
+	Identifier.Reserve(Name.Len());
+	for (TCHAR Char : Name)
+	{
+		Identifier.AppendChar((FChar::IsAlnum(Char) || (Char == TEXT('_'))) ? Char : TEXT('_'));
+	}
+	if (Identifier.IsEmpty() || FChar::IsDigit(Identifier[0]))
+	{
+		Identifier.InsertAt(0, TEXT('_'));
+	}
+
+	return Identifier;
+}
+
+bool IsExecPin(const UEdGraphPin* Pin)
+{
+	return Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec;
+}
+
+bool IsPassedByReference(const FString& CppType)
+{
+	return (CppType == TEXT("FString")) || (CppType == TEXT("FName"));
+}
+
+bool IsFloatingPoint(const FString& CppType)
+{
+	return (CppType == TEXT("float")) || (CppType == TEXT("double"));
+}
+
+// The native enum is exported as its own type, and the enum class can not be converted from the integer implicitly.
+FString MakeByteLiteral(const FString& CppType, int64 Value)
+{
+	if (CppType == TEXT("uint8"))
+	{
+		return FString::Printf(TEXT("(uint8)%lld"), Value);
+	}
+
+	return FString::Printf(TEXT("static_cast<%s>((uint8)%lld)"), *CppType, Value);
+}
+
+// Candidate values of the parameter used by the round trip test.
+TArray<FString> GetCandidateValues(const FEdGraphPinType& PinType, const FString& CppType)
+{
+	if (CppType == TEXT("bool"))
+	{
+		return {TEXT("false"), TEXT("true")};
+	}
+	else if (PinType.PinCategory == UEdGraphSchema_K2::PC_Byte)
+	{
+		if (UEnum* Enum = Cast<UEnum>(PinType.PinSubCategoryObject.Get()))
+		{
+			TArray<FString> Values;
+			const int32 EnumCount = Enum->ContainsExistingMax() ? Enum->NumEnums() - 1 : Enum->NumEnums();
+			for (int32 Index = 0; Index < EnumCount; ++Index)
+			{
+				Values.Add(MakeByteLiteral(CppType, Enum->GetValueByIndex(Index)));
+			}
+			return Values;
+		}
+		return {TEXT("(uint8)0"), TEXT("(uint8)1"), TEXT("(uint8)2"), TEXT("(uint8)3"), TEXT("(uint8)255")};
+	}
+	else if ((CppType == TEXT("int32")) || (CppType == TEXT("int64")))
+	{
+		return {TEXT("0"), TEXT("1"), TEXT("2"), TEXT("3"), TEXT("-1"), TEXT("7"), TEXT("100")};
+	}
+	else if (CppType == TEXT("float"))
+	{
+		return {TEXT("0.0f"), TEXT("1.0f"), TEXT("-1.0f"), TEXT("0.5f"), TEXT("2.0f")};
+	}
+	else if (CppType == TEXT("double"))
+	{
+		return {TEXT("0.0"), TEXT("1.0"), TEXT("-1.0"), TEXT("0.5"), TEXT("2.0")};
+	}
+	else if (CppType == TEXT("FString"))
+	{
+		return {TEXT("FString()"), TEXT("FString(TEXT(\"A\"))")};
+	}
+	else if (CppType == TEXT("FName"))
+	{
+		return {TEXT("FName()"), TEXT("FName(TEXT(\"A\"))")};
+	}
+
+	return {FString::Printf(TEXT("%s()"), *CppType)};
+}
+
+// Get the cases of the bitmask nodes in the order of the bit position. The first case wins if some cases have the same bit.
+bool GetBitmaskCases(const TArray<CasePinPair>& CasePairs, int32 BitCount, TArray<TPair<int32, UEdGraphPin*>>& OutCases)
+{
+	uint64 UsedBits = 0;
+	for (const CasePinPair& Pair : CasePairs)
+	{
+		int32 Bit;
+		if (!FAdvancedControlFlowBitmaskUtils::GetCaseBit(Pair.Key, Bit) || (Bit >= BitCount))
+		{
+			return false;
+		}
+		if ((UsedBits & (1ull << Bit)) != 0)
+		{
+			continue;
+		}
+		UsedBits |= 1ull << Bit;
+		OutCases.Add(TPair<int32, UEdGraphPin*>(Bit, Pair.Value));
+	}
+	OutCases.Sort([](const TPair<int32, UEdGraphPin*>& A, const TPair<int32, UEdGraphPin*>& B) { return A.Key < B.Key; });
+
+	return true;
+}
+
+FString MakeBitTestExpression(const FString& BitmaskVariable, int32 Bit)
+{
+	return FString::Printf(TEXT("(%s & 0x%llxull) != 0"), *BitmaskVariable, 1ull << Bit);
+}
+}	 // namespace
+
+FAdvancedControlFlowCppExporter::FAdvancedControlFlowCppExporter(const FString& InModuleName, const FString& InClassName)
+	: ModuleName(MakeIdentifier(InModuleName)), ClassName(MakeIdentifier(InClassName))
+{
+}
+
+bool FAdvancedControlFlowCppExporter::AddFunction(UBlueprint* Blueprint, UEdGraph* Graph)
+{
+	FExportedFunction Function;
+	Function.Name = MakeIdentifier(Graph->GetName());
+	Function.BlueprintFunctionName = Graph->GetFName();
+	Function.BlueprintClassPath = (Blueprint->GeneratedClass != nullptr) ? Blueprint->GeneratedClass->GetPathName() : FString();
+
+	FFunctionContext Context;
+	Context.Function = &Function;
+
+	TArray<UK2Node_FunctionEntry*> EntryNodes;
+	Graph->GetNodesOfClass(EntryNodes);
+	TArray<UK2Node_FunctionResult*> ResultNodes;
+	Graph->GetNodesOfClass(ResultNodes);
+	if (EntryNodes.Num() != 1)
+	{
+		AddError(Context, nullptr, TEXT("The function graph must have one entry node."));
+		return false;
+	}
+
+	// Parameters
+	for (UEdGraphPin* Pin : EntryNodes[0]->Pins)
+	{
+		if ((Pin->Direction != EGPD_Output) || IsExecPin(Pin))
+		{
+			continue;
+		}
+
+		FParam Param;
+		Param.Name = MakeIdentifier(Pin->PinName.ToString());
+		Param.PinName = Pin->PinName;
+		Param.PinType = Pin->PinType;
+		if (!GetCppType(Pin->PinType, Param.CppType))
+		{
+			AddError(Context, EntryNodes[0],
+				FString::Printf(TEXT("The type of the parameter '%s' is not supported."), *Param.Name));
+			continue;
+		}
+		Function.Inputs.Add(Param);
+		Context.PinVariableMap.Add(Pin, Param.Name);
+	}
+	if (ResultNodes.Num() > 0)
+	{
+		for (UEdGraphPin* Pin : ResultNodes[0]->Pins)
+		{
+			if ((Pin->Direction != EGPD_Input) || IsExecPin(Pin))
+			{
+				continue;
+			}
+
+			FParam Param;
+			Param.Name = MakeIdentifier(Pin->PinName.ToString());
+			Param.PinName = Pin->PinName;
+			Param.PinType = Pin->PinType;
+			if (!GetCppType(Pin->PinType, Param.CppType))
+			{
+				AddError(
+					Context, ResultNodes[0], FString::Printf(TEXT("The type of the output '%s' is not supported."), *Param.Name));
+				continue;
+			}
+			Function.Outputs.Add(Param);
+		}
+	}
+	Function.bHasReturnValue = (Function.Outputs.Num() == 1) && (Function.Outputs[0].PinName == UEdGraphSchema_K2::PN_ReturnValue);
+
+	// The outputs are zero-initialized as well as the Blueprint functions.
+	if (Function.bHasReturnValue)
+	{
+		EmitLine(Context, FString::Printf(TEXT("%s ReturnValue{};"), *Function.Outputs[0].CppType));
+	}
+	else
+	{
+		for (const FParam& Output : Function.Outputs)
+		{
+			EmitLine(Context, FString::Printf(TEXT("%s = %s{};"), *Output.Name, *Output.CppType));
+		}
+	}
+
+	// The outputs of the impure nodes keep the value after the node is executed, so they are declared at first.
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node);
+		if ((CallNode == nullptr) || CallNode->IsNodePure())
+		{
+			continue;
+		}
+
+		for (UEdGraphPin* Pin : CallNode->Pins)
+		{
+			if ((Pin->Direction != EGPD_Output) || IsExecPin(Pin))
+			{
+				continue;
+			}
+
+			FString CppType;
+			if (!GetCppType(Pin->PinType, CppType))
+			{
+				AddError(Context, CallNode, FString::Printf(TEXT("The type of '%s' is not supported."), *Pin->PinName.ToString()));
+				continue;
+			}
+			const FString VariableName =
+				MakeIdentifier(FString::Printf(TEXT("%s_%s"), *CallNode->GetName(), *Pin->PinName.ToString()));
+			EmitLine(Context, FString::Printf(TEXT("%s %s{};"), *CppType, *VariableName));
+			Context.PinVariableMap.Add(Pin, VariableName);
+		}
+	}
+
+	EmitExecChain(Context, EntryNodes[0]->FindPin(UEdGraphSchema_K2::PN_Then));
+	if (Function.bHasReturnValue)
+	{
+		EmitLine(Context, TEXT("return ReturnValue;"));
+	}
+
+	if (Context.bFailed)
+	{
+		return false;
+	}
+	Functions.Add(MoveTemp(Function));
+
+	return true;
+}
+
+TMap<FString, FString> FAdvancedControlFlowCppExporter::GenerateFiles() const
+{
+	TMap<FString, FString> Files;
+	Files.Add(FString::Printf(TEXT("%s.Build.cs"), *ModuleName), GenerateBuildRules());
+	Files.Add(FString::Printf(TEXT("Private/%sModule.cpp"), *ModuleName), GenerateModuleSource());
+	Files.Add(FString::Printf(TEXT("Public/%s.h"), *ClassName), GenerateHeader());
+	Files.Add(FString::Printf(TEXT("Private/%s.cpp"), *ClassName), GenerateSource());
+	Files.Add(FString::Printf(TEXT("Private/%sRoundTripTest.cpp"), *ClassName), GenerateRoundTripTestSource());
+
+	return Files;
+}
+
+FString FAdvancedControlFlowCppExporter::GenerateBuildRules() const
+{
+	TArray<FString> Dependencies = {TEXT("Core"), TEXT("CoreUObject"), TEXT("Engine")};
+	TArray<FString> SortedModuleDependencies = ModuleDependencies.Array();
+	SortedModuleDependencies.Sort();
+	for (const FString& Dependency : SortedModuleDependencies)
+	{
+		Dependencies.AddUnique(Dependency);
+	}
+
+	TArray<FString> Lines;
+	Lines.Add(TEXT("// Generated by the AdvancedControlFlowExport commandlet. Do not edit."));
+	Lines.Add(TEXT(""));
+	Lines.Add(TEXT("using UnrealBuildTool;"));
+	Lines.Add(TEXT(""));
+	Lines.Add(FString::Printf(TEXT("public class %s : ModuleRules"), *ModuleName));
+	Lines.Add(TEXT("{"));
+	Lines.Add(FString::Printf(TEXT("\tpublic %s(ReadOnlyTargetRules Target) : base(Target)"), *ModuleName));
+	Lines.Add(TEXT("\t{"));
+	Lines.Add(TEXT("\t\tPCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;"));
+	Lines.Add(TEXT(""));
+	Lines.Add(TEXT("\t\tPublicDependencyModuleNames.AddRange(new string[]{"));
+	for (const FString& Dependency : Dependencies)
+	{
+		Lines.Add(FString::Printf(TEXT("\t\t\t\"%s\","), *Dependency));
+	}
+	Lines.Add(TEXT("\t\t});"));
+	Lines.Add(TEXT("\t}"));
+	Lines.Add(TEXT("}"));
+
+	return FString::Join(Lines, TEXT("\n")) + TEXT("\n");
+}
+
+FString FAdvancedControlFlowCppExporter::GenerateModuleSource() const
+{
+	TArray<FString> Lines;
+	Lines.Add(TEXT("// Generated by the AdvancedControlFlowExport commandlet. Do not edit."));
+	Lines.Add(TEXT(""));
+	Lines.Add(TEXT("#include \"Modules/ModuleManager.h\""));
+	Lines.Add(TEXT(""));
+	Lines.Add(FString::Printf(TEXT("IMPLEMENT_MODULE(FDefaultModuleImpl, %s);"), *ModuleName));
+
+	return FString::Join(Lines, TEXT("\n")) + TEXT("\n");
+}
+
+FString FAdvancedControlFlowCppExporter::GenerateHeader() const
+{
+	TArray<FString> Lines;
+	Lines.Add(TEXT("// Generated by the AdvancedControlFlowExport commandlet. Do not edit."));
+	Lines.Add(TEXT(""));
+	Lines.Add(TEXT("#pragma once"));
+	Lines.Add(TEXT(""));
+	Lines.Add(TEXT("#include \"CoreMinimal.h\""));
+	Lines.Add(TEXT("#include \"Kismet/BlueprintFunctionLibrary.h\""));
+	TArray<FString> SortedHeaderIncludes = HeaderIncludes.Array();
+	SortedHeaderIncludes.Sort();
+	for (const FString& Include : SortedHeaderIncludes)
+	{
+		Lines.Add(FString::Printf(TEXT("#include \"%s\""), *Include));
+	}
+	Lines.Add(TEXT(""));
+	Lines.Add(FString::Printf(TEXT("#include \"%s.generated.h\""), *ClassName));
+	Lines.Add(TEXT(""));
+	Lines.Add(TEXT("UCLASS()"));
+	Lines.Add(FString::Printf(
+		TEXT("class %s_API U%s : public UBlueprintFunctionLibrary"), *ModuleName.ToUpper(), *ClassName));
+	Lines.Add(TEXT("{"));
+	Lines.Add(TEXT("\tGENERATED_BODY()"));
+	Lines.Add(TEXT(""));
+	Lines.Add(TEXT("public:"));
+	for (int32 Index = 0; Index < Functions.Num(); ++Index)
+	{
+		if (Index > 0)
+		{
+			Lines.Add(TEXT(""));
+		}
+		Lines.Add(FString::Printf(TEXT("\t// Exported from %s"), *Functions[Index].BlueprintClassPath));
+		Lines.Add(TEXT("\tUFUNCTION(BlueprintCallable, Category = \"AdvancedControlFlow|Exported\")"));
+		Lines.Add(FString::Printf(TEXT("\tstatic %s;"), *GetFunctionSignature(Functions[Index], false)));
+	}
+	Lines.Add(TEXT("};"));
+
+	return FString::Join(Lines, TEXT("\n")) + TEXT("\n");
+}
+
+FString FAdvancedControlFlowCppExporter::GenerateSource() const
+{
+	TArray<FString> SortedIncludes = Includes.Array();
+	SortedIncludes.Sort();
+
+	TArray<FString> Lines;
+	Lines.Add(TEXT("// Generated by the AdvancedControlFlowExport commandlet. Do not edit."));
+	Lines.Add(TEXT(""));
+	Lines.Add(FString::Printf(TEXT("#include \"%s.h\""), *ClassName));
+	if (SortedIncludes.Num() > 0)
+	{
+		Lines.Add(TEXT(""));
+		for (const FString& Include : SortedIncludes)
+		{
+			Lines.Add(FString::Printf(TEXT("#include \"%s\""), *Include));
+		}
+	}
+	for (const FExportedFunction& Function : Functions)
+	{
+		Lines.Add(TEXT(""));
+		Lines.Add(GetFunctionSignature(Function, true));
+		Lines.Add(TEXT("{"));
+		Lines.Append(Function.BodyLines);
+		Lines.Add(TEXT("}"));
+	}
+
+	return FString::Join(Lines, TEXT("\n")) + TEXT("\n");
+}
+
+FString FAdvancedControlFlowCppExporter::GenerateRoundTripTestSource() const
+{
+	TArray<FString> Lines;
+	Lines.Add(TEXT("// Generated by the AdvancedControlFlowExport commandlet. Do not edit."));
+	Lines.Add(TEXT("//"));
+	Lines.Add(TEXT("// Call the Blueprint functions and the exported functions with the same inputs, and compare the outputs."));
+	Lines.Add(TEXT(""));
+	Lines.Add(FString::Printf(TEXT("#include \"%s.h\""), *ClassName));
+	Lines.Add(TEXT(""));
+	Lines.Add(TEXT("#include \"Math/RandomStream.h\""));
+	Lines.Add(TEXT("#include \"Misc/AutomationTest.h\""));
+	Lines.Add(TEXT("#include \"UObject/StructOnScope.h\""));
+	Lines.Add(TEXT(""));
+	Lines.Add(TEXT("#if WITH_DEV_AUTOMATION_TESTS && WITH_EDITOR"));
+
+	for (const FExportedFunction& Function : Functions)
+	{
+		const FString TestName = FString::Printf(TEXT("F%s_%s_RoundTripTest"), *ClassName, *Function.Name);
+
+		// Use all combinations if possible.
+		int64 CombinationCount = 1;
+		TArray<TArray<FString>> CandidateValues;
+		for (const FParam& Input : Function.Inputs)
+		{
+			CandidateValues.Add(GetCandidateValues(Input.PinType, Input.CppType));
+			CombinationCount *= CandidateValues.Last().Num();
+			CombinationCount = FMath::Min<int64>(CombinationCount, MAX_int32);
+		}
+		const bool bExhaustive = (CombinationCount <= MaxRoundTripSampleCount);
+		const int64 SampleCount = bExhaustive ? CombinationCount : MaxRoundTripSampleCount;
+
+		Lines.Add(TEXT(""));
+		Lines.Add(FString::Printf(TEXT("IMPLEMENT_SIMPLE_AUTOMATION_TEST(%s, \"AdvancedControlFlow.Export.%s.%s\","), *TestName,
+			*ClassName, *Function.Name));
+		Lines.Add(TEXT("\tEAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)"));
+		Lines.Add(TEXT(""));
+		Lines.Add(FString::Printf(TEXT("bool %s::RunTest(const FString& Parameters)"), *TestName));
+		Lines.Add(TEXT("{"));
+		Lines.Add(FString::Printf(
+			TEXT("\tUClass* BlueprintClass = LoadObject<UClass>(nullptr, TEXT(\"%s\"));"), *Function.BlueprintClassPath));
+		Lines.Add(TEXT("\tif (!TestNotNull(TEXT(\"Blueprint class\"), BlueprintClass))"));
+		Lines.Add(TEXT("\t{"));
+		Lines.Add(TEXT("\t\treturn false;"));
+		Lines.Add(TEXT("\t}"));
+		Lines.Add(FString::Printf(TEXT("\tUFunction* Function = BlueprintClass->FindFunctionByName(TEXT(\"%s\"));"),
+			*Function.BlueprintFunctionName.ToString()));
+		Lines.Add(TEXT("\tif (!TestNotNull(TEXT(\"Blueprint function\"), Function))"));
+		Lines.Add(TEXT("\t{"));
+		Lines.Add(TEXT("\t\treturn false;"));
+		Lines.Add(TEXT("\t}"));
+		Lines.Add(TEXT("\tUObject* Object = NewObject<UObject>(GetTransientPackage(), BlueprintClass);"));
+		Lines.Add(TEXT(""));
+		for (int32 Index = 0; Index < Function.Inputs.Num(); ++Index)
+		{
+			const FParam& Input = Function.Inputs[Index];
+			Lines.Add(FString::Printf(TEXT("\tconst TArray<%s> Candidates_%s = {%s};"), *Input.CppType, *Input.Name,
+				*FString::Join(CandidateValues[Index], TEXT(", "))));
+		}
+		Lines.Add(FString::Printf(TEXT("\tfor (int32 Sample = 0; Sample < %lld; ++Sample)"), SampleCount));
+		Lines.Add(TEXT("\t{"));
+		Lines.Add(TEXT("\t\tFRandomStream Stream(Sample);"));
+		Lines.Add(TEXT("\t\tFStructOnScope Params(Function);"));
+		Lines.Add(TEXT("\t\tuint8* Memory = Params.GetStructMemory();"));
+
+		// Inputs
+		int64 Stride = 1;
+		TArray<FString> NativeArgs;
+		for (int32 Index = 0; Index < Function.Inputs.Num(); ++Index)
+		{
+			const FParam& Input = Function.Inputs[Index];
+			const int32 CandidateCount = CandidateValues[Index].Num();
+			const FString Selector = bExhaustive
+				? FString::Printf(TEXT("(Sample / %lld) %% %d"), Stride, CandidateCount)
+				: FString::Printf(TEXT("Stream.RandHelper(%d)"), CandidateCount);
+			Stride *= CandidateCount;
+
+			Lines.Add(FString::Printf(
+				TEXT("\t\tconst %s In_%s = Candidates_%s[%s];"), *Input.CppType, *Input.Name, *Input.Name, *Selector));
+			Lines.Add(FString::Printf(
+				TEXT("\t\t*Function->FindPropertyByName(TEXT(\"%s\"))->ContainerPtrToValuePtr<%s>(Memory) = In_%s;"),
+				*Input.PinName.ToString(), *Input.CppType, *Input.Name));
+			NativeArgs.Add(FString::Printf(TEXT("In_%s"), *Input.Name));
+		}
+
+		// Call the Blueprint function.
+		Lines.Add(TEXT("\t\t{"));
+		Lines.Add(TEXT("\t\t\tFEditorScriptExecutionGuard ScriptGuard;"));
+		Lines.Add(TEXT("\t\t\tObject->ProcessEvent(Function, Memory);"));
+		Lines.Add(TEXT("\t\t}"));
+
+		// Call the exported function.
+		FString NativeCall;
+		if (Function.bHasReturnValue)
+		{
+			NativeCall = FString::Printf(
+				TEXT("const %s Native_ReturnValue = U%s::%s(%s);"), *Function.Outputs[0].CppType, *ClassName, *Function.Name,
+				*FString::Join(NativeArgs, TEXT(", ")));
+		}
+		else
+		{
+			for (const FParam& Output : Function.Outputs)
+			{
+				Lines.Add(FString::Printf(TEXT("\t\t%s Native_%s{};"), *Output.CppType, *Output.Name));
+				NativeArgs.Add(FString::Printf(TEXT("Native_%s"), *Output.Name));
+			}
+			NativeCall =
+				FString::Printf(TEXT("U%s::%s(%s);"), *ClassName, *Function.Name, *FString::Join(NativeArgs, TEXT(", ")));
+		}
+		Lines.Add(FString::Printf(TEXT("\t\t%s"), *NativeCall));
+
+		// Compare the outputs.
+		for (const FParam& Output : Function.Outputs)
+		{
+			const FString BlueprintValue = FString::Printf(
+				TEXT("*Function->FindPropertyByName(TEXT(\"%s\"))->ContainerPtrToValuePtr<%s>(Memory)"), *Output.PinName.ToString(),
+				*Output.CppType);
+			const FString NativeValue = FString::Printf(TEXT("Native_%s"), *Output.Name);
+			const FString Comparison = IsFloatingPoint(Output.CppType)
+				? FString::Printf(TEXT("FMath::IsNearlyEqual(%s, %s)"), *BlueprintValue, *NativeValue)
+				: FString::Printf(TEXT("(%s == %s)"), *BlueprintValue, *NativeValue);
+			Lines.Add(FString::Printf(
+				TEXT("\t\tTestTrue(FString::Printf(TEXT(\"%s (Sample %%d)\"), Sample), %s);"), *Output.Name, *Comparison));
+		}
+		Lines.Add(TEXT("\t}"));
+		Lines.Add(TEXT(""));
+		Lines.Add(TEXT("\treturn true;"));
+		Lines.Add(TEXT("}"));
+	}
+
+	Lines.Add(TEXT(""));
+	Lines.Add(TEXT("#endif"));
+
+	return FString::Join(Lines, TEXT("\n")) + TEXT("\n");
+}
+
+FString FAdvancedControlFlowCppExporter::GetFunctionSignature(const FExportedFunction& Function, bool bWithClassName) const
+{
+	TArray<FString> Params;
+	for (const FParam& Input : Function.Inputs)
+	{
+		Params.Add(IsPassedByReference(Input.CppType) ? FString::Printf(TEXT("const %s& %s"), *Input.CppType, *Input.Name)
+													  : FString::Printf(TEXT("%s %s"), *Input.CppType, *Input.Name));
+	}
+	if (!Function.bHasReturnValue)
+	{
+		for (const FParam& Output : Function.Outputs)
+		{
+			Params.Add(FString::Printf(TEXT("%s& %s"), *Output.CppType, *Output.Name));
+		}
+	}
+
+	return FString::Printf(TEXT("%s %s%s(%s)"), Function.bHasReturnValue ? *Function.Outputs[0].CppType : TEXT("void"),
+		bWithClassName ? *FString::Printf(TEXT("U%s::"), *ClassName) : TEXT(""), *Function.Name,
+		*FString::Join(Params, TEXT(", ")));
+}
+
+void FAdvancedControlFlowCppExporter::EmitLine(FFunctionContext& Context, const FString& Line) const
+{
+	Context.Function->BodyLines.Add(FString::ChrN(Context.Indent, TEXT('\t')) + Line);
+}
+
+void FAdvancedControlFlowCppExporter::EmitExecChain(FFunctionContext& Context, const UEdGraphPin* ExecOutputPin)
+{
+	if ((ExecOutputPin == nullptr) || (ExecOutputPin->LinkedTo.Num() == 0) || Context.bFailed)
+	{
+		// The execution ends here.
+		return;
+	}
+
+	EmitExecNode(Context, ExecOutputPin->LinkedTo[0]->GetOwningNode());
+}
+
+void FAdvancedControlFlowCppExporter::EmitExecNode(FFunctionContext& Context, UEdGraphNode* Node)
+{
+	if (Context.VisitingNodes.Contains(Node))
+	{
+		AddError(Context, Node, TEXT("The loop in the execution flow is not supported."));
+		return;
+	}
+	Context.VisitingNodes.Add(Node);
+
+	if (UK2Node_Knot* KnotNode = Cast<UK2Node_Knot>(Node))
+	{
+		EmitExecChain(Context, KnotNode->GetOutputPin());
+	}
+	else if (UK2Node_FunctionResult* ResultNode = Cast<UK2Node_FunctionResult>(Node))
+	{
+		for (UEdGraphPin* Pin : ResultNode->Pins)
+		{
+			if ((Pin->Direction != EGPD_Input) || IsExecPin(Pin))
+			{
+				continue;
+			}
+
+			const FParam* Output =
+				Context.Function->Outputs.FindByPredicate([Pin](const FParam& Param) { return Param.PinName == Pin->PinName; });
+			if (Output == nullptr)
+			{
+				AddError(Context, ResultNode, TEXT("The outputs of the result nodes must be same."));
+				continue;
+			}
+			const FString Variable = Context.Function->bHasReturnValue ? FString(TEXT("ReturnValue")) : Output->Name;
+			EmitLine(Context, FString::Printf(TEXT("%s = %s;"), *Variable, *GetInputExpression(Context, Pin)));
+		}
+		EmitLine(Context, Context.Function->bHasReturnValue ? TEXT("return ReturnValue;") : TEXT("return;"));
+	}
+	else if (UK2Node_BitmaskMultiBranch* BitmaskMultiBranchNode = Cast<UK2Node_BitmaskMultiBranch>(Node))
+	{
+		// if (Bitmask & Bit 0) {...} else if (Bitmask & Bit 1) {...} else {Default}
+		UEdGraphPin* BitmaskPin = BitmaskMultiBranchNode->GetBitmaskPin();
+		TArray<TPair<int32, UEdGraphPin*>> Cases;
+		FString CppType;
+		if (!GetCppType(BitmaskPin->PinType, CppType))
+		{
+			AddError(Context, BitmaskMultiBranchNode, TEXT("The type of the bitmask is undetermined."));
+		}
+		else if (!GetBitmaskCases(BitmaskMultiBranchNode->GetCasePinPairs(),
+					 FAdvancedControlFlowBitmaskUtils::GetBitCount(BitmaskPin), Cases))
+		{
+			AddError(Context, BitmaskMultiBranchNode, TEXT("The case bit is invalid."));
+		}
+		else
+		{
+			// The bitmask is evaluated only once.
+			const FString BitmaskVariable =
+				FString::Printf(TEXT("Bitmask_%s"), *BitmaskMultiBranchNode->NodeGuid.ToString(EGuidFormats::Digits));
+			EmitLine(Context, TEXT("{"));
+			++Context.Indent;
+			const FString BitmaskExpression = GetInputExpression(Context, BitmaskPin);
+			EmitLine(Context, FString::Printf(TEXT("const %s %s = %s;"), *CppType, *BitmaskVariable, *BitmaskExpression));
+			for (int32 CaseIndex = 0; CaseIndex < Cases.Num(); ++CaseIndex)
+			{
+				const FString Condition = MakeBitTestExpression(BitmaskVariable, Cases[CaseIndex].Key);
+				EmitBlock(Context, FString::Printf(TEXT("%sif (%s)"), (CaseIndex > 0) ? TEXT("else ") : TEXT(""), *Condition),
+					Cases[CaseIndex].Value);
+			}
+			EmitBlock(Context, (Cases.Num() > 0) ? TEXT("else") : FString(), BitmaskMultiBranchNode->GetDefaultExecPin());
+			--Context.Indent;
+			EmitLine(Context, TEXT("}"));
+		}
+	}
+	else if (UK2Node_BitmaskConditionalSequence* BitmaskConditionalSequenceNode = Cast<UK2Node_BitmaskConditionalSequence>(Node))
+	{
+		// if (Bitmask & Bit 0) {...} if (Bitmask & Bit 1) {...} Default
+		UEdGraphPin* BitmaskPin = BitmaskConditionalSequenceNode->GetBitmaskPin();
+		TArray<TPair<int32, UEdGraphPin*>> Cases;
+		FString CppType;
+		if (!GetCppType(BitmaskPin->PinType, CppType))
+		{
+			AddError(Context, BitmaskConditionalSequenceNode, TEXT("The type of the bitmask is undetermined."));
+		}
+		else if (!GetBitmaskCases(BitmaskConditionalSequenceNode->GetCasePinPairs(),
+					 FAdvancedControlFlowBitmaskUtils::GetBitCount(BitmaskPin), Cases))
+		{
+			AddError(Context, BitmaskConditionalSequenceNode, TEXT("The case bit is invalid."));
+		}
+		else
+		{
+			// The bitmask is evaluated only once at the entry as the Blueprint.
+			const FString BitmaskVariable =
+				FString::Printf(TEXT("Bitmask_%s"), *BitmaskConditionalSequenceNode->NodeGuid.ToString(EGuidFormats::Digits));
+			EmitLine(Context, TEXT("{"));
+			++Context.Indent;
+			const FString BitmaskExpression = GetInputExpression(Context, BitmaskPin);
+			EmitLine(Context, FString::Printf(TEXT("const %s %s = %s;"), *CppType, *BitmaskVariable, *BitmaskExpression));
+			for (const TPair<int32, UEdGraphPin*>& Case : Cases)
+			{
+				if (Case.Value->LinkedTo.Num() == 0)
+				{
+					continue;
+				}
+				EmitBlock(
+					Context, FString::Printf(TEXT("if (%s)"), *MakeBitTestExpression(BitmaskVariable, Case.Key)), Case.Value);
+			}
+			--Context.Indent;
+			EmitLine(Context, TEXT("}"));
+			EmitExecChain(Context, BitmaskConditionalSequenceNode->GetDefaultExecPin());
+		}
+	}
+	else if (UK2Node_MultiBranch* MultiBranchNode = Cast<UK2Node_MultiBranch>(Node))
+	{
+		// if (Condition 0) {...} else if (Condition 1) {...} else {Default}
+		TArray<CasePinPair> CasePairs = MultiBranchNode->GetCasePinPairs();
+		for (int32 CaseIndex = 0; CaseIndex < CasePairs.Num(); ++CaseIndex)
+		{
+			const FString Condition = GetInputExpression(Context, CasePairs[CaseIndex].Key);
+			EmitBlock(Context, FString::Printf(TEXT("%sif (%s)"), (CaseIndex > 0) ? TEXT("else ") : TEXT(""), *Condition),
+				CasePairs[CaseIndex].Value);
+		}
+		if (CasePairs.Num() > 0)
+		{
+			EmitBlock(Context, TEXT("else"), MultiBranchNode->GetDefaultExecPin());
+		}
+		else
+		{
+			EmitExecChain(Context, MultiBranchNode->GetDefaultExecPin());
+		}
+	}
+	else if (UK2Node_ConditionalSequence* ConditionalSequenceNode = Cast<UK2Node_ConditionalSequence>(Node))
+	{
+		// if (Condition 0) {...} if (Condition 1) {...} Default
+		for (const CasePinPair& Pair : ConditionalSequenceNode->GetCasePinPairs())
+		{
+			if (Pair.Value->LinkedTo.Num() == 0)
+			{
+				continue;
+			}
+			EmitBlock(Context, FString::Printf(TEXT("if (%s)"), *GetInputExpression(Context, Pair.Key)), Pair.Value);
+		}
+		EmitExecChain(Context, ConditionalSequenceNode->GetDefaultExecPin());
+	}
+	else if (UK2Node_SwitchStringExec* SwitchStringExecNode = Cast<UK2Node_SwitchStringExec>(Node))
+	{
+		UEdGraphPin* SelectionPin = SwitchStringExecNode->GetSelectionPin();
+		FString CppType;
+		if (!GetCppType(SelectionPin->PinType, CppType))
+		{
+			AddError(Context, SwitchStringExecNode, TEXT("The type of the selection is undetermined."));
+		}
+		else
+		{
+			// The selection is evaluated only once as the switch statement.
+			const FString SelectionVariable =
+				FString::Printf(TEXT("Selection_%s"), *SwitchStringExecNode->NodeGuid.ToString(EGuidFormats::Digits));
+			const bool bIsName = (SelectionPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Name);
+			EmitLine(Context, TEXT("{"));
+			++Context.Indent;
+			const FString SelectionExpression = GetInputExpression(Context, SelectionPin);
+			EmitLine(Context, FString::Printf(TEXT("const %s %s = %s;"), *CppType, *SelectionVariable, *SelectionExpression));
+
+			// The first case wins if some cases have the same value.
+			// The values are compared without case by the same function as the Blueprint to fold the case in the same way.
+			const bool bCaseSensitive = !bIsName && SwitchStringExecNode->bCaseSensitive;
+			if (!bCaseSensitive)
+			{
+				Includes.Add(TEXT("AdvancedControlFlowSwitchLibrary.h"));
+				ModuleDependencies.Add(TEXT("AdvancedControlFlowRuntime"));
+			}
+			bool bHasCase = false;
+			for (const CasePinPair& Pair : SwitchStringExecNode->GetCasePinPairs())
+			{
+				const FString CaseValue = GetLiteral(Context, Pair.Key);
+				const FString Condition = bCaseSensitive
+					? FString::Printf(TEXT("%s.Equals(%s, ESearchCase::CaseSensitive)"), *SelectionVariable, *CaseValue)
+					: FString::Printf(TEXT("!UAdvancedControlFlowSwitchLibrary::NotEqual%sIgnoreCase(%s, %s)"),
+						  bIsName ? TEXT("Name") : TEXT("String"), *SelectionVariable, *CaseValue);
+				const TCHAR* Keyword = bHasCase ? TEXT("else if") : TEXT("if");
+				EmitBlock(Context, FString::Printf(TEXT("%s (%s)"), Keyword, *Condition), Pair.Value);
+				bHasCase = true;
+			}
+			EmitBlock(Context, bHasCase ? TEXT("else") : FString(), SwitchStringExecNode->GetDefaultExecPin());
+
+			--Context.Indent;
+			EmitLine(Context, TEXT("}"));
+		}
+	}
+	else if (UK2Node_SwitchExec* SwitchExecNode = Cast<UK2Node_SwitchExec>(Node))
+	{
+		UEdGraphPin* SelectionPin = SwitchExecNode->GetSelectionPin();
+		if (SelectionPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+		{
+			AddError(Context, SwitchExecNode, TEXT("The type of the selection is undetermined."));
+		}
+		else
+		{
+			// The case labels are the integers, so the enum class is converted to the underlying type.
+			FString SelectionExpression = GetInputExpression(Context, SelectionPin);
+			FString CppType;
+			if (GetCppType(SelectionPin->PinType, CppType) && (SelectionPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Byte) &&
+				(CppType != TEXT("uint8")))
+			{
+				SelectionExpression = FString::Printf(TEXT("static_cast<uint8>(%s)"), *SelectionExpression);
+			}
+			EmitLine(Context, FString::Printf(TEXT("switch (%s)"), *SelectionExpression));
+			EmitLine(Context, TEXT("{"));
+
+			// The first case wins if some cases have the same value.
+			TSet<int64> CaseValues;
+			for (const CasePinPair& Pair : SwitchExecNode->GetCasePinPairs())
+			{
+				int64 CaseValue;
+				if (!SwitchExecNode->GetCaseValue(Pair.Key, CaseValue))
+				{
+					AddError(Context, SwitchExecNode, TEXT("The case value is invalid."));
+					continue;
+				}
+				if (CaseValues.Contains(CaseValue))
+				{
+					continue;
+				}
+				CaseValues.Add(CaseValue);
+
+				EmitLine(Context, FString::Printf(TEXT("case %lld:"), CaseValue));
+				EmitBlock(Context, FString(), Pair.Value);
+				EmitLine(Context, TEXT("break;"));
+			}
+			EmitLine(Context, TEXT("default:"));
+			EmitBlock(Context, FString(), SwitchExecNode->GetDefaultExecPin());
+			EmitLine(Context, TEXT("break;"));
+
+			EmitLine(Context, TEXT("}"));
+		}
+	}
+	else if (UK2Node_IfThenElse* BranchNode = Cast<UK2Node_IfThenElse>(Node))
+	{
+		EmitBlock(Context, FString::Printf(TEXT("if (%s)"), *GetInputExpression(Context, BranchNode->GetConditionPin())),
+			BranchNode->GetThenPin());
+		EmitBlock(Context, TEXT("else"), BranchNode->GetElsePin());
+	}
+	else if (UK2Node_ExecutionSequence* SequenceNode = Cast<UK2Node_ExecutionSequence>(Node))
+	{
+		for (UEdGraphPin* Pin : SequenceNode->Pins)
+		{
+			if ((Pin->Direction == EGPD_Output) && IsExecPin(Pin))
+			{
+				EmitExecChain(Context, Pin);
+			}
+		}
+	}
+	else if (UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node))
+	{
+		const FString CallExpression = GetCallExpression(Context, CallNode);
+		UEdGraphPin* ReturnValuePin = CallNode->GetReturnValuePin();
+		if (ReturnValuePin != nullptr)
+		{
+			EmitLine(Context, FString::Printf(TEXT("%s = %s;"), *Context.PinVariableMap.FindRef(ReturnValuePin), *CallExpression));
+		}
+		else
+		{
+			EmitLine(Context, FString::Printf(TEXT("%s;"), *CallExpression));
+		}
+		EmitExecChain(Context, CallNode->GetThenPin());
+	}
+	else
+	{
+		AddError(Context, Node, TEXT("The node is not supported."));
+	}
+
+	Context.VisitingNodes.Remove(Node);
+}
+
+void FAdvancedControlFlowCppExporter::EmitBlock(FFunctionContext& Context, const FString& Header, const UEdGraphPin* ExecOutputPin)
+{
+	if (!Header.IsEmpty())
+	{
+		EmitLine(Context, Header);
+	}
+	EmitLine(Context, TEXT("{"));
+	++Context.Indent;
+	EmitExecChain(Context, ExecOutputPin);
+	--Context.Indent;
+	EmitLine(Context, TEXT("}"));
+}
+
+FString FAdvancedControlFlowCppExporter::GetInputExpression(FFunctionContext& Context, const UEdGraphPin* InputPin)
+{
+	if (InputPin->LinkedTo.Num() == 0)
+	{
+		return GetLiteral(Context, InputPin);
+	}
+
+	return GetOutputExpression(Context, InputPin->LinkedTo[0]);
+}
+
+FString FAdvancedControlFlowCppExporter::GetOutputExpression(FFunctionContext& Context, const UEdGraphPin* OutputPin)
+{
+	if (const FString* Variable = Context.PinVariableMap.Find(OutputPin))
+	{
+		return *Variable;
+	}
+
+	UEdGraphNode* Node = OutputPin->GetOwningNode();
+	if (UK2Node_Knot* KnotNode = Cast<UK2Node_Knot>(Node))
+	{
+		return GetInputExpression(Context, KnotNode->GetInputPin());
+	}
+	else if (Cast<UK2Node_BatchMultiConditionalSelect>(Node) != nullptr)
+	{
+		AddError(Context, Node, TEXT("Batch Multi-Conditional Select node is not supported."));
+		return FString();
+	}
+	else if (UK2Node_MultiConditionalSelect* MultiConditionalSelectNode = Cast<UK2Node_MultiConditionalSelect>(Node))
+	{
+		// (Condition 0 ? Option 0 : (Condition 1 ? Option 1 : Default))
+		// Only the options of the true condition are evaluated as well as the Blueprint.
+		FString Expression = GetInputExpression(Context, MultiConditionalSelectNode->GetDefaultOptionPin());
+		TArray<CasePinPair> CasePairs = MultiConditionalSelectNode->GetCasePinPairs();
+		for (int32 CaseIndex = CasePairs.Num() - 1; CaseIndex >= 0; --CaseIndex)
+		{
+			Expression = FString::Printf(TEXT("(%s ? %s : %s)"), *GetInputExpression(Context, CasePairs[CaseIndex].Value),
+				*GetInputExpression(Context, CasePairs[CaseIndex].Key), *Expression);
+		}
+		return Expression;
+	}
+	else if (UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Node))
+	{
+		if (CallNode->IsNodePure() && (OutputPin == CallNode->GetReturnValuePin()))
+		{
+			return GetCallExpression(Context, CallNode);
+		}
+		AddError(Context, Node, TEXT("The output parameters of the pure functions are not supported."));
+		return FString();
+	}
+
+	AddError(Context, Node, TEXT("The node is not supported."));
+
+	return FString();
+}
+
+FString FAdvancedControlFlowCppExporter::GetCallExpression(FFunctionContext& Context, UK2Node_CallFunction* CallNode)
+{
+	UFunction* Function = CallNode->GetTargetFunction();
+	if ((Function == nullptr) || !Function->HasAllFunctionFlags(FUNC_Static | FUNC_Native) ||
+		Function->HasMetaData(TEXT("Latent")))
+	{
+		AddError(Context, CallNode, TEXT("Only the static native functions are supported."));
+		return FString();
+	}
+
+	UClass* FunctionClass = Function->GetOwnerClass();
+	const FString IncludePath = FunctionClass->GetMetaData(TEXT("IncludePath"));
+	if (!IncludePath.IsEmpty())
+	{
+		Includes.Add(IncludePath);
+	}
+	const FString PackageName = FunctionClass->GetOutermost()->GetName();
+	if (PackageName.StartsWith(TEXT("/Script/")))
+	{
+		ModuleDependencies.Add(PackageName.RightChop(8));
+	}
+
+	TArray<FString> Args;
+	for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	{
+		if (It->HasAnyPropertyFlags(CPF_ReturnParm))
+		{
+			continue;
+		}
+
+		UEdGraphPin* Pin = CallNode->FindPin(It->GetFName());
+		if (Pin == nullptr)
+		{
+			AddError(Context, CallNode, FString::Printf(TEXT("The pin '%s' is not found."), *It->GetName()));
+			return FString();
+		}
+
+		if (Pin->Direction == EGPD_Output)
+		{
+			// Output parameters of the impure functions are declared as the local variables.
+			const FString* Variable = Context.PinVariableMap.Find(Pin);
+			if (Variable == nullptr)
+			{
+				AddError(Context, CallNode, TEXT("The output parameters of the pure functions are not supported."));
+				return FString();
+			}
+			Args.Add(*Variable);
+		}
+		else if (Pin->bHidden)
+		{
+			AddError(Context, CallNode,
+				FString::Printf(TEXT("The hidden parameter '%s' (e.g. World Context) is not supported."), *It->GetName()));
+			return FString();
+		}
+		else
+		{
+			Args.Add(GetInputExpression(Context, Pin));
+		}
+	}
+
+	return FString::Printf(TEXT("%s%s::%s(%s)"), FunctionClass->GetPrefixCPP(), *FunctionClass->GetName(), *Function->GetName(),
+		*FString::Join(Args, TEXT(", ")));
+}
+
+FString FAdvancedControlFlowCppExporter::GetLiteral(FFunctionContext& Context, const UEdGraphPin* Pin)
+{
+	const FString& DefaultValue = Pin->DefaultValue;
+	const FName& PinCategory = Pin->PinType.PinCategory;
+
+	FString CppType;
+	if (!GetCppType(Pin->PinType, CppType))
+	{
+		AddError(Context, Pin->GetOwningNode(),
+			FString::Printf(TEXT("The type of the pin '%s' is not supported."), *Pin->PinName.ToString()));
+		return FString();
+	}
+
+	if (PinCategory == UEdGraphSchema_K2::PC_Boolean)
+	{
+		return DefaultValue.ToBool() ? TEXT("true") : TEXT("false");
+	}
+	else if (PinCategory == UEdGraphSchema_K2::PC_Byte)
+	{
+		int64 Value = FCString::Atoi64(*DefaultValue);
+		if (UEnum* Enum = Cast<UEnum>(Pin->PinType.PinSubCategoryObject.Get()))
+		{
+			Value = FMath::Max<int64>(Enum->GetValueByNameString(DefaultValue), 0);
+		}
+		return MakeByteLiteral(CppType, Value);
+	}
+	else if (PinCategory == UEdGraphSchema_K2::PC_Int)
+	{
+		return FString::FromInt(FCString::Atoi(*DefaultValue));
+	}
+	else if (PinCategory == UEdGraphSchema_K2::PC_Int64)
+	{
+		return FString::Printf(TEXT("%lldLL"), FCString::Atoi64(*DefaultValue));
+	}
+	else if (PinCategory == UEdGraphSchema_K2::PC_String)
+	{
+		return FString::Printf(TEXT("FString(TEXT(\"%s\"))"), *DefaultValue.ReplaceCharWithEscapedChar());
+	}
+	else if (PinCategory == UEdGraphSchema_K2::PC_Name)
+	{
+		if (DefaultValue.IsEmpty() || (DefaultValue == TEXT("None")))
+		{
+			return TEXT("FName()");
+		}
+		return FString::Printf(TEXT("FName(TEXT(\"%s\"))"), *DefaultValue.ReplaceCharWithEscapedChar());
+	}
+
+	// Float/Double
+	const FString Value = FString::SanitizeFloat(FCString::Atod(*DefaultValue));
+	return (CppType == TEXT("float")) ? Value + TEXT("f") : Value;
+}
+
+bool FAdvancedControlFlowCppExporter::GetCppType(const FEdGraphPinType& PinType, FString& OutCppType)
+{
+	if (PinType.IsContainer())
+	{
+		return false;
+	}
+
+	const FName& PinCategory = PinType.PinCategory;
+	if (PinCategory == UEdGraphSchema_K2::PC_Boolean)
+	{
+		OutCppType = TEXT("bool");
+	}
+	else if (PinCategory == UEdGraphSchema_K2::PC_Byte)
+	{
+		// The user defined enum has no C++ type, so it is exported as the byte.
+		const UEnum* Enum = Cast<UEnum>(PinType.PinSubCategoryObject.Get());
+		if ((Enum != nullptr) && !Enum->IsA<UUserDefinedEnum>() && !Enum->CppType.IsEmpty())
+		{
+			OutCppType = (Enum->GetCppForm() == UEnum::ECppForm::EnumClass)
+				? Enum->CppType
+				: FString::Printf(TEXT("TEnumAsByte<%s>"), *Enum->CppType);
+			AddEnumDependency(Enum);
+		}
+		else
+		{
+			OutCppType = TEXT("uint8");
+		}
+	}
+	else if (PinCategory == UEdGraphSchema_K2::PC_Int)
+	{
+		OutCppType = TEXT("int32");
+	}
+	else if (PinCategory == UEdGraphSchema_K2::PC_Int64)
+	{
+		OutCppType = TEXT("int64");
+	}
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+	else if (PinCategory == UEdGraphSchema_K2::PC_Float)
+	{
+		OutCppType = TEXT("float");
+	}
+#else
+	else if (PinCategory == UEdGraphSchema_K2::PC_Real)
+	{
+		OutCppType = (PinType.PinSubCategory == UEdGraphSchema_K2::PC_Float) ? TEXT("float") : TEXT("double");
+	}
+#endif
+	else if (PinCategory == UEdGraphSchema_K2::PC_String)
+	{
+		OutCppType = TEXT("FString");
+	}
+	else if (PinCategory == UEdGraphSchema_K2::PC_Name)
+	{
+		OutCppType = TEXT("FName");
+	}
+	else
+	{
+		return false;
+	}
+
+	return true;
+}
+
+void FAdvancedControlFlowCppExporter::AddEnumDependency(const UEnum* Enum)
+{
+	// The enum is used in the function signatures, so the header declaring it is included from the generated header.
+	FString IncludePath = Enum->GetMetaData(TEXT("ModuleRelativePath"));
+	if (IncludePath.RemoveFromStart(TEXT("Public/")) || IncludePath.RemoveFromStart(TEXT("Classes/")))
+	{
+		HeaderIncludes.Add(IncludePath);
+	}
+	const FString PackageName = Enum->GetOutermost()->GetName();
+	if (PackageName.StartsWith(TEXT("/Script/")))
+	{
+		ModuleDependencies.Add(PackageName.RightChop(8));
+	}
+}
+
+void FAdvancedControlFlowCppExporter::AddError(FFunctionContext& Context, const UEdGraphNode* Node, const FString& Message)
+{
+	Context.bFailed = true;
+
+	const FString Location = (Node != nullptr) ? FString::Printf(TEXT("%s (%s)"), *Context.Function->Name,
+													 *Node->GetNodeTitle(ENodeTitleType::ListView).ToString())
+											   : Context.Function->Name;
+	Errors.Add(FString::Printf(TEXT("%s: %s"), *Location, *Message));
+}
@@ -0,0 +1,115 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowExportCommandlet.h"
+
+#include "AdvancedControlFlowBenchmarkUtils.h"
+#include "AdvancedControlFlowCppExporter.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAdvancedControlFlowExport, Log, All);
+
+UAdvancedControlFlowExportCommandlet::UAdvancedControlFlowExportCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAdvancedControlFlowExportCommandlet::Main(const FString& Params)
+{
+	FString BlueprintPath;
+	if (!FParse::Value(*Params, TEXT("Blueprint="), BlueprintPath))
+	{
+		UE_LOG(LogAdvancedControlFlowExport, Error, TEXT("-Blueprint=<Blueprint path> is required."));
+		return 1;
+	}
+	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
+	if (Blueprint == nullptr)
+	{
+		UE_LOG(LogAdvancedControlFlowExport, Error, TEXT("Failed to load the Blueprint: %s"), *BlueprintPath);
+		return 1;
+	}
+
+	FString ModuleName = TEXT("AdvancedControlFlowExported");
+	FParse::Value(*Params, TEXT("Module="), ModuleName);
+	FString ClassName = Blueprint->GetName() + TEXT("Native");
+	FParse::Value(*Params, TEXT("ClassName="), ClassName);
+	FString OutputDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AdvancedControlFlow"), TEXT("Export"), ModuleName);
+	FParse::Value(*Params, TEXT("Output="), OutputDir);
+	const bool bVerify = FParse::Param(*Params, TEXT("Verify"));
+	const TArray<FString> FunctionNames = FAdvancedControlFlowBenchmarkUtils::ParseStringList(Params, TEXT("Functions="), {});
+
+	// The generated round trip test loads the generated class of the Blueprint.
+	FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+
+	FAdvancedControlFlowCppExporter Exporter(ModuleName, ClassName);
+	int32 ExportedCount = 0;
+	for (UEdGraph* Graph : Blueprint->FunctionGraphs)
+	{
+		const FString GraphName = Graph->GetName();
+		if (FunctionNames.Num() > 0 && !FunctionNames.Contains(GraphName))
+		{
+			continue;
+		}
+		if (FunctionNames.Num() == 0 && Graph->GetFName() == UEdGraphSchema_K2::FN_UserConstructionScript)
+		{
+			continue;
+		}
+
+		if (Exporter.AddFunction(Blueprint, Graph))
+		{
+			UE_LOG(LogAdvancedControlFlowExport, Display, TEXT("Exported %s"), *GraphName);
+			++ExportedCount;
+		}
+	}
+	for (const FString& Error : Exporter.GetErrors())
+	{
+		UE_LOG(LogAdvancedControlFlowExport, Error, TEXT("%s"), *Error);
+	}
+	if ((Exporter.GetErrors().Num() > 0) || (ExportedCount == 0))
+	{
+		UE_LOG(LogAdvancedControlFlowExport, Error, TEXT("Failed to export the functions of %s"), *BlueprintPath);
+		return 1;
+	}
+
+	bool bSucceeded = true;
+	for (const TPair<FString, FString>& File : Exporter.GenerateFiles())
+	{
+		const FString FilePath = FPaths::Combine(OutputDir, File.Key);
+		if (bVerify)
+		{
+			FString ExistingContent;
+			if (!FFileHelper::LoadFileToString(ExistingContent, *FilePath) || (ExistingContent != File.Value))
+			{
+				UE_LOG(LogAdvancedControlFlowExport, Error, TEXT("%s is out of date. Export the functions again."), *FilePath);
+				bSucceeded = false;
+			}
+		}
+		else if (!FFileHelper::SaveStringToFile(File.Value, *FilePath))
+		{
+			UE_LOG(LogAdvancedControlFlowExport, Error, TEXT("Failed to write %s"), *FilePath);
+			bSucceeded = false;
+		}
+	}
+	if (!bSucceeded)
+	{
+		return 1;
+	}
+	UE_LOG(LogAdvancedControlFlowExport, Display, TEXT("%s the module %s"), bVerify ? TEXT("Verified") : TEXT("Exported"),
+		*OutputDir);
+
+	return 0;
+}
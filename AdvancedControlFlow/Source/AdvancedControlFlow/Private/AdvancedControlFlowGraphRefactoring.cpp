@@ -0,0 +1,498 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowGraphRefactoring.h"
+
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_MultiBranch.h"
+#include "K2Node_MultiConditionalSelect.h"
+#include "K2Node_Select.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "ScopedTransaction.h"
+#include "ToolMenus.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAdvancedControlFlowGraphRefactoring, Log, All);
+
+namespace
+{
+const FName MenuOwnerName(TEXT("AdvancedControlFlowGraphRefactoring"));
+FDelegateHandle MenuStartupCallbackHandle;
+
+bool IsBooleanSelect(const UEdGraphNode* Node)
+{
+	const UK2Node_Select* SelectNode = Cast<UK2Node_Select>(Node);
+	if (SelectNode == nullptr)
+	{
+		return false;
+	}
+
+	const UEdGraphPin* IndexPin = SelectNode->GetIndexPin();
+	return (IndexPin != nullptr) && (IndexPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Boolean);
+}
+
+bool IsChainableNode(const UEdGraphNode* Node)
+{
+	return (Node != nullptr) && Node->IsNodeEnabled() && ((Cast<UK2Node_IfThenElse>(Node) != nullptr) || IsBooleanSelect(Node));
+}
+
+// Get the next node whose input is linked only from the False pin of the node.
+UEdGraphNode* GetNextChainNode(UEdGraphNode* Node)
+{
+	if (!IsChainableNode(Node))
+	{
+		return nullptr;
+	}
+
+	if (UK2Node_IfThenElse* BranchNode = Cast<UK2Node_IfThenElse>(Node))
+	{
+		UEdGraphPin* ElsePin = BranchNode->GetElsePin();
+		if (ElsePin->LinkedTo.Num() != 1)
+		{
+			return nullptr;
+		}
+
+		UEdGraphPin* NextExecPin = ElsePin->LinkedTo[0];
+		UK2Node_IfThenElse* NextBranchNode = Cast<UK2Node_IfThenElse>(NextExecPin->GetOwningNode());
+		if ((NextBranchNode == nullptr) || (NextBranchNode == BranchNode) || !IsChainableNode(NextBranchNode) ||
+			(NextExecPin != NextBranchNode->GetExecPin()) || (NextExecPin->LinkedTo.Num() != 1))
+		{
+			return nullptr;
+		}
+
+		return NextBranchNode;
+	}
+
+	// The option pins are [False, True] when the index pin is Boolean.
+	UK2Node_Select* SelectNode = CastChecked<UK2Node_Select>(Node);
+	TArray<UEdGraphPin*> OptionPins;
+	SelectNode->GetOptionPins(OptionPins);
+	if ((OptionPins.Num() != 2) || (OptionPins[0]->LinkedTo.Num() != 1))
+	{
+		return nullptr;
+	}
+
+	UEdGraphPin* NextReturnValuePin = OptionPins[0]->LinkedTo[0];
+	UEdGraphNode* NextNode = NextReturnValuePin->GetOwningNode();
+	if ((NextNode == SelectNode) || !IsChainableNode(NextNode) || !IsBooleanSelect(NextNode))
+	{
+		return nullptr;
+	}
+	UK2Node_Select* NextSelectNode = CastChecked<UK2Node_Select>(NextNode);
+	if ((NextReturnValuePin != NextSelectNode->GetReturnValuePin()) || (NextReturnValuePin->LinkedTo.Num() != 1) ||
+		(NextReturnValuePin->PinType != SelectNode->GetReturnValuePin()->PinType))
+	{
+		return nullptr;
+	}
+
+	return NextSelectNode;
+}
+
+UEdGraphNode* GetPrevChainNode(UEdGraphNode* Node)
+{
+	if (!IsChainableNode(Node))
+	{
+		return nullptr;
+	}
+
+	UEdGraphPin* InputPin = nullptr;
+	if (UK2Node_IfThenElse* BranchNode = Cast<UK2Node_IfThenElse>(Node))
+	{
+		InputPin = BranchNode->GetExecPin();
+	}
+	else
+	{
+		InputPin = CastChecked<UK2Node_Select>(Node)->GetReturnValuePin();
+	}
+	if ((InputPin == nullptr) || (InputPin->LinkedTo.Num() != 1))
+	{
+		return nullptr;
+	}
+
+	UEdGraphNode* PrevNode = InputPin->LinkedTo[0]->GetOwningNode();
+	return (GetNextChainNode(PrevNode) == Node) ? PrevNode : nullptr;
+}
+
+TArray<UEdGraphNode*> GetChainFromHead(UEdGraphNode* HeadNode)
+{
+	TArray<UEdGraphNode*> Chain;
+	for (UEdGraphNode* Node = HeadNode; (Node != nullptr) && !Chain.Contains(Node); Node = GetNextChainNode(Node))
+	{
+		Chain.Add(Node);
+	}
+
+	return Chain;
+}
+
+// Split the chain from the head so that the new node does not exceed MaxChainLength cases. The False pin of the last node
+// of each piece is linked to the head of the next piece, so the pieces are collapsed into the nodes linked by Default.
+void SplitChain(const TArray<UEdGraphNode*>& Chain, TArray<TArray<UEdGraphNode*>>& OutChains)
+{
+	const int32 MaxChainLength = FAdvancedControlFlowGraphRefactoring::MaxChainLength;
+	for (int32 Offset = 0; Offset < Chain.Num(); Offset += MaxChainLength)
+	{
+		const int32 Length = FMath::Min(MaxChainLength, Chain.Num() - Offset);
+		if (Length >= FAdvancedControlFlowGraphRefactoring::MinChainLength)
+		{
+			OutChains.Emplace(Chain.GetData() + Offset, Length);
+		}
+	}
+}
+
+// Move the links and the default value to the pin of the new node.
+void MovePinLinksAndDefaultValue(UEdGraphPin* FromPin, UEdGraphPin* ToPin)
+{
+	ToPin->DefaultValue = FromPin->DefaultValue;
+	ToPin->DefaultObject = FromPin->DefaultObject;
+	ToPin->DefaultTextValue = FromPin->DefaultTextValue;
+	GetDefault<UEdGraphSchema_K2>()->MovePinLinks(*FromPin, *ToPin);
+}
+
+// Node comments of the chain are joined into the comment of the new node.
+void TakeOverNodeComments(const TArray<UEdGraphNode*>& Chain, UEdGraphNode* NewNode)
+{
+	TArray<FString> Comments;
+	bool bCommentBubbleVisible = false;
+	for (const UEdGraphNode* Node : Chain)
+	{
+		if (!Node->NodeComment.IsEmpty())
+		{
+			Comments.Add(Node->NodeComment);
+			bCommentBubbleVisible |= Node->bCommentBubbleVisible;
+		}
+	}
+	NewNode->NodeComment = FString::Join(Comments, TEXT("\n"));
+	NewNode->bCommentBubbleVisible = bCommentBubbleVisible;
+	NewNode->bCommentBubblePinned = bCommentBubbleVisible;
+}
+
+UEdGraphNode* CollapseBranchChain(UEdGraph* Graph, const TArray<UEdGraphNode*>& Chain)
+{
+	UK2Node_IfThenElse* HeadNode = CastChecked<UK2Node_IfThenElse>(Chain[0]);
+
+	FGraphNodeCreator<UK2Node_MultiBranch> NodeCreator(*Graph);
+	UK2Node_MultiBranch* MultiBranchNode = NodeCreator.CreateNode(false);
+	MultiBranchNode->NodePosX = HeadNode->NodePosX;
+	MultiBranchNode->NodePosY = HeadNode->NodePosY;
+	NodeCreator.Finalize();
+	MultiBranchNode->SetCasePinCount(Chain.Num());
+
+	// Branch N: Condition -> Condition N, True -> Case N, False of the last Branch -> Default
+	const TArray<CasePinPair> CasePairs = MultiBranchNode->GetCasePinPairs();
+	GetDefault<UEdGraphSchema_K2>()->MovePinLinks(*HeadNode->GetExecPin(), *MultiBranchNode->GetExecPin());
+	for (int32 Index = 0; Index < Chain.Num(); ++Index)
+	{
+		UK2Node_IfThenElse* BranchNode = CastChecked<UK2Node_IfThenElse>(Chain[Index]);
+		MovePinLinksAndDefaultValue(BranchNode->GetConditionPin(), CasePairs[Index].Key);
+		MovePinLinksAndDefaultValue(BranchNode->GetThenPin(), CasePairs[Index].Value);
+	}
+	UK2Node_IfThenElse* TailNode = CastChecked<UK2Node_IfThenElse>(Chain.Last());
+	MovePinLinksAndDefaultValue(TailNode->GetElsePin(), MultiBranchNode->GetDefaultExecPin());
+
+	return MultiBranchNode;
+}
+
+UEdGraphNode* CollapseSelectChain(UEdGraph* Graph, const TArray<UEdGraphNode*>& Chain)
+{
+	UK2Node_Select* HeadNode = CastChecked<UK2Node_Select>(Chain[0]);
+	const FEdGraphPinType OptionPinType = HeadNode->GetReturnValuePin()->PinType;
+
+	FGraphNodeCreator<UK2Node_MultiConditionalSelect> NodeCreator(*Graph);
+	UK2Node_MultiConditionalSelect* MultiConditionalSelectNode = NodeCreator.CreateNode(false);
+	MultiConditionalSelectNode->NodePosX = HeadNode->NodePosX;
+	MultiConditionalSelectNode->NodePosY = HeadNode->NodePosY;
+	NodeCreator.Finalize();
+	MultiConditionalSelectNode->SetCasePinCount(Chain.Num());
+
+	// The type of the options is determined without the connection.
+	const TArray<CasePinPair> CasePairs = MultiConditionalSelectNode->GetCasePinPairs();
+	MultiConditionalSelectNode->GetDefaultOptionPin()->PinType = OptionPinType;
+	MultiConditionalSelectNode->GetReturnValuePin()->PinType = OptionPinType;
+	for (const CasePinPair& Pair : CasePairs)
+	{
+		Pair.Key->PinType = OptionPinType;
+	}
+
+	// Select N: True -> Option N, Index -> Condition N, False of the last Select -> Default
+	GetDefault<UEdGraphSchema_K2>()->MovePinLinks(
+		*HeadNode->GetReturnValuePin(), *MultiConditionalSelectNode->GetReturnValuePin());
+	TArray<UEdGraphPin*> OptionPins;
+	for (int32 Index = 0; Index < Chain.Num(); ++Index)
+	{
+		UK2Node_Select* SelectNode = CastChecked<UK2Node_Select>(Chain[Index]);
+		SelectNode->GetOptionPins(OptionPins);
+		MovePinLinksAndDefaultValue(OptionPins[1], CasePairs[Index].Key);
+		MovePinLinksAndDefaultValue(SelectNode->GetIndexPin(), CasePairs[Index].Value);
+	}
+	CastChecked<UK2Node_Select>(Chain.Last())->GetOptionPins(OptionPins);
+	MovePinLinksAndDefaultValue(OptionPins[0], MultiConditionalSelectNode->GetDefaultOptionPin());
+
+	return MultiConditionalSelectNode;
+}
+
+void ShowNotification(const FText& Text, bool bSucceeded)
+{
+	FNotificationInfo Info(Text);
+	Info.ExpireDuration = 8.0f;
+	TSharedPtr<SNotificationItem> Notification = FSlateNotificationManager::Get().AddNotification(Info);
+	if (Notification.IsValid())
+	{
+		Notification->SetCompletionState(bSucceeded ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+	}
+}
+
+void CollapseChainsFromMenu(TWeakObjectPtr<UBlueprint> WeakBlueprint, TWeakObjectPtr<UEdGraphNode> WeakNode)
+{
+	UBlueprint* Blueprint = WeakBlueprint.Get();
+	if (Blueprint == nullptr)
+	{
+		return;
+	}
+
+	// Collapse all chains in the Blueprint if the node is not specified.
+	TArray<TArray<UEdGraphNode*>> Chains;
+	if (UEdGraphNode* Node = WeakNode.Get())
+	{
+		TArray<UEdGraphNode*> Chain = FAdvancedControlFlowGraphRefactoring::FindChain(Node);
+		if (Chain.Num() > 0)
+		{
+			Chains.Add(MoveTemp(Chain));
+		}
+	}
+	else
+	{
+		FAdvancedControlFlowGraphRefactoring::FindChains(Blueprint, Chains);
+	}
+	if (Chains.Num() == 0)
+	{
+		ShowNotification(LOCTEXT("NoChainsFound", "No Branch/Select chains to collapse are found"), false);
+		return;
+	}
+
+	const FAdvancedControlFlowCollapseResult Result = FAdvancedControlFlowGraphRefactoring::CollapseChains(Blueprint, Chains);
+	ShowNotification(Result.ToText(), Result.After.BytecodeSize >= 0);
+}
+
+void ExtendNodeContextMenu(UToolMenu* Menu)
+{
+	UGraphNodeContextMenuContext* Context = Menu->FindContext<UGraphNodeContextMenuContext>();
+	if ((Context == nullptr) || (Context->Node == nullptr) || (Context->Blueprint == nullptr) || Context->bIsDebugging)
+	{
+		return;
+	}
+
+	const UEdGraphNode* ContextNode = Context->Node;
+	const UBlueprint* ContextBlueprint = Context->Blueprint;
+	UEdGraphNode* Node = const_cast<UEdGraphNode*>(ContextNode);
+	TWeakObjectPtr<UBlueprint> WeakBlueprint = const_cast<UBlueprint*>(ContextBlueprint);
+	FToolMenuSection& Section =
+		Menu->AddSection("AdvancedControlFlowRefactoring", LOCTEXT("AdvancedControlFlowRefactoring", "Advanced Control Flow"));
+
+	if (FAdvancedControlFlowGraphRefactoring::FindChain(Node).Num() > 0)
+	{
+		const bool bIsBranch = (Cast<UK2Node_IfThenElse>(Node) != nullptr);
+		Section.AddMenuEntry("CollapseChain",
+			bIsBranch ? LOCTEXT("CollapseBranchChain", "Collapse Branch chain into Multi-Branch")
+					  : LOCTEXT("CollapseSelectChain", "Collapse Select chain into Multi-Conditional Select"),
+			LOCTEXT("CollapseChainTooltip", "Replace the chain which contains this node with one node"), FSlateIcon(),
+			FUIAction(FExecuteAction::CreateStatic(&CollapseChainsFromMenu, WeakBlueprint, TWeakObjectPtr<UEdGraphNode>(Node))));
+	}
+	Section.AddMenuEntry("CollapseAllChains", LOCTEXT("CollapseAllChains", "Collapse all Branch/Select chains in Blueprint"),
+		LOCTEXT("CollapseAllChainsTooltip",
+			"Replace all Branch chains with Multi-Branch nodes and all Select chains with Multi-Conditional Select nodes"),
+		FSlateIcon(),
+		FUIAction(FExecuteAction::CreateStatic(&CollapseChainsFromMenu, WeakBlueprint, TWeakObjectPtr<UEdGraphNode>())));
+}
+}	 // namespace
+
+FText FAdvancedControlFlowCollapseResult::ToText() const
+{
+	FFormatNamedArguments Args;
+	Args.Add(TEXT("BranchChainCount"), BranchChainCount);
+	Args.Add(TEXT("SelectChainCount"), SelectChainCount);
+	Args.Add(TEXT("NodeCountBefore"), Before.NodeCount);
+	Args.Add(TEXT("NodeCountAfter"), After.NodeCount);
+	Args.Add(TEXT("BytecodeSizeBefore"), Before.BytecodeSize);
+	Args.Add(TEXT("BytecodeSizeAfter"), After.BytecodeSize);
+	return FText::Format(LOCTEXT("CollapseResult",
+							 "Collapsed {BranchChainCount} Branch chain(s) and {SelectChainCount} Select chain(s) "
+							 "(Nodes: {NodeCountBefore} -> {NodeCountAfter}, "
+							 "Bytecode: {BytecodeSizeBefore} -> {BytecodeSizeAfter} bytes)"),
+		Args);
+}
+
+TArray<UEdGraphNode*> FAdvancedControlFlowGraphRefactoring::FindChain(UEdGraphNode* Node)
+{
+	if (!IsChainableNode(Node))
+	{
+		return TArray<UEdGraphNode*>();
+	}
+
+	// The nodes which are linked in a loop are not a chain.
+	TSet<UEdGraphNode*> VisitedNodes;
+	UEdGraphNode* HeadNode = Node;
+	while (UEdGraphNode* PrevNode = GetPrevChainNode(HeadNode))
+	{
+		if (VisitedNodes.Contains(PrevNode))
+		{
+			return TArray<UEdGraphNode*>();
+		}
+		VisitedNodes.Add(PrevNode);
+		HeadNode = PrevNode;
+	}
+
+	const TArray<UEdGraphNode*> Chain = GetChainFromHead(HeadNode);
+	TArray<TArray<UEdGraphNode*>> SplitChains;
+	SplitChain(Chain, SplitChains);
+	for (TArray<UEdGraphNode*>& SplitChainNodes : SplitChains)
+	{
+		if (SplitChainNodes.Contains(Node))
+		{
+			return MoveTemp(SplitChainNodes);
+		}
+	}
+
+	return TArray<UEdGraphNode*>();
+}
+
+void FAdvancedControlFlowGraphRefactoring::FindChains(UEdGraph* Graph, TArray<TArray<UEdGraphNode*>>& OutChains)
+{
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (!IsChainableNode(Node) || (GetPrevChainNode(Node) != nullptr))
+		{
+			continue;
+		}
+
+		SplitChain(GetChainFromHead(Node), OutChains);
+	}
+}
+
+void FAdvancedControlFlowGraphRefactoring::FindChains(UBlueprint* Blueprint, TArray<TArray<UEdGraphNode*>>& OutChains)
+{
+	TArray<UEdGraph*> Graphs;
+	Blueprint->GetAllGraphs(Graphs);
+	for (UEdGraph* Graph : Graphs)
+	{
+		FindChains(Graph, OutChains);
+	}
+}
+
+UEdGraphNode* FAdvancedControlFlowGraphRefactoring::CollapseChain(const TArray<UEdGraphNode*>& Chain)
+{
+	if ((Chain.Num() < MinChainLength) || (Chain.Num() > MaxChainLength) || (FindChain(Chain[0]) != Chain))
+	{
+		return nullptr;
+	}
+
+	UEdGraph* Graph = Chain[0]->GetGraph();
+	Graph->Modify();
+
+	UEdGraphNode* NewNode =
+		(Cast<UK2Node_IfThenElse>(Chain[0]) != nullptr) ? CollapseBranchChain(Graph, Chain) : CollapseSelectChain(Graph, Chain);
+	TakeOverNodeComments(Chain, NewNode);
+
+	UBlueprint* Blueprint = FBlueprintEditorUtils::FindBlueprintForGraph(Graph);
+	for (UEdGraphNode* Node : Chain)
+	{
+		FBlueprintEditorUtils::RemoveNode(Blueprint, Node, true);
+	}
+
+	return NewNode;
+}
+
+FAdvancedControlFlowCollapseResult FAdvancedControlFlowGraphRefactoring::CollapseChains(
+	UBlueprint* Blueprint, const TArray<TArray<UEdGraphNode*>>& Chains)
+{
+	FAdvancedControlFlowCollapseResult Result;
+	Result.Before = MeasureBlueprint(Blueprint);
+
+	{
+		const FScopedTransaction Transaction(LOCTEXT("CollapseChains", "Collapse Branch/Select Chains"));
+		Blueprint->Modify();
+		for (const TArray<UEdGraphNode*>& Chain : Chains)
+		{
+			UEdGraphNode* NewNode = CollapseChain(Chain);
+			if (Cast<UK2Node_MultiBranch>(NewNode) != nullptr)
+			{
+				++Result.BranchChainCount;
+			}
+			else if (Cast<UK2Node_MultiConditionalSelect>(NewNode) != nullptr)
+			{
+				++Result.SelectChainCount;
+			}
+		}
+		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+	}
+
+	Result.After = MeasureBlueprint(Blueprint);
+	UE_LOG(LogAdvancedControlFlowGraphRefactoring, Display, TEXT("%s: %s"), *Blueprint->GetPathName(), *Result.ToText().ToString());
+
+	return Result;
+}
+
+FAdvancedControlFlowBlueprintSize FAdvancedControlFlowGraphRefactoring::MeasureBlueprint(UBlueprint* Blueprint)
+{
+	FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+
+	FAdvancedControlFlowBlueprintSize Size;
+	TArray<UEdGraph*> Graphs;
+	Blueprint->GetAllGraphs(Graphs);
+	for (const UEdGraph* Graph : Graphs)
+	{
+		Size.NodeCount += Graph->Nodes.Num();
+	}
+
+	if ((Blueprint->Status != BS_Error) && (Blueprint->GeneratedClass != nullptr))
+	{
+		Size.BytecodeSize = 0;
+		for (TFieldIterator<UFunction> It(Blueprint->GeneratedClass, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+		{
+			Size.BytecodeSize += It->Script.Num();
+		}
+	}
+
+	return Size;
+}
+
+void FAdvancedControlFlowGraphRefactoring::RegisterMenus()
+{
+	MenuStartupCallbackHandle = UToolMenus::RegisterStartupCallback(FSimpleMulticastDelegate::FDelegate::CreateLambda(
+		[]()
+		{
+			// The context menu of each node class is named by the graph editor.
+			FToolMenuOwnerScoped OwnerScoped(MenuOwnerName);
+			const TCHAR* MenuNames[] = {
+				TEXT("GraphEditor.GraphNodeContextMenu.K2Node_IfThenElse"),
+				TEXT("GraphEditor.GraphNodeContextMenu.K2Node_Select"),
+			};
+			for (const TCHAR* MenuName : MenuNames)
+			{
+				UToolMenu* Menu = UToolMenus::Get()->ExtendMenu(MenuName);
+				Menu->AddDynamicSection(
+					"AdvancedControlFlowRefactoring", FNewToolMenuDelegate::CreateStatic(&ExtendNodeContextMenu));
+			}
+		}));
+}
+
+void FAdvancedControlFlowGraphRefactoring::UnregisterMenus()
+{
+	UToolMenus::UnRegisterStartupCallback(MenuStartupCallbackHandle);
+	UToolMenus::UnregisterOwner(MenuOwnerName);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -9,13 +9,21 @@
 
 #include "AdvancedControlFlowModule.h"
 
+#include "AdvancedControlFlowAssetRegistryTags.h"
+#include "AdvancedControlFlowCaseHitCounter.h"
+#include "AdvancedControlFlowGraphRefactoring.h"
+#include "CasePairedPinsNodeDetails.h"
 #include "EdGraphUtilities.h"
+#include "Editor.h"
 #include "K2Node_ConditionalSequence.h"
 #include "K2Node_MultiBranch.h"
 #include "K2Node_MultiConditionalSelect.h"
+#include "K2Node_SwitchExec.h"
+#include "PropertyEditorModule.h"
 #include "SGraphNodeConditionalSequence.h"
 #include "SGraphNodeMultiBranch.h"
 #include "SGraphNodeMultiConditionalSelect.h"
+#include "SGraphNodeSwitchExec.h"
 
 #define LOCTEXT_NAMESPACE "AdvancedControlFlow"
 
@@ -35,6 +43,10 @@ class FGraphPanelNodeFactory_AdvancedControlFlow : public FGraphPanelNodeFactory
 		{
 			return SNew(SGraphNodeMultiConditionalSelect, MultiConditionalSelect);
 		}
+		else if (UK2Node_SwitchExec* SwitchExec = Cast<UK2Node_SwitchExec>(Node))
+		{
+			return SNew(SGraphNodeSwitchExec, SwitchExec);
+		}
 
 		return nullptr;
 	}
@@ -44,15 +56,36 @@ void FAdvancedControlFlowModule::StartupModule()
 {
 	GraphPanelNodeFactory_AdvancedControlFlow = MakeShareable(new FGraphPanelNodeFactory_AdvancedControlFlow());
 	FEdGraphUtilities::RegisterVisualNodeFactory(GraphPanelNodeFactory_AdvancedControlFlow);
+
+	FPropertyEditorModule& PropertyEditorModule = FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor");
+	PropertyEditorModule.RegisterCustomClassLayout(UK2Node_CasePairedPinsNode::StaticClass()->GetFName(),
+		FOnGetDetailCustomizationInstance::CreateStatic(&FCasePairedPinsNodeDetails::MakeInstance));
+
+	FAdvancedControlFlowAssetRegistryTags::Register();
+	FAdvancedControlFlowGraphRefactoring::RegisterMenus();
+
+	// Save the hit counts recorded in PIE.
+	EndPIEHandle =
+		FEditorDelegates::EndPIE.AddLambda([](bool bIsSimulating) { FAdvancedControlFlowCaseHitCounter::Get().Flush(); });
 }
 
 void FAdvancedControlFlowModule::ShutdownModule()
 {
+	FEditorDelegates::EndPIE.Remove(EndPIEHandle);
+	FAdvancedControlFlowGraphRefactoring::UnregisterMenus();
+	FAdvancedControlFlowAssetRegistryTags::Unregister();
+
 	if (GraphPanelNodeFactory_AdvancedControlFlow.IsValid())
 	{
 		FEdGraphUtilities::UnregisterVisualNodeFactory(GraphPanelNodeFactory_AdvancedControlFlow);
 		GraphPanelNodeFactory_AdvancedControlFlow.Reset();
 	}
+
+	if (FModuleManager::Get().IsModuleLoaded("PropertyEditor"))
+	{
+		FPropertyEditorModule& PropertyEditorModule = FModuleManager::GetModuleChecked<FPropertyEditorModule>("PropertyEditor");
+		PropertyEditorModule.UnregisterCustomClassLayout(UK2Node_CasePairedPinsNode::StaticClass()->GetFName());
+	}
 }
 
 bool FAdvancedControlFlowModule::SupportsDynamicReloading()
@@ -0,0 +1,162 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowNodeCostRecorder.h"
+
+#include "BlueprintCompiledStatement.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "KismetCompiledFunctionContext.h"
+
+namespace
+{
+int32 CountLocals(const TIndirectArray<FBPTerminal>& Terms, const UEdGraphNode* Node)
+{
+	int32 Count = 0;
+	for (const FBPTerminal& Term : Terms)
+	{
+		if (Term.Source == Node)
+		{
+			++Count;
+		}
+	}
+
+	return Count;
+}
+}	 // namespace
+
+FAdvancedControlFlowNodeCostRecorder& FAdvancedControlFlowNodeCostRecorder::Get()
+{
+	static FAdvancedControlFlowNodeCostRecorder Instance;
+	return Instance;
+}
+
+void FAdvancedControlFlowNodeCostRecorder::StartRecording()
+{
+	NodeCosts.Reset();
+	bRecording = true;
+}
+
+void FAdvancedControlFlowNodeCostRecorder::StopRecording()
+{
+	bRecording = false;
+}
+
+bool FAdvancedControlFlowNodeCostRecorder::IsRecording() const
+{
+	return bRecording;
+}
+
+void FAdvancedControlFlowNodeCostRecorder::RecordNode(FKismetFunctionContext& Context, UEdGraphNode* Node)
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	UEdGraphNode* SourceNode = Cast<UEdGraphNode>(Context.MessageLog.FindSourceObject(Node));
+	FAdvancedControlFlowNodeCost& Cost = NodeCosts.FindOrAdd((SourceNode != nullptr) ? SourceNode : Node);
+	++Cost.InstanceCount;
+	Cost.LocalCount += CountLocals(Context.Locals, Node) + CountLocals(Context.EventGraphLocals, Node);
+
+	const TArray<FBlueprintCompiledStatement*>* Statements = Context.StatementsPerNode.Find(Node);
+	if (Statements == nullptr)
+	{
+		return;
+	}
+
+	Cost.StatementCount += Statements->Num();
+	for (const FBlueprintCompiledStatement* Statement : *Statements)
+	{
+		if (Statement->Type == KCST_CallFunction)
+		{
+			++Cost.FunctionCallCount;
+		}
+	}
+	Cost.WorstCaseTestCount = FMath::Max(Cost.WorstCaseTestCount, GetWorstCaseTestCount(*Statements));
+}
+
+void FAdvancedControlFlowNodeCostRecorder::CollectBytecodeSizes(UBlueprint* Blueprint)
+{
+	UBlueprintGeneratedClass* GeneratedClass = Cast<UBlueprintGeneratedClass>(Blueprint->GeneratedClass);
+	if (GeneratedClass == nullptr)
+	{
+		return;
+	}
+
+	// The debug data maps the offset of the first byte of each statement to the source node.
+	// The bytes until the next mapped offset belong to the same node.
+	const FBlueprintDebugData& DebugData = GeneratedClass->GetDebugData();
+	for (TFieldIterator<UFunction> It(GeneratedClass, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+	{
+		UFunction* Function = *It;
+		FAdvancedControlFlowNodeCost* Cost = nullptr;
+		for (int32 Offset = 0; Offset < Function->Script.Num(); ++Offset)
+		{
+			if (UEdGraphNode* Node = DebugData.FindSourceNodeFromCodeLocation(Function, Offset, false))
+			{
+				Cost = NodeCosts.Find(Node);
+			}
+			if (Cost != nullptr)
+			{
+				++Cost->BytecodeSize;
+			}
+		}
+	}
+}
+
+const TMap<UEdGraphNode*, FAdvancedControlFlowNodeCost>& FAdvancedControlFlowNodeCostRecorder::GetNodeCosts() const
+{
+	return NodeCosts;
+}
+
+int32 FAdvancedControlFlowNodeCostRecorder::GetWorstCaseTestCount(const TArray<FBlueprintCompiledStatement*>& Statements)
+{
+	TMap<const FBlueprintCompiledStatement*, int32> StatementIndices;
+	for (int32 Index = 0; Index < Statements.Num(); ++Index)
+	{
+		StatementIndices.Add(Statements[Index], Index);
+	}
+
+	// The number of the tests from the statement to the end of the path. The last element is the end of the statements.
+	TArray<int32> TestCounts;
+	TestCounts.SetNumZeroed(Statements.Num() + 1);
+	for (int32 Index = Statements.Num() - 1; Index >= 0; --Index)
+	{
+		const FBlueprintCompiledStatement* Statement = Statements[Index];
+		const int32* TargetIndex = StatementIndices.Find(Statement->TargetLabel);
+		const int32 TargetTestCount = ((TargetIndex != nullptr) && (*TargetIndex > Index)) ? TestCounts[*TargetIndex] : 0;
+
+		switch (Statement->Type)
+		{
+			case KCST_GotoIfNot:
+				TestCounts[Index] = 1 + FMath::Max(TestCounts[Index + 1], TargetTestCount);
+				break;
+			case KCST_EndOfThreadIfNot:
+			case KCST_GotoReturnIfNot:
+				TestCounts[Index] = 1 + TestCounts[Index + 1];
+				break;
+			case KCST_UnconditionalGoto:
+				TestCounts[Index] = TargetTestCount;
+				break;
+			case KCST_Return:
+			case KCST_EndOfThread:
+			case KCST_ComputedGoto:
+			case KCST_GotoReturn:
+				TestCounts[Index] = 0;
+				break;
+			default:
+				TestCounts[Index] = TestCounts[Index + 1];
+				break;
+		}
+	}
+
+	return TestCounts[0];
+}
@@ -0,0 +1,179 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowNodeCostReportCommandlet.h"
+
+#include "AdvancedControlFlowAssetRegistryTags.h"
+#include "AdvancedControlFlowBenchmarkUtils.h"
+#include "AdvancedControlFlowNodeCostRecorder.h"
+#include "Dom/JsonObject.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAdvancedControlFlowNodeCostReport, Log, All);
+
+UAdvancedControlFlowNodeCostReportCommandlet::UAdvancedControlFlowNodeCostReportCommandlet(
+	const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAdvancedControlFlowNodeCostReportCommandlet::Main(const FString& Params)
+{
+	FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AdvancedControlFlow"), TEXT("NodeCostReport.json"));
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	const TArray<FString> Paths = FAdvancedControlFlowBenchmarkUtils::ParseStringList(Params, TEXT("Paths="), {});
+	const TArray<FString> AssetNames = FAdvancedControlFlowBenchmarkUtils::ParseStringList(Params, TEXT("Assets="), {});
+	// 0 means no budget.
+	int32 MaxWorstCaseTests = 0;
+	FParse::Value(*Params, TEXT("MaxWorstCaseTests="), MaxWorstCaseTests);
+	int32 MaxBytecodeSize = 0;
+	FParse::Value(*Params, TEXT("MaxBytecodeSize="), MaxBytecodeSize);
+
+	// Find the Blueprints from the asset registry tags.
+	TArray<FAssetData> Assets;
+	TArray<FAssetData> UntaggedAssets;
+	FAdvancedControlFlowAssetRegistryTags::FindBlueprints(Paths, AssetNames, Assets, UntaggedAssets);
+
+	int32 ErrorCount = 0;
+	for (const FString& AssetName : AssetNames)
+	{
+		auto HasPackageName = [&AssetName](const FAssetData& Asset) { return Asset.PackageName == FName(*AssetName); };
+		if (UntaggedAssets.ContainsByPredicate(HasPackageName))
+		{
+			// The explicitly requested Blueprint may be saved before the tags were introduced.
+			UE_LOG(LogAdvancedControlFlowNodeCostReport, Warning, TEXT("%s: No asset registry tags (resave to add them)"),
+				*AssetName);
+		}
+		else if (!Assets.ContainsByPredicate(HasPackageName))
+		{
+			UE_LOG(LogAdvancedControlFlowNodeCostReport, Error, TEXT("%s: Blueprint is not found"), *AssetName);
+			++ErrorCount;
+		}
+	}
+	if (AssetNames.Num() > 0)
+	{
+		Assets.Append(UntaggedAssets);
+		Assets.Sort([](const FAssetData& A, const FAssetData& B) { return A.PackageName.LexicalLess(B.PackageName); });
+	}
+	UE_LOG(LogAdvancedControlFlowNodeCostReport, Display, TEXT("Found %d Blueprints"), Assets.Num());
+
+	FAdvancedControlFlowNodeCostRecorder& Recorder = FAdvancedControlFlowNodeCostRecorder::Get();
+	int32 OverBudgetCount = 0;
+	TArray<TSharedPtr<FJsonValue>> BlueprintResults;
+	for (int32 Index = 0; Index < Assets.Num(); ++Index)
+	{
+		const FString PackageName = Assets[Index].PackageName.ToString();
+		TSharedRef<FJsonObject> BlueprintResult = MakeShared<FJsonObject>();
+		BlueprintResult->SetStringField(TEXT("Asset"), PackageName);
+
+		UBlueprint* Blueprint = Cast<UBlueprint>(Assets[Index].GetAsset());
+		if (Blueprint == nullptr)
+		{
+			UE_LOG(LogAdvancedControlFlowNodeCostReport, Error, TEXT("%s: Failed to load"), *PackageName);
+			BlueprintResult->SetStringField(TEXT("Status"), TEXT("Error"));
+			BlueprintResults.Add(MakeShared<FJsonValueObject>(BlueprintResult));
+			++ErrorCount;
+			continue;
+		}
+
+		Recorder.StartRecording();
+		FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+		Recorder.StopRecording();
+		Recorder.CollectBytecodeSizes(Blueprint);
+
+		const bool bSucceeded = (Blueprint->Status != BS_Error);
+		if (!bSucceeded)
+		{
+			UE_LOG(LogAdvancedControlFlowNodeCostReport, Error, TEXT("%s: Failed to compile"), *PackageName);
+			++ErrorCount;
+		}
+		BlueprintResult->SetStringField(TEXT("Status"), bSucceeded ? TEXT("Succeeded") : TEXT("Error"));
+
+		TArray<TSharedPtr<FJsonValue>> NodeResults;
+		for (const TPair<UEdGraphNode*, FAdvancedControlFlowNodeCost>& Entry : Recorder.GetNodeCosts())
+		{
+			const UEdGraphNode* Node = Entry.Key;
+			const FAdvancedControlFlowNodeCost& Cost = Entry.Value;
+
+			// The nodes of the other Blueprints which are compiled together (e.g. child Blueprints) are reported by themselves.
+			if (FBlueprintEditorUtils::FindBlueprintForNode(Node) != Blueprint)
+			{
+				continue;
+			}
+
+			const bool bOverBudget = ((MaxWorstCaseTests > 0) && (Cost.WorstCaseTestCount > MaxWorstCaseTests)) ||
+									 ((MaxBytecodeSize > 0) && (Cost.BytecodeSize > MaxBytecodeSize));
+			const FString NodeTitle = Node->GetNodeTitle(ENodeTitleType::ListView).ToString();
+			const FString GraphName = (Node->GetGraph() != nullptr) ? Node->GetGraph()->GetName() : FString();
+			if (bOverBudget)
+			{
+				UE_LOG(LogAdvancedControlFlowNodeCostReport, Error,
+					TEXT("%s: %s (%s) in %s is over budget (WorstCaseTests=%d, Bytecode=%d bytes)"), *PackageName, *NodeTitle,
+					*Node->NodeGuid.ToString(), *GraphName, Cost.WorstCaseTestCount, Cost.BytecodeSize);
+				++OverBudgetCount;
+			}
+
+			TSharedRef<FJsonObject> NodeResult = MakeShared<FJsonObject>();
+			NodeResult->SetStringField(TEXT("NodeGuid"), Node->NodeGuid.ToString());
+			NodeResult->SetStringField(TEXT("NodeClass"), Node->GetClass()->GetName());
+			NodeResult->SetStringField(TEXT("NodeTitle"), NodeTitle);
+			NodeResult->SetStringField(TEXT("Graph"), GraphName);
+			NodeResult->SetNumberField(TEXT("InstanceCount"), Cost.InstanceCount);
+			NodeResult->SetNumberField(TEXT("StatementCount"), Cost.StatementCount);
+			NodeResult->SetNumberField(TEXT("FunctionCallCount"), Cost.FunctionCallCount);
+			NodeResult->SetNumberField(TEXT("LocalCount"), Cost.LocalCount);
+			NodeResult->SetNumberField(TEXT("WorstCaseTestCount"), Cost.WorstCaseTestCount);
+			NodeResult->SetNumberField(TEXT("BytecodeSize"), Cost.BytecodeSize);
+			NodeResult->SetBoolField(TEXT("OverBudget"), bOverBudget);
+			NodeResults.Add(MakeShared<FJsonValueObject>(NodeResult));
+		}
+		BlueprintResult->SetArrayField(TEXT("Nodes"), NodeResults);
+		BlueprintResults.Add(MakeShared<FJsonValueObject>(BlueprintResult));
+		UE_LOG(LogAdvancedControlFlowNodeCostReport, Display, TEXT("%s: %d nodes"), *PackageName, NodeResults.Num());
+
+		// Loading all Blueprints at once may run out of memory.
+		if ((Index % 32) == 31)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+	}
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("EngineVersion"), FEngineVersion::Current().ToString());
+	Root->SetNumberField(TEXT("MaxWorstCaseTests"), MaxWorstCaseTests);
+	Root->SetNumberField(TEXT("MaxBytecodeSize"), MaxBytecodeSize);
+	Root->SetArrayField(TEXT("Blueprints"), BlueprintResults);
+
+	FString OutputString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	FJsonSerializer::Serialize(Root, Writer);
+	if (!FFileHelper::SaveStringToFile(OutputString, *OutputPath))
+	{
+		UE_LOG(LogAdvancedControlFlowNodeCostReport, Error, TEXT("Failed to write the result to %s"), *OutputPath);
+		return 1;
+	}
+	UE_LOG(LogAdvancedControlFlowNodeCostReport, Display,
+		TEXT("Reported %d Blueprints (%d failed, %d nodes over budget). The result is written to %s"), Assets.Num(),
+		ErrorCount, OverBudgetCount, *OutputPath);
+
+	return ((ErrorCount > 0) || (OverBudgetCount > 0)) ? 1 : 0;
+}
@@ -0,0 +1,569 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowRuntimeBenchmarkCommandlet.h"
+
+#include "AdvancedControlFlowBenchmarkUtils.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "HAL/MemoryBase.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_ConditionalSequence.h"
+#include "K2Node_ExecutionSequence.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_FunctionResult.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_MakeArray.h"
+#include "K2Node_MultiBranch.h"
+#include "K2Node_MultiConditionalSelect.h"
+#include "K2Node_Select.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Script.h"
+
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogAdvancedControlFlowRuntimeBenchmark, Log, All);
+
+int32 UAdvancedControlFlowBenchmarkLibrary::Count = 0;
+
+void UAdvancedControlFlowBenchmarkLibrary::CountUp()
+{
+	++Count;
+}
+
+namespace
+{
+const FName HitIndexParamName(TEXT("HitIndex"));
+const FName ReturnValueParamName(TEXT("ReturnValue"));
+
+// Implementations compared in the benchmark.
+const FName AdvancedControlFlowFunctionName(TEXT("AdvancedControlFlow"));
+const FName VanillaFunctionName(TEXT("Vanilla"));
+
+// Count the allocations on the game thread while CountAllocations() runs the function.
+// LLM tracks the allocated size per tag, but not the number of allocations.
+// The other threads keep allocating while the commandlet runs, so the proxy is installed as GMalloc only once with the atomic
+// exchange and is never uninstalled. Swapping GMalloc for each measurement would race with them.
+class FMallocCountingProxy : public FMalloc
+{
+public:
+	explicit FMallocCountingProxy(FMalloc* InInnerMalloc) : InnerMalloc(InInnerMalloc)
+	{
+	}
+
+	// Override from FMalloc
+	virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+	{
+		CountAllocation();
+		return InnerMalloc->Malloc(Count, Alignment);
+	}
+	virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+	{
+		if (Count > 0)
+		{
+			CountAllocation();
+		}
+		return InnerMalloc->Realloc(Original, Count, Alignment);
+	}
+	virtual void Free(void* Original) override
+	{
+		InnerMalloc->Free(Original);
+	}
+	virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+	{
+		return InnerMalloc->QuantizeSize(Count, Alignment);
+	}
+	virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+	{
+		return InnerMalloc->GetAllocationSize(Original, SizeOut);
+	}
+	virtual void Trim(bool bTrimThreadCaches) override
+	{
+		InnerMalloc->Trim(bTrimThreadCaches);
+	}
+	virtual void SetupTLSCachesOnCurrentThread() override
+	{
+		InnerMalloc->SetupTLSCachesOnCurrentThread();
+	}
+	virtual void ClearAndDisableTLSCachesOnCurrentThread() override
+	{
+		InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread();
+	}
+	virtual bool IsInternallyThreadSafe() const override
+	{
+		return InnerMalloc->IsInternallyThreadSafe();
+	}
+	virtual bool ValidateHeap() override
+	{
+		return InnerMalloc->ValidateHeap();
+	}
+	virtual const TCHAR* GetDescriptiveName() override
+	{
+		return InnerMalloc->GetDescriptiveName();
+	}
+
+	static int64 CountAllocations(TFunctionRef<void()> Function)
+	{
+		FMallocCountingProxy& Proxy = Install();
+
+		Proxy.AllocationCount = 0;
+		Proxy.bCounting.store(true);
+		Function();
+		Proxy.bCounting.store(false);
+
+		return Proxy.AllocationCount;
+	}
+
+private:
+	static FMallocCountingProxy& Install()
+	{
+		static FMallocCountingProxy* Proxy = []()
+		{
+			FMallocCountingProxy* NewProxy = new FMallocCountingProxy(GMalloc);
+			FPlatformAtomics::InterlockedExchangePtr(reinterpret_cast<void**>(&GMalloc), NewProxy);
+			return NewProxy;
+		}();
+
+		return *Proxy;
+	}
+
+	void CountAllocation()
+	{
+		if (bCounting.load(std::memory_order_relaxed) && IsInGameThread())
+		{
+			++AllocationCount;
+		}
+	}
+
+	FMalloc* InnerMalloc;
+	std::atomic<bool> bCounting{false};
+	// Only updated on the game thread.
+	int64 AllocationCount = 0;
+};
+
+FEdGraphPinType GetOptionPinType(const FString& OptionType)
+{
+	if (OptionType == TEXT("Vector"))
+	{
+		return FAdvancedControlFlowBenchmarkUtils::MakePinType(UEdGraphSchema_K2::PC_Struct, TBaseStructure<FVector>::Get());
+	}
+	else if (OptionType == TEXT("Transform"))
+	{
+		return FAdvancedControlFlowBenchmarkUtils::MakePinType(UEdGraphSchema_K2::PC_Struct, TBaseStructure<FTransform>::Get());
+	}
+	else if (OptionType == TEXT("IntArray"))
+	{
+		return FAdvancedControlFlowBenchmarkUtils::MakePinType(UEdGraphSchema_K2::PC_Int, nullptr, EPinContainerType::Array);
+	}
+
+	return FAdvancedControlFlowBenchmarkUtils::MakePinType(UEdGraphSchema_K2::PC_Int);
+}
+
+// Give the value identified by the index to the option pin.
+// The Transform option keeps the default value (identity) because only the copy cost matters.
+void LinkOptionValue(UEdGraph* Graph, UEdGraphPin* OptionPin, const FString& OptionType, int32 Index)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	if (OptionType == TEXT("Int"))
+	{
+		Schema->TrySetDefaultValue(*OptionPin, FString::FromInt(Index));
+	}
+	else if (OptionType == TEXT("Vector"))
+	{
+		Schema->TrySetDefaultValue(*OptionPin, FString::Printf(TEXT("%d,%d,%d"), Index, Index, Index));
+	}
+	else if (OptionType == TEXT("IntArray"))
+	{
+		UK2Node_MakeArray* MakeArrayNode = FAdvancedControlFlowBenchmarkUtils::SpawnNode<UK2Node_MakeArray>(Graph);
+		Schema->TryCreateConnection(MakeArrayNode->GetOutputPin(), OptionPin);
+		Schema->TrySetDefaultValue(*MakeArrayNode->FindPinChecked(TEXT("[0]")), FString::FromInt(Index));
+	}
+}
+
+// HitIndex == CaseIndex
+UEdGraphPin* SpawnConditionPin(UEdGraph* Graph, UEdGraphPin* HitIndexPin, int32 CaseIndex)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	UK2Node_CallFunction* EqualNode = FAdvancedControlFlowBenchmarkUtils::SpawnCallFunctionNode(
+		Graph, UKismetMathLibrary::StaticClass(), GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, EqualEqual_IntInt));
+	Schema->TryCreateConnection(HitIndexPin, EqualNode->FindPinChecked(TEXT("A")));
+	Schema->TrySetDefaultValue(*EqualNode->FindPinChecked(TEXT("B")), FString::FromInt(CaseIndex));
+
+	return EqualNode->GetReturnValuePin();
+}
+
+// All cases share one CountUp node as the body.
+UK2Node_CallFunction* SpawnCountUpNode(UEdGraph* Graph)
+{
+	return FAdvancedControlFlowBenchmarkUtils::SpawnCallFunctionNode(Graph, UAdvancedControlFlowBenchmarkLibrary::StaticClass(),
+		GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowBenchmarkLibrary, CountUp));
+}
+
+// Multi-Branch:
+//   Entry -> Multi-Branch (Condition N: HitIndex == N) -> CountUp
+// Vanilla:
+//   Entry -> Branch (HitIndex == 0) -[False]-> Branch (HitIndex == 1) -[False]-> ... -> CountUp
+void BuildMultiBranchFunction(UEdGraph* Graph, UK2Node_FunctionEntry* EntryNode, UEdGraphPin* HitIndexPin, int32 CaseCount,
+	bool bVanilla)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	UK2Node_CallFunction* CountUpNode = SpawnCountUpNode(Graph);
+	UEdGraphPin* ThenPin = EntryNode->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+
+	if (bVanilla)
+	{
+		UEdGraphPin* PrevElsePin = ThenPin;
+		for (int32 CaseIndex = 0; CaseIndex < CaseCount; ++CaseIndex)
+		{
+			UK2Node_IfThenElse* BranchNode = FAdvancedControlFlowBenchmarkUtils::SpawnNode<UK2Node_IfThenElse>(Graph);
+			Schema->TryCreateConnection(PrevElsePin, BranchNode->GetExecPin());
+			Schema->TryCreateConnection(SpawnConditionPin(Graph, HitIndexPin, CaseIndex), BranchNode->GetConditionPin());
+			Schema->TryCreateConnection(BranchNode->GetThenPin(), CountUpNode->GetExecPin());
+			PrevElsePin = BranchNode->GetElsePin();
+		}
+		Schema->TryCreateConnection(PrevElsePin, CountUpNode->GetExecPin());
+	}
+	else
+	{
+		UK2Node_MultiBranch* MultiBranchNode = FAdvancedControlFlowBenchmarkUtils::SpawnNode<UK2Node_MultiBranch>(Graph);
+		MultiBranchNode->SetCasePinCount(CaseCount);
+		Schema->TryCreateConnection(ThenPin, MultiBranchNode->GetExecPin());
+
+		TArray<CasePinPair> CasePairs = MultiBranchNode->GetCasePinPairs();
+		for (int32 CaseIndex = 0; CaseIndex < CasePairs.Num(); ++CaseIndex)
+		{
+			Schema->TryCreateConnection(SpawnConditionPin(Graph, HitIndexPin, CaseIndex), CasePairs[CaseIndex].Key);
+			Schema->TryCreateConnection(CasePairs[CaseIndex].Value, CountUpNode->GetExecPin());
+		}
+		Schema->TryCreateConnection(MultiBranchNode->GetDefaultExecPin(), CountUpNode->GetExecPin());
+	}
+}
+
+// Conditional Sequence:
+//   Entry -> Conditional Sequence (Condition N: HitIndex == N) -> CountUp
+// Vanilla:
+//   Entry -> Sequence -[Then N]-> Branch (HitIndex == N) -> CountUp
+//                     -[Last]-> CountUp
+void BuildConditionalSequenceFunction(UEdGraph* Graph, UK2Node_FunctionEntry* EntryNode, UEdGraphPin* HitIndexPin,
+	int32 CaseCount, bool bVanilla)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	UK2Node_CallFunction* CountUpNode = SpawnCountUpNode(Graph);
+	UEdGraphPin* ThenPin = EntryNode->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+
+	if (bVanilla)
+	{
+		UK2Node_ExecutionSequence* SequenceNode = FAdvancedControlFlowBenchmarkUtils::SpawnNode<UK2Node_ExecutionSequence>(Graph);
+		while (SequenceNode->GetThenPinGivenIndex(CaseCount) == nullptr)
+		{
+			SequenceNode->AddInputPin();
+		}
+		Schema->TryCreateConnection(ThenPin, SequenceNode->GetExecPin());
+
+		for (int32 CaseIndex = 0; CaseIndex < CaseCount; ++CaseIndex)
+		{
+			UK2Node_IfThenElse* BranchNode = FAdvancedControlFlowBenchmarkUtils::SpawnNode<UK2Node_IfThenElse>(Graph);
+			Schema->TryCreateConnection(SequenceNode->GetThenPinGivenIndex(CaseIndex), BranchNode->GetExecPin());
+			Schema->TryCreateConnection(SpawnConditionPin(Graph, HitIndexPin, CaseIndex), BranchNode->GetConditionPin());
+			Schema->TryCreateConnection(BranchNode->GetThenPin(), CountUpNode->GetExecPin());
+		}
+		Schema->TryCreateConnection(SequenceNode->GetThenPinGivenIndex(CaseCount), CountUpNode->GetExecPin());
+	}
+	else
+	{
+		UK2Node_ConditionalSequence* ConditionalSequenceNode =
+			FAdvancedControlFlowBenchmarkUtils::SpawnNode<UK2Node_ConditionalSequence>(Graph);
+		ConditionalSequenceNode->SetCasePinCount(CaseCount);
+		Schema->TryCreateConnection(ThenPin, ConditionalSequenceNode->GetExecPin());
+
+		TArray<CasePinPair> CasePairs = ConditionalSequenceNode->GetCasePinPairs();
+		for (int32 CaseIndex = 0; CaseIndex < CasePairs.Num(); ++CaseIndex)
+		{
+			Schema->TryCreateConnection(SpawnConditionPin(Graph, HitIndexPin, CaseIndex), CasePairs[CaseIndex].Key);
+			Schema->TryCreateConnection(CasePairs[CaseIndex].Value, CountUpNode->GetExecPin());
+		}
+		Schema->TryCreateConnection(ConditionalSequenceNode->GetDefaultExecPin(), CountUpNode->GetExecPin());
+	}
+}
+
+// Multi-Conditional Select:
+//   Multi-Conditional Select (Option N: N, Condition N: HitIndex == N, Default: -1) -> Result
+// Vanilla:
+//   Select (True: 0, Index: HitIndex == 0) -> Result
+//     False: Select (True: 1, Index: HitIndex == 1)
+//       False: ... Select (True: N-1, False: -1, Index: HitIndex == N-1)
+void BuildMultiConditionalSelectFunction(UEdGraph* Graph, UK2Node_FunctionEntry* EntryNode, UK2Node_FunctionResult* ResultNode,
+	UEdGraphPin* HitIndexPin, int32 CaseCount, const FString& OptionType, bool bVanilla)
+{
+	const UEdGraphSchema_K2* Schema = GetDefault<UEdGraphSchema_K2>();
+
+	UEdGraphPin* ReturnValuePin = ResultNode->CreateUserDefinedPin(ReturnValueParamName, GetOptionPinType(OptionType), EGPD_Input);
+	Schema->TryCreateConnection(EntryNode->FindPinChecked(UEdGraphSchema_K2::PN_Then), ResultNode->GetExecPin());
+
+	if (bVanilla)
+	{
+		UEdGraphPin* PrevFalsePin = ReturnValuePin;
+		for (int32 CaseIndex = 0; CaseIndex < CaseCount; ++CaseIndex)
+		{
+			UK2Node_Select* SelectNode = FAdvancedControlFlowBenchmarkUtils::SpawnNode<UK2Node_Select>(Graph);
+			Schema->TryCreateConnection(SpawnConditionPin(Graph, HitIndexPin, CaseIndex), SelectNode->GetIndexPin());
+			Schema->TryCreateConnection(SelectNode->GetReturnValuePin(), PrevFalsePin);
+
+			// The option pins are [False, True] when the index pin is Boolean.
+			TArray<UEdGraphPin*> OptionPins;
+			SelectNode->GetOptionPins(OptionPins);
+			LinkOptionValue(Graph, OptionPins[1], OptionType, CaseIndex);
+			PrevFalsePin = OptionPins[0];
+		}
+		LinkOptionValue(Graph, PrevFalsePin, OptionType, -1);
+	}
+	else
+	{
+		UK2Node_MultiConditionalSelect* MultiConditionalSelectNode =
+			FAdvancedControlFlowBenchmarkUtils::SpawnNode<UK2Node_MultiConditionalSelect>(Graph);
+		MultiConditionalSelectNode->SetCasePinCount(CaseCount);
+		Schema->TryCreateConnection(MultiConditionalSelectNode->GetReturnValuePin(), ReturnValuePin);
+
+		TArray<CasePinPair> CasePairs = MultiConditionalSelectNode->GetCasePinPairs();
+		for (int32 CaseIndex = 0; CaseIndex < CasePairs.Num(); ++CaseIndex)
+		{
+			LinkOptionValue(Graph, CasePairs[CaseIndex].Key, OptionType, CaseIndex);
+			Schema->TryCreateConnection(SpawnConditionPin(Graph, HitIndexPin, CaseIndex), CasePairs[CaseIndex].Value);
+		}
+		LinkOptionValue(Graph, MultiConditionalSelectNode->GetDefaultOptionPin(), OptionType, -1);
+	}
+}
+
+UBlueprint* CreateBenchmarkBlueprint(const FString& NodeType, const FString& OptionType, int32 CaseCount)
+{
+	UBlueprint* Blueprint = FAdvancedControlFlowBenchmarkUtils::CreateTransientBlueprint(TEXT("ACFRuntimeBenchmark"));
+
+	for (const FName& FunctionName : {AdvancedControlFlowFunctionName, VanillaFunctionName})
+	{
+		const bool bVanilla = (FunctionName == VanillaFunctionName);
+
+		UK2Node_FunctionEntry* EntryNode = nullptr;
+		UK2Node_FunctionResult* ResultNode = nullptr;
+		UEdGraph* Graph = FAdvancedControlFlowBenchmarkUtils::AddFunctionGraph(Blueprint, FunctionName, EntryNode, ResultNode);
+		UEdGraphPin* HitIndexPin = EntryNode->CreateUserDefinedPin(
+			HitIndexParamName, FAdvancedControlFlowBenchmarkUtils::MakePinType(UEdGraphSchema_K2::PC_Int), EGPD_Output);
+
+		if (NodeType == TEXT("MultiBranch"))
+		{
+			BuildMultiBranchFunction(Graph, EntryNode, HitIndexPin, CaseCount, bVanilla);
+		}
+		else if (NodeType == TEXT("ConditionalSequence"))
+		{
+			BuildConditionalSequenceFunction(Graph, EntryNode, HitIndexPin, CaseCount, bVanilla);
+		}
+		else
+		{
+			BuildMultiConditionalSelectFunction(Graph, EntryNode, ResultNode, HitIndexPin, CaseCount, OptionType, bVanilla);
+		}
+	}
+
+	FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection);
+
+	return Blueprint;
+}
+
+struct FRuntimeBenchmarkResult
+{
+	double NanosecondsPerCall = 0.0;
+	double AllocationsPerCall = 0.0;
+	bool bVerified = true;
+};
+
+// Call the function in the same way as the functional tests (ProcessEvent with the parameter buffer).
+FRuntimeBenchmarkResult RunFunction(
+	UObject* Object, UFunction* Function, const FString& NodeType, const FString& OptionType, int32 HitIndex, int32 Iterations)
+{
+	FRuntimeBenchmarkResult Result;
+
+	uint8* Params = static_cast<uint8*>(FMemory::Malloc(FMath::Max(Function->ParmsSize, 1), Function->GetMinAlignment()));
+	Function->InitializeStruct(Params);
+	FIntProperty* HitIndexProperty = CastField<FIntProperty>(Function->FindPropertyByName(HitIndexParamName));
+	check(HitIndexProperty != nullptr);
+	HitIndexProperty->SetPropertyValue_InContainer(Params, HitIndex);
+
+	FEditorScriptExecutionGuard ScriptGuard;
+
+	// Check the result before the measurement.
+	UAdvancedControlFlowBenchmarkLibrary::Count = 0;
+	Object->ProcessEvent(Function, Params);
+	if (NodeType == TEXT("MultiBranch"))
+	{
+		Result.bVerified = (UAdvancedControlFlowBenchmarkLibrary::Count == 1);
+	}
+	else if (NodeType == TEXT("ConditionalSequence"))
+	{
+		Result.bVerified = (UAdvancedControlFlowBenchmarkLibrary::Count == ((HitIndex >= 0) ? 2 : 1));
+	}
+	else if (OptionType == TEXT("Int"))
+	{
+		FIntProperty* ReturnValueProperty = CastField<FIntProperty>(Function->FindPropertyByName(ReturnValueParamName));
+		Result.bVerified =
+			(ReturnValueProperty != nullptr) && (ReturnValueProperty->GetPropertyValue_InContainer(Params) == HitIndex);
+	}
+
+	for (int32 Index = 0; Index < FMath::Max(Iterations / 10, 1); ++Index)
+	{
+		Object->ProcessEvent(Function, Params);
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < Iterations; ++Index)
+	{
+		Object->ProcessEvent(Function, Params);
+	}
+	Result.NanosecondsPerCall = (FPlatformTime::Seconds() - StartTime) * 1e9 / Iterations;
+
+	// Allocations are counted separately so that the counting does not affect the time.
+	const int32 AllocationIterations = FMath::Min(Iterations, 1000);
+	const int64 AllocationCount = FMallocCountingProxy::CountAllocations(
+		[&]()
+		{
+			for (int32 Index = 0; Index < AllocationIterations; ++Index)
+			{
+				Object->ProcessEvent(Function, Params);
+			}
+		});
+	Result.AllocationsPerCall = static_cast<double>(AllocationCount) / AllocationIterations;
+
+	Function->DestroyStruct(Params);
+	FMemory::Free(Params);
+
+	return Result;
+}
+}	 // namespace
+
+UAdvancedControlFlowRuntimeBenchmarkCommandlet::UAdvancedControlFlowRuntimeBenchmarkCommandlet(
+	const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAdvancedControlFlowRuntimeBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AdvancedControlFlow"), TEXT("RuntimeBenchmark.csv"));
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	const TArray<FString> NodeTypes = FAdvancedControlFlowBenchmarkUtils::ParseStringList(
+		Params, TEXT("NodeTypes="), {TEXT("MultiBranch"), TEXT("ConditionalSequence"), TEXT("MultiConditionalSelect")});
+	const TArray<int32> CaseCounts = FAdvancedControlFlowBenchmarkUtils::ParseIntList(Params, TEXT("CaseCounts="), {2, 8, 32, 128});
+	const TArray<FString> OptionTypes = FAdvancedControlFlowBenchmarkUtils::ParseStringList(
+		Params, TEXT("OptionTypes="), {TEXT("Int"), TEXT("Vector"), TEXT("Transform"), TEXT("IntArray")});
+	int32 Iterations = 10000;
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	Iterations = FMath::Max(Iterations, 1);
+
+	for (const FString& NodeType : NodeTypes)
+	{
+		if ((NodeType != TEXT("MultiBranch")) && (NodeType != TEXT("ConditionalSequence")) &&
+			(NodeType != TEXT("MultiConditionalSelect")))
+		{
+			UE_LOG(LogAdvancedControlFlowRuntimeBenchmark, Error, TEXT("Unknown node type: %s"), *NodeType);
+			return 1;
+		}
+	}
+	for (const FString& OptionType : OptionTypes)
+	{
+		if ((OptionType != TEXT("Int")) && (OptionType != TEXT("Vector")) && (OptionType != TEXT("Transform")) &&
+			(OptionType != TEXT("IntArray")))
+		{
+			UE_LOG(LogAdvancedControlFlowRuntimeBenchmark, Error, TEXT("Unknown option type: %s"), *OptionType);
+			return 1;
+		}
+	}
+
+	FString Csv = TEXT("NodeType,OptionType,CaseCount,HitPosition,HitIndex,Implementation,NanosecondsPerCall,AllocationsPerCall\n");
+	bool bAllVerified = true;
+	for (const FString& NodeType : NodeTypes)
+	{
+		// Only Multi-Conditional Select has the options.
+		const TArray<FString> NodeOptionTypes =
+			(NodeType == TEXT("MultiConditionalSelect")) ? OptionTypes : TArray<FString>{TEXT("None")};
+
+		for (const FString& OptionType : NodeOptionTypes)
+		{
+			for (int32 CaseCount : CaseCounts)
+			{
+				if (CaseCount <= 0)
+				{
+					continue;
+				}
+
+				UBlueprint* Blueprint = CreateBenchmarkBlueprint(NodeType, OptionType, CaseCount);
+				if (Blueprint->Status == BS_Error)
+				{
+					UE_LOG(LogAdvancedControlFlowRuntimeBenchmark, Error, TEXT("Failed to compile %s (Option=%s, Cases=%d)"),
+						*NodeType, *OptionType, CaseCount);
+					FAdvancedControlFlowBenchmarkUtils::DiscardBlueprint(Blueprint);
+					return 1;
+				}
+
+				UObject* Object = NewObject<UObject>(GetTransientPackage(), Blueprint->GeneratedClass);
+				const TArray<TPair<FString, int32>> HitPositions = {
+					{TEXT("First"), 0},
+					{TEXT("Middle"), CaseCount / 2},
+					{TEXT("Last"), CaseCount - 1},
+					{TEXT("Default"), -1},
+				};
+				for (const TPair<FString, int32>& HitPosition : HitPositions)
+				{
+					for (const FName& FunctionName : {AdvancedControlFlowFunctionName, VanillaFunctionName})
+					{
+						UFunction* Function = Blueprint->GeneratedClass->FindFunctionByName(FunctionName);
+						check(Function != nullptr);
+
+						const FRuntimeBenchmarkResult Result =
+							RunFunction(Object, Function, NodeType, OptionType, HitPosition.Value, Iterations);
+						if (!Result.bVerified)
+						{
+							UE_LOG(LogAdvancedControlFlowRuntimeBenchmark, Error,
+								TEXT("Unexpected result: %s (Option=%s, Cases=%d, Hit=%s, Implementation=%s)"), *NodeType,
+								*OptionType, CaseCount, *HitPosition.Key, *FunctionName.ToString());
+							bAllVerified = false;
+						}
+
+						Csv += FString::Printf(TEXT("%s,%s,%d,%s,%d,%s,%.2f,%.2f\n"), *NodeType, *OptionType, CaseCount,
+							*HitPosition.Key, HitPosition.Value, *FunctionName.ToString(), Result.NanosecondsPerCall,
+							Result.AllocationsPerCall);
+						UE_LOG(LogAdvancedControlFlowRuntimeBenchmark, Display,
+							TEXT("%s (Option=%s, Cases=%d, Hit=%s, Implementation=%s): %.2f ns/call, %.2f allocs/call"), *NodeType,
+							*OptionType, CaseCount, *HitPosition.Key, *FunctionName.ToString(), Result.NanosecondsPerCall,
+							Result.AllocationsPerCall);
+					}
+				}
+
+				FAdvancedControlFlowBenchmarkUtils::DiscardBlueprint(Blueprint);
+			}
+		}
+	}
+
+	if (!FFileHelper::SaveStringToFile(Csv, *OutputPath))
+	{
+		UE_LOG(LogAdvancedControlFlowRuntimeBenchmark, Error, TEXT("Failed to write the result to %s"), *OutputPath);
+		return 1;
+	}
+	UE_LOG(LogAdvancedControlFlowRuntimeBenchmark, Display, TEXT("The result is written to %s"), *OutputPath);
+
+	return bAllVerified ? 0 : 1;
+}
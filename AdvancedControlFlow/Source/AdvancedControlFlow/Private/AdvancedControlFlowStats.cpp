@@ -0,0 +1,35 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowStats.h"
+
+DEFINE_STAT(STAT_ACF_AddCasePinPair);
+DEFINE_STAT(STAT_ACF_RemoveCasePinPairs);
+DEFINE_STAT(STAT_ACF_ReorderCasePinPairs);
+DEFINE_STAT(STAT_ACF_GetCasePinPairs);
+DEFINE_STAT(STAT_ACF_ResolveCasePinPairEntries);
+DEFINE_STAT(STAT_ACF_ReallocatePinsDuringReconstruction);
+
+DEFINE_STAT(STAT_ACF_CompileMultiBranch);
+DEFINE_STAT(STAT_ACF_CompileConditionalSequence);
+DEFINE_STAT(STAT_ACF_CompileMultiConditionalSelect);
+DEFINE_STAT(STAT_ACF_CompileSwitchExec);
+DEFINE_STAT(STAT_ACF_CompileSwitchStringExec);
+
+DEFINE_STAT(STAT_ACF_NumCasePinsCreated);
+DEFINE_STAT(STAT_ACF_NumCasePinsDestroyed);
+DEFINE_STAT(STAT_ACF_NumNodesCompiled);
+DEFINE_STAT(STAT_ACF_NumStatementsEmitted);
+DEFINE_STAT(STAT_ACF_NumStatementsInlined);
+DEFINE_STAT(STAT_ACF_NumCasesPruned);
+DEFINE_STAT(STAT_ACF_NumCaseTablesRebuilt);
+
+#if !UE_VERSION_OLDER_THAN(5, 0, 0)
+LLM_DEFINE_TAG(AdvancedControlFlow);
+#endif
@@ -0,0 +1,310 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "CasePairedPinsNodeDetails.h"
+
+#include "DetailCategoryBuilder.h"
+#include "DetailLayoutBuilder.h"
+#include "DetailWidgetRow.h"
+#include "K2Node_CasePairedPinsNode.h"
+#include "PropertyCustomizationHelpers.h"
+#include "ScopedTransaction.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SNumericEntryBox.h"
+#include "Widgets/Text/STextBlock.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+TSharedRef<IDetailCustomization> FCasePairedPinsNodeDetails::MakeInstance()
+{
+	return MakeShareable(new FCasePairedPinsNodeDetails());
+}
+
+void FCasePairedPinsNodeDetails::CustomizeDetails(const TSharedPtr<IDetailLayoutBuilder>& InDetailBuilder)
+{
+	DetailBuilder = InDetailBuilder;
+
+	CustomizeDetails(*InDetailBuilder);
+}
+
+void FCasePairedPinsNodeDetails::CustomizeDetails(IDetailLayoutBuilder& InDetailBuilder)
+{
+	TArray<TWeakObjectPtr<UObject>> Objects;
+	InDetailBuilder.GetObjectsBeingCustomized(Objects);
+	if (Objects.Num() != 1)
+	{
+		return;
+	}
+
+	UK2Node_CasePairedPinsNode* CasePairedPinsNode = Cast<UK2Node_CasePairedPinsNode>(Objects[0].Get());
+	if (CasePairedPinsNode == nullptr)
+	{
+		return;
+	}
+	Node = CasePairedPinsNode;
+
+	IDetailCategoryBuilder& Category = InDetailBuilder.EditCategory("Cases", LOCTEXT("CasesCategory", "Cases"));
+	const TAttribute<bool> CanAddCasePinAttribute =
+		TAttribute<bool>::Create(TAttribute<bool>::FGetter::CreateSP(this, &FCasePairedPinsNodeDetails::CanAddCasePin));
+
+	// clang-format off
+	Category.AddCustomRow(LOCTEXT("CasePinCount", "Case Pins"))
+		.NameContent()
+		[
+			SNew(STextBlock)
+			.Text(LOCTEXT("CasePinCount", "Case Pins"))
+			.Font(IDetailLayoutBuilder::GetDetailFont())
+		]
+		.ValueContent()
+		.MinDesiredWidth(200.0f)
+		[
+			SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.0f)
+			.VAlign(VAlign_Center)
+			[
+				SNew(SNumericEntryBox<int32>)
+				.AllowSpin(false)
+				.MinValue(0)
+				.MaxValue(this, &FCasePairedPinsNodeDetails::GetMaxCasePinCount)
+				.Value(this, &FCasePairedPinsNodeDetails::GetCasePinCount)
+				.OnValueCommitted(this, &FCasePairedPinsNodeDetails::OnCasePinCountCommitted)
+				.Font(IDetailLayoutBuilder::GetDetailFont())
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			[
+				PropertyCustomizationHelpers::MakeAddButton(
+					FSimpleDelegate::CreateSP(this, &FCasePairedPinsNodeDetails::OnAddCasePinLast),
+					LOCTEXT("AddCasePinTooltip", "Add case pin"),
+					CanAddCasePinAttribute)
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			[
+				PropertyCustomizationHelpers::MakeEmptyButton(
+					FSimpleDelegate::CreateSP(this, &FCasePairedPinsNodeDetails::OnRemoveAllCasePins),
+					LOCTEXT("RemoveAllCasePinsTooltip", "Remove all case pins"))
+			]
+		];
+	// clang-format on
+
+	const int32 CaseCount = CasePairedPinsNode->GetCasePinCount();
+	for (int32 CaseIndex = 0; CaseIndex < CaseCount; ++CaseIndex)
+	{
+		// clang-format off
+		Category.AddCustomRow(GetCaseLabel(CaseIndex))
+			.NameContent()
+			[
+				SNew(STextBlock)
+				.Text(FText::Format(LOCTEXT("CaseIndex", "Case {0}"), FText::AsNumber(CaseIndex)))
+				.Font(IDetailLayoutBuilder::GetDetailFont())
+			]
+			.ValueContent()
+			.MinDesiredWidth(200.0f)
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				.FillWidth(1.0f)
+				.VAlign(VAlign_Center)
+				[
+					SNew(STextBlock)
+					.Text(this, &FCasePairedPinsNodeDetails::GetCaseLabel, CaseIndex)
+					.Font(IDetailLayoutBuilder::GetDetailFont())
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				[
+					SNew(SButton)
+					.Text(FText::AsCultureInvariant(TEXT("\x25B2")))
+					.ToolTipText(LOCTEXT("MoveCasePinUpTooltip", "Move this case pin up"))
+					.IsEnabled(CaseIndex > 0)
+					.OnClicked(this, &FCasePairedPinsNodeDetails::OnMoveCasePin, CaseIndex, -1)
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				[
+					SNew(SButton)
+					.Text(FText::AsCultureInvariant(TEXT("\x25BC")))
+					.ToolTipText(LOCTEXT("MoveCasePinDownTooltip", "Move this case pin down"))
+					.IsEnabled(CaseIndex < CaseCount - 1)
+					.OnClicked(this, &FCasePairedPinsNodeDetails::OnMoveCasePin, CaseIndex, 1)
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				[
+					PropertyCustomizationHelpers::MakeAddButton(
+						FSimpleDelegate::CreateSP(this, &FCasePairedPinsNodeDetails::OnInsertCasePin, CaseIndex),
+						LOCTEXT("InsertCasePinTooltip", "Insert case pin before this case pin"),
+						CanAddCasePinAttribute)
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.VAlign(VAlign_Center)
+				[
+					PropertyCustomizationHelpers::MakeRemoveButton(
+						FSimpleDelegate::CreateSP(this, &FCasePairedPinsNodeDetails::OnRemoveCasePin, CaseIndex),
+						LOCTEXT("RemoveCasePinTooltip", "Remove this case pin"))
+				]
+			];
+		// clang-format on
+	}
+}
+
+TOptional<int32> FCasePairedPinsNodeDetails::GetCasePinCount() const
+{
+	if (!Node.IsValid())
+	{
+		return TOptional<int32>();
+	}
+
+	return Node->GetCasePinCount();
+}
+
+TOptional<int32> FCasePairedPinsNodeDetails::GetMaxCasePinCount() const
+{
+#ifdef ACF_FREE_VERSION
+	return 3;
+#else
+	return TOptional<int32>();
+#endif
+}
+
+bool FCasePairedPinsNodeDetails::CanAddCasePin() const
+{
+	if (!Node.IsValid())
+	{
+		return false;
+	}
+
+#ifdef ACF_FREE_VERSION
+	return Node->GetCasePinCount() < 3;
+#else
+	return true;
+#endif
+}
+
+FText FCasePairedPinsNodeDetails::GetCaseLabel(int32 CaseIndex) const
+{
+	if (!Node.IsValid() || (CaseIndex >= Node->GetCasePinCount()))
+	{
+		return FText::GetEmpty();
+	}
+
+	const CasePinPair Pair = Node->GetCasePinPairs()[CaseIndex];
+	const bool bLinked = (Pair.Key->LinkedTo.Num() > 0) || (Pair.Value->LinkedTo.Num() > 0);
+
+	return FText::Format(LOCTEXT("CaseLabel", "{0}{1}"), Node->GetPinDisplayName(Pair.Key),
+		bLinked ? LOCTEXT("CaseLinked", " (Linked)") : FText::GetEmpty());
+}
+
+void FCasePairedPinsNodeDetails::OnCasePinCountCommitted(int32 NewCount, ETextCommit::Type CommitType)
+{
+	if (!Node.IsValid())
+	{
+		return;
+	}
+
+	TOptional<int32> MaxCount = GetMaxCasePinCount();
+	if (MaxCount.IsSet())
+	{
+		NewCount = FMath::Min(NewCount, MaxCount.GetValue());
+	}
+	if (NewCount == Node->GetCasePinCount())
+	{
+		return;
+	}
+
+	const FScopedTransaction Transaction(LOCTEXT("ChangeCasePinCountTransaction", "Change Case Pin Count"));
+	Node->SetCasePinCount(FMath::Max(NewCount, 0));
+
+	RefreshDetails();
+}
+
+void FCasePairedPinsNodeDetails::OnAddCasePinLast()
+{
+	if (!Node.IsValid() || !CanAddCasePin())
+	{
+		return;
+	}
+
+	const FScopedTransaction Transaction(LOCTEXT("AddCasePinTransaction", "Add Case Pin"));
+	Node->InsertCasePinPairs(Node->GetCasePinCount(), 1);
+
+	RefreshDetails();
+}
+
+void FCasePairedPinsNodeDetails::OnRemoveAllCasePins()
+{
+	if (!Node.IsValid() || (Node->GetCasePinCount() == 0))
+	{
+		return;
+	}
+
+	const FScopedTransaction Transaction(LOCTEXT("RemoveAllCasePinsTransaction", "Remove All Case Pins"));
+	Node->SetCasePinCount(0);
+
+	RefreshDetails();
+}
+
+void FCasePairedPinsNodeDetails::OnInsertCasePin(int32 CaseIndex)
+{
+	if (!Node.IsValid() || !CanAddCasePin())
+	{
+		return;
+	}
+
+	const FScopedTransaction Transaction(LOCTEXT("InsertCasePinTransaction", "Insert Case Pin"));
+	Node->InsertCasePinPairs(CaseIndex, 1);
+
+	RefreshDetails();
+}
+
+void FCasePairedPinsNodeDetails::OnRemoveCasePin(int32 CaseIndex)
+{
+	if (!Node.IsValid())
+	{
+		return;
+	}
+
+	const FScopedTransaction Transaction(LOCTEXT("RemoveCasePinTransaction", "Remove Case Pin"));
+	Node->RemoveCasePinPairs({CaseIndex});
+
+	RefreshDetails();
+}
+
+FReply FCasePairedPinsNodeDetails::OnMoveCasePin(int32 CaseIndex, int32 Offset)
+{
+	if (!Node.IsValid())
+	{
+		return FReply::Handled();
+	}
+
+	const FScopedTransaction Transaction(LOCTEXT("MoveCasePinTransaction", "Move Case Pin"));
+	Node->MoveCasePinPair(CaseIndex, CaseIndex + Offset);
+
+	RefreshDetails();
+
+	return FReply::Handled();
+}
+
+void FCasePairedPinsNodeDetails::RefreshDetails()
+{
+	if (TSharedPtr<IDetailLayoutBuilder> Builder = DetailBuilder.Pin())
+	{
+		Builder->ForceRefreshDetails();
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
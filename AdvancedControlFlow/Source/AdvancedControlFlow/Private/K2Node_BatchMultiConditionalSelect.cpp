@@ -0,0 +1,183 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "K2Node_BatchMultiConditionalSelect.h"
+
+#include "AdvancedControlFlowBatchLibrary.h"
+#include "AdvancedControlFlowStats.h"
+#include "EdGraphSchema_K2.h"
+#include "EdGraphUtilities.h"
+#include "KCHandler_CasePairedPinsNode.h"
+#include "KismetCompiledFunctionContext.h"
+#include "KismetCompiler.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+// clang-format off
+/*
+	Internal statement structure
+
+	The elements are not processed by the VM one by one. Each case is one native call which processes all elements.
+	The cases are applied from the last one so that the first true condition wins.
+
+	       Return Value = Default
+	       OverwriteSelectedElements(Return Value, Condition N-1, Option N-1)
+	       ...
+	       OverwriteSelectedElements(Return Value, Condition 0, Option 0)
+
+	The number of the elements of Return Value is same as Default. The elements beyond the length of the condition or the
+	option are not selected by the case.
+ */
+// clang-format on
+class FKCHandler_BatchMultiConditionalSelect : public FKCHandler_CasePairedPinsNode
+{
+public:
+	FKCHandler_BatchMultiConditionalSelect(FKismetCompilerContext& InCompilerContext)
+		: FKCHandler_CasePairedPinsNode(InCompilerContext)
+	{
+	}
+
+	virtual void RegisterNets(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		FKCHandler_CasePairedPinsNode::RegisterNets(Context, Node);
+
+		UK2Node_BatchMultiConditionalSelect* BatchNode = CastChecked<UK2Node_BatchMultiConditionalSelect>(Node);
+		UEdGraphPin* ReturnValuePin = BatchNode->GetReturnValuePin();
+		FBPTerminal* ReturnValueTerm =
+			Context.CreateLocalTerminalFromPinAutoChooseScope(ReturnValuePin, Context.NetNameMap->MakeValidName(ReturnValuePin));
+		Context.NetMap.Add(ReturnValuePin, ReturnValueTerm);
+	}
+
+	virtual void Compile(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ACF_CompileMultiConditionalSelect);
+		ACF_LLM_SCOPE();
+
+		UK2Node_BatchMultiConditionalSelect* BatchNode = CastChecked<UK2Node_BatchMultiConditionalSelect>(Node);
+
+		UEdGraphPin* ReturnValuePin = BatchNode->GetReturnValuePin();
+		if (ReturnValuePin->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("UndeterminedPinType_Error", "The type of @@ is undetermined").ToString(), ReturnValuePin);
+			return;
+		}
+		FBPTerminal* ReturnValueTerm = Context.NetMap.FindRef(ReturnValuePin);
+
+		// Return Value = Default
+		UEdGraphPin* DefaultOptionPin = BatchNode->GetDefaultOptionPin();
+		if (DefaultOptionPin->LinkedTo.Num() == 0)
+		{
+			CompilerContext.MessageLog.Warning(
+				*LOCTEXT("BatchDefaultNotLinked_Warning", "@@ is not linked. Return Value is always empty").ToString(),
+				DefaultOptionPin);
+		}
+		FBPTerminal* DefaultOptionTerm = FindInputTerm(Context, DefaultOptionPin);
+		if (DefaultOptionTerm == nullptr)
+		{
+			return;
+		}
+		FBlueprintCompiledStatement& AssignStatement = Context.AppendStatementForNode(BatchNode);
+		AssignStatement.Type = KCST_Assignment;
+		AssignStatement.LHS = ReturnValueTerm;
+		AssignStatement.RHS.Add(DefaultOptionTerm);
+
+		// The unlinked option or condition is an empty array, so the case never selects any element.
+		UFunction* Function = UAdvancedControlFlowBatchLibrary::StaticClass()->FindFunctionByName(
+			GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowBatchLibrary, OverwriteSelectedElements));
+		const TArray<CasePinPair> CasePinPairs = BatchNode->GetCasePinPairs();
+		for (int32 CaseIndex = CasePinPairs.Num() - 1; CaseIndex >= 0; --CaseIndex)
+		{
+			UEdGraphPin* OptionPin = CasePinPairs[CaseIndex].Key;
+			UEdGraphPin* CondPin = CasePinPairs[CaseIndex].Value;
+			if ((OptionPin->LinkedTo.Num() == 0) || (CondPin->LinkedTo.Num() == 0))
+			{
+				INC_DWORD_STAT(STAT_ACF_NumCasesPruned);
+				continue;
+			}
+
+			FBPTerminal* OptionTerm = FindInputTerm(Context, OptionPin);
+			FBPTerminal* CondTerm = FindInputTerm(Context, CondPin);
+			if ((OptionTerm == nullptr) || (CondTerm == nullptr))
+			{
+				return;
+			}
+
+			// OverwriteSelectedElements(Return Value, Condition, Option)
+			AppendCallFunctionStatement(Context, BatchNode, Function, {ReturnValueTerm, CondTerm, OptionTerm});
+		}
+
+		INC_DWORD_STAT(STAT_ACF_NumNodesCompiled);
+		if (TArray<FBlueprintCompiledStatement*>* Statements = Context.StatementsPerNode.Find(Node))
+		{
+			INC_DWORD_STAT_BY(STAT_ACF_NumStatementsEmitted, Statements->Num());
+		}
+		RecordNodeCost(Context, Node);
+	}
+
+private:
+	FBPTerminal* FindInputTerm(FKismetFunctionContext& Context, UEdGraphPin* Pin)
+	{
+		FBPTerminal* Term = Context.NetMap.FindRef(FEdGraphUtilities::GetNetFromPin(Pin));
+		if (Term == nullptr)
+		{
+			CompilerContext.MessageLog.Error(*LOCTEXT("UnregisteredPin_Error", "Failed to find the term for @@").ToString(), Pin);
+		}
+
+		return Term;
+	}
+};
+
+UK2Node_BatchMultiConditionalSelect::UK2Node_BatchMultiConditionalSelect(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	NodeContextMenuSectionName = "K2NodeBatchMultiConditionalSelect";
+	NodeContextMenuSectionLabel = LOCTEXT("BatchMultiConditionalSelect", "Batch Multi Conditional Select");
+}
+
+FText UK2Node_BatchMultiConditionalSelect::GetTooltipText() const
+{
+	return LOCTEXT("BatchMultiConditionalSelect_Tooltip",
+		"Batch Multi-Conditional Select\nReturn the array whose each element is the option where the condition is true\n"
+		"The options and the conditions are the arrays, and the elements of the same index are tested together");
+}
+
+FText UK2Node_BatchMultiConditionalSelect::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("BatchMultiConditionalSelect", "Batch Multi-Conditional Select");
+}
+
+class FNodeHandlingFunctor* UK2Node_BatchMultiConditionalSelect::CreateNodeHandler(
+	class FKismetCompilerContext& CompilerContext) const
+{
+	return new FKCHandler_BatchMultiConditionalSelect(CompilerContext);
+}
+
+void UK2Node_BatchMultiConditionalSelect::CreateDefaultOptionPin()
+{
+	Super::CreateDefaultOptionPin();
+	GetDefaultOptionPin()->PinType.ContainerType = EPinContainerType::Array;
+}
+
+void UK2Node_BatchMultiConditionalSelect::CreateReturnValuePin()
+{
+	Super::CreateReturnValuePin();
+	GetReturnValuePin()->PinType.ContainerType = EPinContainerType::Array;
+}
+
+CasePinPair UK2Node_BatchMultiConditionalSelect::CreateCasePinPair(int32 CaseIndex)
+{
+	// The option pin follows the type of the default option pin.
+	CasePinPair Pair = Super::CreateCasePinPair(CaseIndex);
+	Pair.Value->PinType.ContainerType = EPinContainerType::Array;
+
+	return Pair;
+}
+
+#undef LOCTEXT_NAMESPACE
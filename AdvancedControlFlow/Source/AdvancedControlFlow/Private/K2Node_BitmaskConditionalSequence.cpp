@@ -0,0 +1,339 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "K2Node_BitmaskConditionalSequence.h"
+
+#include "AdvancedControlFlowBitmaskLibrary.h"
+#include "AdvancedControlFlowBitmaskUtils.h"
+#include "AdvancedControlFlowStats.h"
+#include "EdGraphSchema_K2.h"
+#include "EdGraphUtilities.h"
+#include "KCHandler_CasePairedPinsNode.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetCompiledFunctionContext.h"
+#include "KismetCompiler.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+// clang-format off
+/*
+	Internal statement structure
+
+	The bitmask is read once when the node is executed. The set bits are walked from the lowest one by the native call
+	(count trailing zeros), so the cases whose bit is not set are never tested.
+
+	Example (Case bits: 0, 3, 5)
+
+	       Remaining = Bitmask
+	Loop:
+	       Bit = PopLowestSetBit(Remaining, 0b101001)
+	       (Dispatch Bit by the binary decision tree as Switch Exec on Integer/Enum)
+	       Goto Default                            (Bit is -1 if all set bits are walked)
+	Case Bit 0:
+	       PushState Loop
+	       Goto Case Execution Bit 0
+	Case Bit 3:
+	       ...
+ */
+// clang-format on
+class FKCHandler_BitmaskConditionalSequence : public FKCHandler_CasePairedPinsNode
+{
+	TMap<UEdGraphNode*, FBPTerminal*> BoolTermMap;
+	TMap<UEdGraphNode*, FBPTerminal*> BitTermMap;
+	TMap<UEdGraphNode*, FBPTerminal*> RemainingTermMap;
+
+public:
+	FKCHandler_BitmaskConditionalSequence(FKismetCompilerContext& InCompilerContext)
+		: FKCHandler_CasePairedPinsNode(InCompilerContext)
+	{
+	}
+
+	virtual void RegisterNets(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		FKCHandler_CasePairedPinsNode::RegisterNets(Context, Node);
+
+		// Result of the comparison. It is consumed by the next statement, so one term is enough for the node.
+		FBPTerminal* BoolTerm = Context.CreateLocalTerminal();
+		BoolTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+		BoolTerm->Source = Node;
+		BoolTerm->Name = Context.NetNameMap->MakeValidName(Node, TEXT("CompareResult"));
+		BoolTermMap.Add(Node, BoolTerm);
+
+		FBPTerminal* BitTerm = Context.CreateLocalTerminal();
+		BitTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Int;
+		BitTerm->Source = Node;
+		BitTerm->Name = Context.NetNameMap->MakeValidName(Node, TEXT("LowestSetBit"));
+		BitTermMap.Add(Node, BitTerm);
+
+		// The bits which are not walked yet. The type follows the bitmask pin.
+		UK2Node_BitmaskConditionalSequence* BitmaskConditionalSequenceNode =
+			CastChecked<UK2Node_BitmaskConditionalSequence>(Node);
+		FBPTerminal* RemainingTerm = Context.CreateLocalTerminal();
+		RemainingTerm->Type.PinCategory =
+			(FAdvancedControlFlowBitmaskUtils::GetBitCount(BitmaskConditionalSequenceNode->GetBitmaskPin()) == 64)
+			? UEdGraphSchema_K2::PC_Int64
+			: UEdGraphSchema_K2::PC_Int;
+		RemainingTerm->Source = Node;
+		RemainingTerm->Name = Context.NetNameMap->MakeValidName(Node, TEXT("RemainingBits"));
+		RemainingTermMap.Add(Node, RemainingTerm);
+	}
+
+	virtual void Compile(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ACF_CompileConditionalSequence);
+		ACF_LLM_SCOPE();
+
+		UK2Node_BitmaskConditionalSequence* BitmaskConditionalSequenceNode =
+			CastChecked<UK2Node_BitmaskConditionalSequence>(Node);
+
+		FEdGraphPinType ExpectedExecPinType;
+		ExpectedExecPinType.PinCategory = UEdGraphSchema_K2::PC_Exec;
+
+		{
+			UEdGraphPin* ExecTriggeringPin =
+				Context.FindRequiredPinByName(BitmaskConditionalSequenceNode, UEdGraphSchema_K2::PN_Execute, EGPD_Input);
+			if ((ExecTriggeringPin == nullptr) || !Context.ValidatePinType(ExecTriggeringPin, ExpectedExecPinType))
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("NoValidExecutionPinForBitmaskConditionalSequence_Error", "@@ must have a valid execution pin @@")
+						 .ToString(),
+					BitmaskConditionalSequenceNode, ExecTriggeringPin);
+				return;
+			}
+			else if (ExecTriggeringPin->LinkedTo.Num() == 0)
+			{
+				CompilerContext.MessageLog.Warning(
+					*LOCTEXT("NodeNeverExecuted_Warning", "@@ will never be executed").ToString(), BitmaskConditionalSequenceNode);
+				return;
+			}
+		}
+
+		UEdGraphPin* DefaultExecPin = BitmaskConditionalSequenceNode->GetDefaultExecPin();
+		UEdGraphPin* BitmaskPin = BitmaskConditionalSequenceNode->GetBitmaskPin();
+		const int32 BitCount = FAdvancedControlFlowBitmaskUtils::GetBitCount(BitmaskPin);
+		if (BitCount == 0)
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("UndeterminedPinType_Error", "The type of @@ is undetermined").ToString(), BitmaskPin);
+			return;
+		}
+		FBPTerminal* BitmaskTerm = Context.NetMap.FindRef(FEdGraphUtilities::GetNetFromPin(BitmaskPin));
+		if (BitmaskTerm == nullptr)
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("UnregisteredPin_Error", "Failed to find the term for @@").ToString(), BitmaskPin);
+			return;
+		}
+
+		// The case whose execution pin is not linked does nothing. The first case wins if some cases have the same bit.
+		TArray<FIntegerCase> Cases;
+		TMap<int64, UEdGraphPin*> CaseExecPins;
+		uint64 UsedBits = 0;
+		uint64 CaseMask = 0;
+		for (const CasePinPair& Pair : BitmaskConditionalSequenceNode->GetCasePinPairs())
+		{
+			int32 Bit;
+			if (!FAdvancedControlFlowBitmaskUtils::GetCaseBit(Pair.Key, Bit) || (Bit >= BitCount))
+			{
+				CompilerContext.MessageLog.Error(
+					*FText::Format(LOCTEXT("InvalidCaseBit_Error", "@@ must be the bit position from 0 to {0}"), BitCount - 1)
+						 .ToString(),
+					Pair.Key);
+				return;
+			}
+			if ((UsedBits & (1ull << Bit)) != 0)
+			{
+				CompilerContext.MessageLog.Warning(
+					*LOCTEXT("DuplicatedCaseBit_Warning", "@@ has the same bit as the previous case").ToString(), Pair.Key);
+				continue;
+			}
+			UsedBits |= 1ull << Bit;
+			if (Pair.Value->LinkedTo.Num() == 0)
+			{
+				continue;
+			}
+			CaseMask |= 1ull << Bit;
+
+			// The jumps to the cases are fixed up after the case blocks are appended.
+			FIntegerCase Case;
+			Case.Value = Bit;
+			Case.ValueTerm = Context.NetMap.FindRef(Pair.Key);
+			check(Case.ValueTerm != nullptr);
+			Cases.Add(Case);
+			CaseExecPins.Add(Bit, Pair.Value);
+		}
+		Cases.Sort([](const FIntegerCase& A, const FIntegerCase& B) { return A.Value < B.Value; });
+
+		if (Cases.Num() > 0)
+		{
+			// Remaining = Bitmask
+			FBPTerminal* RemainingTerm = RemainingTermMap.FindRef(Node);
+			FBlueprintCompiledStatement& AssignStatement = Context.AppendStatementForNode(Node);
+			AssignStatement.Type = KCST_Assignment;
+			AssignStatement.LHS = RemainingTerm;
+			AssignStatement.RHS.Add(BitmaskTerm);
+
+			// Bit = PopLowestSetBit(Remaining, CaseMask)
+			// Only the bits of the linked cases are walked.
+			FBlueprintCompiledStatement& LoopStatement = AppendJumpTargetStatement(Context, Node);
+			FBPTerminal* BitTerm = BitTermMap.FindRef(Node);
+			if (BitCount == 32)
+			{
+				UFunction* Function = UAdvancedControlFlowBitmaskLibrary::StaticClass()->FindFunctionByName(
+					GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowBitmaskLibrary, PopLowestSetBit));
+				const FString CaseMaskValue = FString::FromInt(static_cast<int32>(static_cast<uint32>(CaseMask)));
+				AppendCallFunctionStatement(Context, Node, Function,
+					{RemainingTerm, CreateLiteralTerm(Context, UEdGraphSchema_K2::PC_Int, CaseMaskValue)}, BitTerm);
+			}
+			else
+			{
+				UFunction* Function = UAdvancedControlFlowBitmaskLibrary::StaticClass()->FindFunctionByName(
+					GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowBitmaskLibrary, PopLowestSetBit64));
+				const FString CaseMaskValue = LexToString(static_cast<int64>(CaseMask));
+				AppendCallFunctionStatement(Context, Node, Function,
+					{RemainingTerm, CreateLiteralTerm(Context, UEdGraphSchema_K2::PC_Int64, CaseMaskValue)}, BitTerm);
+			}
+
+			AppendIntegerDispatchStatements(
+				Context, BitmaskConditionalSequenceNode, BitTerm, BoolTermMap.FindRef(Node), Cases, DefaultExecPin);
+
+			// Come back to the loop after the case execution is finished.
+			for (const FIntegerCase& Case : Cases)
+			{
+				Case.GotoStatement->TargetLabel = &AppendJumpTargetStatement(Context, Node);
+
+				FBlueprintCompiledStatement& PushLoopStatement = Context.AppendStatementForNode(Node);
+				PushLoopStatement.Type = KCST_PushState;
+				PushLoopStatement.TargetLabel = &LoopStatement;
+
+				FBlueprintCompiledStatement& GotoCaseExecStatement = Context.AppendStatementForNode(Node);
+				GotoCaseExecStatement.Type = KCST_UnconditionalGoto;
+				Context.GotoFixupRequestMap.Add(&GotoCaseExecStatement, CaseExecPins.FindChecked(Case.Value));
+			}
+		}
+		else
+		{
+			GenerateSimpleThenGoto(Context, *BitmaskConditionalSequenceNode, DefaultExecPin);
+		}
+
+		INC_DWORD_STAT(STAT_ACF_NumNodesCompiled);
+		if (TArray<FBlueprintCompiledStatement*>* Statements = Context.StatementsPerNode.Find(Node))
+		{
+			INC_DWORD_STAT_BY(STAT_ACF_NumStatementsEmitted, Statements->Num());
+		}
+		RecordNodeCost(Context, Node);
+	}
+};
+
+UK2Node_BitmaskConditionalSequence::UK2Node_BitmaskConditionalSequence(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	NodeContextMenuSectionName = "K2NodeBitmaskConditionalSequence";
+	NodeContextMenuSectionLabel = LOCTEXT("BitmaskConditionalSequence", "Bitmask Conditional Sequence");
+	CaseKeyPinNamePrefix = TEXT("CaseBit");
+	CaseKeyPinFriendlyNamePrefix = TEXT("Bit ");
+}
+
+void UK2Node_BitmaskConditionalSequence::AllocateDefaultPins()
+{
+	// Pin structure
+	//   N: Number of case pin pair
+	// -----
+	// 0: Execution Triggering (In, Exec)
+	// 1: Default Execution (Out, Exec)
+	// 2: Bitmask (In, Integer/Integer64)
+	// 3 - 2+N: Case Bit (In, Integer, Literal only)
+	// 2+N+1 - 2*(N+1): Case Execution (Out, Exec)
+
+	CreateExecTriggeringPin();
+	CreateDefaultExecPin();
+	FAdvancedControlFlowBitmaskUtils::CreateBitmaskPin(this, 2);
+
+	// Skip UK2Node_ConditionalSequence which creates the pins without the bitmask pin.
+	UK2Node_CasePairedPinsNode::AllocateDefaultPins();
+}
+
+FText UK2Node_BitmaskConditionalSequence::GetTooltipText() const
+{
+	return LOCTEXT("BitmaskConditionalSequence_Tooltip",
+		"Bitmask Conditional Sequence\nExecutes a series of pins whose bit is set in the bitmask\n"
+		"The pins are executed in the order of the bit position");
+}
+
+FText UK2Node_BitmaskConditionalSequence::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("BitmaskConditionalSequence", "Bitmask Conditional Sequence");
+}
+
+void UK2Node_BitmaskConditionalSequence::PinConnectionListChanged(UEdGraphPin* Pin)
+{
+	Super::PinConnectionListChanged(Pin);
+
+	if ((Pin != nullptr) && (Pin == GetBitmaskPin()) && FAdvancedControlFlowBitmaskUtils::ResolveBitmaskPinType(Pin))
+	{
+		UBlueprint* Blueprint = GetBlueprint();
+		FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+		Blueprint->BroadcastChanged();
+	}
+}
+
+void UK2Node_BitmaskConditionalSequence::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
+{
+	CreateExecTriggeringPin();
+	CreateDefaultExecPin();
+	UEdGraphPin* BitmaskPin = FAdvancedControlFlowBitmaskUtils::CreateBitmaskPin(this, 2);
+	FAdvancedControlFlowBitmaskUtils::RestoreBitmaskPinType(BitmaskPin, OldPins);
+
+	UK2Node_CasePairedPinsNode::ReallocatePinsDuringReconstruction(OldPins);
+}
+
+class FNodeHandlingFunctor* UK2Node_BitmaskConditionalSequence::CreateNodeHandler(
+	class FKismetCompilerContext& CompilerContext) const
+{
+	return new FKCHandler_BitmaskConditionalSequence(CompilerContext);
+}
+
+bool UK2Node_BitmaskConditionalSequence::IsConnectionDisallowed(
+	const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const
+{
+	if (FAdvancedControlFlowBitmaskUtils::IsBitmaskConnectionDisallowed(GetBitmaskPin(), MyPin, OtherPin, OutReason))
+	{
+		return true;
+	}
+
+	return Super::IsConnectionDisallowed(MyPin, OtherPin, OutReason);
+}
+
+CasePinPair UK2Node_BitmaskConditionalSequence::CreateCasePinPair(int32 CaseIndex)
+{
+	CasePinPair Pair;
+	int N = GetCasePinCount();
+
+	Pair.Key = FAdvancedControlFlowBitmaskUtils::CreateCaseBitPin(this,
+		GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex),
+		GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), CaseIndex), 3 + CaseIndex, CasePinPairEntries,
+		bReallocatingCasePinPairs);
+	{
+		FCreatePinParams Params;
+		Params.Index = 3 + N + 1 + CaseIndex;
+		Pair.Value = CreatePin(
+			EGPD_Output, UEdGraphSchema_K2::PC_Exec, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Value->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), CaseIndex));
+	}
+
+	return Pair;
+}
+
+UEdGraphPin* UK2Node_BitmaskConditionalSequence::GetBitmaskPin() const
+{
+	return FindPin(FAdvancedControlFlowBitmaskUtils::BitmaskPinName);
+}
+
+#undef LOCTEXT_NAMESPACE
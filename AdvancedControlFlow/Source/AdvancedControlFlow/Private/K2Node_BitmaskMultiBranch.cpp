@@ -0,0 +1,282 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "K2Node_BitmaskMultiBranch.h"
+
+#include "AdvancedControlFlowBitmaskLibrary.h"
+#include "AdvancedControlFlowBitmaskUtils.h"
+#include "AdvancedControlFlowStats.h"
+#include "EdGraphSchema_K2.h"
+#include "EdGraphUtilities.h"
+#include "KCHandler_CasePairedPinsNode.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetCompiledFunctionContext.h"
+#include "KismetCompiler.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+// clang-format off
+/*
+	Internal statement structure
+
+	The lowest bit which is set in both the bitmask and the case bits is found by the native call (count trailing zeros),
+	and the bit position is dispatched by the binary decision tree as Switch Exec on Integer/Enum.
+
+	Example (Case bits: 0, 3, 5)
+
+	       Bit = FindLowestSetBit(Bitmask, 0b101001)
+	       Bool = NotEqual(Bit, 0)
+	       GotoIfNot(Bool) -> Case Bit 0
+	       Bool = NotEqual(Bit, 3)
+	       GotoIfNot(Bool) -> Case Bit 3
+	       Bool = NotEqual(Bit, 5)
+	       GotoIfNot(Bool) -> Case Bit 5
+	       Goto Default                            (Bit is -1 if no case bit is set)
+ */
+// clang-format on
+class FKCHandler_BitmaskMultiBranch : public FKCHandler_CasePairedPinsNode
+{
+	TMap<UEdGraphNode*, FBPTerminal*> BoolTermMap;
+	TMap<UEdGraphNode*, FBPTerminal*> BitTermMap;
+
+public:
+	FKCHandler_BitmaskMultiBranch(FKismetCompilerContext& InCompilerContext) : FKCHandler_CasePairedPinsNode(InCompilerContext)
+	{
+	}
+
+	virtual void RegisterNets(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		FKCHandler_CasePairedPinsNode::RegisterNets(Context, Node);
+
+		// Result of the comparison. It is consumed by the next statement, so one term is enough for the node.
+		FBPTerminal* BoolTerm = Context.CreateLocalTerminal();
+		BoolTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+		BoolTerm->Source = Node;
+		BoolTerm->Name = Context.NetNameMap->MakeValidName(Node, TEXT("CompareResult"));
+		BoolTermMap.Add(Node, BoolTerm);
+
+		FBPTerminal* BitTerm = Context.CreateLocalTerminal();
+		BitTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Int;
+		BitTerm->Source = Node;
+		BitTerm->Name = Context.NetNameMap->MakeValidName(Node, TEXT("LowestSetBit"));
+		BitTermMap.Add(Node, BitTerm);
+	}
+
+	virtual void Compile(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ACF_CompileMultiBranch);
+		ACF_LLM_SCOPE();
+
+		UK2Node_BitmaskMultiBranch* BitmaskMultiBranchNode = CastChecked<UK2Node_BitmaskMultiBranch>(Node);
+
+		FEdGraphPinType ExpectedExecPinType;
+		ExpectedExecPinType.PinCategory = UEdGraphSchema_K2::PC_Exec;
+
+		{
+			UEdGraphPin* ExecTriggeringPin =
+				Context.FindRequiredPinByName(BitmaskMultiBranchNode, UEdGraphSchema_K2::PN_Execute, EGPD_Input);
+			if ((ExecTriggeringPin == nullptr) || !Context.ValidatePinType(ExecTriggeringPin, ExpectedExecPinType))
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("NoValidExecutionPinForBitmaskMultiBranch_Error", "@@ must have a valid execution pin @@")
+						 .ToString(),
+					BitmaskMultiBranchNode, ExecTriggeringPin);
+				return;
+			}
+			else if (ExecTriggeringPin->LinkedTo.Num() == 0)
+			{
+				CompilerContext.MessageLog.Warning(
+					*LOCTEXT("NodeNeverExecuted_Warning", "@@ will never be executed").ToString(), BitmaskMultiBranchNode);
+				return;
+			}
+		}
+
+		UEdGraphPin* BitmaskPin = BitmaskMultiBranchNode->GetBitmaskPin();
+		const int32 BitCount = FAdvancedControlFlowBitmaskUtils::GetBitCount(BitmaskPin);
+		if (BitCount == 0)
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("UndeterminedPinType_Error", "The type of @@ is undetermined").ToString(), BitmaskPin);
+			return;
+		}
+		FBPTerminal* BitmaskTerm = Context.NetMap.FindRef(FEdGraphUtilities::GetNetFromPin(BitmaskPin));
+		if (BitmaskTerm == nullptr)
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("UnregisteredPin_Error", "Failed to find the term for @@").ToString(), BitmaskPin);
+			return;
+		}
+
+		// The first case wins if some cases have the same bit.
+		TArray<FIntegerCase> Cases;
+		uint64 CaseMask = 0;
+		for (const CasePinPair& Pair : BitmaskMultiBranchNode->GetCasePinPairs())
+		{
+			FIntegerCase Case;
+			int32 Bit;
+			if (!FAdvancedControlFlowBitmaskUtils::GetCaseBit(Pair.Key, Bit) || (Bit >= BitCount))
+			{
+				CompilerContext.MessageLog.Error(
+					*FText::Format(LOCTEXT("InvalidCaseBit_Error", "@@ must be the bit position from 0 to {0}"), BitCount - 1)
+						 .ToString(),
+					Pair.Key);
+				return;
+			}
+			if ((CaseMask & (1ull << Bit)) != 0)
+			{
+				CompilerContext.MessageLog.Warning(
+					*LOCTEXT("DuplicatedCaseBit_Warning", "@@ has the same bit as the previous case").ToString(), Pair.Key);
+				continue;
+			}
+			CaseMask |= 1ull << Bit;
+			Case.Value = Bit;
+			Case.ValueTerm = Context.NetMap.FindRef(Pair.Key);
+			Case.ExecPin = Pair.Value;
+			check(Case.ValueTerm != nullptr);
+			Cases.Add(Case);
+		}
+		Cases.Sort([](const FIntegerCase& A, const FIntegerCase& B) { return A.Value < B.Value; });
+
+		// Bit = FindLowestSetBit(Bitmask, CaseMask)
+		FBPTerminal* BitTerm = BitTermMap.FindRef(Node);
+		if (BitCount == 32)
+		{
+			UFunction* Function = UAdvancedControlFlowBitmaskLibrary::StaticClass()->FindFunctionByName(
+				GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowBitmaskLibrary, FindLowestSetBit));
+			AppendCallFunctionStatement(Context, Node, Function,
+				{BitmaskTerm,
+					CreateLiteralTerm(
+						Context, UEdGraphSchema_K2::PC_Int, FString::FromInt(static_cast<int32>(static_cast<uint32>(CaseMask))))},
+				BitTerm);
+		}
+		else
+		{
+			UFunction* Function = UAdvancedControlFlowBitmaskLibrary::StaticClass()->FindFunctionByName(
+				GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowBitmaskLibrary, FindLowestSetBit64));
+			AppendCallFunctionStatement(Context, Node, Function,
+				{BitmaskTerm, CreateLiteralTerm(Context, UEdGraphSchema_K2::PC_Int64, LexToString(static_cast<int64>(CaseMask)))},
+				BitTerm);
+		}
+
+		AppendIntegerDispatchStatements(Context, BitmaskMultiBranchNode, BitTerm, BoolTermMap.FindRef(Node), Cases,
+			BitmaskMultiBranchNode->GetDefaultExecPin());
+
+		INC_DWORD_STAT(STAT_ACF_NumNodesCompiled);
+		if (TArray<FBlueprintCompiledStatement*>* Statements = Context.StatementsPerNode.Find(Node))
+		{
+			INC_DWORD_STAT_BY(STAT_ACF_NumStatementsEmitted, Statements->Num());
+		}
+		RecordNodeCost(Context, Node);
+	}
+};
+
+UK2Node_BitmaskMultiBranch::UK2Node_BitmaskMultiBranch(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	NodeContextMenuSectionName = "K2NodeBitmaskMultiBranch";
+	NodeContextMenuSectionLabel = LOCTEXT("BitmaskMultiBranch", "Bitmask Multi-Branch");
+	CaseKeyPinNamePrefix = TEXT("CaseBit");
+	CaseKeyPinFriendlyNamePrefix = TEXT("Bit ");
+}
+
+void UK2Node_BitmaskMultiBranch::AllocateDefaultPins()
+{
+	// Pin structure
+	//   N: Number of case pin pair
+	// -----
+	// 0: Execution Triggering (In, Exec)
+	// 1: Default Execution (Out, Exec)
+	// 2: Bitmask (In, Integer/Integer64)
+	// 3 - 2+N: Case Bit (In, Integer, Literal only)
+	// 2+N+1 - 2*(N+1): Case Execution (Out, Exec)
+
+	CreateExecTriggeringPin();
+	CreateDefaultExecPin();
+	FAdvancedControlFlowBitmaskUtils::CreateBitmaskPin(this, 2);
+
+	// Skip UK2Node_MultiBranch which creates the pins without the bitmask pin.
+	UK2Node_CasePairedPinsNode::AllocateDefaultPins();
+}
+
+FText UK2Node_BitmaskMultiBranch::GetTooltipText() const
+{
+	return LOCTEXT("BitmaskMultiBranchStatement_Tooltip",
+		"Bitmask Multi-Branch Statement\nExecution goes where the lowest bit of the bitmask is set\n"
+		"The cases are tested in the order of the bit position");
+}
+
+FText UK2Node_BitmaskMultiBranch::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("BitmaskMultiBranch", "Bitmask Multi-Branch");
+}
+
+void UK2Node_BitmaskMultiBranch::PinConnectionListChanged(UEdGraphPin* Pin)
+{
+	Super::PinConnectionListChanged(Pin);
+
+	if ((Pin != nullptr) && (Pin == GetBitmaskPin()) && FAdvancedControlFlowBitmaskUtils::ResolveBitmaskPinType(Pin))
+	{
+		UBlueprint* Blueprint = GetBlueprint();
+		FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+		Blueprint->BroadcastChanged();
+	}
+}
+
+void UK2Node_BitmaskMultiBranch::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
+{
+	CreateExecTriggeringPin();
+	CreateDefaultExecPin();
+	UEdGraphPin* BitmaskPin = FAdvancedControlFlowBitmaskUtils::CreateBitmaskPin(this, 2);
+	FAdvancedControlFlowBitmaskUtils::RestoreBitmaskPinType(BitmaskPin, OldPins);
+
+	UK2Node_CasePairedPinsNode::ReallocatePinsDuringReconstruction(OldPins);
+}
+
+class FNodeHandlingFunctor* UK2Node_BitmaskMultiBranch::CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const
+{
+	return new FKCHandler_BitmaskMultiBranch(CompilerContext);
+}
+
+bool UK2Node_BitmaskMultiBranch::IsConnectionDisallowed(
+	const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const
+{
+	if (FAdvancedControlFlowBitmaskUtils::IsBitmaskConnectionDisallowed(GetBitmaskPin(), MyPin, OtherPin, OutReason))
+	{
+		return true;
+	}
+
+	return Super::IsConnectionDisallowed(MyPin, OtherPin, OutReason);
+}
+
+CasePinPair UK2Node_BitmaskMultiBranch::CreateCasePinPair(int32 CaseIndex)
+{
+	CasePinPair Pair;
+	int N = GetCasePinCount();
+
+	Pair.Key = FAdvancedControlFlowBitmaskUtils::CreateCaseBitPin(this,
+		GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex),
+		GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), CaseIndex), 3 + CaseIndex, CasePinPairEntries,
+		bReallocatingCasePinPairs);
+	{
+		FCreatePinParams Params;
+		Params.Index = 3 + N + 1 + CaseIndex;
+		Pair.Value = CreatePin(
+			EGPD_Output, UEdGraphSchema_K2::PC_Exec, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Value->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), CaseIndex));
+	}
+
+	return Pair;
+}
+
+UEdGraphPin* UK2Node_BitmaskMultiBranch::GetBitmaskPin() const
+{
+	return FindPin(FAdvancedControlFlowBitmaskUtils::BitmaskPinName);
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -9,7 +9,7 @@
 
 #include "K2Node_CasePairedPinsNode.h"
 
-#include "Internationalization/Regex.h"
+#include "AdvancedControlFlowStats.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "ToolMenu.h"
 
@@ -22,6 +22,45 @@ UK2Node_CasePairedPinsNode::UK2Node_CasePairedPinsNode(const FObjectInitializer&
 {
 }
 
+void UK2Node_CasePairedPinsNode::Serialize(FArchive& Ar)
+{
+	// The pins may be moved after the case table is built, so the indices are taken when the node is saved.
+	if (Ar.IsSaving())
+	{
+		UpdateCasePinIndices();
+	}
+
+	Super::Serialize(Ar);
+}
+
+void UK2Node_CasePairedPinsNode::PostLoad()
+{
+	Super::PostLoad();
+
+	ResolveCasePinPairEntries();
+}
+
+void UK2Node_CasePairedPinsNode::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	ResolveCasePinPairEntries();
+}
+
+void UK2Node_CasePairedPinsNode::PostDuplicate(bool bDuplicateForPIE)
+{
+	Super::PostDuplicate(bDuplicateForPIE);
+
+	ResolveCasePinPairEntries();
+}
+
+void UK2Node_CasePairedPinsNode::PostPasteNode()
+{
+	Super::PostPasteNode();
+
+	ResolveCasePinPairEntries();
+}
+
 void UK2Node_CasePairedPinsNode::GetNodeContextMenuActions(class UToolMenu* Menu, class UGraphNodeContextMenuContext* Context) const
 {
 	Super::GetNodeContextMenuActions(Menu, Context);
@@ -70,23 +109,70 @@ void UK2Node_CasePairedPinsNode::GetNodeContextMenuActions(class UToolMenu* Menu
 
 void UK2Node_CasePairedPinsNode::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
 {
+	SCOPE_CYCLE_COUNTER(STAT_ACF_ReallocatePinsDuringReconstruction);
+	ACF_LLM_SCOPE();
+
 	Super::AllocateDefaultPins();
 
-	int32 CasePinCount = 0;
-	for (auto& Pin : OldPins)
+	// The case table still refers to the old pins.
+	TArray<CasePinPair> OldPairs;
+	OldPairs.Reserve(CasePinPairEntries.Num());
+	for (const FCasePinPairEntry& Entry : CasePinPairEntries)
 	{
-		if (IsCaseKeyPin(Pin))
-		{
-			++CasePinCount;
-		}
+		OldPairs.Add(CasePinPair(Entry.KeyPin, Entry.ValuePin));
+	}
+	if (OldPairs.Num() == 0)
+	{
+		// The case table is not available (e.g. the node was saved before the case table was introduced).
+		BuildCasePinPairsFromPinNames(OldPins, OldPairs);
 	}
 
+	// The pins are recreated in the same order as the old pins, so that the engine finds the old pin of each new pin at the
+	// same index when it rewires the links.
+	const int32 CasePinCount = OldPairs.Num();
+	Pins.Reserve(FMath::Max(OldPins.Num(), Pins.Num() + CasePinCount * 2));
+	CasePinPairEntries.Reset(CasePinCount);
+	TGuardValue<bool> ReallocatingGuard(bReallocatingCasePinPairs, true);
 	for (int32 Index = 0; Index < CasePinCount; ++Index)
 	{
-		AddCasePinPair(Index);
+		CasePinPair Pair = AddCasePinPair(Index);
+
+		// The engine moves the pin IDs from the old pins. Take them over now so that the case table stays valid.
+		FCasePinPairEntry& Entry = CasePinPairEntries[Index];
+		if (OldPairs[Index].Key != nullptr)
+		{
+			Pair.Key->PinId = OldPairs[Index].Key->PinId;
+			Entry.KeyPinId = Pair.Key->PinId;
+		}
+		if (OldPairs[Index].Value != nullptr)
+		{
+			Pair.Value->PinId = OldPairs[Index].Value->PinId;
+			Entry.ValuePinId = Pair.Value->PinId;
+		}
 	}
 }
 
+CasePinPair UK2Node_CasePairedPinsNode::AddCasePinPair(int32 CaseIndex)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ACF_AddCasePinPair);
+	ACF_LLM_SCOPE();
+
+	check(CaseIndex >= 0 && CaseIndex <= CasePinPairEntries.Num());
+
+	CasePinPair Pair = CreateCasePinPair(CaseIndex);
+	check(Pair.Key && Pair.Value);
+
+	FCasePinPairEntry Entry;
+	Entry.KeyPinId = Pair.Key->PinId;
+	Entry.ValuePinId = Pair.Value->PinId;
+	Entry.KeyPin = Pair.Key;
+	Entry.ValuePin = Pair.Value;
+	CasePinPairEntries.Insert(Entry, CaseIndex);
+	INC_DWORD_STAT_BY(STAT_ACF_NumCasePinsCreated, 2);
+
+	return Pair;
+}
+
 void UK2Node_CasePairedPinsNode::AddCasePinAfter(UEdGraphPin* Pin)
 {
 	if (Pin == nullptr)
@@ -98,36 +184,10 @@ void UK2Node_CasePairedPinsNode::AddCasePinAfter(UEdGraphPin* Pin)
 
 	if (OwnerNode)
 	{
-		Modify();
-
-		CasePinPair Pair = GetCasePinPair(Pin);
-
-		UEdGraphPin* CaseKeyAfterPin = Pair.Key;
-		UEdGraphPin* CaseValueAfterPin = Pair.Value;
-		int32 CaseIndexAfter = GetCaseIndexFromCaseKeyPin(CaseKeyAfterPin);
-		check(CaseIndexAfter == GetCaseIndexFromCaseValuePin(CaseValueAfterPin));
-
-		// Get current key-value pin pair.
-		TArray<CasePinPair> CasePairs = GetCasePinPairs();
+		int32 CaseIndexAfter = GetCaseIndexFromCasePin(Pin);
+		check(CaseIndexAfter != INDEX_NONE);
 
-		// Add new pin pair.
-		AddCasePinPair(CaseIndexAfter + 1);
-
-		// Restore key-value pin pair name.
-		for (int32 Index = CaseIndexAfter + 1; Index < CasePairs.Num(); ++Index)
-		{
-			UEdGraphPin* CaseKeyPin = CasePairs[Index].Key;
-			UEdGraphPin* CaseValuePin = CasePairs[Index].Value;
-
-			CaseValuePin->PinName = *GetCasePinName(CaseValuePinNamePrefix.ToString(), Index + 1);
-			CaseValuePin->PinFriendlyName =
-				FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), Index + 1));
-			CaseKeyPin->PinName = *GetCasePinName(CaseKeyPinNamePrefix.ToString(), Index + 1);
-			CaseKeyPin->PinFriendlyName =
-				FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), Index + 1));
-		}
-
-		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
+		InsertCasePinPairs(CaseIndexAfter + 1, 1);
 	}
 }
 
@@ -142,36 +202,10 @@ void UK2Node_CasePairedPinsNode::AddCasePinBefore(UEdGraphPin* Pin)
 
 	if (OwnerNode)
 	{
-		Modify();
-
-		CasePinPair Pair = GetCasePinPair(Pin);
-
-		UEdGraphPin* CaseKeyBeforePin = Pair.Key;
-		UEdGraphPin* CaseValueBeforePin = Pair.Value;
-		int32 CaseIndexBefore = GetCaseIndexFromCaseKeyPin(CaseKeyBeforePin);
-		check(CaseIndexBefore == GetCaseIndexFromCaseValuePin(CaseValueBeforePin));
-
-		// Get current key-value pin pair.
-		TArray<CasePinPair> CasePairs = GetCasePinPairs();
-
-		// Add new pin pair.
-		AddCasePinPair(CaseIndexBefore);
+		int32 CaseIndexBefore = GetCaseIndexFromCasePin(Pin);
+		check(CaseIndexBefore != INDEX_NONE);
 
-		// Restore key-value pin pair name.
-		for (int32 Index = CaseIndexBefore; Index < CasePairs.Num(); ++Index)
-		{
-			UEdGraphPin* CaseKeyPin = CasePairs[Index].Key;
-			UEdGraphPin* CaseValuePin = CasePairs[Index].Value;
-
-			CaseValuePin->PinName = *GetCasePinName(CaseValuePinNamePrefix.ToString(), Index + 1);
-			CaseValuePin->PinFriendlyName =
-				FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), Index + 1));
-			CaseKeyPin->PinName = *GetCasePinName(CaseKeyPinNamePrefix.ToString(), Index + 1);
-			CaseKeyPin->PinFriendlyName =
-				FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), Index + 1));
-		}
-
-		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
+		InsertCasePinPairs(CaseIndexBefore, 1);
 	}
 }
 
@@ -186,8 +220,6 @@ void UK2Node_CasePairedPinsNode::RemoveCasePinAt(UEdGraphPin* Pin)
 
 	if (OwnerNode)
 	{
-		Modify();
-
 		int32 CaseIndex = GetCaseIndexFromCasePin(Pin);
 		RemoveCasePinAt(CaseIndex);
 	}
@@ -209,105 +241,80 @@ void UK2Node_CasePairedPinsNode::RemoveLastCasePin()
 
 UEdGraphPin* UK2Node_CasePairedPinsNode::GetCaseKeyPinFromCaseIndex(int32 CaseIndex) const
 {
-	for (auto& P : Pins)
+	if (!CasePinPairEntries.IsValidIndex(CaseIndex))
 	{
-		if (IsCaseKeyPin(P))
-		{
-			int32 ActualIndex = GetCaseIndexFromCaseKeyPin(P);
-
-			if ((ActualIndex != -1) && (ActualIndex == CaseIndex))
-			{
-				return P;
-			}
-		}
+		return nullptr;
 	}
 
-	return nullptr;
+	return CasePinPairEntries[CaseIndex].KeyPin;
 }
 
 UEdGraphPin* UK2Node_CasePairedPinsNode::GetCaseValuePinFromCaseIndex(int32 CaseIndex) const
 {
-	for (auto& P : Pins)
+	if (!CasePinPairEntries.IsValidIndex(CaseIndex))
 	{
-		if (IsCaseValuePin(P))
-		{
-			int32 ActualIndex = GetCaseIndexFromCaseValuePin(P);
-
-			if ((ActualIndex != -1) && (ActualIndex == CaseIndex))
-			{
-				return P;
-			}
-		}
+		return nullptr;
 	}
 
-	return nullptr;
+	return CasePinPairEntries[CaseIndex].ValuePin;
 }
 
 CasePinPair UK2Node_CasePairedPinsNode::GetCasePinPair(UEdGraphPin* Pin) const
 {
-	CasePinPair Pair;
+	int32 CaseIndex = GetCaseIndexFromCasePin(Pin);
+	check(CaseIndex != INDEX_NONE);
 
-	if (IsCaseValuePin(Pin))
-	{
-		Pair.Key = GetCaseKeyPinFromCaseValuePin(Pin);
-		Pair.Value = Pin;
-		check(Pair.Key);
-	}
-	else
-	{
-		check(IsCaseKeyPin(Pin));
+	const FCasePinPairEntry& Entry = CasePinPairEntries[CaseIndex];
 
-		Pair.Key = Pin;
-		Pair.Value = GetCaseValuePinFromCaseKeyPin(Pin);
-		check(Pair.Value);
-	}
-
-	return Pair;
+	return CasePinPair(Entry.KeyPin, Entry.ValuePin);
 }
 
-int32 UK2Node_CasePairedPinsNode::GetCaseIndexFromCasePin(UEdGraphPin* Pin) const
+int32 UK2Node_CasePairedPinsNode::GetCaseIndexFromCasePin(const UEdGraphPin* Pin) const
 {
-	check(IsCasePin(Pin));
-
-	if (IsCaseValuePin(Pin))
+	for (int32 Index = 0; Index < CasePinPairEntries.Num(); ++Index)
 	{
-		return GetCaseIndexFromCaseValuePin(Pin);
+		const FCasePinPairEntry& Entry = CasePinPairEntries[Index];
+		if ((Entry.KeyPin == Pin) || (Entry.ValuePin == Pin))
+		{
+			return Index;
+		}
 	}
-	check(IsCaseKeyPin(Pin));
 
-	return GetCaseIndexFromCaseKeyPin(Pin);
+	return INDEX_NONE;
 }
 
-int32 UK2Node_CasePairedPinsNode::GetCaseIndexFromCasePin(const FString& Prefix, UEdGraphPin* Pin) const
+int32 UK2Node_CasePairedPinsNode::GetCaseIndexFromCaseValuePin(const UEdGraphPin* Pin) const
 {
-	check(IsCasePin(Pin));
-
-	FString PinName = Pin->GetFName().ToString();
-	FString Dummy;
-	FString IndexStr;
-	if (!PinName.Split(Prefix + "_", &Dummy, &IndexStr, ESearchCase::CaseSensitive))
+	for (int32 Index = 0; Index < CasePinPairEntries.Num(); ++Index)
 	{
-		return -1;
+		if (CasePinPairEntries[Index].ValuePin == Pin)
+		{
+			return Index;
+		}
 	}
 
-	return FCString::Atoi(*IndexStr);
+	return INDEX_NONE;
 }
 
-int32 UK2Node_CasePairedPinsNode::GetCaseIndexFromCaseValuePin(UEdGraphPin* Pin) const
+int32 UK2Node_CasePairedPinsNode::GetCaseIndexFromCaseKeyPin(const UEdGraphPin* Pin) const
 {
-	check(IsCaseValuePin(Pin));
+	for (int32 Index = 0; Index < CasePinPairEntries.Num(); ++Index)
+	{
+		if (CasePinPairEntries[Index].KeyPin == Pin)
+		{
+			return Index;
+		}
+	}
 
-	return GetCaseIndexFromCasePin(CaseValuePinNamePrefix.ToString(), Pin);
+	return INDEX_NONE;
 }
 
-int32 UK2Node_CasePairedPinsNode::GetCaseIndexFromCaseKeyPin(UEdGraphPin* Pin) const
+void UK2Node_CasePairedPinsNode::RemoveCasePinAt(int32 CaseIndex)
 {
-	check(IsCaseKeyPin(Pin));
-
-	return GetCaseIndexFromCasePin(CaseKeyPinNamePrefix.ToString(), Pin);
+	RemoveCasePinPairs({CaseIndex});
 }
 
-void UK2Node_CasePairedPinsNode::RemoveCasePinAt(int32 CaseIndex)
+void UK2Node_CasePairedPinsNode::DestroyCasePinPair(int32 CaseIndex)
 {
 	UEdGraphPin* CaseValuePinToRemove = GetCaseValuePinFromCaseIndex(CaseIndex);
 	UEdGraphPin* CaseKeyPinToRemove = GetCaseKeyPinFromCaseIndex(CaseIndex);
@@ -323,134 +330,411 @@ void UK2Node_CasePairedPinsNode::RemoveCasePinAt(int32 CaseIndex)
 	CaseValuePinToRemove->MarkAsGarbage();
 	CaseKeyPinToRemove->MarkAsGarbage();
 #endif
+	CasePinPairEntries.RemoveAt(CaseIndex);
+	INC_DWORD_STAT_BY(STAT_ACF_NumCasePinsDestroyed, 2);
+}
 
-	int32 Index = 0;
-	for (auto& P : Pins)
-	{
-		if (IsCaseValuePin(P))
-		{
-			UEdGraphPin* CaseValuePin = P;
-			UEdGraphPin* CaseKeyPin = GetCaseKeyPinFromCaseValuePin(CaseValuePin);
+int32 UK2Node_CasePairedPinsNode::GetCasePinCount() const
+{
+	return CasePinPairEntries.Num();
+}
 
-			CaseValuePin->PinName = *GetCasePinName(CaseValuePinNamePrefix.ToString(), Index);
-			CaseValuePin->PinFriendlyName =
-				FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), Index));
-			CaseKeyPin->PinName = *GetCasePinName(CaseKeyPinNamePrefix.ToString(), Index);
-			CaseKeyPin->PinFriendlyName =
-				FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), Index));
+TArray<CasePinPair> UK2Node_CasePairedPinsNode::GetCasePinPairs() const
+{
+	SCOPE_CYCLE_COUNTER(STAT_ACF_GetCasePinPairs);
 
-			++Index;
-		}
+	TArray<CasePinPair> CasePairs;
+	CasePairs.Reserve(CasePinPairEntries.Num());
+
+	for (const FCasePinPairEntry& Entry : CasePinPairEntries)
+	{
+		CasePairs.Add(CasePinPair(Entry.KeyPin, Entry.ValuePin));
 	}
 
-	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
+	return CasePairs;
 }
 
-int32 UK2Node_CasePairedPinsNode::GetCasePinCount() const
+bool UK2Node_CasePairedPinsNode::IsCasePin(const UEdGraphPin* Pin) const
 {
-	// TODO: need to optimize.
-	for (int32 Index = Pins.Num(); Index >= 0; --Index)
+	return GetCaseIndexFromCasePin(Pin) != INDEX_NONE;
+}
+
+bool UK2Node_CasePairedPinsNode::IsCaseKeyPin(const UEdGraphPin* Pin) const
+{
+	return GetCaseIndexFromCaseKeyPin(Pin) != INDEX_NONE;
+}
+
+bool UK2Node_CasePairedPinsNode::IsCaseValuePin(const UEdGraphPin* Pin) const
+{
+	return GetCaseIndexFromCaseValuePin(Pin) != INDEX_NONE;
+}
+
+FString UK2Node_CasePairedPinsNode::GetCasePinName(const FString& Prefix, int32 CaseIndex) const
+{
+	return FString::Printf(TEXT("%s_%d"), *Prefix, CaseIndex);
+}
+
+FString UK2Node_CasePairedPinsNode::GetCasePinFriendlyName(const FString& Prefix, int32 CaseIndex) const
+{
+	return FString::Printf(TEXT("%s%d"), *Prefix, CaseIndex);
+}
+
+void UK2Node_CasePairedPinsNode::RenameCasePinPairs(int32 StartCaseIndex)
+{
+	const FString KeyPinNamePrefix = CaseKeyPinNamePrefix.ToString();
+	const FString ValuePinNamePrefix = CaseValuePinNamePrefix.ToString();
+	const FString KeyPinFriendlyNamePrefix = CaseKeyPinFriendlyNamePrefix.ToString();
+	const FString ValuePinFriendlyNamePrefix = CaseValuePinFriendlyNamePrefix.ToString();
+
+	for (int32 Index = StartCaseIndex; Index < CasePinPairEntries.Num(); ++Index)
+	{
+		UEdGraphPin* CaseKeyPin = CasePinPairEntries[Index].KeyPin;
+		UEdGraphPin* CaseValuePin = CasePinPairEntries[Index].ValuePin;
+
+		CaseValuePin->PinName = *GetCasePinName(ValuePinNamePrefix, Index);
+		CaseValuePin->PinFriendlyName = FText::AsCultureInvariant(GetCasePinFriendlyName(ValuePinFriendlyNamePrefix, Index));
+		CaseKeyPin->PinName = *GetCasePinName(KeyPinNamePrefix, Index);
+		CaseKeyPin->PinFriendlyName = FText::AsCultureInvariant(GetCasePinFriendlyName(KeyPinFriendlyNamePrefix, Index));
+	}
+}
+
+void UK2Node_CasePairedPinsNode::ResolveCasePinPairEntries()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ACF_ResolveCasePinPairEntries);
+	ACF_LLM_SCOPE();
+
+	if (ResolveCasePinPairEntriesByPinIndices())
 	{
-		UEdGraphPin* CaseKeyPinIndex = GetCaseKeyPinFromCaseIndex(Index);
-		UEdGraphPin* CaseValuePinIndex = GetCaseValuePinFromCaseIndex(Index);
+		return;
+	}
+	INC_DWORD_STAT(STAT_ACF_NumCaseTablesRebuilt);
 
-		if ((CaseKeyPinIndex != nullptr) && (CaseValuePinIndex != nullptr))
+	TMap<FGuid, UEdGraphPin*> PinsById;
+	PinsById.Reserve(Pins.Num());
+	for (UEdGraphPin* Pin : Pins)
+	{
+		PinsById.Add(Pin->PinId, Pin);
+	}
+
+	bool bResolved = true;
+	for (FCasePinPairEntry& Entry : CasePinPairEntries)
+	{
+		Entry.KeyPin = PinsById.FindRef(Entry.KeyPinId);
+		Entry.ValuePin = PinsById.FindRef(Entry.ValuePinId);
+		if ((Entry.KeyPin == nullptr) || (Entry.ValuePin == nullptr))
 		{
-			return Index + 1;
+			bResolved = false;
 		}
 	}
 
-	return 0;
+	if (bResolved && (CasePinPairEntries.Num() > 0))
+	{
+		UpdateCasePinIndices();
+		return;
+	}
+
+	// The case table is missing or stale (e.g. the node was saved before the case table was introduced).
+	// Rebuild it from the pin names.
+	TArray<CasePinPair> Pairs;
+	if (!BuildCasePinPairsFromPinNames(Pins, Pairs))
+	{
+		CasePinPairEntries.Reset();
+		return;
+	}
+
+	CasePinPairEntries.SetNum(Pairs.Num());
+	for (int32 Index = 0; Index < Pairs.Num(); ++Index)
+	{
+		FCasePinPairEntry& Entry = CasePinPairEntries[Index];
+		Entry.KeyPin = Pairs[Index].Key;
+		Entry.ValuePin = Pairs[Index].Value;
+		Entry.KeyPinId = Entry.KeyPin->PinId;
+		Entry.ValuePinId = Entry.ValuePin->PinId;
+	}
+	UpdateCasePinIndices();
 }
 
-TArray<CasePinPair> UK2Node_CasePairedPinsNode::GetCasePinPairs() const
+bool UK2Node_CasePairedPinsNode::ResolveCasePinPairEntriesByPinIndices()
 {
-	TArray<CasePinPair> CasePairs;
-	CasePairs.SetNum(GetCasePinCount());
+	if ((CaseTableVersion < static_cast<int32>(ECaseTableVersion::PinIndices)) || (CasePinPairEntries.Num() == 0))
+	{
+		return false;
+	}
 
-	for (auto& P : Pins)
+	for (FCasePinPairEntry& Entry : CasePinPairEntries)
 	{
-		if (IsCaseValuePin(P))
+		Entry.KeyPin = Pins.IsValidIndex(Entry.KeyPinIndex) ? Pins[Entry.KeyPinIndex] : nullptr;
+		Entry.ValuePin = Pins.IsValidIndex(Entry.ValuePinIndex) ? Pins[Entry.ValuePinIndex] : nullptr;
+		if ((Entry.KeyPin == nullptr) || (Entry.KeyPin->PinId != Entry.KeyPinId) || (Entry.ValuePin == nullptr) ||
+			(Entry.ValuePin->PinId != Entry.ValuePinId))
 		{
-			UEdGraphPin* CaseValuePin = P;
-			int32 Index = GetCaseIndexFromCaseValuePin(CaseValuePin);
-			CasePairs[Index] = GetCasePinPair(CaseValuePin);
+			return false;
 		}
 	}
 
-	return CasePairs;
+	return true;
 }
 
-bool UK2Node_CasePairedPinsNode::IsCasePin(const UEdGraphPin* Pin) const
+void UK2Node_CasePairedPinsNode::UpdateCasePinIndices()
 {
-	return IsCaseKeyPin(Pin) || IsCaseValuePin(Pin);
+	if (CasePinPairEntries.Num() == 0)
+	{
+		return;
+	}
+
+	TMap<const UEdGraphPin*, int32> PinIndices;
+	PinIndices.Reserve(Pins.Num());
+	for (int32 Index = 0; Index < Pins.Num(); ++Index)
+	{
+		PinIndices.Add(Pins[Index], Index);
+	}
+
+	for (FCasePinPairEntry& Entry : CasePinPairEntries)
+	{
+		const int32* KeyPinIndex = PinIndices.Find(Entry.KeyPin);
+		const int32* ValuePinIndex = PinIndices.Find(Entry.ValuePin);
+		Entry.KeyPinIndex = (KeyPinIndex != nullptr) ? *KeyPinIndex : INDEX_NONE;
+		Entry.ValuePinIndex = (ValuePinIndex != nullptr) ? *ValuePinIndex : INDEX_NONE;
+	}
+	CaseTableVersion = static_cast<int32>(ECaseTableVersion::LatestVersion);
 }
 
-bool UK2Node_CasePairedPinsNode::IsCaseKeyPin(const UEdGraphPin* Pin) const
+bool UK2Node_CasePairedPinsNode::BuildCasePinPairsFromPinNames(
+	const TArray<UEdGraphPin*>& InPins, TArray<CasePinPair>& OutPairs) const
 {
-	FString PinName = Pin->GetFName().ToString();
+	const FString KeyPinNamePrefix = CaseKeyPinNamePrefix.ToString() + TEXT("_");
+	const FString ValuePinNamePrefix = CaseValuePinNamePrefix.ToString() + TEXT("_");
 
-	FRegexPattern Pattern = FRegexPattern(FString::Format(TEXT("{0}_[0-9]+"), {CaseKeyPinNamePrefix.ToString()}));
-	FRegexMatcher Matcher(Pattern, PinName);
+	OutPairs.Reset();
+	for (UEdGraphPin* Pin : InPins)
+	{
+		if (Pin->bOrphanedPin)
+		{
+			continue;
+		}
 
-	return Matcher.FindNext();
-}
+		const FString PinName = Pin->PinName.ToString();
+		bool bIsKey = PinName.StartsWith(KeyPinNamePrefix, ESearchCase::CaseSensitive);
+		bool bIsValue = !bIsKey && PinName.StartsWith(ValuePinNamePrefix, ESearchCase::CaseSensitive);
+		if (!bIsKey && !bIsValue)
+		{
+			continue;
+		}
 
-bool UK2Node_CasePairedPinsNode::IsCaseValuePin(const UEdGraphPin* Pin) const
-{
-	FString PinName = Pin->GetFName().ToString();
+		const FString IndexStr = PinName.RightChop(bIsKey ? KeyPinNamePrefix.Len() : ValuePinNamePrefix.Len());
+		if (!IndexStr.IsNumeric())
+		{
+			continue;
+		}
 
-	FRegexPattern Pattern = FRegexPattern(FString::Format(TEXT("{0}_[0-9]+"), {CaseValuePinNamePrefix.ToString()}));
-	FRegexMatcher Matcher(Pattern, PinName);
+		int32 CaseIndex = FCString::Atoi(*IndexStr);
+		if (CaseIndex < 0 || CaseIndex >= InPins.Num())
+		{
+			continue;
+		}
+		if (CaseIndex >= OutPairs.Num())
+		{
+			OutPairs.SetNum(CaseIndex + 1);
+		}
+		if (bIsKey)
+		{
+			OutPairs[CaseIndex].Key = Pin;
+		}
+		else
+		{
+			OutPairs[CaseIndex].Value = Pin;
+		}
+	}
 
-	return Matcher.FindNext();
+	for (const CasePinPair& Pair : OutPairs)
+	{
+		if ((Pair.Key == nullptr) || (Pair.Value == nullptr))
+		{
+			OutPairs.Reset();
+			return false;
+		}
+	}
+
+	return true;
 }
 
-FString UK2Node_CasePairedPinsNode::GetCasePinName(const FString& Prefix, int32 CaseIndex) const
+UEdGraphPin* UK2Node_CasePairedPinsNode::GetCaseKeyPinFromCaseValuePin(const UEdGraphPin* ValuePin) const
 {
-	return FString::Printf(TEXT("%s_%d"), *Prefix, CaseIndex);
+	return GetCaseKeyPinFromCaseIndex(GetCaseIndexFromCaseValuePin(ValuePin));
 }
 
-FString UK2Node_CasePairedPinsNode::GetCasePinFriendlyName(const FString& Prefix, int32 CaseIndex) const
+UEdGraphPin* UK2Node_CasePairedPinsNode::GetCaseValuePinFromCaseKeyPin(const UEdGraphPin* KeyPin) const
 {
-	return FString::Printf(TEXT("%s%d"), *Prefix, CaseIndex);
+	return GetCaseValuePinFromCaseIndex(GetCaseIndexFromCaseKeyPin(KeyPin));
 }
 
-UEdGraphPin* UK2Node_CasePairedPinsNode::GetCaseKeyPinFromCaseValuePin(const UEdGraphPin* ValuePin) const
+void UK2Node_CasePairedPinsNode::AddCasePinLast()
+{
+	Modify();
+
+	int32 N = GetCasePinCount();
+
+	AddCasePinPair(N);
+}
+
+void UK2Node_CasePairedPinsNode::InsertCasePinPairs(int32 CaseIndex, int32 Count)
 {
-	FString ValuePinName = ValuePin->GetFName().ToString();
+	if ((Count <= 0) || (CaseIndex < 0) || (CaseIndex > GetCasePinCount()))
+	{
+		return;
+	}
+
+	ACF_LLM_SCOPE();
 
-	FString Dummy;
-	FString Suffix;
-	if (!ValuePinName.Split(CaseValuePinNamePrefix.ToString(), &Dummy, &Suffix, ESearchCase::CaseSensitive))
+	Modify();
+
+	CasePinPairEntries.Reserve(CasePinPairEntries.Num() + Count);
+	for (int32 Offset = 0; Offset < Count; ++Offset)
 	{
-		return nullptr;
+		AddCasePinPair(CaseIndex + Offset);
 	}
 
-	return FindPin(CaseKeyPinNamePrefix.ToString() + Suffix);
+	// Restore key-value pin pair name.
+	RenameCasePinPairs(CaseIndex + Count);
+
+	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
 }
 
-UEdGraphPin* UK2Node_CasePairedPinsNode::GetCaseValuePinFromCaseKeyPin(const UEdGraphPin* KeyPin) const
+void UK2Node_CasePairedPinsNode::RemoveCasePinPairs(const TArray<int32>& CaseIndices)
 {
-	FString KeyPinName = KeyPin->GetFName().ToString();
+	TArray<int32> SortedCaseIndices = CaseIndices.FilterByPredicate(
+		[this](int32 CaseIndex) { return CasePinPairEntries.IsValidIndex(CaseIndex); });
+	if (SortedCaseIndices.Num() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ACF_RemoveCasePinPairs);
 
-	FString Dummy;
-	FString Suffix;
-	if (!KeyPinName.Split(CaseKeyPinNamePrefix.ToString(), &Dummy, &Suffix, ESearchCase::CaseSensitive))
+	// Remove from the last one so that the remaining case indices are not shifted.
+	// The duplicated indices are adjacent after sorting.
+	SortedCaseIndices.Sort(TGreater<int32>());
+	int32 UniqueCount = 1;
+	for (int32 Index = 1; Index < SortedCaseIndices.Num(); ++Index)
 	{
-		return nullptr;
+		if (SortedCaseIndices[Index] != SortedCaseIndices[UniqueCount - 1])
+		{
+			SortedCaseIndices[UniqueCount++] = SortedCaseIndices[Index];
+		}
 	}
+	SortedCaseIndices.SetNum(UniqueCount);
+
+	Modify();
 
-	return FindPin(CaseValuePinNamePrefix.ToString() + Suffix);
+	for (int32 CaseIndex : SortedCaseIndices)
+	{
+		DestroyCasePinPair(CaseIndex);
+	}
+
+	// Restore key-value pin pair name.
+	RenameCasePinPairs(SortedCaseIndices.Last());
+
+	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
 }
 
-void UK2Node_CasePairedPinsNode::AddCasePinLast()
+void UK2Node_CasePairedPinsNode::ReorderCasePinPairs(const TArray<int32>& NewOrder)
 {
+	// NewOrder[NewCaseIndex] is the current case index of the case pin pair which will be placed at NewCaseIndex.
+	const int32 CaseCount = CasePinPairEntries.Num();
+	if (NewOrder.Num() != CaseCount)
+	{
+		return;
+	}
+
+	TBitArray<> Used(false, CaseCount);
+	bool bChanged = false;
+	for (int32 NewCaseIndex = 0; NewCaseIndex < CaseCount; ++NewCaseIndex)
+	{
+		const int32 OldCaseIndex = NewOrder[NewCaseIndex];
+		if (!CasePinPairEntries.IsValidIndex(OldCaseIndex) || Used[OldCaseIndex])
+		{
+			return;
+		}
+		Used[OldCaseIndex] = true;
+		bChanged |= (OldCaseIndex != NewCaseIndex);
+	}
+	if (!bChanged)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ACF_ReorderCasePinPairs);
+	ACF_LLM_SCOPE();
+
 	Modify();
 
-	int32 N = GetCasePinCount();
+	// Case pins keep their slots in the pin list. Only the pins in the slots are swapped.
+	TArray<int32> KeyPinSlots;
+	TArray<int32> ValuePinSlots;
+	KeyPinSlots.Reserve(CaseCount);
+	ValuePinSlots.Reserve(CaseCount);
+	for (const FCasePinPairEntry& Entry : CasePinPairEntries)
+	{
+		KeyPinSlots.Add(Pins.Find(Entry.KeyPin));
+		ValuePinSlots.Add(Pins.Find(Entry.ValuePin));
+	}
+	KeyPinSlots.Sort();
+	ValuePinSlots.Sort();
 
-	AddCasePinPair(N);
+	TArray<FCasePinPairEntry> NewEntries;
+	NewEntries.Reserve(CaseCount);
+	for (int32 NewCaseIndex = 0; NewCaseIndex < CaseCount; ++NewCaseIndex)
+	{
+		const FCasePinPairEntry& Entry = CasePinPairEntries[NewOrder[NewCaseIndex]];
+		Pins[KeyPinSlots[NewCaseIndex]] = Entry.KeyPin;
+		Pins[ValuePinSlots[NewCaseIndex]] = Entry.ValuePin;
+		NewEntries.Add(Entry);
+	}
+	CasePinPairEntries = MoveTemp(NewEntries);
+
+	// Restore key-value pin pair name.
+	RenameCasePinPairs(0);
+
+	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(GetBlueprint());
+}
+
+void UK2Node_CasePairedPinsNode::MoveCasePinPair(int32 FromCaseIndex, int32 ToCaseIndex)
+{
+	const int32 CaseCount = CasePinPairEntries.Num();
+	if (!CasePinPairEntries.IsValidIndex(FromCaseIndex) || !CasePinPairEntries.IsValidIndex(ToCaseIndex) ||
+		(FromCaseIndex == ToCaseIndex))
+	{
+		return;
+	}
+
+	TArray<int32> NewOrder;
+	NewOrder.Reserve(CaseCount);
+	for (int32 Index = 0; Index < CaseCount; ++Index)
+	{
+		NewOrder.Add(Index);
+	}
+	NewOrder.RemoveAt(FromCaseIndex);
+	NewOrder.Insert(FromCaseIndex, ToCaseIndex);
+
+	ReorderCasePinPairs(NewOrder);
+}
+
+void UK2Node_CasePairedPinsNode::SetCasePinCount(int32 Count)
+{
+	const int32 CaseCount = GetCasePinCount();
+	if (Count > CaseCount)
+	{
+		InsertCasePinPairs(CaseCount, Count - CaseCount);
+	}
+	else if (Count < CaseCount)
+	{
+		TArray<int32> CaseIndices;
+		for (int32 Index = FMath::Max(Count, 0); Index < CaseCount; ++Index)
+		{
+			CaseIndices.Add(Index);
+		}
+		RemoveCasePinPairs(CaseIndices);
+	}
 }
 
 #undef LOCTEXT_NAMESPACE
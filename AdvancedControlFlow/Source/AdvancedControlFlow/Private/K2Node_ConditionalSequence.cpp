@@ -9,15 +9,204 @@
 
 #include "K2Node_ConditionalSequence.h"
 
+#include "AdvancedControlFlowStats.h"
 #include "BlueprintActionDatabaseRegistrar.h"
 #include "BlueprintNodeSpawner.h"
+#include "EdGraphSchema_K2.h"
+#include "EdGraphUtilities.h"
 #include "EditorCategoryUtils.h"
-#include "K2Node_ExecutionSequence.h"
-#include "K2Node_IfThenElse.h"
+#include "KCHandler_CasePairedPinsNode.h"
+#include "KismetCompiledFunctionContext.h"
 #include "KismetCompiler.h"
 
 #define LOCTEXT_NAMESPACE "AdvancedControlFlow"
 
+// clang-format off
+/*
+* Internal statement structure
+
+  CaseLoop:
+            (Statements of the pure nodes which Condition N depends on)
+            GotoIfNot Condition N, NextCase
+            RecordCaseHit N                    (Only when ACF.ProfileCaseHits is enabled)
+            EndNodeTrace N                     (Only when ACF.TraceNodeExecution is enabled)
+            PushState NextCase                 (Only when the cases or default follow)
+            Goto Case Execution N
+  NextCase:
+            (Loop to next case)
+
+            Goto Default Execution
+
+  The case whose condition is always false is removed.
+  The case whose condition is always true is emitted without GotoIfNot.
+ */
+// clang-format on
+class FKCHandler_ConditionalSequence : public FKCHandler_CasePairedPinsNode
+{
+public:
+	FKCHandler_ConditionalSequence(FKismetCompilerContext& InCompilerContext) : FKCHandler_CasePairedPinsNode(InCompilerContext)
+	{
+		bSupportsNodeTrace = true;
+	}
+
+	virtual void Compile(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ACF_CompileConditionalSequence);
+		ACF_LLM_SCOPE();
+
+		UK2Node_ConditionalSequence* ConditionalSequenceNode = CastChecked<UK2Node_ConditionalSequence>(Node);
+
+		FEdGraphPinType ExpectedExecPinType;
+		ExpectedExecPinType.PinCategory = UEdGraphSchema_K2::PC_Exec;
+
+		{
+			UEdGraphPin* ExecTriggeringPin =
+				Context.FindRequiredPinByName(ConditionalSequenceNode, UEdGraphSchema_K2::PN_Execute, EGPD_Input);
+			if ((ExecTriggeringPin == nullptr) || !Context.ValidatePinType(ExecTriggeringPin, ExpectedExecPinType))
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("NoValidExecutionPinForConditionalSequence_Error", "@@ must have a valid execution pin @@").ToString(),
+					ConditionalSequenceNode, ExecTriggeringPin);
+				return;
+			}
+			else if (ExecTriggeringPin->LinkedTo.Num() == 0)
+			{
+				CompilerContext.MessageLog.Warning(
+					*LOCTEXT("NodeNeverExecuted_Warning", "@@ will never be executed").ToString(), ConditionalSequenceNode);
+				return;
+			}
+		}
+
+		UEdGraphPin* DefaultExecPin = ConditionalSequenceNode->GetDefaultExecPin();
+
+		// The case whose execution pin is not linked or whose condition is always false does nothing.
+		const TArray<CasePinPair> AllCasePairs = ConditionalSequenceNode->GetCasePinPairs();
+		TArray<CasePinPair> CasePairs;
+		TArray<int32> CaseIndices;
+		TArray<UEdGraphPin*> CondPins;
+		for (int32 CaseIndex = 0; CaseIndex < AllCasePairs.Num(); ++CaseIndex)
+		{
+			const CasePinPair& Pair = AllCasePairs[CaseIndex];
+			CondPins.Add(Pair.Key);
+			if (Pair.Value->LinkedTo.Num() == 0)
+			{
+				continue;
+			}
+
+			bool bConstantCond = true;
+			if (GetConstantBool(Context, Pair.Key, bConstantCond) && !bConstantCond)
+			{
+				CompilerContext.MessageLog.Note(
+					*LOCTEXT("AlwaysFalseCondition_Note", "@@ is always false. The case is removed").ToString(), Pair.Key);
+				INC_DWORD_STAT(STAT_ACF_NumCasesPruned);
+				continue;
+			}
+			CasePairs.Add(Pair);
+			CaseIndices.Add(CaseIndex);
+		}
+
+		const FString NodeId = GetCaseHitNodeId(ConditionalSequenceNode);
+		const bool bProfileCaseHits = IsCaseHitProfilingEnabled();
+
+		// Each trace event measures the tests from the node entry or the return from the previous case.
+		const bool bTraceNode = IsNodeTraceEnabled();
+		if (bTraceNode)
+		{
+			AppendBeginNodeTraceStatement(Context, ConditionalSequenceNode);
+		}
+
+		for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
+		{
+			UEdGraphPin* CondPin = CasePairs[Index].Key;
+			UEdGraphPin* ExecPin = CasePairs[Index].Value;
+
+			// The case whose condition is always true is executed without the test.
+			bool bConstantCond = false;
+			const bool bAlwaysTrue = GetConstantBool(Context, CondPin, bConstantCond) && bConstantCond;
+
+			FBlueprintCompiledStatement* GotoNextCaseStatement = nullptr;
+			if (!bAlwaysTrue)
+			{
+				FBPTerminal* CondTerm = Context.NetMap.FindRef(FEdGraphUtilities::GetNetFromPin(CondPin));
+				if (CondTerm == nullptr)
+				{
+					CompilerContext.MessageLog.Error(
+						*LOCTEXT("UnregisteredPin_Error", "Failed to find the term for @@").ToString(), CondPin);
+					return;
+				}
+
+				// The condition must be evaluated after the previous case is executed.
+				AppendCopiedStatements(Context, ConditionalSequenceNode, CondPin);
+
+				// Goto next case if Cond is false.
+				GotoNextCaseStatement = &Context.AppendStatementForNode(ConditionalSequenceNode);
+				GotoNextCaseStatement->Type = KCST_GotoIfNot;
+				GotoNextCaseStatement->LHS = CondTerm;
+			}
+
+			if (bProfileCaseHits)
+			{
+				AppendRecordCaseHitStatement(
+					Context, ConditionalSequenceNode, NodeId, CaseIndices[Index], AllCasePairs.Num());
+			}
+			if (bTraceNode)
+			{
+				AppendEndNodeTraceStatement(Context, ConditionalSequenceNode, CaseIndices[Index]);
+			}
+
+			// Come back to next case after the case execution is finished.
+			const bool bHasFollowingExecution = (Index < CasePairs.Num() - 1) || (DefaultExecPin->LinkedTo.Num() > 0);
+			FBlueprintCompiledStatement* PushNextCaseStatement = nullptr;
+			if (bHasFollowingExecution)
+			{
+				PushNextCaseStatement = &Context.AppendStatementForNode(ConditionalSequenceNode);
+				PushNextCaseStatement->Type = KCST_PushState;
+			}
+
+			FBlueprintCompiledStatement& GotoCaseExecStatement = Context.AppendStatementForNode(ConditionalSequenceNode);
+			GotoCaseExecStatement.Type = KCST_UnconditionalGoto;
+			Context.GotoFixupRequestMap.Add(&GotoCaseExecStatement, ExecPin);
+
+			// Restart measuring when the case execution is finished.
+			FBlueprintCompiledStatement* ReturnStatement = nullptr;
+			if (bTraceNode && (PushNextCaseStatement != nullptr))
+			{
+				ReturnStatement = &AppendJumpTargetStatement(Context, ConditionalSequenceNode);
+				AppendBeginNodeTraceStatement(Context, ConditionalSequenceNode);
+			}
+
+			FBlueprintCompiledStatement& NextCaseStatement = AppendJumpTargetStatement(Context, ConditionalSequenceNode);
+			if (GotoNextCaseStatement != nullptr)
+			{
+				GotoNextCaseStatement->TargetLabel = &NextCaseStatement;
+			}
+			if (PushNextCaseStatement != nullptr)
+			{
+				PushNextCaseStatement->TargetLabel = (ReturnStatement != nullptr) ? ReturnStatement : &NextCaseStatement;
+			}
+		}
+
+		// The pure nodes only used by the conditions are evaluated above, so they must not be evaluated again.
+		TArray<UEdGraphNode*> CondOnlyNodes;
+		CollectPureNodes(Context, CondPins, true, CondOnlyNodes);
+		DiscardStatements(Context, CondOnlyNodes);
+
+		// Goto default
+		if (bTraceNode)
+		{
+			AppendEndNodeTraceStatement(Context, ConditionalSequenceNode, INDEX_NONE);
+		}
+		GenerateSimpleThenGoto(Context, *ConditionalSequenceNode, DefaultExecPin);
+
+		INC_DWORD_STAT(STAT_ACF_NumNodesCompiled);
+		if (TArray<FBlueprintCompiledStatement*>* Statements = Context.StatementsPerNode.Find(Node))
+		{
+			INC_DWORD_STAT_BY(STAT_ACF_NumStatementsEmitted, Statements->Num());
+		}
+		RecordNodeCost(Context, Node);
+	}
+};
+
 UK2Node_ConditionalSequence::UK2Node_ConditionalSequence(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	NodeContextMenuSectionName = "K2NodeConditionalSequence";
@@ -74,44 +263,9 @@ void UK2Node_ConditionalSequence::ReallocatePinsDuringReconstruction(TArray<UEdG
 	Super::ReallocatePinsDuringReconstruction(OldPins);
 }
 
-void UK2Node_ConditionalSequence::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+class FNodeHandlingFunctor* UK2Node_ConditionalSequence::CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const
 {
-	Super::ExpandNode(CompilerContext, SourceGraph);
-
-	TArray<CasePinPair> CasePairs = GetCasePinPairs();
-
-	UEdGraphPin* ExecTriggeringPin = GetExecPin();
-	UEdGraphPin* DefaultExecPin = FindPin(DefaultExecPinName);
-
-	{
-		UK2Node_ExecutionSequence* Sequence = CompilerContext.SpawnIntermediateNode<UK2Node_ExecutionSequence>(this, SourceGraph);
-		Sequence->AllocateDefaultPins();
-
-		CompilerContext.MovePinLinksToIntermediate(*ExecTriggeringPin, *Sequence->GetExecPin());
-
-		for (int32 Index = 0; Index < CasePairs.Num(); ++Index)
-		{
-			UK2Node_IfThenElse* IfThenElse = CompilerContext.SpawnIntermediateNode<UK2Node_IfThenElse>(this, SourceGraph);
-			IfThenElse->AllocateDefaultPins();
-
-			Sequence->AddInputPin();
-
-			UEdGraphPin* CaseCondPin = CasePairs[Index].Key;
-			UEdGraphPin* CaseExecPin = CasePairs[Index].Value;
-			UEdGraphPin* SequenceExecPin = Sequence->GetThenPinGivenIndex(Index);
-			UEdGraphPin* IfThenElseExecPin = IfThenElse->GetExecPin();
-			UEdGraphPin* IfThenElseThenPin = IfThenElse->GetThenPin();
-			UEdGraphPin* IfThenElseCondPin = IfThenElse->GetConditionPin();
-
-			SequenceExecPin->MakeLinkTo(IfThenElseExecPin);
-			CompilerContext.MovePinLinksToIntermediate(*CaseExecPin, *IfThenElseThenPin);
-			CompilerContext.MovePinLinksToIntermediate(*CaseCondPin, *IfThenElseCondPin);
-		}
-
-		CompilerContext.MovePinLinksToIntermediate(*DefaultExecPin, *Sequence->GetThenPinGivenIndex(CasePairs.Num()));
-	}
-
-	BreakAllNodeLinks();
+	return new FKCHandler_ConditionalSequence(CompilerContext);
 }
 
 void UK2Node_ConditionalSequence::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
@@ -146,7 +300,7 @@ void UK2Node_ConditionalSequence::CreateDefaultExecPin()
 	DefaultExecPin->PinFriendlyName = FText::AsCultureInvariant(DefaultExecPinFriendlyName.ToString());
 }
 
-CasePinPair UK2Node_ConditionalSequence::AddCasePinPair(int32 CaseIndex)
+CasePinPair UK2Node_ConditionalSequence::CreateCasePinPair(int32 CaseIndex)
 {
 	CasePinPair Pair;
 	int N = GetCasePinCount();
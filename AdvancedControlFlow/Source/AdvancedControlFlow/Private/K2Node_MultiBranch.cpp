@@ -9,42 +9,33 @@
 
 #include "K2Node_MultiBranch.h"
 
+#include "AdvancedControlFlowStats.h"
 #include "BlueprintNodeSpawner.h"
 #include "EdGraphSchema_K2.h"
 #include "EdGraphUtilities.h"
 #include "EditorCategoryUtils.h"
 #include "GraphEditorSettings.h"
-#include "Kismet/KismetMathLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "KCHandler_CasePairedPinsNode.h"
 #include "KismetCompiledFunctionContext.h"
 #include "KismetCompiler.h"
 #include "KismetCompilerMisc.h"
 
 #define LOCTEXT_NAMESPACE "AdvancedControlFlow"
 
-class FKCHandler_MultiBranch : public FNodeHandlingFunctor
+class FKCHandler_MultiBranch : public FKCHandler_CasePairedPinsNode
 {
-	TMap<UEdGraphNode*, FBPTerminal*> BoolTermMap;
-
 public:
-	FKCHandler_MultiBranch(FKismetCompilerContext& InCompilerContext) : FNodeHandlingFunctor(InCompilerContext)
+	FKCHandler_MultiBranch(FKismetCompilerContext& InCompilerContext) : FKCHandler_CasePairedPinsNode(InCompilerContext)
 	{
-	}
-
-	virtual void RegisterNets(FKismetFunctionContext& Context, UEdGraphNode* Node) override
-	{
-		UK2Node_MultiBranch* MultiBranchNode = CastChecked<UK2Node_MultiBranch>(Node);
-
-		FNodeHandlingFunctor::RegisterNets(Context, Node);
-
-		FBPTerminal* BoolTerm = Context.CreateLocalTerminal();
-		BoolTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Boolean;
-		BoolTerm->Source = Node;
-		BoolTerm->Name = Context.NetNameMap->MakeValidName(Node, TEXT("Inverted"));
-		BoolTermMap.Add(Node, BoolTerm);
+		bSupportsNodeTrace = true;
 	}
 
 	virtual void Compile(FKismetFunctionContext& Context, UEdGraphNode* Node) override
 	{
+		SCOPE_CYCLE_COUNTER(STAT_ACF_CompileMultiBranch);
+		ACF_LLM_SCOPE();
+
 		UK2Node_MultiBranch* MultiBranchNode = CastChecked<UK2Node_MultiBranch>(Node);
 
 		FEdGraphPinType ExpectedExecPinType;
@@ -69,59 +60,162 @@ public:
 		}
 
 		UEdGraphPin* DefaultExecPin = MultiBranchNode->GetDefaultExecPin();
+		const TArray<CasePinPair> CasePinPairs = MultiBranchNode->GetCasePinPairs();
 
-		UEdGraphPin* FunctionPin = MultiBranchNode->GetFunctionPin();
-		FBPTerminal* FunctionContext = Context.NetMap.FindRef(FunctionPin);
-		UClass* FunctionClass = Cast<UClass>(FunctionPin->PinType.PinSubCategoryObject.Get());
-		UFunction* FunctionPtr = FindUField<UFunction>(FunctionClass, FunctionPin->PinName);
-		check(FunctionPtr);
-
-		FBPTerminal* BoolTerm = BoolTermMap.FindRef(MultiBranchNode);
+		TArray<UEdGraphPin*> CondPins;
+		CondPins.Reserve(CasePinPairs.Num());
+		for (const CasePinPair& Pair : CasePinPairs)
+		{
+			CondPins.Add(Pair.Key);
+		}
+		FCaseConditions Conditions;
+		AnalyzeCaseConditions(Context, CondPins, Conditions);
+
+		// The conditions which are mutually exclusive can be tested in any order.
+		// Test them in the order of the hit counts recorded by the profiling mode.
+		TArray<int32> CaseOrder;
+		const FString NodeId = GetCaseHitNodeId(MultiBranchNode);
+		const bool bProfileCaseHits = IsCaseHitProfilingEnabled();
+		if (!MultiBranchNode->bConditionsMutuallyExclusive || bProfileCaseHits ||
+			!GetCaseOrderByHitCounts(NodeId, CasePinPairs.Num(), CaseOrder))
+		{
+			CaseOrder.Reset(CasePinPairs.Num());
+			for (int32 CaseIndex = 0; CaseIndex < CasePinPairs.Num(); ++CaseIndex)
+			{
+				CaseOrder.Add(CaseIndex);
+			}
+		}
 
-		for (auto PinIt = MultiBranchNode->Pins.CreateIterator(); PinIt; ++PinIt)
+		const bool bTraceNode = IsNodeTraceEnabled();
+		if (bTraceNode)
 		{
-			UEdGraphPin* ExecPin = *PinIt;
+			AppendBeginNodeTraceStatement(Context, MultiBranchNode);
+		}
 
-			if (ExecPin->Direction != EGPD_Output)
+		// Set to false when a condition is always true. The following cases and the default are never executed.
+		bool bFollowingCasesReachable = true;
+		for (int32 CaseIndex : CaseOrder)
+		{
+			const CasePinPair& Pair = CasePinPairs[CaseIndex];
+			UEdGraphPin* CondPin = Pair.Key;
+			UEdGraphPin* ExecPin = Pair.Value;
+			if (!bFollowingCasesReachable)
 			{
+				DiscardLazyStatements(Context, CondPin);
+				INC_DWORD_STAT(STAT_ACF_NumCasesPruned);
 				continue;
 			}
-			if (ExecPin->GetFName() == DefaultExecPinName)
+
+			// Fold the constant condition.
+			bool bConstantCond = false;
+			if (GetConstantBool(Context, CondPin, bConstantCond))
 			{
+				DiscardLazyStatements(Context, CondPin);
+				if (bConstantCond)
+				{
+					const FText Message = LOCTEXT("MultiBranchAlwaysTrueCondition_Note",
+						"@@ is always true. The following cases and the default are removed");
+					CompilerContext.MessageLog.Note(*Message.ToString(), CondPin);
+					AppendGotoCaseExecStatements(Context, MultiBranchNode, ExecPin, CaseIndex, bTraceNode);
+					bFollowingCasesReachable = false;
+				}
+				else
+				{
+					CompilerContext.MessageLog.Note(
+						*LOCTEXT("AlwaysFalseCondition_Note", "@@ is always false. The case is removed").ToString(), CondPin);
+					INC_DWORD_STAT(STAT_ACF_NumCasesPruned);
+				}
 				continue;
 			}
 
-			UEdGraphPin* CondPin = MultiBranchNode->GetCaseKeyPinFromCaseValuePin(ExecPin);
-			UEdGraphPin* CondNet = FEdGraphUtilities::GetNetFromPin(CondPin);
-			FBPTerminal* CondValueTerm = Context.NetMap.FindRef(CondNet);
+			// The pure nodes only used by Cond are evaluated here, so the conditions after the true one are not evaluated.
+			// The condition which is shared with the previous cases is not evaluated again.
+			FBPTerminal* CondValueTerm = AppendCaseConditionStatements(Context, MultiBranchNode, Conditions, CaseIndex);
 
-			// Goto if Not_PreBool(Cond)
+			const bool bNegated = Conditions.Conditions[CaseIndex].bNegated;
+			if (bNegated && !bProfileCaseHits && !bTraceNode)
+			{
+				// Goto case execution if the input of NOT Boolean is false, otherwise goto next case.
+				FBlueprintCompiledStatement& GotoCaseExecStatement = Context.AppendStatementForNode(MultiBranchNode);
+				GotoCaseExecStatement.Type = KCST_GotoIfNot;
+				GotoCaseExecStatement.LHS = CondValueTerm;
+				Context.GotoFixupRequestMap.Add(&GotoCaseExecStatement, ExecPin);
+			}
+			else
 			{
-				FBlueprintCompiledStatement& CallFuncStatement = Context.AppendStatementForNode(MultiBranchNode);
-				CallFuncStatement.Type = KCST_CallFunction;
-				CallFuncStatement.FunctionToCall = FunctionPtr;
-				CallFuncStatement.FunctionContext = FunctionContext;
-				CallFuncStatement.bIsParentContext = false;
-				CallFuncStatement.LHS = BoolTerm;
-				CallFuncStatement.RHS.Add(CondValueTerm);
-
-				FBlueprintCompiledStatement& GotoStatement = Context.AppendStatementForNode(MultiBranchNode);
-				GotoStatement.Type = KCST_GotoIfNot;
-				GotoStatement.LHS = BoolTerm;
-
-				Context.GotoFixupRequestMap.Add(&GotoStatement, ExecPin);
+				// Goto next case if Cond is false, otherwise goto case execution.
+				FBlueprintCompiledStatement* GotoNextCaseStatement =
+					AppendGotoNextCaseStatement(Context, MultiBranchNode, CondValueTerm, bNegated);
+
+				if (bProfileCaseHits)
+				{
+					AppendRecordCaseHitStatement(Context, MultiBranchNode, NodeId, CaseIndex, CasePinPairs.Num());
+				}
+				AppendGotoCaseExecStatements(Context, MultiBranchNode, ExecPin, CaseIndex, bTraceNode);
+
+				GotoNextCaseStatement->TargetLabel = &AppendJumpTargetStatement(Context, MultiBranchNode);
 			}
 		}
 
 		// Goto default
-		GenerateSimpleThenGoto(Context, *MultiBranchNode, DefaultExecPin);
+		if (bFollowingCasesReachable)
+		{
+			if (bTraceNode)
+			{
+				AppendEndNodeTraceStatement(Context, MultiBranchNode, INDEX_NONE);
+			}
+			GenerateSimpleThenGoto(Context, *MultiBranchNode, DefaultExecPin);
+		}
+
+		INC_DWORD_STAT(STAT_ACF_NumNodesCompiled);
+		if (TArray<FBlueprintCompiledStatement*>* Statements = Context.StatementsPerNode.Find(Node))
+		{
+			INC_DWORD_STAT_BY(STAT_ACF_NumStatementsEmitted, Statements->Num());
+		}
+		RecordNodeCost(Context, Node);
+	}
+
+private:
+	// Append the statement which jumps if the condition is false, and return it to set the target later.
+	// The statements after it are executed if the condition is true.
+	FBlueprintCompiledStatement* AppendGotoNextCaseStatement(
+		FKismetFunctionContext& Context, UEdGraphNode* Node, FBPTerminal* CondValueTerm, bool bNegated)
+	{
+		if (bNegated)
+		{
+			FBlueprintCompiledStatement& GotoTakeCaseStatement = Context.AppendStatementForNode(Node);
+			GotoTakeCaseStatement.Type = KCST_GotoIfNot;
+			GotoTakeCaseStatement.LHS = CondValueTerm;
+
+			FBlueprintCompiledStatement& GotoNextCaseStatement = Context.AppendStatementForNode(Node);
+			GotoNextCaseStatement.Type = KCST_UnconditionalGoto;
+
+			GotoTakeCaseStatement.TargetLabel = &AppendJumpTargetStatement(Context, Node);
+			return &GotoNextCaseStatement;
+		}
+
+		FBlueprintCompiledStatement& GotoNextCaseStatement = Context.AppendStatementForNode(Node);
+		GotoNextCaseStatement.Type = KCST_GotoIfNot;
+		GotoNextCaseStatement.LHS = CondValueTerm;
+		return &GotoNextCaseStatement;
+	}
+
+	void AppendGotoCaseExecStatements(
+		FKismetFunctionContext& Context, UEdGraphNode* Node, UEdGraphPin* ExecPin, int32 CaseIndex, bool bTraceNode)
+	{
+		if (bTraceNode)
+		{
+			AppendEndNodeTraceStatement(Context, Node, CaseIndex);
+		}
+
+		FBlueprintCompiledStatement& GotoCaseExecStatement = Context.AppendStatementForNode(Node);
+		GotoCaseExecStatement.Type = KCST_UnconditionalGoto;
+		Context.GotoFixupRequestMap.Add(&GotoCaseExecStatement, ExecPin);
 	}
 };
 
 UK2Node_MultiBranch::UK2Node_MultiBranch(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
-	ConditionPreProcessFuncClass = UKismetMathLibrary::StaticClass();
-	ConditionPreProcessFuncName = TEXT("Not_PreBool");
 	NodeContextMenuSectionName = "K2NodeMultiBranch";
 	NodeContextMenuSectionLabel = LOCTEXT("MultiBranch", "MultiBranch");
 	CaseKeyPinNamePrefix = TEXT("CaseCond");
@@ -135,13 +229,11 @@ void UK2Node_MultiBranch::AllocateDefaultPins()
 	// Pin structure
 	//   N: Number of case pin pair
 	// -----
-	// 0: Internal function (Hidden, Object)
-	// 1: Execution Triggering (In, Exec)
-	// 2: Default Execution (Out, Exec)
-	// 3 - 2+N: Case Conditional (In, Boolean)
-	// 2+N+1 - 2*(N+1): Case Execution (Out, Exec)
+	// 0: Execution Triggering (In, Exec)
+	// 1: Default Execution (Out, Exec)
+	// 2 - 1+N: Case Conditional (In, Boolean)
+	// 1+N+1 - 2*(N+1)-1: Case Execution (Out, Exec)
 
-	CreateFunctionPin();
 	CreateExecTriggeringPin();
 	CreateDefaultExecPin();
 
@@ -169,9 +261,20 @@ FSlateIcon UK2Node_MultiBranch::GetIconAndTint(FLinearColor& OutColor) const
 	return Icon;
 }
 
+void UK2Node_MultiBranch::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// The order of the condition tests depends on the property, so the Blueprint must be recompiled.
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UK2Node_MultiBranch, bConditionsMutuallyExclusive))
+	{
+		FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
+	}
+}
+
 void UK2Node_MultiBranch::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
 {
-	CreateFunctionPin();
+	// The internal function pin (Not_PreBool) of the old nodes is not recreated, and will be discarded.
 	CreateExecTriggeringPin();
 	CreateDefaultExecPin();
 
@@ -200,14 +303,14 @@ FText UK2Node_MultiBranch::GetMenuCategory() const
 	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::FlowControl);
 }
 
-CasePinPair UK2Node_MultiBranch::AddCasePinPair(int32 CaseIndex)
+CasePinPair UK2Node_MultiBranch::CreateCasePinPair(int32 CaseIndex)
 {
 	CasePinPair Pair;
 	int N = GetCasePinCount();
 
 	{
 		FCreatePinParams Params;
-		Params.Index = 3 + CaseIndex;
+		Params.Index = 2 + CaseIndex;
 		Pair.Key = CreatePin(
 			EGPD_Input, UEdGraphSchema_K2::PC_Boolean, *GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex), Params);
 		Pair.Key->PinFriendlyName =
@@ -215,7 +318,7 @@ CasePinPair UK2Node_MultiBranch::AddCasePinPair(int32 CaseIndex)
 	}
 	{
 		FCreatePinParams Params;
-		Params.Index = 3 + N + 1 + CaseIndex;
+		Params.Index = 2 + N + 1 + CaseIndex;
 		Pair.Value = CreatePin(
 			EGPD_Output, UEdGraphSchema_K2::PC_Exec, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
 		Pair.Value->PinFriendlyName =
@@ -225,42 +328,17 @@ CasePinPair UK2Node_MultiBranch::AddCasePinPair(int32 CaseIndex)
 	return Pair;
 }
 
-void UK2Node_MultiBranch::CreateFunctionPin()
-{
-	FCreatePinParams Params;
-	Params.Index = 0;
-	UEdGraphPin* FunctionPin =
-		CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Object, ConditionPreProcessFuncClass, ConditionPreProcessFuncName, Params);
-	FunctionPin->bDefaultValueIsReadOnly = true;
-	FunctionPin->bNotConnectable = true;
-	FunctionPin->bHidden = true;
-
-	UFunction* Function = FindUField<UFunction>(ConditionPreProcessFuncClass, ConditionPreProcessFuncName);
-	if (Function != nullptr && Function->HasAllFunctionFlags(FUNC_Static))
-	{
-		UBlueprint* Blueprint = GetBlueprint();
-		if (Blueprint != nullptr)
-		{
-			UClass* FunctionOwnerClass = Function->GetOuterUClass();
-			if (!Blueprint->SkeletonGeneratedClass->IsChildOf(FunctionOwnerClass))
-			{
-				FunctionPin->DefaultObject = FunctionOwnerClass->GetDefaultObject();
-			}
-		}
-	}
-}
-
 void UK2Node_MultiBranch::CreateExecTriggeringPin()
 {
 	FCreatePinParams Params;
-	Params.Index = 1;
+	Params.Index = 0;
 	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute, Params);
 }
 
 void UK2Node_MultiBranch::CreateDefaultExecPin()
 {
 	FCreatePinParams Params;
-	Params.Index = 2;
+	Params.Index = 1;
 	UEdGraphPin* DefaultExecPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, DefaultExecPinName, Params);
 	DefaultExecPin->PinFriendlyName = FText::AsCultureInvariant(DefaultExecPinFriendlyName.ToString());
 }
@@ -270,9 +348,4 @@ UEdGraphPin* UK2Node_MultiBranch::GetDefaultExecPin() const
 	return FindPin(DefaultExecPinName);
 }
 
-UEdGraphPin* UK2Node_MultiBranch::GetFunctionPin() const
-{
-	return FindPin(ConditionPreProcessFuncName);
-}
-
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -9,15 +9,14 @@
 
 #include "K2Node_MultiConditionalSelect.h"
 
+#include "AdvancedControlFlowStats.h"
 #include "BlueprintNodeSpawner.h"
+#include "EdGraphUtilities.h"
 #include "EditorCategoryUtils.h"
 #include "GraphEditorSettings.h"
-#include "K2Node_CallFunction.h"
-#include "K2Node_MakeArray.h"
-#include "K2Node_Select.h"
-#include "Kismet/KismetArrayLibrary.h"
-#include "Kismet/KismetMathLibrary.h"
+#include "KCHandler_CasePairedPinsNode.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetCompiledFunctionContext.h"
 #include "KismetCompiler.h"
 
 #define LOCTEXT_NAMESPACE "AdvancedControlFlow"
@@ -27,6 +26,238 @@ const FName ReturnValueOptionPinName(TEXT("Return Value"));
 const FName OptionPinFriendlyNamePrefix(TEXT("Option "));
 const FName ConditionPinFriendlyNamePrefix(TEXT("Condition "));
 
+// clang-format off
+/*
+* Internal statement structure
+
+  CaseLoop:
+            (Statements of the pure nodes only used by Condition N)
+            GotoIfNot Condition N, NextCase
+  TakeCase:
+            (Statements of the pure nodes only used by Option N)
+            Return Value = Option N
+            Goto End
+  NextCase:
+            (Loop to next case)
+
+            (Statements of the pure nodes only used by Default)
+            Return Value = Default
+  End:
+
+  The condition which has the same net as the previous case is not evaluated again.
+  The condition which is NOT Boolean of A is tested as below instead.
+
+            GotoIfNot A, TakeCase
+            Goto NextCase
+
+  The case whose condition is always false is removed.
+  The case whose condition is always true is emitted without GotoIfNot, and the following cases and default are removed.
+ */
+// clang-format on
+class FKCHandler_MultiConditionalSelect : public FKCHandler_CasePairedPinsNode
+{
+public:
+	FKCHandler_MultiConditionalSelect(FKismetCompilerContext& InCompilerContext) : FKCHandler_CasePairedPinsNode(InCompilerContext)
+	{
+		bSupportsNodeTrace = true;
+	}
+
+	virtual void RegisterNets(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		FKCHandler_CasePairedPinsNode::RegisterNets(Context, Node);
+
+		UK2Node_MultiConditionalSelect* MultiConditionalSelectNode = CastChecked<UK2Node_MultiConditionalSelect>(Node);
+		UEdGraphPin* ReturnValuePin = MultiConditionalSelectNode->GetReturnValuePin();
+		FBPTerminal* ReturnValueTerm =
+			Context.CreateLocalTerminalFromPinAutoChooseScope(ReturnValuePin, Context.NetNameMap->MakeValidName(ReturnValuePin));
+		Context.NetMap.Add(ReturnValuePin, ReturnValueTerm);
+	}
+
+	virtual void Compile(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ACF_CompileMultiConditionalSelect);
+		ACF_LLM_SCOPE();
+
+		UK2Node_MultiConditionalSelect* MultiConditionalSelectNode = CastChecked<UK2Node_MultiConditionalSelect>(Node);
+
+		UEdGraphPin* ReturnValuePin = MultiConditionalSelectNode->GetReturnValuePin();
+		if (ReturnValuePin->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("UndeterminedPinType_Error", "The type of @@ is undetermined").ToString(), ReturnValuePin);
+			return;
+		}
+		FBPTerminal* ReturnValueTerm = Context.NetMap.FindRef(ReturnValuePin);
+
+		TArray<FBlueprintCompiledStatement*> GotoEndStatements;
+
+		const TArray<CasePinPair> CasePinPairs = MultiConditionalSelectNode->GetCasePinPairs();
+
+		TArray<UEdGraphPin*> CondPins;
+		CondPins.Reserve(CasePinPairs.Num());
+		for (const CasePinPair& Pair : CasePinPairs)
+		{
+			CondPins.Add(Pair.Value);
+		}
+		FCaseConditions Conditions;
+		AnalyzeCaseConditions(Context, CondPins, Conditions);
+
+		const bool bTraceNode = IsNodeTraceEnabled();
+		if (bTraceNode)
+		{
+			AppendBeginNodeTraceStatement(Context, MultiConditionalSelectNode);
+		}
+
+		// Set to false when a condition is always true. The following cases and the default are never selected.
+		bool bFollowingCasesReachable = true;
+		for (int32 CaseIndex = 0; CaseIndex < CasePinPairs.Num(); ++CaseIndex)
+		{
+			const CasePinPair& Pair = CasePinPairs[CaseIndex];
+			UEdGraphPin* OptionPin = Pair.Key;
+			UEdGraphPin* CondPin = Pair.Value;
+			if (!bFollowingCasesReachable)
+			{
+				DiscardLazyStatements(Context, CondPin);
+				DiscardLazyStatements(Context, OptionPin);
+				INC_DWORD_STAT(STAT_ACF_NumCasesPruned);
+				continue;
+			}
+
+			// Fold the constant condition.
+			bool bConstantCond = false;
+			const bool bIsConstantCond = GetConstantBool(Context, CondPin, bConstantCond);
+			if (bIsConstantCond && !bConstantCond)
+			{
+				CompilerContext.MessageLog.Note(
+					*LOCTEXT("AlwaysFalseCondition_Note", "@@ is always false. The case is removed").ToString(), CondPin);
+				DiscardLazyStatements(Context, CondPin);
+				DiscardLazyStatements(Context, OptionPin);
+				INC_DWORD_STAT(STAT_ACF_NumCasesPruned);
+				continue;
+			}
+
+			FBPTerminal* OptionTerm = FindInputTerm(Context, OptionPin);
+			if (OptionTerm == nullptr)
+			{
+				return;
+			}
+			if (bIsConstantCond)
+			{
+				const FText Message = LOCTEXT("MultiConditionalSelectAlwaysTrueCondition_Note",
+					"@@ is always true. The following options and the default are removed");
+				CompilerContext.MessageLog.Note(*Message.ToString(), CondPin);
+				DiscardLazyStatements(Context, CondPin);
+
+				// Return Value = Option
+				AppendLazyStatements(Context, MultiConditionalSelectNode, OptionPin);
+				AppendAssignStatement(Context, MultiConditionalSelectNode, ReturnValueTerm, OptionTerm);
+				if (bTraceNode)
+				{
+					AppendEndNodeTraceStatement(Context, MultiConditionalSelectNode, CaseIndex);
+				}
+				bFollowingCasesReachable = false;
+				continue;
+			}
+
+			// The condition which is shared with the previous cases is not evaluated again.
+			FBPTerminal* CondTerm = AppendCaseConditionStatements(Context, MultiConditionalSelectNode, Conditions, CaseIndex);
+			if (CondTerm == nullptr)
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("UnregisteredPin_Error", "Failed to find the term for @@").ToString(), CondPin);
+				return;
+			}
+
+			// Goto next case if Cond is false.
+			FBlueprintCompiledStatement* GotoNextCaseStatement = nullptr;
+			if (Conditions.Conditions[CaseIndex].bNegated)
+			{
+				FBlueprintCompiledStatement& GotoTakeCaseStatement = Context.AppendStatementForNode(MultiConditionalSelectNode);
+				GotoTakeCaseStatement.Type = KCST_GotoIfNot;
+				GotoTakeCaseStatement.LHS = CondTerm;
+
+				GotoNextCaseStatement = &Context.AppendStatementForNode(MultiConditionalSelectNode);
+				GotoNextCaseStatement->Type = KCST_UnconditionalGoto;
+
+				GotoTakeCaseStatement.TargetLabel = &AppendJumpTargetStatement(Context, MultiConditionalSelectNode);
+			}
+			else
+			{
+				GotoNextCaseStatement = &Context.AppendStatementForNode(MultiConditionalSelectNode);
+				GotoNextCaseStatement->Type = KCST_GotoIfNot;
+				GotoNextCaseStatement->LHS = CondTerm;
+			}
+
+			// Return Value = Option, and goto end.
+			AppendLazyStatements(Context, MultiConditionalSelectNode, OptionPin);
+			AppendAssignStatement(Context, MultiConditionalSelectNode, ReturnValueTerm, OptionTerm);
+			if (bTraceNode)
+			{
+				AppendEndNodeTraceStatement(Context, MultiConditionalSelectNode, CaseIndex);
+			}
+			FBlueprintCompiledStatement& GotoEndStatement = Context.AppendStatementForNode(MultiConditionalSelectNode);
+			GotoEndStatement.Type = KCST_UnconditionalGoto;
+			GotoEndStatements.Add(&GotoEndStatement);
+
+			GotoNextCaseStatement->TargetLabel = &AppendJumpTargetStatement(Context, MultiConditionalSelectNode);
+		}
+
+		// Return Value = Default
+		UEdGraphPin* DefaultOptionPin = MultiConditionalSelectNode->GetDefaultOptionPin();
+		if (bFollowingCasesReachable)
+		{
+			FBPTerminal* DefaultOptionTerm = FindInputTerm(Context, DefaultOptionPin);
+			if (DefaultOptionTerm == nullptr)
+			{
+				return;
+			}
+			AppendLazyStatements(Context, MultiConditionalSelectNode, DefaultOptionPin);
+			AppendAssignStatement(Context, MultiConditionalSelectNode, ReturnValueTerm, DefaultOptionTerm);
+			if (bTraceNode)
+			{
+				AppendEndNodeTraceStatement(Context, MultiConditionalSelectNode, INDEX_NONE);
+			}
+		}
+		else
+		{
+			DiscardLazyStatements(Context, DefaultOptionPin);
+		}
+
+		FBlueprintCompiledStatement& EndStatement = AppendJumpTargetStatement(Context, MultiConditionalSelectNode);
+		for (FBlueprintCompiledStatement* GotoEndStatement : GotoEndStatements)
+		{
+			GotoEndStatement->TargetLabel = &EndStatement;
+		}
+
+		INC_DWORD_STAT(STAT_ACF_NumNodesCompiled);
+		if (TArray<FBlueprintCompiledStatement*>* Statements = Context.StatementsPerNode.Find(Node))
+		{
+			INC_DWORD_STAT_BY(STAT_ACF_NumStatementsEmitted, Statements->Num());
+		}
+		RecordNodeCost(Context, Node);
+	}
+
+private:
+	FBPTerminal* FindInputTerm(FKismetFunctionContext& Context, UEdGraphPin* Pin)
+	{
+		FBPTerminal* Term = Context.NetMap.FindRef(FEdGraphUtilities::GetNetFromPin(Pin));
+		if (Term == nullptr)
+		{
+			CompilerContext.MessageLog.Error(*LOCTEXT("UnregisteredPin_Error", "Failed to find the term for @@").ToString(), Pin);
+		}
+
+		return Term;
+	}
+
+	void AppendAssignStatement(FKismetFunctionContext& Context, UEdGraphNode* Node, FBPTerminal* LHSTerm, FBPTerminal* RHSTerm)
+	{
+		FBlueprintCompiledStatement& Statement = Context.AppendStatementForNode(Node);
+		Statement.Type = KCST_Assignment;
+		Statement.LHS = LHSTerm;
+		Statement.RHS.Add(RHSTerm);
+	}
+};
+
 UK2Node_MultiConditionalSelect::UK2Node_MultiConditionalSelect(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -142,22 +373,21 @@ void UK2Node_MultiConditionalSelect::ReallocatePinsDuringReconstruction(TArray<U
 		if (Pin->GetFName() == DefaultOptionPinName)
 		{
 			OldDefaultPin = Pin;
+			break;
 		}
 	}
 
 	CreateDefaultOptionPin();
 	CreateReturnValuePin();
-	Super::ReallocatePinsDuringReconstruction(OldPins);
 
+	// The option pins are created with the type of the default option pin.
 	if (OldDefaultPin != nullptr)
 	{
 		GetDefaultOptionPin()->PinType = OldDefaultPin->PinType;
 		GetReturnValuePin()->PinType = OldDefaultPin->PinType;
-		for (auto& Pair : GetCasePinPairs())
-		{
-			Pair.Key->PinType = OldDefaultPin->PinType;
-		}
 	}
+
+	Super::ReallocatePinsDuringReconstruction(OldPins);
 }
 
 void UK2Node_MultiConditionalSelect::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
@@ -177,164 +407,9 @@ FText UK2Node_MultiConditionalSelect::GetMenuCategory() const
 	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::Utilities);
 }
 
-// clang-format off
-/*
-* Internal node structure
-
-            +-----------------------------------------------------------------------------------------------------------------------+
-            |                                                                                                                       |
-            |                                         +----------------------------+           +----------------------------+       |
-            |                                         |          Select            |           |           Select           |       |
-            |                                         |                            |           |                            |       |
-            +-+                                       +-+                        +-+           +-+                        +-+     +-+
-   Option 0 | +---------------------------------------+ | Option 0  Return Value | +-----------+ | False     Return Value | +-----+ | Return Value
-            +-+                                       +-+                        +-+           +-+                        +-+     +-+
-            |                                         |                            |           |                            |       |
-            |                                         |                            |           |                            |       |
-            +-+                                       +-+                          |           +-+                          |       |
-   Option 1 | +---------------------------------------+ | Option 1                 |   +-------+ | True                     |       |
-            +-+                                       +-+                          |   |       +-+                          |       |
-            |                                         |                            |   |       |                            |       |
-            |                                         |                            |   |       |                            |       |
-            +-+                                       +-+                          |   |       +-+                          |       |
-    Default | +------------------+            +-------+ | Index (Integer)          |   |    +--+ | Index (Boolean)          |       |
-            +-+                  |            |       +-+                          |   |    |  +-+                          |       |
-            |                    |            |       |                            |   |    |  |                            |       |
-            |                    |            |       |                            |   |    |  |                            |       |
-            |                    |            |       +----------------------------+   |    |  +----------------------------+       |
-            |                    |            x                                        |    |                                       |
-            |                    |            x                                        |    |                                       |
-            |                    +------------x----------------------------------------+    +------------------------+              |
-            |                                 x                                                                      |              |
-            |                                 x-----------------------------------+                                  |              |
-            |                                                                     |                                  |              |
-            |       +------------------+     +---------------------------------+  |  +-----------------------+       |              |
-            |       |    Make Array    |     |          Find (Array)           |  |  |     == (Integer)      |       |              |
-            |       |                  |     |                                 |  |  |                       |       |              |
-            +-+     +-+              +-+     +-+                             +-+  |  +-+                   +-+       |              |
-Condition 0 | +-----+ | [0]    Array | +-----+ | Target Array   Return Value | +--+--+ | A    Return Value | +-------+              |
-            +-+     +-+              +-+     +-+                             +-+     +-+                   +-+                      |
-            |       |                  |     |                                 |     |                       |                      |
-            |       |                  |     |                                 |     |                       |                      |
-            +-+     +-+                |     +-+                               |     +-+                     |                      |
-Condition 1 | +-----+ | [1]            |     | | Item To Find                  |     | | B                   |                      |
-            +-+     +-+                |     +-+                               |     +-+                     |                      |
-            |       |                  |     |                                 |     |                       |                      |
-            |       |                  |     |                                 |     |                       |                      |
-            |       +------------------+     +---------------------------------+     +-----------------------+                      |
-            |                                                                                                                       |
-            |                                                                                                                       |
-            +-----------------------------------------------------------------------------------------------------------------------+
- */
-// clang-format on
-void UK2Node_MultiConditionalSelect::ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph)
+class FNodeHandlingFunctor* UK2Node_MultiConditionalSelect::CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const
 {
-	Super::ExpandNode(CompilerContext, SourceGraph);
-
-	UEdGraphPin* ReferenceOptionPin = GetCasePinPairs()[0].Key;
-	TArray<CasePinPair> CasePinPairs = GetCasePinPairs();
-
-	FEdGraphPinType Select1stPinType;
-	Select1stPinType.PinCategory = UEdGraphSchema_K2::PC_Int;
-	Select1stPinType.PinSubCategory = UEdGraphSchema_K2::PSC_Index;
-	Select1stPinType.PinSubCategoryObject = nullptr;
-
-	FEdGraphPinType Select2ndPinType;
-	Select2ndPinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
-	Select2ndPinType.PinSubCategory = UEdGraphSchema_K2::PSC_Index;
-	Select1stPinType.PinSubCategoryObject = nullptr;
-
-	UK2Node_Select* Select1st = CompilerContext.SpawnIntermediateNode<UK2Node_Select>(this, SourceGraph);
-	Select1st->AllocateDefaultPins();
-	Select1st->ChangePinType(ReferenceOptionPin);
-	for (int32 Index = 2; Index < CasePinPairs.Num(); ++Index)
-	{
-		Select1st->AddInputPin();
-	}
-
-	UK2Node_Select* Select2nd = CompilerContext.SpawnIntermediateNode<UK2Node_Select>(this, SourceGraph);
-	Select2nd->AllocateDefaultPins();
-	Select2nd->ChangePinType(ReferenceOptionPin);
-	for (int32 Index = 2; Index < CasePinPairs.Num(); ++Index)
-	{
-		Select2nd->AddInputPin();
-	}
-
-	UK2Node_MakeArray* MakeArray = CompilerContext.SpawnIntermediateNode<UK2Node_MakeArray>(this, SourceGraph);
-	MakeArray->AllocateDefaultPins();
-	for (int32 Index = 1; Index < CasePinPairs.Num(); ++Index)
-	{
-		MakeArray->AddInputPin();
-	}
-
-	UK2Node_CallFunction* ArrayFind = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
-	UClass* KismetArrayLibrary = UKismetArrayLibrary::StaticClass();
-	UFunction* ArrayFindFunction = KismetArrayLibrary->FindFunctionByName("Array_Find");
-	ArrayFind->SetFromFunction(ArrayFindFunction);
-	ArrayFind->AllocateDefaultPins();
-
-	UK2Node_CallFunction* IntEqual = CompilerContext.SpawnIntermediateNode<UK2Node_CallFunction>(this, SourceGraph);
-	UClass* KismetMathLibrary = UKismetMathLibrary::StaticClass();
-	UFunction* EqualEqualIntIntFunction = KismetMathLibrary->FindFunctionByName("EqualEqual_IntInt");
-	IntEqual->SetFromFunction(EqualEqualIntIntFunction);
-	IntEqual->AllocateDefaultPins();
-
-	// Link between outer and 1st Select
-	TArray<UEdGraphPin*> Select1stOptionPins;
-	Select1st->GetOptionPins(Select1stOptionPins);
-	for (int Index = 0; Index < CasePinPairs.Num(); ++Index)
-	{
-		CompilerContext.MovePinLinksToIntermediate(*CasePinPairs[Index].Key, *Select1stOptionPins[Index]);
-	}
-
-	// Link between outer and Make Array
-	TArray<UEdGraphPin*> KeyPins;
-	TArray<UEdGraphPin*> ValuePins;
-	MakeArray->GetKeyAndValuePins(KeyPins, ValuePins);
-	for (int Index = 0; Index < CasePinPairs.Num(); ++Index)
-	{
-		KeyPins[Index]->PinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
-		CompilerContext.MovePinLinksToIntermediate(*CasePinPairs[Index].Value, *KeyPins[Index]);
-	}
-
-	// Link between Make Array and Array Find
-	UEdGraphPin* ArrayPin = MakeArray->GetOutputPin();
-	UEdGraphPin* TargetArrayPin = ArrayFind->FindPinChecked(TEXT("TargetArray"));
-	UEdGraphPin* ItemToFindPin = ArrayFind->FindPinChecked(TEXT("ItemToFind"));
-	ArrayPin->PinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
-	ArrayPin->MakeLinkTo(TargetArrayPin);
-	TargetArrayPin->PinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
-	ItemToFindPin->PinType.PinCategory = UEdGraphSchema_K2::PC_Boolean;
-	MakeArray->GetSchema()->TrySetDefaultValue(*ItemToFindPin, TEXT("true"));
-
-	// Link between Array Find and 1st Select
-	UEdGraphPin* ArrayFindOutputPin = ArrayFind->GetReturnValuePin();
-	UEdGraphPin* Select1stIndexPin = Select1st->GetIndexPin();
-	ArrayFindOutputPin->MakeLinkTo(Select1stIndexPin);
-	Select1st->NotifyPinConnectionListChanged(Select1stIndexPin);
-
-	// Link between Array Find and Int Equal
-	UEdGraphPin* IntEqualAPin = IntEqual->FindPinChecked(TEXT("A"));
-	UEdGraphPin* IntEqualBPin = IntEqual->FindPinChecked(TEXT("B"));
-	ArrayFindOutputPin->MakeLinkTo(IntEqualAPin);
-	ArrayFindOutputPin->GetSchema()->TrySetDefaultValue(*IntEqualBPin, TEXT("-1"));
-
-	// Link among 1st Select, 2nd Select and Int Equal
-	UEdGraphPin* Select1stReturnValuePin = Select1st->GetReturnValuePin();
-	UEdGraphPin* IntEqualReturnValuePin = IntEqual->GetReturnValuePin();
-	UEdGraphPin* Select2ndIndexPin = Select2nd->GetIndexPin();
-	TArray<UEdGraphPin*> Select2ndOptionPins;
-	Select2nd->GetOptionPins(Select2ndOptionPins);
-	IntEqualReturnValuePin->MakeLinkTo(Select2ndIndexPin);
-	Select2nd->NotifyPinConnectionListChanged(Select2ndIndexPin);
-	Select1stReturnValuePin->MakeLinkTo(Select2ndOptionPins[0]);
-	CompilerContext.MovePinLinksToIntermediate(*GetDefaultOptionPin(), *Select2ndOptionPins[1]);
-
-	// Link 2nd Select and outer
-	UEdGraphPin* Select2ndReturnValuePin = Select2nd->GetReturnValuePin();
-	CompilerContext.MovePinLinksToIntermediate(*GetReturnValuePin(), *Select2ndReturnValuePin);
-
-	BreakAllNodeLinks();
+	return new FKCHandler_MultiConditionalSelect(CompilerContext);
 }
 
 bool UK2Node_MultiConditionalSelect::IsConnectionDisallowed(
@@ -358,10 +433,9 @@ void UK2Node_MultiConditionalSelect::CreateDefaultOptionPin()
 
 void UK2Node_MultiConditionalSelect::CreateReturnValuePin()
 {
-	int N = GetCasePinCount();
-
+	// Case pin pairs are inserted before this pin.
 	FCreatePinParams Params;
-	Params.Index = 2 * N + 1;
+	Params.Index = 1;
 	UEdGraphPin* DefaultOptionPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Wildcard, ReturnValueOptionPinName, Params);
 }
 
@@ -375,7 +449,7 @@ UEdGraphPin* UK2Node_MultiConditionalSelect::GetReturnValuePin() const
 	return FindPin(ReturnValueOptionPinName);
 }
 
-CasePinPair UK2Node_MultiConditionalSelect::AddCasePinPair(int32 CaseIndex)
+CasePinPair UK2Node_MultiConditionalSelect::CreateCasePinPair(int32 CaseIndex)
 {
 	CasePinPair Pair;
 	int N = GetCasePinCount();
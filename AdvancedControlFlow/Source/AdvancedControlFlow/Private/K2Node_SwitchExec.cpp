@@ -0,0 +1,503 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "K2Node_SwitchExec.h"
+
+#include "AdvancedControlFlowStats.h"
+#include "BlueprintNodeSpawner.h"
+#include "EdGraphSchema_K2.h"
+#include "EdGraphUtilities.h"
+#include "EditorCategoryUtils.h"
+#include "GraphEditorSettings.h"
+#include "KCHandler_CasePairedPinsNode.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetCompiledFunctionContext.h"
+#include "KismetCompiler.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+const FName SelectionPinName(TEXT("Selection"));
+
+namespace
+{
+// FString::IsNumeric accepts the fraction (e.g. "1.5") and FCString::Atoi64 truncates it, so the case value is parsed strictly
+// as the decimal integer with an optional sign.
+bool ParseIntegerLiteral(const FString& Literal, int64 MinValue, int64 MaxValue, int64& OutValue)
+{
+	int32 Index = 0;
+	bool bNegative = false;
+	if ((Literal.Len() > 0) && ((Literal[0] == TEXT('-')) || (Literal[0] == TEXT('+'))))
+	{
+		bNegative = (Literal[0] == TEXT('-'));
+		Index = 1;
+	}
+	if (Index >= Literal.Len())
+	{
+		return false;
+	}
+
+	int64 Value = 0;
+	for (; Index < Literal.Len(); ++Index)
+	{
+		if ((Literal[Index] < TEXT('0')) || (Literal[Index] > TEXT('9')))
+		{
+			return false;
+		}
+		Value = Value * 10 + (Literal[Index] - TEXT('0'));
+		// Stop before the overflow. The range of the case value is much narrower than int64.
+		if (Value > MAX_uint32)
+		{
+			return false;
+		}
+	}
+	if (bNegative)
+	{
+		Value = -Value;
+	}
+	if ((Value < MinValue) || (Value > MaxValue))
+	{
+		return false;
+	}
+
+	OutValue = Value;
+	return true;
+}
+}	 // namespace
+
+// clang-format off
+/*
+	Internal statement structure
+
+	The cases are sorted by the value, and dispatched by the binary decision tree.
+	A leaf of the tree which has MaxLinearCaseCount cases or less tests the cases one by one.
+
+	Example (Case values: 1, 3, 5, 7, 9, 11, 13, 15)
+
+	       Bool = Less(Selection, 9)
+	       GotoIfNot(Bool) -> Upper
+	       Bool = Less(Selection, 5)
+	       GotoIfNot(Bool) -> Upper'
+	       Bool = NotEqual(Selection, 1)
+	       GotoIfNot(Bool) -> Case 1
+	       Bool = NotEqual(Selection, 3)
+	       GotoIfNot(Bool) -> Case 3
+	       Goto Default
+	Upper':
+	       ...
+	       Goto Default
+	Upper:
+	       ...
+	       Goto Default
+ */
+// clang-format on
+class FKCHandler_SwitchExec : public FKCHandler_CasePairedPinsNode
+{
+	TMap<UEdGraphNode*, FBPTerminal*> BoolTermMap;
+
+public:
+	FKCHandler_SwitchExec(FKismetCompilerContext& InCompilerContext) : FKCHandler_CasePairedPinsNode(InCompilerContext)
+	{
+	}
+
+	virtual void RegisterNets(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		FKCHandler_CasePairedPinsNode::RegisterNets(Context, Node);
+
+		// Result of the comparison. It is consumed by the next statement, so one term is enough for the node.
+		FBPTerminal* BoolTerm = Context.CreateLocalTerminal();
+		BoolTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+		BoolTerm->Source = Node;
+		BoolTerm->Name = Context.NetNameMap->MakeValidName(Node, TEXT("CompareResult"));
+		BoolTermMap.Add(Node, BoolTerm);
+	}
+
+	virtual void Compile(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ACF_CompileSwitchExec);
+		ACF_LLM_SCOPE();
+
+		UK2Node_SwitchExec* SwitchExecNode = CastChecked<UK2Node_SwitchExec>(Node);
+
+		FEdGraphPinType ExpectedExecPinType;
+		ExpectedExecPinType.PinCategory = UEdGraphSchema_K2::PC_Exec;
+
+		{
+			UEdGraphPin* ExecTriggeringPin =
+				Context.FindRequiredPinByName(SwitchExecNode, UEdGraphSchema_K2::PN_Execute, EGPD_Input);
+			if ((ExecTriggeringPin == nullptr) || !Context.ValidatePinType(ExecTriggeringPin, ExpectedExecPinType))
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("NoValidExecutionPinForSwitchExec_Error", "@@ must have a valid execution pin @@").ToString(),
+					SwitchExecNode, ExecTriggeringPin);
+				return;
+			}
+			else if (ExecTriggeringPin->LinkedTo.Num() == 0)
+			{
+				CompilerContext.MessageLog.Warning(
+					*LOCTEXT("NodeNeverExecuted_Warning", "@@ will never be executed").ToString(), SwitchExecNode);
+				return;
+			}
+		}
+
+		UEdGraphPin* SelectionPin = SwitchExecNode->GetSelectionPin();
+		if (SelectionPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("UndeterminedPinType_Error", "The type of @@ is undetermined").ToString(), SelectionPin);
+			return;
+		}
+		FBPTerminal* SelectionTerm = Context.NetMap.FindRef(FEdGraphUtilities::GetNetFromPin(SelectionPin));
+		if (SelectionTerm == nullptr)
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("UnregisteredPin_Error", "Failed to find the term for @@").ToString(), SelectionPin);
+			return;
+		}
+
+		// The first case wins if some cases have the same value.
+		TArray<FIntegerCase> Cases;
+		for (const CasePinPair& Pair : SwitchExecNode->GetCasePinPairs())
+		{
+			FIntegerCase Case;
+			if (!SwitchExecNode->GetCaseValue(Pair.Key, Case.Value))
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("InvalidCaseValue_Error", "@@ has an invalid case value").ToString(), Pair.Key);
+				return;
+			}
+			if (Cases.ContainsByPredicate([&Case](const FIntegerCase& Other) { return Other.Value == Case.Value; }))
+			{
+				CompilerContext.MessageLog.Warning(
+					*LOCTEXT("DuplicatedCaseValue_Warning", "@@ has the same value as the previous case").ToString(), Pair.Key);
+				continue;
+			}
+			Case.ValueTerm = Context.NetMap.FindRef(Pair.Key);
+			Case.ExecPin = Pair.Value;
+			check(Case.ValueTerm != nullptr);
+			Cases.Add(Case);
+		}
+		Cases.Sort([](const FIntegerCase& A, const FIntegerCase& B) { return A.Value < B.Value; });
+
+		AppendIntegerDispatchStatements(
+			Context, SwitchExecNode, SelectionTerm, BoolTermMap.FindRef(Node), Cases, SwitchExecNode->GetDefaultExecPin());
+
+		INC_DWORD_STAT(STAT_ACF_NumNodesCompiled);
+		if (TArray<FBlueprintCompiledStatement*>* Statements = Context.StatementsPerNode.Find(Node))
+		{
+			INC_DWORD_STAT_BY(STAT_ACF_NumStatementsEmitted, Statements->Num());
+		}
+		RecordNodeCost(Context, Node);
+	}
+};
+
+UK2Node_SwitchExec::UK2Node_SwitchExec(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	NodeContextMenuSectionName = "K2NodeSwitchExec";
+	NodeContextMenuSectionLabel = LOCTEXT("SwitchExec", "SwitchExec");
+	CaseKeyPinNamePrefix = TEXT("CaseValue");
+	CaseValuePinNamePrefix = TEXT("CaseExec");
+	CaseKeyPinFriendlyNamePrefix = TEXT("Case ");
+	CaseValuePinFriendlyNamePrefix = TEXT(" ");
+}
+
+void UK2Node_SwitchExec::AllocateDefaultPins()
+{
+	// Pin structure
+	//   N: Number of case pin pair
+	// -----
+	// 0: Execution Triggering (In, Exec)
+	// 1: Selection (In, Integer/Enum)
+	// 2: Default Execution (Out, Exec)
+	// 3 - 2+N: Case Value (In, Integer/Enum, Literal only)
+	// 2+N+1 - 2*(N+1): Case Execution (Out, Exec)
+
+	CreateExecTriggeringPin();
+	CreateSelectionPin();
+	CreateDefaultExecPin();
+
+	Super::AllocateDefaultPins();
+}
+
+FText UK2Node_SwitchExec::GetTooltipText() const
+{
+	return LOCTEXT("SwitchExecStatement_Tooltip",
+		"Switch Exec on Integer/Enum\nExecution goes where the case value is equal to the selection\n"
+		"The cases are dispatched by the binary search");
+}
+
+FLinearColor UK2Node_SwitchExec::GetNodeTitleColor() const
+{
+	return GetDefault<UGraphEditorSettings>()->ExecBranchNodeTitleColor;
+}
+
+FText UK2Node_SwitchExec::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("SwitchExecTitle", "Switch Exec on Integer/Enum");
+}
+
+FSlateIcon UK2Node_SwitchExec::GetIconAndTint(FLinearColor& OutColor) const
+{
+	static FSlateIcon Icon("EditorStyle", "GraphEditor.Switch_16x");
+	return Icon;
+}
+
+void UK2Node_SwitchExec::PinConnectionListChanged(UEdGraphPin* Pin)
+{
+	if ((Pin == nullptr) || (Pin != GetSelectionPin()) || (Pin->LinkedTo.Num() == 0))
+	{
+		// Ignore the disconnection event and the other pins.
+		return;
+	}
+
+	if (Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard)
+	{
+		// Pin type has already fixed.
+		return;
+	}
+
+	UEdGraphPin* LinkedPin = Pin->LinkedTo[0];
+	if (LinkedPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+	{
+		return;
+	}
+
+	Super::PinConnectionListChanged(Pin);
+
+	Modify();
+
+	FEdGraphPinType PinType = LinkedPin->PinType;
+	PinType.ContainerType = EPinContainerType::None;
+	PinType.bIsReference = false;
+	Pin->PinType = PinType;
+
+	// Give the unique values to the case value pins.
+	TArray<CasePinPair> CasePinPairs = GetCasePinPairs();
+	for (const CasePinPair& Pair : CasePinPairs)
+	{
+		Pair.Key->PinType = PinType;
+		Pair.Key->DefaultValue.Empty();
+	}
+	for (const CasePinPair& Pair : CasePinPairs)
+	{
+		// Finding the unused value scans all cases, and the old value is restored during the reconstruction.
+		if (!bReallocatingCasePinPairs)
+		{
+			Pair.Key->DefaultValue = GetUnusedCaseValue();
+		}
+	}
+
+	UBlueprint* Blueprint = GetBlueprint();
+	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
+	Blueprint->BroadcastChanged();
+}
+
+void UK2Node_SwitchExec::ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins)
+{
+	UEdGraphPin* OldSelectionPin = nullptr;
+	for (UEdGraphPin* Pin : OldPins)
+	{
+		if (Pin->GetFName() == SelectionPinName)
+		{
+			OldSelectionPin = Pin;
+			break;
+		}
+	}
+
+	CreateExecTriggeringPin();
+	CreateSelectionPin();
+	CreateDefaultExecPin();
+
+	// The type of the case value pins follows the selection pin, so it must be restored first.
+	if (OldSelectionPin != nullptr)
+	{
+		GetSelectionPin()->PinType = OldSelectionPin->PinType;
+	}
+
+	Super::ReallocatePinsDuringReconstruction(OldPins);
+}
+
+class FNodeHandlingFunctor* UK2Node_SwitchExec::CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const
+{
+	return new FKCHandler_SwitchExec(CompilerContext);
+}
+
+void UK2Node_SwitchExec::GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const
+{
+	UClass* ActionKey = GetClass();
+	if (ActionRegistrar.IsOpenForRegistration(ActionKey))
+	{
+		UBlueprintNodeSpawner* NodeSpawner = UBlueprintNodeSpawner::Create(GetClass());
+		check(NodeSpawner != nullptr);
+
+		ActionRegistrar.AddBlueprintAction(ActionKey, NodeSpawner);
+	}
+}
+
+FText UK2Node_SwitchExec::GetMenuCategory() const
+{
+	return FEditorCategoryUtils::GetCommonCategory(FCommonEditorCategory::FlowControl);
+}
+
+bool UK2Node_SwitchExec::IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const
+{
+	if ((MyPin == GetSelectionPin()) && (OtherPin != nullptr) && (OtherPin->PinType.PinCategory != UEdGraphSchema_K2::PC_Int) &&
+		(OtherPin->PinType.PinCategory != UEdGraphSchema_K2::PC_Byte) &&
+		(OtherPin->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard))
+	{
+		OutReason = LOCTEXT("SelectionConnectionDisallowed", "Only Integer, Byte or Enum can be connected.").ToString();
+		return true;
+	}
+	if ((OtherPin != nullptr) && OtherPin->PinType.IsContainer())
+	{
+		OutReason = LOCTEXT("ContainerConnectionDisallowed", "Can't connect with container pin.").ToString();
+		return true;
+	}
+
+	return Super::IsConnectionDisallowed(MyPin, OtherPin, OutReason);
+}
+
+void UK2Node_SwitchExec::CreateExecTriggeringPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 0;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Exec, UEdGraphSchema_K2::PN_Execute, Params);
+}
+
+void UK2Node_SwitchExec::CreateSelectionPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 1;
+	CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, SelectionPinName, Params);
+}
+
+void UK2Node_SwitchExec::CreateDefaultExecPin()
+{
+	FCreatePinParams Params;
+	Params.Index = 2;
+	UEdGraphPin* DefaultExecPin = CreatePin(EGPD_Output, UEdGraphSchema_K2::PC_Exec, DefaultExecPinName, Params);
+	DefaultExecPin->PinFriendlyName = FText::AsCultureInvariant(DefaultExecPinFriendlyName.ToString());
+}
+
+UEdGraphPin* UK2Node_SwitchExec::GetSelectionPin() const
+{
+	return FindPin(SelectionPinName);
+}
+
+UEdGraphPin* UK2Node_SwitchExec::GetDefaultExecPin() const
+{
+	return FindPin(DefaultExecPinName);
+}
+
+CasePinPair UK2Node_SwitchExec::CreateCasePinPair(int32 CaseIndex)
+{
+	CasePinPair Pair;
+	int N = GetCasePinCount();
+	UEdGraphPin* SelectionPin = GetSelectionPin();
+
+	{
+		FCreatePinParams Params;
+		Params.Index = 3 + CaseIndex;
+		Pair.Key = CreatePin(
+			EGPD_Input, UEdGraphSchema_K2::PC_Wildcard, *GetCasePinName(CaseKeyPinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Key->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseKeyPinFriendlyNamePrefix.ToString(), CaseIndex));
+		Pair.Key->PinType = SelectionPin->PinType;
+		// Finding the unused value scans all cases, and the old value is restored during the reconstruction.
+		if (!bReallocatingCasePinPairs)
+		{
+			Pair.Key->DefaultValue = GetUnusedCaseValue();
+		}
+
+		// The case values must be known at compile time.
+		Pair.Key->bNotConnectable = true;
+	}
+	{
+		FCreatePinParams Params;
+		Params.Index = 3 + N + 1 + CaseIndex;
+		Pair.Value = CreatePin(
+			EGPD_Output, UEdGraphSchema_K2::PC_Exec, *GetCasePinName(CaseValuePinNamePrefix.ToString(), CaseIndex), Params);
+		Pair.Value->PinFriendlyName =
+			FText::AsCultureInvariant(GetCasePinFriendlyName(CaseValuePinFriendlyNamePrefix.ToString(), CaseIndex));
+	}
+
+	return Pair;
+}
+
+FString UK2Node_SwitchExec::GetUnusedCaseValue() const
+{
+	const FEdGraphPinType& PinType = GetSelectionPin()->PinType;
+	if (PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+	{
+		return FString();
+	}
+
+	TSet<int64> UsedValues;
+	for (const FCasePinPairEntry& Entry : CasePinPairEntries)
+	{
+		int64 Value;
+		if ((Entry.KeyPin != nullptr) && GetCaseValue(Entry.KeyPin, Value))
+		{
+			UsedValues.Add(Value);
+		}
+	}
+
+	if (UEnum* Enum = Cast<UEnum>(PinType.PinSubCategoryObject.Get()))
+	{
+		const int32 EnumCount = Enum->ContainsExistingMax() ? Enum->NumEnums() - 1 : Enum->NumEnums();
+		for (int32 Index = 0; Index < EnumCount; ++Index)
+		{
+			if (!UsedValues.Contains(Enum->GetValueByIndex(Index)))
+			{
+				return Enum->GetNameStringByIndex(Index);
+			}
+		}
+
+		return (EnumCount > 0) ? Enum->GetNameStringByIndex(0) : FString();
+	}
+
+	int64 MaxValue = -1;
+	for (int64 Value : UsedValues)
+	{
+		MaxValue = FMath::Max(MaxValue, Value);
+	}
+	if (PinType.PinCategory == UEdGraphSchema_K2::PC_Byte)
+	{
+		MaxValue = FMath::Min<int64>(MaxValue, MAX_uint8 - 1);
+	}
+	else
+	{
+		MaxValue = FMath::Min<int64>(MaxValue, MAX_int32 - 1);
+	}
+
+	return LexToString(MaxValue + 1);
+}
+
+bool UK2Node_SwitchExec::GetCaseValue(const UEdGraphPin* CaseKeyPin, int64& OutValue) const
+{
+	const FString& DefaultValue = CaseKeyPin->DefaultValue;
+
+	if (CaseKeyPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Byte)
+	{
+		if (UEnum* Enum = Cast<UEnum>(CaseKeyPin->PinType.PinSubCategoryObject.Get()))
+		{
+			OutValue = Enum->GetValueByNameString(DefaultValue);
+			return OutValue != INDEX_NONE;
+		}
+
+		return ParseIntegerLiteral(DefaultValue, 0, MAX_uint8, OutValue);
+	}
+	else if (CaseKeyPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Int)
+	{
+		return ParseIntegerLiteral(DefaultValue, MIN_int32, MAX_int32, OutValue);
+	}
+
+	return false;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,466 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "K2Node_SwitchStringExec.h"
+
+#include "AdvancedControlFlowStats.h"
+#include "AdvancedControlFlowSwitchLibrary.h"
+#include "EdGraphSchema_K2.h"
+#include "EdGraphUtilities.h"
+#include "KCHandler_CasePairedPinsNode.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Kismet/KismetStringLibrary.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetCompiledFunctionContext.h"
+#include "KismetCompiler.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+// clang-format off
+/*
+	Internal statement structure
+
+	The compiler builds the hash table of the case values, and searches the seed which distributes them most evenly.
+	The seed gives the perfect hash (one case per bucket) for the small number of cases in most cases.
+	The non-empty buckets are dispatched by the binary decision tree as Switch Exec on Integer/Enum, and the case values
+	in the bucket are compared one by one. The selection is hashed only once, and compared with one case value in most
+	cases.
+
+	Example (Buckets: 2 -> "Apple", 5 -> "Banana" and "Cherry")
+
+	       Bucket = GetStringBucket(Selection, Seed, BucketMask, bCaseSensitive)
+	       Bool = EqualEqual(Bucket, 2)
+	       GotoIfNot(Bool) -> Next
+	       Bool = NotEqual(Selection, "Apple")
+	       GotoIfNot(Bool) -> Case "Apple"
+	       Goto Default
+	Next:
+	       Bool = EqualEqual(Bucket, 5)
+	       GotoIfNot(Bool) -> Next'
+	       Bool = NotEqual(Selection, "Banana")
+	       GotoIfNot(Bool) -> Case "Banana"
+	       Bool = NotEqual(Selection, "Cherry")
+	       GotoIfNot(Bool) -> Case "Cherry"
+	       Goto Default
+	Next':
+	       Goto Default
+ */
+// clang-format on
+class FKCHandler_SwitchStringExec : public FKCHandler_CasePairedPinsNode
+{
+	struct FCase
+	{
+		FString Value;
+		FBPTerminal* ValueTerm;
+		UEdGraphPin* ExecPin;
+	};
+
+	struct FBucket
+	{
+		int32 Index;
+		TArray<const FCase*> Cases;
+	};
+
+	// Same as Switch Exec on Integer/Enum.
+	static constexpr int32 MaxLinearBucketCount = 3;
+
+	// The table of the small number of cases has more buckets to find the perfect hash easily.
+	static constexpr int32 MaxSmallCaseCount = 16;
+
+	// The number of the seeds which are tried to build the hash table.
+	static constexpr int32 MaxSeedCount = 256;
+
+	TMap<UEdGraphNode*, FBPTerminal*> BoolTermMap;
+	TMap<UEdGraphNode*, FBPTerminal*> BucketTermMap;
+
+public:
+	FKCHandler_SwitchStringExec(FKismetCompilerContext& InCompilerContext) : FKCHandler_CasePairedPinsNode(InCompilerContext)
+	{
+	}
+
+	virtual void RegisterNets(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		FKCHandler_CasePairedPinsNode::RegisterNets(Context, Node);
+
+		// Result of the comparison. It is consumed by the next statement, so one term is enough for the node.
+		FBPTerminal* BoolTerm = Context.CreateLocalTerminal();
+		BoolTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Boolean;
+		BoolTerm->Source = Node;
+		BoolTerm->Name = Context.NetNameMap->MakeValidName(Node, TEXT("CompareResult"));
+		BoolTermMap.Add(Node, BoolTerm);
+
+		FBPTerminal* BucketTerm = Context.CreateLocalTerminal();
+		BucketTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Int;
+		BucketTerm->Source = Node;
+		BucketTerm->Name = Context.NetNameMap->MakeValidName(Node, TEXT("Bucket"));
+		BucketTermMap.Add(Node, BucketTerm);
+	}
+
+	virtual void Compile(FKismetFunctionContext& Context, UEdGraphNode* Node) override
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ACF_CompileSwitchStringExec);
+		ACF_LLM_SCOPE();
+
+		UK2Node_SwitchStringExec* SwitchStringExecNode = CastChecked<UK2Node_SwitchStringExec>(Node);
+
+		FEdGraphPinType ExpectedExecPinType;
+		ExpectedExecPinType.PinCategory = UEdGraphSchema_K2::PC_Exec;
+
+		{
+			UEdGraphPin* ExecTriggeringPin =
+				Context.FindRequiredPinByName(SwitchStringExecNode, UEdGraphSchema_K2::PN_Execute, EGPD_Input);
+			if ((ExecTriggeringPin == nullptr) || !Context.ValidatePinType(ExecTriggeringPin, ExpectedExecPinType))
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("NoValidExecutionPinForSwitchStringExec_Error", "@@ must have a valid execution pin @@").ToString(),
+					SwitchStringExecNode, ExecTriggeringPin);
+				return;
+			}
+			else if (ExecTriggeringPin->LinkedTo.Num() == 0)
+			{
+				CompilerContext.MessageLog.Warning(
+					*LOCTEXT("NodeNeverExecuted_Warning", "@@ will never be executed").ToString(), SwitchStringExecNode);
+				return;
+			}
+		}
+
+		UEdGraphPin* SelectionPin = SwitchStringExecNode->GetSelectionPin();
+		if (SelectionPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("UndeterminedPinType_Error", "The type of @@ is undetermined").ToString(), SelectionPin);
+			return;
+		}
+		FBPTerminal* SelectionTerm = Context.NetMap.FindRef(FEdGraphUtilities::GetNetFromPin(SelectionPin));
+		if (SelectionTerm == nullptr)
+		{
+			CompilerContext.MessageLog.Error(
+				*LOCTEXT("UnregisteredPin_Error", "Failed to find the term for @@").ToString(), SelectionPin);
+			return;
+		}
+
+		const bool bIsName = (SelectionPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Name);
+		const bool bCaseSensitive = !bIsName && SwitchStringExecNode->bCaseSensitive;
+
+		// The first case wins if some cases have the same value.
+		TArray<FCase> Cases;
+		for (const CasePinPair& Pair : SwitchStringExecNode->GetCasePinPairs())
+		{
+			FCase Case;
+			if (!SwitchStringExecNode->GetCaseString(Pair.Key, Case.Value))
+			{
+				CompilerContext.MessageLog.Error(
+					*LOCTEXT("InvalidCaseValue_Error", "@@ has an invalid case value").ToString(), Pair.Key);
+				return;
+			}
+			if (Cases.ContainsByPredicate(
+					[&Case, bCaseSensitive](const FCase& Other)
+					{
+						return UAdvancedControlFlowSwitchLibrary::EqualCaseValue(
+							*Other.Value, Other.Value.Len(), *Case.Value, Case.Value.Len(), bCaseSensitive);
+					}))
+			{
+				CompilerContext.MessageLog.Warning(
+					*LOCTEXT("DuplicatedCaseValue_Warning", "@@ has the same value as the previous case").ToString(), Pair.Key);
+				continue;
+			}
+			Case.ValueTerm = Context.NetMap.FindRef(Pair.Key);
+			Case.ExecPin = Pair.Value;
+			check(Case.ValueTerm != nullptr);
+			Cases.Add(Case);
+		}
+
+		int32 Seed;
+		int32 BucketCount;
+		TArray<FBucket> Buckets;
+		BuildHashTable(Cases, bCaseSensitive, Seed, BucketCount, Buckets);
+
+		// Bucket = GetStringBucket(Selection, Seed, BucketMask, bCaseSensitive) or GetNameBucket(Selection, Seed, BucketMask)
+		{
+			FBlueprintCompiledStatement& CallFuncStatement = Context.AppendStatementForNode(Node);
+			CallFuncStatement.Type = KCST_CallFunction;
+			CallFuncStatement.FunctionToCall = UAdvancedControlFlowSwitchLibrary::StaticClass()->FindFunctionByName(bIsName
+					? GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowSwitchLibrary, GetNameBucket)
+					: GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowSwitchLibrary, GetStringBucket));
+			CallFuncStatement.FunctionContext = CreateLibraryTerm(Context, Node, UAdvancedControlFlowSwitchLibrary::StaticClass());
+			CallFuncStatement.bIsParentContext = false;
+			CallFuncStatement.LHS = BucketTermMap.FindRef(Node);
+			CallFuncStatement.RHS.Add(SelectionTerm);
+			CallFuncStatement.RHS.Add(CreateLiteralTerm(Context, UEdGraphSchema_K2::PC_Int, FString::FromInt(Seed)));
+			CallFuncStatement.RHS.Add(CreateLiteralTerm(Context, UEdGraphSchema_K2::PC_Int, FString::FromInt(BucketCount - 1)));
+			if (!bIsName)
+			{
+				CallFuncStatement.RHS.Add(
+					CreateLiteralTerm(Context, UEdGraphSchema_K2::PC_Boolean, bCaseSensitive ? TEXT("true") : TEXT("false")));
+			}
+			check(CallFuncStatement.FunctionToCall);
+		}
+
+		// The case values must be folded in the same way as the hash, or the equal values can be in the different buckets.
+		UFunction* NotEqualFunction = bCaseSensitive
+			? UKismetStringLibrary::StaticClass()->FindFunctionByName(
+				  GET_FUNCTION_NAME_CHECKED(UKismetStringLibrary, NotEqual_StrStr))
+			: UAdvancedControlFlowSwitchLibrary::StaticClass()->FindFunctionByName(bIsName
+					  ? GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowSwitchLibrary, NotEqualNameIgnoreCase)
+					  : GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowSwitchLibrary, NotEqualStringIgnoreCase));
+		check(NotEqualFunction);
+
+		AppendDecisionTree(Context, SwitchStringExecNode, SelectionTerm, Buckets, 0, Buckets.Num(), NotEqualFunction);
+
+		INC_DWORD_STAT(STAT_ACF_NumNodesCompiled);
+		if (TArray<FBlueprintCompiledStatement*>* Statements = Context.StatementsPerNode.Find(Node))
+		{
+			INC_DWORD_STAT_BY(STAT_ACF_NumStatementsEmitted, Statements->Num());
+		}
+		RecordNodeCost(Context, Node);
+	}
+
+private:
+	// Search the seed which minimizes the largest bucket, and return the non-empty buckets sorted by the index.
+	void BuildHashTable(
+		const TArray<FCase>& Cases, bool bCaseSensitive, int32& OutSeed, int32& OutBucketCount, TArray<FBucket>& OutBuckets)
+	{
+		const int32 CaseCount = Cases.Num();
+		OutBucketCount = FMath::RoundUpToPowerOfTwo(FMath::Max(CaseCount * ((CaseCount <= MaxSmallCaseCount) ? 4 : 2), 1));
+		const uint32 BucketMask = OutBucketCount - 1;
+
+		TArray<int32> BucketSizes;
+		int32 BestMaxBucketSize = MAX_int32;
+		OutSeed = 0;
+		for (int32 Seed = 0; Seed < MaxSeedCount; ++Seed)
+		{
+			BucketSizes.Reset();
+			BucketSizes.SetNumZeroed(OutBucketCount);
+			int32 MaxBucketSize = 0;
+			for (const FCase& Case : Cases)
+			{
+				const uint32 Hash =
+					UAdvancedControlFlowSwitchLibrary::HashCaseValue(*Case.Value, Case.Value.Len(), Seed, bCaseSensitive);
+				MaxBucketSize = FMath::Max(MaxBucketSize, ++BucketSizes[Hash & BucketMask]);
+			}
+			if (MaxBucketSize < BestMaxBucketSize)
+			{
+				BestMaxBucketSize = MaxBucketSize;
+				OutSeed = Seed;
+			}
+			if (BestMaxBucketSize <= 1)
+			{
+				break;
+			}
+		}
+
+		TMap<int32, FBucket> BucketMap;
+		for (const FCase& Case : Cases)
+		{
+			const int32 Index = static_cast<int32>(
+				UAdvancedControlFlowSwitchLibrary::HashCaseValue(*Case.Value, Case.Value.Len(), OutSeed, bCaseSensitive) &
+				BucketMask);
+			FBucket& Bucket = BucketMap.FindOrAdd(Index);
+			Bucket.Index = Index;
+			Bucket.Cases.Add(&Case);
+		}
+		BucketMap.GenerateValueArray(OutBuckets);
+		OutBuckets.Sort([](const FBucket& A, const FBucket& B) { return A.Index < B.Index; });
+	}
+
+	// Append the statements to dispatch Buckets[Begin, End).
+	void AppendDecisionTree(FKismetFunctionContext& Context, UK2Node_SwitchStringExec* Node, FBPTerminal* SelectionTerm,
+		const TArray<FBucket>& Buckets, int32 Begin, int32 End, UFunction* NotEqualFunction)
+	{
+		FBPTerminal* BucketTerm = BucketTermMap.FindRef(Node);
+		UFunction* EqualFunction =
+			UKismetMathLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, EqualEqual_IntInt));
+		UFunction* LessFunction =
+			UKismetMathLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Less_IntInt));
+		check(EqualFunction && LessFunction);
+
+		if (End - Begin <= MaxLinearBucketCount)
+		{
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				// Goto next bucket if Bucket != Index.
+				FBPTerminal* BucketBoolTerm = AppendCompareStatement(Context, Node, EqualFunction, BucketTerm,
+					CreateLiteralTerm(Context, UEdGraphSchema_K2::PC_Int, FString::FromInt(Buckets[Index].Index)));
+				FBlueprintCompiledStatement& GotoNextStatement = Context.AppendStatementForNode(Node);
+				GotoNextStatement.Type = KCST_GotoIfNot;
+				GotoNextStatement.LHS = BucketBoolTerm;
+
+				// Goto case execution if Selection == Value.
+				for (const FCase* Case : Buckets[Index].Cases)
+				{
+					FBPTerminal* BoolTerm =
+						AppendCompareStatement(Context, Node, NotEqualFunction, SelectionTerm, Case->ValueTerm);
+
+					FBlueprintCompiledStatement& GotoCaseExecStatement = Context.AppendStatementForNode(Node);
+					GotoCaseExecStatement.Type = KCST_GotoIfNot;
+					GotoCaseExecStatement.LHS = BoolTerm;
+					Context.GotoFixupRequestMap.Add(&GotoCaseExecStatement, Case->ExecPin);
+				}
+
+				AppendGotoDefaultStatement(Context, Node);
+				GotoNextStatement.TargetLabel = &AppendJumpTargetStatement(Context, Node);
+			}
+
+			AppendGotoDefaultStatement(Context, Node);
+			return;
+		}
+
+		// Goto upper half if Bucket >= Buckets[Middle].Index.
+		const int32 Middle = (Begin + End) / 2;
+		FBPTerminal* BoolTerm = AppendCompareStatement(Context, Node, LessFunction, BucketTerm,
+			CreateLiteralTerm(Context, UEdGraphSchema_K2::PC_Int, FString::FromInt(Buckets[Middle].Index)));
+		FBlueprintCompiledStatement& GotoUpperStatement = Context.AppendStatementForNode(Node);
+		GotoUpperStatement.Type = KCST_GotoIfNot;
+		GotoUpperStatement.LHS = BoolTerm;
+
+		AppendDecisionTree(Context, Node, SelectionTerm, Buckets, Begin, Middle, NotEqualFunction);
+		GotoUpperStatement.TargetLabel = &AppendJumpTargetStatement(Context, Node);
+		AppendDecisionTree(Context, Node, SelectionTerm, Buckets, Middle, End, NotEqualFunction);
+	}
+
+	void AppendGotoDefaultStatement(FKismetFunctionContext& Context, UK2Node_SwitchStringExec* Node)
+	{
+		FBlueprintCompiledStatement& GotoDefaultStatement = Context.AppendStatementForNode(Node);
+		GotoDefaultStatement.Type = KCST_UnconditionalGoto;
+		Context.GotoFixupRequestMap.Add(&GotoDefaultStatement, Node->GetDefaultExecPin());
+	}
+
+	FBPTerminal* AppendCompareStatement(
+		FKismetFunctionContext& Context, UEdGraphNode* Node, UFunction* Function, FBPTerminal* LhsTerm, FBPTerminal* RhsTerm)
+	{
+		FBPTerminal* BoolTerm = BoolTermMap.FindRef(Node);
+
+		FBlueprintCompiledStatement& CallFuncStatement = Context.AppendStatementForNode(Node);
+		CallFuncStatement.Type = KCST_CallFunction;
+		CallFuncStatement.FunctionToCall = Function;
+		CallFuncStatement.FunctionContext = CreateLibraryTerm(Context, Node, Function->GetOwnerClass());
+		CallFuncStatement.bIsParentContext = false;
+		CallFuncStatement.LHS = BoolTerm;
+		CallFuncStatement.RHS.Add(LhsTerm);
+		CallFuncStatement.RHS.Add(RhsTerm);
+
+		return BoolTerm;
+	}
+
+	// Static functions are called on the class default object.
+	FBPTerminal* CreateLibraryTerm(FKismetFunctionContext& Context, UEdGraphNode* Node, UClass* LibraryClass)
+	{
+		UObject* Library = LibraryClass->GetDefaultObject();
+		FBPTerminal* LibraryTerm = Context.CreateLocalTerminal(ETerminalSpecification::TS_Literal);
+		LibraryTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Object;
+		LibraryTerm->Type.PinSubCategoryObject = LibraryClass;
+		LibraryTerm->Source = Node;
+		LibraryTerm->Name = Library->GetName();
+		LibraryTerm->ObjectLiteral = Library;
+
+		return LibraryTerm;
+	}
+};
+
+UK2Node_SwitchStringExec::UK2Node_SwitchStringExec(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	NodeContextMenuSectionName = "K2NodeSwitchStringExec";
+	NodeContextMenuSectionLabel = LOCTEXT("SwitchStringExec", "SwitchStringExec");
+}
+
+FText UK2Node_SwitchStringExec::GetTooltipText() const
+{
+	return LOCTEXT("SwitchStringExecStatement_Tooltip",
+		"Switch Exec on String/Name\nExecution goes where the case value is equal to the selection\n"
+		"The cases are dispatched by the hash table which is built at compile time");
+}
+
+FText UK2Node_SwitchStringExec::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return LOCTEXT("SwitchStringExecTitle", "Switch Exec on String/Name");
+}
+
+void UK2Node_SwitchStringExec::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// The hash table depends on the property, so the Blueprint must be recompiled.
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(UK2Node_SwitchStringExec, bCaseSensitive))
+	{
+		FBlueprintEditorUtils::MarkBlueprintAsModified(GetBlueprint());
+	}
+}
+
+class FNodeHandlingFunctor* UK2Node_SwitchStringExec::CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const
+{
+	return new FKCHandler_SwitchStringExec(CompilerContext);
+}
+
+bool UK2Node_SwitchStringExec::IsConnectionDisallowed(
+	const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const
+{
+	if ((MyPin == GetSelectionPin()) && (OtherPin != nullptr) &&
+		(OtherPin->PinType.PinCategory != UEdGraphSchema_K2::PC_String) &&
+		(OtherPin->PinType.PinCategory != UEdGraphSchema_K2::PC_Name) &&
+		(OtherPin->PinType.PinCategory != UEdGraphSchema_K2::PC_Wildcard))
+	{
+		OutReason = LOCTEXT("SelectionStringConnectionDisallowed", "Only String or Name can be connected.").ToString();
+		return true;
+	}
+	if ((OtherPin != nullptr) && OtherPin->PinType.IsContainer())
+	{
+		OutReason = LOCTEXT("ContainerConnectionDisallowed", "Can't connect with container pin.").ToString();
+		return true;
+	}
+
+	// Skip the check of the selection type of Switch Exec on Integer/Enum.
+	return UK2Node_CasePairedPinsNode::IsConnectionDisallowed(MyPin, OtherPin, OutReason);
+}
+
+FString UK2Node_SwitchStringExec::GetUnusedCaseValue() const
+{
+	if (GetSelectionPin()->PinType.PinCategory == UEdGraphSchema_K2::PC_Wildcard)
+	{
+		return FString();
+	}
+
+	TSet<FString> UsedValues;
+	for (const FCasePinPairEntry& Entry : CasePinPairEntries)
+	{
+		FString Value;
+		if ((Entry.KeyPin != nullptr) && GetCaseString(Entry.KeyPin, Value))
+		{
+			// TSet<FString> compares the strings without case.
+			UsedValues.Add(Value);
+		}
+	}
+
+	for (int32 Number = UsedValues.Num();; ++Number)
+	{
+		const FString Value = FString::Printf(TEXT("Case%d"), Number);
+		if (!UsedValues.Contains(Value))
+		{
+			return Value;
+		}
+	}
+}
+
+bool UK2Node_SwitchStringExec::GetCaseString(const UEdGraphPin* CaseKeyPin, FString& OutValue) const
+{
+	if (CaseKeyPin->PinType.PinCategory == UEdGraphSchema_K2::PC_String)
+	{
+		OutValue = CaseKeyPin->DefaultValue;
+		return true;
+	}
+	else if (CaseKeyPin->PinType.PinCategory == UEdGraphSchema_K2::PC_Name)
+	{
+		// Same as the literal term of the pin (e.g. the empty value is None).
+		OutValue = FName(*CaseKeyPin->DefaultValue).ToString();
+		return true;
+	}
+
+	return false;
+}
+
+#undef LOCTEXT_NAMESPACE
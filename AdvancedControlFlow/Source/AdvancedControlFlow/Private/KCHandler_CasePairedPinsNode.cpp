@@ -0,0 +1,525 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "KCHandler_CasePairedPinsNode.h"
+
+#include "AdvancedControlFlowCaseHitCounter.h"
+#include "AdvancedControlFlowNodeCostRecorder.h"
+#include "AdvancedControlFlowProfilingLibrary.h"
+#include "AdvancedControlFlowStats.h"
+#include "Algo/StableSort.h"
+#include "EdGraphSchema_K2.h"
+#include "EdGraphUtilities.h"
+#include "HAL/IConsoleManager.h"
+#include "K2Node.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_Knot.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "KismetCompiledFunctionContext.h"
+#include "KismetCompiler.h"
+
+static TAutoConsoleVariable<bool> CVarProfileCaseHits(TEXT("ACF.ProfileCaseHits"), false,
+	TEXT("Compile Multi-Branch and Conditional Sequence with the call to record the hit counts of the cases.\n")
+		TEXT("The hit counts are saved to Saved/AdvancedControlFlow/CaseHitCounts.json when PIE ends or the game exits, and\n")
+		TEXT("can be written to CSV by ACF.DumpCaseHitCounts."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<bool> CVarTraceNodeExecution(TEXT("ACF.TraceNodeExecution"), false,
+	TEXT("Compile Multi-Branch, Conditional Sequence and Multi-Conditional Select with the calls to output the trace\n")
+		TEXT("events of the node execution (node GUID, taken case and elapsed time) to the trace channel \"ACF\"."),
+	ECVF_Default);
+
+FKCHandler_CasePairedPinsNode::FKCHandler_CasePairedPinsNode(FKismetCompilerContext& InCompilerContext)
+	: FNodeHandlingFunctor(InCompilerContext)
+{
+}
+
+void FKCHandler_CasePairedPinsNode::RegisterNets(FKismetFunctionContext& Context, UEdGraphNode* Node)
+{
+	FNodeHandlingFunctor::RegisterNets(Context, Node);
+
+	if (IsNodeTraceEnabled())
+	{
+		FBPTerminal* StartTerm = Context.CreateLocalTerminal();
+		StartTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Int64;
+		StartTerm->Source = Node;
+		StartTerm->Name = Context.NetNameMap->MakeValidName(Node, TEXT("TraceStartCycle"));
+		NodeTraceStartTerms.Add(Node, StartTerm);
+	}
+}
+
+void FKCHandler_CasePairedPinsNode::AnalyzeCaseConditions(
+	FKismetFunctionContext& Context, const TArray<UEdGraphPin*>& CondPins, FCaseConditions& OutConditions)
+{
+	static const FName NotFunctionName = GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Not_PreBool);
+
+	TSet<UEdGraphPin*> CondPinSet(CondPins);
+	TSet<UEdGraphNode*> NegationNodes;
+
+	OutConditions.Conditions.Reset(CondPins.Num());
+	for (UEdGraphPin* CondPin : CondPins)
+	{
+		FCaseCondition& Condition = OutConditions.Conditions.AddDefaulted_GetRef();
+		Condition.Net = FEdGraphUtilities::GetNetFromPin(CondPin);
+		Condition.SourcePin = CondPin;
+
+		// NOT Boolean node can be removed only if its output is not used by the others.
+		UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(Condition.Net->GetOwningNode());
+		UFunction* Function = (CallNode != nullptr) ? CallNode->GetTargetFunction() : nullptr;
+		if ((Function != nullptr) && (Function->GetFName() == NotFunctionName) &&
+			(Function->GetOwnerClass() == UKismetMathLibrary::StaticClass()))
+		{
+			UEdGraphPin* InputPin = CallNode->FindPin(TEXT("A"), EGPD_Input);
+			const bool bOnlyUsedByCondPins = !Condition.Net->LinkedTo.ContainsByPredicate(
+				[&CondPinSet](UEdGraphPin* LinkedPin) { return !CondPinSet.Contains(LinkedPin); });
+			if ((InputPin != nullptr) && bOnlyUsedByCondPins)
+			{
+				UEdGraphPin* InputNet = FEdGraphUtilities::GetNetFromPin(InputPin);
+				if (Context.NetMap.FindRef(InputNet) != nullptr)
+				{
+					Condition.Net = InputNet;
+					Condition.SourcePin = InputPin;
+					Condition.bNegated = true;
+					NegationNodes.Add(CallNode);
+				}
+			}
+		}
+
+		OutConditions.SourcePinsPerNet.FindOrAdd(Condition.Net).AddUnique(Condition.SourcePin);
+	}
+
+	DiscardStatements(Context, NegationNodes.Array());
+	OutConditions.EvaluatedNets.Reset();
+}
+
+FBPTerminal* FKCHandler_CasePairedPinsNode::AppendCaseConditionStatements(
+	FKismetFunctionContext& Context, UEdGraphNode* Node, FCaseConditions& Conditions, int32 CaseIndex)
+{
+	const FCaseCondition& Condition = Conditions.Conditions[CaseIndex];
+	if (!Conditions.EvaluatedNets.Contains(Condition.Net))
+	{
+		Conditions.EvaluatedNets.Add(Condition.Net);
+		AppendLazyStatements(Context, Node, Conditions.SourcePinsPerNet.FindChecked(Condition.Net));
+	}
+
+	return Context.NetMap.FindRef(Condition.Net);
+}
+
+void FKCHandler_CasePairedPinsNode::AppendLazyStatements(FKismetFunctionContext& Context, UEdGraphNode* Node, UEdGraphPin* Pin)
+{
+	AppendLazyStatements(Context, Node, TArray<UEdGraphPin*>({Pin}));
+}
+
+void FKCHandler_CasePairedPinsNode::AppendLazyStatements(
+	FKismetFunctionContext& Context, UEdGraphNode* Node, const TArray<UEdGraphPin*>& Pins)
+{
+	TArray<UEdGraphNode*> LazyNodes;
+	CollectPureNodes(Context, Pins, true, LazyNodes);
+
+	TArray<FBlueprintCompiledStatement*>& NodeStatements = Context.StatementsPerNode.FindOrAdd(Node);
+	for (UEdGraphNode* LazyNode : LazyNodes)
+	{
+		TArray<FBlueprintCompiledStatement*>* LazyNodeStatements = Context.StatementsPerNode.Find(LazyNode);
+		if (LazyNodeStatements == nullptr)
+		{
+			continue;
+		}
+
+		NodeStatements.Append(*LazyNodeStatements);
+		INC_DWORD_STAT_BY(STAT_ACF_NumStatementsInlined, LazyNodeStatements->Num());
+	}
+
+	// The statements are moved, so they must not be prepended to the impure nodes.
+	DiscardStatements(Context, LazyNodes);
+}
+
+void FKCHandler_CasePairedPinsNode::AppendCopiedStatements(FKismetFunctionContext& Context, UEdGraphNode* Node, UEdGraphPin* Pin)
+{
+	TArray<UEdGraphNode*> PureNodes;
+	CollectPureNodes(Context, {Pin}, false, PureNodes);
+
+	TMap<FBlueprintCompiledStatement*, FBlueprintCompiledStatement*> CopiedStatementMap;
+	TArray<FBlueprintCompiledStatement*> CopiedStatements;
+	for (UEdGraphNode* PureNode : PureNodes)
+	{
+		TArray<FBlueprintCompiledStatement*>* PureNodeStatements = Context.StatementsPerNode.Find(PureNode);
+		if (PureNodeStatements == nullptr)
+		{
+			continue;
+		}
+
+		// Copy to the local array at first because the statement list of the pure node may be reallocated.
+		TArray<FBlueprintCompiledStatement*> SourceStatements = *PureNodeStatements;
+		for (FBlueprintCompiledStatement* SourceStatement : SourceStatements)
+		{
+			FBlueprintCompiledStatement& CopiedStatement = Context.AppendStatementForNode(Node);
+			CopiedStatement = *SourceStatement;
+			CopiedStatementMap.Add(SourceStatement, &CopiedStatement);
+			CopiedStatements.Add(&CopiedStatement);
+		}
+		INC_DWORD_STAT_BY(STAT_ACF_NumStatementsInlined, SourceStatements.Num());
+	}
+
+	// Jump targets in the copied statements must also be the copied ones.
+	for (FBlueprintCompiledStatement* CopiedStatement : CopiedStatements)
+	{
+		if (FBlueprintCompiledStatement** TargetLabel = CopiedStatementMap.Find(CopiedStatement->TargetLabel))
+		{
+			CopiedStatement->TargetLabel = *TargetLabel;
+		}
+	}
+}
+
+void FKCHandler_CasePairedPinsNode::AppendIntegerDispatchStatements(FKismetFunctionContext& Context, UEdGraphNode* Node,
+	FBPTerminal* SelectionTerm, FBPTerminal* BoolTerm, TArray<FIntegerCase>& Cases, UEdGraphPin* DefaultExecPin)
+{
+	const FName& PinCategory = SelectionTerm->Type.PinCategory;
+	FName LessFunctionName = GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Less_IntInt);
+	FName NotEqualFunctionName = GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, NotEqual_IntInt);
+	if (PinCategory == UEdGraphSchema_K2::PC_Byte)
+	{
+		LessFunctionName = GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Less_ByteByte);
+		NotEqualFunctionName = GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, NotEqual_ByteByte);
+	}
+	else if (PinCategory == UEdGraphSchema_K2::PC_Int64)
+	{
+		LessFunctionName = GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Less_Int64Int64);
+		NotEqualFunctionName = GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, NotEqual_Int64Int64);
+	}
+	UFunction* LessFunction = UKismetMathLibrary::StaticClass()->FindFunctionByName(LessFunctionName);
+	UFunction* NotEqualFunction = UKismetMathLibrary::StaticClass()->FindFunctionByName(NotEqualFunctionName);
+	check(LessFunction && NotEqualFunction);
+
+	AppendIntegerDecisionTree(
+		Context, Node, SelectionTerm, BoolTerm, Cases, 0, Cases.Num(), DefaultExecPin, LessFunction, NotEqualFunction);
+}
+
+void FKCHandler_CasePairedPinsNode::AppendIntegerDecisionTree(FKismetFunctionContext& Context, UEdGraphNode* Node,
+	FBPTerminal* SelectionTerm, FBPTerminal* BoolTerm, TArray<FIntegerCase>& Cases, int32 Begin, int32 End,
+	UEdGraphPin* DefaultExecPin, UFunction* LessFunction, UFunction* NotEqualFunction)
+{
+	if (End - Begin <= MaxLinearCaseCount)
+	{
+		// Goto case execution if Selection == Value.
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			AppendCallFunctionStatement(Context, Node, NotEqualFunction, {SelectionTerm, Cases[Index].ValueTerm}, BoolTerm);
+
+			FBlueprintCompiledStatement& GotoCaseExecStatement = Context.AppendStatementForNode(Node);
+			GotoCaseExecStatement.Type = KCST_GotoIfNot;
+			GotoCaseExecStatement.LHS = BoolTerm;
+			if (Cases[Index].ExecPin != nullptr)
+			{
+				Context.GotoFixupRequestMap.Add(&GotoCaseExecStatement, Cases[Index].ExecPin);
+			}
+			Cases[Index].GotoStatement = &GotoCaseExecStatement;
+		}
+
+		// Goto default
+		FBlueprintCompiledStatement& GotoDefaultStatement = Context.AppendStatementForNode(Node);
+		GotoDefaultStatement.Type = KCST_UnconditionalGoto;
+		Context.GotoFixupRequestMap.Add(&GotoDefaultStatement, DefaultExecPin);
+		return;
+	}
+
+	// Goto upper half if Selection >= Cases[Middle].Value.
+	const int32 Middle = (Begin + End) / 2;
+	AppendCallFunctionStatement(Context, Node, LessFunction, {SelectionTerm, Cases[Middle].ValueTerm}, BoolTerm);
+	FBlueprintCompiledStatement& GotoUpperStatement = Context.AppendStatementForNode(Node);
+	GotoUpperStatement.Type = KCST_GotoIfNot;
+	GotoUpperStatement.LHS = BoolTerm;
+
+	AppendIntegerDecisionTree(
+		Context, Node, SelectionTerm, BoolTerm, Cases, Begin, Middle, DefaultExecPin, LessFunction, NotEqualFunction);
+	GotoUpperStatement.TargetLabel = &AppendJumpTargetStatement(Context, Node);
+	AppendIntegerDecisionTree(
+		Context, Node, SelectionTerm, BoolTerm, Cases, Middle, End, DefaultExecPin, LessFunction, NotEqualFunction);
+}
+
+void FKCHandler_CasePairedPinsNode::AppendCallFunctionStatement(FKismetFunctionContext& Context, UEdGraphNode* Node,
+	UFunction* Function, const TArray<FBPTerminal*>& Args, FBPTerminal* ReturnValueTerm)
+{
+	// Static functions are called on the class default object.
+	UClass* LibraryClass = Function->GetOwnerClass();
+	FBPTerminal* LibraryTerm = Context.CreateLocalTerminal(ETerminalSpecification::TS_Literal);
+	LibraryTerm->Type.PinCategory = UEdGraphSchema_K2::PC_Object;
+	LibraryTerm->Type.PinSubCategoryObject = LibraryClass;
+	LibraryTerm->ObjectLiteral = LibraryClass->GetDefaultObject();
+	LibraryTerm->Name = LibraryTerm->ObjectLiteral->GetName();
+
+	FBlueprintCompiledStatement& Statement = Context.AppendStatementForNode(Node);
+	Statement.Type = KCST_CallFunction;
+	Statement.FunctionToCall = Function;
+	Statement.FunctionContext = LibraryTerm;
+	Statement.bIsParentContext = false;
+	Statement.LHS = ReturnValueTerm;
+	Statement.RHS = Args;
+}
+
+FBlueprintCompiledStatement& FKCHandler_CasePairedPinsNode::AppendJumpTargetStatement(
+	FKismetFunctionContext& Context, UEdGraphNode* Node)
+{
+	FBlueprintCompiledStatement& Statement = Context.AppendStatementForNode(Node);
+	Statement.Type = KCST_Nop;
+	Statement.bIsJumpTarget = true;
+
+	return Statement;
+}
+
+void FKCHandler_CasePairedPinsNode::CollectPureNodes(FKismetFunctionContext& Context, const TArray<UEdGraphPin*>& Pins,
+	bool bOnlyUsedByPins, TArray<UEdGraphNode*>& OutNodes) const
+{
+	// Collect the pure nodes which the pins depend on.
+	TSet<UEdGraphNode*> Candidates;
+	TArray<UEdGraphPin*> PinsToVisit = Pins;
+	while (PinsToVisit.Num() > 0)
+	{
+		UEdGraphPin* InputPin = PinsToVisit.Pop();
+		for (UEdGraphPin* LinkedPin : InputPin->LinkedTo)
+		{
+			UK2Node* LinkedNode = Cast<UK2Node>(LinkedPin->GetOwningNode());
+			if ((LinkedNode == nullptr) || !LinkedNode->IsNodePure() || Candidates.Contains(LinkedNode))
+			{
+				continue;
+			}
+
+			Candidates.Add(LinkedNode);
+			for (UEdGraphPin* LinkedNodePin : LinkedNode->Pins)
+			{
+				if (LinkedNodePin->Direction == EGPD_Input)
+				{
+					PinsToVisit.Add(LinkedNodePin);
+				}
+			}
+		}
+	}
+
+	// Exclude the nodes whose outputs are used by the others.
+	bool bExcluded = bOnlyUsedByPins;
+	while (bExcluded)
+	{
+		bExcluded = false;
+		for (auto It = Candidates.CreateIterator(); It; ++It)
+		{
+			bool bUsedByOthers = false;
+			for (UEdGraphPin* CandidatePin : (*It)->Pins)
+			{
+				if (CandidatePin->Direction != EGPD_Output)
+				{
+					continue;
+				}
+				for (UEdGraphPin* LinkedPin : CandidatePin->LinkedTo)
+				{
+					if (!Pins.Contains(LinkedPin) && !Candidates.Contains(LinkedPin->GetOwningNode()))
+					{
+						bUsedByOthers = true;
+						break;
+					}
+				}
+				if (bUsedByOthers)
+				{
+					break;
+				}
+			}
+
+			if (bUsedByOthers)
+			{
+				It.RemoveCurrent();
+				bExcluded = true;
+			}
+		}
+	}
+
+	// Keep the order of the statements same as the linear execution list.
+	for (UEdGraphNode* LinearNode : Context.LinearExecutionList)
+	{
+		if (Candidates.Contains(LinearNode))
+		{
+			OutNodes.Add(LinearNode);
+		}
+	}
+}
+
+void FKCHandler_CasePairedPinsNode::DiscardStatements(FKismetFunctionContext& Context, const TArray<UEdGraphNode*>& Nodes)
+{
+	for (UEdGraphNode* Node : Nodes)
+	{
+		if (TArray<FBlueprintCompiledStatement*>* NodeStatements = Context.StatementsPerNode.Find(Node))
+		{
+			NodeStatements->Empty();
+		}
+	}
+}
+
+void FKCHandler_CasePairedPinsNode::DiscardLazyStatements(FKismetFunctionContext& Context, UEdGraphPin* Pin)
+{
+	TArray<UEdGraphNode*> LazyNodes;
+	CollectPureNodes(Context, {Pin}, true, LazyNodes);
+	DiscardStatements(Context, LazyNodes);
+}
+
+bool FKCHandler_CasePairedPinsNode::GetConstantBool(FKismetFunctionContext& Context, UEdGraphPin* Pin, bool& bOutValue) const
+{
+	if ((Pin == nullptr) || (Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Boolean) || Pin->PinType.IsContainer())
+	{
+		return false;
+	}
+
+	if (Pin->LinkedTo.Num() == 0)
+	{
+		FBPTerminal* Term = Context.NetMap.FindRef(FEdGraphUtilities::GetNetFromPin(Pin));
+		if ((Term == nullptr) || !Term->bIsLiteral)
+		{
+			return false;
+		}
+		bOutValue = Term->Name.ToBool();
+		return true;
+	}
+
+	UEdGraphNode* LinkedNode = Pin->LinkedTo[0]->GetOwningNode();
+	if (UK2Node_Knot* KnotNode = Cast<UK2Node_Knot>(LinkedNode))
+	{
+		return GetConstantBool(Context, KnotNode->GetInputPin(), bOutValue);
+	}
+	if (UK2Node_CallFunction* CallNode = Cast<UK2Node_CallFunction>(LinkedNode))
+	{
+		static const FName MakeLiteralBoolFunctionName = GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, MakeLiteralBool);
+		UFunction* Function = CallNode->GetTargetFunction();
+		if ((Function != nullptr) && (Function->GetFName() == MakeLiteralBoolFunctionName) &&
+			(Function->GetOwnerClass() == UKismetSystemLibrary::StaticClass()))
+		{
+			return GetConstantBool(Context, CallNode->FindPin(TEXT("Value"), EGPD_Input), bOutValue);
+		}
+	}
+
+	return false;
+}
+
+bool FKCHandler_CasePairedPinsNode::IsCaseHitProfilingEnabled()
+{
+	return CVarProfileCaseHits.GetValueOnAnyThread();
+}
+
+FString FKCHandler_CasePairedPinsNode::GetCaseHitNodeId(UEdGraphNode* Node) const
+{
+	// The node in the intermediate graph is a copy of the source node.
+	UEdGraphNode* SourceNode = Cast<UEdGraphNode>(CompilerContext.MessageLog.FindSourceObject(Node));
+	if (SourceNode == nullptr)
+	{
+		SourceNode = Node;
+	}
+
+	return SourceNode->NodeGuid.ToString(EGuidFormats::Digits);
+}
+
+void FKCHandler_CasePairedPinsNode::AppendRecordCaseHitStatement(
+	FKismetFunctionContext& Context, UEdGraphNode* Node, const FString& NodeId, int32 CaseIndex, int32 CaseCount)
+{
+	static const FName RecordCaseHitFunctionName =
+		GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowProfilingLibrary, RecordCaseHit);
+
+	AppendProfilingCallStatement(Context, Node, RecordCaseHitFunctionName,
+		{CreateLiteralTerm(Context, UEdGraphSchema_K2::PC_Name, NodeId),
+			CreateLiteralTerm(Context, UEdGraphSchema_K2::PC_Int, FString::FromInt(CaseIndex)),
+			CreateLiteralTerm(Context, UEdGraphSchema_K2::PC_Int, FString::FromInt(CaseCount))});
+}
+
+bool FKCHandler_CasePairedPinsNode::GetCaseOrderByHitCounts(
+	const FString& NodeId, int32 CaseCount, TArray<int32>& OutCaseOrder) const
+{
+	TArray<int64> HitCounts;
+	if (!FAdvancedControlFlowCaseHitCounter::Get().GetHitCounts(NodeId, HitCounts) || (HitCounts.Num() != CaseCount))
+	{
+		return false;
+	}
+
+	OutCaseOrder.Reset(CaseCount);
+	for (int32 CaseIndex = 0; CaseIndex < CaseCount; ++CaseIndex)
+	{
+		OutCaseOrder.Add(CaseIndex);
+	}
+	// Keep the pin order among the cases which have the same hit count.
+	Algo::StableSort(OutCaseOrder, [&HitCounts](int32 A, int32 B) { return HitCounts[A] > HitCounts[B]; });
+
+	return true;
+}
+
+bool FKCHandler_CasePairedPinsNode::IsNodeTraceEnabled() const
+{
+	return bSupportsNodeTrace && CVarTraceNodeExecution.GetValueOnAnyThread();
+}
+
+void FKCHandler_CasePairedPinsNode::AppendBeginNodeTraceStatement(FKismetFunctionContext& Context, UEdGraphNode* Node)
+{
+	static const FName BeginNodeTraceFunctionName =
+		GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowProfilingLibrary, BeginNodeTrace);
+
+	FBPTerminal* StartTerm = NodeTraceStartTerms.FindRef(Node);
+	if (StartTerm == nullptr)
+	{
+		return;
+	}
+
+	AppendProfilingCallStatement(Context, Node, BeginNodeTraceFunctionName, {}, StartTerm);
+}
+
+void FKCHandler_CasePairedPinsNode::AppendEndNodeTraceStatement(
+	FKismetFunctionContext& Context, UEdGraphNode* Node, int32 CaseIndex)
+{
+	static const FName EndNodeTraceFunctionName = GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowProfilingLibrary, EndNodeTrace);
+
+	FBPTerminal* StartTerm = NodeTraceStartTerms.FindRef(Node);
+	if (StartTerm == nullptr)
+	{
+		return;
+	}
+
+	// The GUID of the source node is passed as 4 integers to avoid parsing it at runtime.
+	UEdGraphNode* SourceNode = Cast<UEdGraphNode>(CompilerContext.MessageLog.FindSourceObject(Node));
+	const FGuid& NodeGuid = (SourceNode != nullptr) ? SourceNode->NodeGuid : Node->NodeGuid;
+
+	AppendProfilingCallStatement(Context, Node, EndNodeTraceFunctionName,
+		{CreateLiteralTerm(Context, UEdGraphSchema_K2::PC_Int, FString::FromInt(static_cast<int32>(NodeGuid.A))),
+			CreateLiteralTerm(Context, UEdGraphSchema_K2::PC_Int, FString::FromInt(static_cast<int32>(NodeGuid.B))),
+			CreateLiteralTerm(Context, UEdGraphSchema_K2::PC_Int, FString::FromInt(static_cast<int32>(NodeGuid.C))),
+			CreateLiteralTerm(Context, UEdGraphSchema_K2::PC_Int, FString::FromInt(static_cast<int32>(NodeGuid.D))),
+			CreateLiteralTerm(Context, UEdGraphSchema_K2::PC_Int, FString::FromInt(CaseIndex)), StartTerm});
+}
+
+void FKCHandler_CasePairedPinsNode::RecordNodeCost(FKismetFunctionContext& Context, UEdGraphNode* Node)
+{
+	FAdvancedControlFlowNodeCostRecorder& Recorder = FAdvancedControlFlowNodeCostRecorder::Get();
+	if (Recorder.IsRecording())
+	{
+		Recorder.RecordNode(Context, Node);
+	}
+}
+
+FBPTerminal* FKCHandler_CasePairedPinsNode::CreateLiteralTerm(
+	FKismetFunctionContext& Context, const FName& PinCategory, const FString& Value) const
+{
+	FBPTerminal* Term = Context.CreateLocalTerminal(ETerminalSpecification::TS_Literal);
+	Term->Type.PinCategory = PinCategory;
+	Term->Name = Value;
+
+	return Term;
+}
+
+void FKCHandler_CasePairedPinsNode::AppendProfilingCallStatement(FKismetFunctionContext& Context, UEdGraphNode* Node,
+	const FName& FunctionName, const TArray<FBPTerminal*>& Args, FBPTerminal* ReturnValueTerm)
+{
+	UFunction* Function = UAdvancedControlFlowProfilingLibrary::StaticClass()->FindFunctionByName(FunctionName);
+	if (Function == nullptr)
+	{
+		return;
+	}
+
+	AppendCallFunctionStatement(Context, Node, Function, Args, ReturnValueTerm);
+}
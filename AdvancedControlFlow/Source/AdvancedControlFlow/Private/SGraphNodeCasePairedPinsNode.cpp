@@ -9,12 +9,89 @@
 
 #include "SGraphNodeCasePairedPinsNode.h"
 
+#include "AdvancedControlFlowCaseHitCounter.h"
 #include "DetailLayoutBuilder.h"
+#include "EdGraphSchema_K2.h"
 #include "EditorStyleSet.h"
 #include "GraphEditorSettings.h"
+#include "HAL/IConsoleManager.h"
 #include "K2Node_CasePairedPinsNode.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "KismetPins/SGraphPinExec.h"
+#include "NodeFactory.h"
 #include "ScopedTransaction.h"
+#include "Widgets/Input/SButton.h"
+
+#define LOCTEXT_NAMESPACE "AdvancedControlFlow"
+
+namespace
+{
+TAutoConsoleVariable<int32> CVarCollapseCasePinsThreshold(TEXT("ACF.CollapseCasePinsThreshold"), 32,
+	TEXT("The nodes which have more cases than this number show only the linked cases until \"Show all cases\" is clicked.\n")
+		TEXT("0 or less shows all cases."),
+	ECVF_Default);
+
+bool HasManyCases(const UK2Node_CasePairedPinsNode* Node)
+{
+	const int32 Threshold = CVarCollapseCasePinsThreshold.GetValueOnGameThread();
+	return (Threshold > 0) && (Node->GetCasePinCount() > Threshold);
+}
+}	 // namespace
+
+class SGraphPinExecCaseHitCount : public SGraphPinExec
+{
+public:
+	SLATE_BEGIN_ARGS(SGraphPinExecCaseHitCount)
+	{
+	}
+	SLATE_ATTRIBUTE(FText, HitCountText)
+	SLATE_ATTRIBUTE(FSlateColor, HitCountColor)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, UEdGraphPin* InPin)
+	{
+		HitCountText = InArgs._HitCountText;
+		HitCountColor = InArgs._HitCountColor;
+
+		SGraphPin::Construct(SGraphPin::FArguments(), InPin);
+
+		CachePinIcons();
+	}
+
+protected:
+	virtual TSharedRef<SWidget> GetLabelWidget(const FName& InPinLabelStyle) override
+	{
+		// clang-format off
+		return SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			.Padding(0.0f, 0.0f, 4.0f, 0.0f)
+			[
+				SNew(STextBlock)
+				.Text(HitCountText)
+				.ColorAndOpacity(HitCountColor)
+				.Font(IDetailLayoutBuilder::GetDetailFont())
+				.Visibility(this, &SGraphPinExecCaseHitCount::GetHitCountVisibility)
+			]
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.VAlign(VAlign_Center)
+			[
+				SGraphPinExec::GetLabelWidget(InPinLabelStyle)
+			];
+		// clang-format on
+	}
+
+private:
+	EVisibility GetHitCountVisibility() const
+	{
+		return HitCountText.Get().IsEmpty() ? EVisibility::Collapsed : EVisibility::Visible;
+	}
+
+	TAttribute<FText> HitCountText;
+	TAttribute<FSlateColor> HitCountColor;
+};
 
 void SGraphNodeCasePairedPinsNode::Construct(const FArguments& InArgs, UK2Node_CasePairedPinsNode* InNode)
 {
@@ -23,10 +100,31 @@ void SGraphNodeCasePairedPinsNode::Construct(const FArguments& InArgs, UK2Node_C
 	this->UpdateGraphNode();
 }
 
+void SGraphNodeCasePairedPinsNode::UpdateGraphNode()
+{
+	UpdateCollapsedCasePins();
+
+	SGraphNodeK2Base::UpdateGraphNode();
+}
+
 void SGraphNodeCasePairedPinsNode::CreateOutputSideAddButton(TSharedPtr<SVerticalBox> OutputBox)
 {
 	UK2Node_CasePairedPinsNode* CasePairedPinsNode = CastChecked<UK2Node_CasePairedPinsNode>(GraphNode);
 
+	if (HasManyCases(CasePairedPinsNode))
+	{
+		TSharedRef<SWidget> ToggleButton =
+			SNew(SButton)
+				.ToolTipText(LOCTEXT("ToggleShowAllCasePinsTooltip", "Show/Hide the cases which are not linked"))
+				.OnClicked(this, &SGraphNodeCasePairedPinsNode::OnToggleShowAllCasePins)[SNew(STextBlock)
+						.Font(IDetailLayoutBuilder::GetDetailFont())
+						.Text(this, &SGraphNodeCasePairedPinsNode::GetToggleShowAllCasePinsText)];
+
+		FMargin Padding = Settings->GetOutputPinPadding();
+		Padding.Top += 6.0f;
+		OutputBox->AddSlot().AutoHeight().VAlign(VAlign_Center).HAlign(HAlign_Right).Padding(Padding)[ToggleButton];
+	}
+
 #ifdef ACF_FREE_VERSION
 	if (CasePairedPinsNode->GetCasePinCount() >= 3)
 	{
@@ -69,8 +167,244 @@ FReply SGraphNodeCasePairedPinsNode::OnAddPin()
 	CasePairedPinsNode->AddCasePinLast();
 	FBlueprintEditorUtils::MarkBlueprintAsModified(CasePairedPinsNode->GetBlueprint());
 
+	// Rebuilding only this node is enough because the new pins are not linked.
+	if (!InsertCasePinWidgets(CasePairedPinsNode->GetCasePinCount() - 1))
+	{
+		UpdateGraphNode();
+	}
+
+	return FReply::Handled();
+}
+
+bool SGraphNodeCasePairedPinsNode::IsCasePinCollapsed(const UEdGraphPin* Pin) const
+{
+	return CollapsedCasePins.Contains(Pin);
+}
+
+void SGraphNodeCasePairedPinsNode::UpdateCollapsedCasePins()
+{
+	CollapsedCasePins.Reset();
+	CollapsedCaseCount = 0;
+
+	UK2Node_CasePairedPinsNode* CasePairedPinsNode = CastChecked<UK2Node_CasePairedPinsNode>(GraphNode);
+	if (!HasManyCases(CasePairedPinsNode) || CasePairedPinsNode->bShowAllCasePins)
+	{
+		return;
+	}
+
+	for (const CasePinPair& Pair : CasePairedPinsNode->GetCasePinPairs())
+	{
+		if ((Pair.Key->LinkedTo.Num() == 0) && (Pair.Value->LinkedTo.Num() == 0))
+		{
+			CollapsedCasePins.Add(Pair.Key);
+			CollapsedCasePins.Add(Pair.Value);
+			++CollapsedCaseCount;
+		}
+	}
+}
+
+FReply SGraphNodeCasePairedPinsNode::OnToggleShowAllCasePins()
+{
+	UK2Node_CasePairedPinsNode* CasePairedPinsNode = CastChecked<UK2Node_CasePairedPinsNode>(GraphNode);
+
+	// The flag is saved with the node, so the toggle can be undone as the other edits.
+	const FScopedTransaction Transaction(LOCTEXT("ToggleShowAllCasePinsTransaction", "Toggle Unlinked Cases"));
+	CasePairedPinsNode->Modify();
+	CasePairedPinsNode->bShowAllCasePins = !CasePairedPinsNode->bShowAllCasePins;
+
 	UpdateGraphNode();
-	GraphNode->GetGraph()->NotifyGraphChanged();
 
 	return FReply::Handled();
-}
\ No newline at end of file
+}
+
+FText SGraphNodeCasePairedPinsNode::GetToggleShowAllCasePinsText() const
+{
+	UK2Node_CasePairedPinsNode* CasePairedPinsNode = CastChecked<UK2Node_CasePairedPinsNode>(GraphNode);
+	if (CasePairedPinsNode->bShowAllCasePins)
+	{
+		return LOCTEXT("HideUnlinkedCases", "Hide unlinked cases");
+	}
+
+	return FText::Format(LOCTEXT("ShowAllCases", "Show all cases ({0} hidden)"), FText::AsNumber(CollapsedCaseCount));
+}
+
+bool SGraphNodeCasePairedPinsNode::InsertCasePinWidgets(int32 CaseIndex)
+{
+	UK2Node_CasePairedPinsNode* CasePairedPinsNode = CastChecked<UK2Node_CasePairedPinsNode>(GraphNode);
+	TArray<CasePinPair> CasePairs = CasePairedPinsNode->GetCasePinPairs();
+	if ((CaseIndex <= 0) || (CaseIndex >= CasePairs.Num()))
+	{
+		return false;
+	}
+
+#ifdef ACF_FREE_VERSION
+	// The add pin button is replaced.
+	if (CasePairs.Num() >= 3)
+	{
+		return false;
+	}
+#endif
+
+	if (HasManyCases(CasePairedPinsNode))
+	{
+		// The button to show all cases appears.
+		if (CasePairs.Num() == CVarCollapseCasePinsThreshold.GetValueOnGameThread() + 1)
+		{
+			return false;
+		}
+
+		// The new case is not linked yet.
+		if (!CasePairedPinsNode->bShowAllCasePins)
+		{
+			CollapsedCasePins.Add(CasePairs[CaseIndex].Key);
+			CollapsedCasePins.Add(CasePairs[CaseIndex].Value);
+			++CollapsedCaseCount;
+			return true;
+		}
+	}
+
+	const CasePinPair& PrevPair = CasePairs[CaseIndex - 1];
+	const CasePinPair& Pair = CasePairs[CaseIndex];
+	if (!InsertCasePinWidget(Pair.Key, PrevPair.Key) || !InsertCasePinWidget(Pair.Value, PrevPair.Value))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+bool SGraphNodeCasePairedPinsNode::InsertCasePinWidget(UEdGraphPin* Pin, UEdGraphPin* PrevPin)
+{
+	if (Pin->bHidden)
+	{
+		return true;
+	}
+
+	TSharedPtr<SGraphPin> PrevPinWidget = FindWidgetForPin(PrevPin);
+	if (!PrevPinWidget.IsValid())
+	{
+		return false;
+	}
+
+	const bool bInput = (Pin->Direction == EGPD_Input);
+	TSharedPtr<SVerticalBox> PinBox = bInput ? LeftNodeBox : RightNodeBox;
+	FChildren* Children = PinBox->GetChildren();
+	int32 SlotIndex = INDEX_NONE;
+	for (int32 Index = 0; Index < Children->Num(); ++Index)
+	{
+		if (Children->GetChildAt(Index) == PrevPinWidget.ToSharedRef())
+		{
+			SlotIndex = Index + 1;
+			break;
+		}
+	}
+	if (SlotIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// Same as SGraphNode::AddPin() except for the slot index.
+	TSharedPtr<SGraphPin> NewPin = CreateCasePinWidget(Pin);
+	check(NewPin.IsValid());
+	NewPin->SetOwner(SharedThis(this));
+	if (bInput)
+	{
+		PinBox->InsertSlot(SlotIndex)
+			.AutoHeight()
+			.HAlign(HAlign_Left)
+			.VAlign(VAlign_Center)
+			.Padding(Settings->GetInputPinPadding())[NewPin.ToSharedRef()];
+		InputPins.Add(NewPin.ToSharedRef());
+	}
+	else
+	{
+		PinBox->InsertSlot(SlotIndex)
+			.AutoHeight()
+			.HAlign(HAlign_Right)
+			.VAlign(VAlign_Center)
+			.Padding(Settings->GetOutputPinPadding())[NewPin.ToSharedRef()];
+		OutputPins.Add(NewPin.ToSharedRef());
+	}
+
+	return true;
+}
+
+TSharedPtr<SGraphPin> SGraphNodeCasePairedPinsNode::CreateCasePinWidget(UEdGraphPin* Pin)
+{
+	UK2Node_CasePairedPinsNode* CasePairedPinsNode = CastChecked<UK2Node_CasePairedPinsNode>(GraphNode);
+	if (!bShowCaseHitCounts || (Pin->PinType.PinCategory != UEdGraphSchema_K2::PC_Exec) ||
+		(CasePairedPinsNode->GetCaseKeyPinFromCaseValuePin(Pin) == nullptr))
+	{
+		return FNodeFactory::CreatePinWidget(Pin);
+	}
+
+	// clang-format off
+	return SNew(SGraphPinExecCaseHitCount, Pin)
+		.HitCountText(this, &SGraphNodeCasePairedPinsNode::GetCaseHitCountText, static_cast<const UEdGraphPin*>(Pin))
+		.HitCountColor(this, &SGraphNodeCasePairedPinsNode::GetCaseHitCountColor, static_cast<const UEdGraphPin*>(Pin));
+	// clang-format on
+}
+
+void SGraphNodeCasePairedPinsNode::UpdateCaseHitCounts() const
+{
+	if (CaseHitCountsFrame == GFrameCounter)
+	{
+		return;
+	}
+	CaseHitCountsFrame = GFrameCounter;
+	CaseHitCounts.Reset();
+	LastTakenCasePin = nullptr;
+
+	TArray<int64> HitCounts;
+	int32 LastCaseIndex = INDEX_NONE;
+	const FName NodeId(*GraphNode->NodeGuid.ToString(EGuidFormats::Digits));
+	if (!FAdvancedControlFlowCaseHitCounter::Get().GetSessionHitCounts(NodeId, HitCounts, LastCaseIndex))
+	{
+		return;
+	}
+
+	UK2Node_CasePairedPinsNode* CasePairedPinsNode = CastChecked<UK2Node_CasePairedPinsNode>(GraphNode);
+	const TArray<CasePinPair> CasePairs = CasePairedPinsNode->GetCasePinPairs();
+	for (int32 CaseIndex = 0; (CaseIndex < CasePairs.Num()) && (CaseIndex < HitCounts.Num()); ++CaseIndex)
+	{
+		CaseHitCounts.Add(CasePairs[CaseIndex].Value, HitCounts[CaseIndex]);
+	}
+	if (CasePairs.IsValidIndex(LastCaseIndex))
+	{
+		LastTakenCasePin = CasePairs[LastCaseIndex].Value;
+	}
+}
+
+FText SGraphNodeCasePairedPinsNode::GetCaseHitCountText(const UEdGraphPin* Pin) const
+{
+	UpdateCaseHitCounts();
+
+	const int64* HitCount = CaseHitCounts.Find(Pin);
+	if (HitCount == nullptr)
+	{
+		return FText::GetEmpty();
+	}
+
+	if (Pin == LastTakenCasePin)
+	{
+		return FText::Format(LOCTEXT("LastTakenCaseHitCount", "[{0}, last]"), FText::AsNumber(*HitCount));
+	}
+	return FText::Format(LOCTEXT("CaseHitCount", "[{0}]"), FText::AsNumber(*HitCount));
+}
+
+FSlateColor SGraphNodeCasePairedPinsNode::GetCaseHitCountColor(const UEdGraphPin* Pin) const
+{
+	UpdateCaseHitCounts();
+
+	if (Pin == LastTakenCasePin)
+	{
+		return FSlateColor(FLinearColor(1.0f, 0.8f, 0.2f));
+	}
+	if (const int64* HitCount = CaseHitCounts.Find(Pin))
+	{
+		return (*HitCount > 0) ? FSlateColor(FLinearColor::White) : FSlateColor(FLinearColor(0.5f, 0.5f, 0.5f));
+	}
+	return FSlateColor(FLinearColor::White);
+}
+
+#undef LOCTEXT_NAMESPACE
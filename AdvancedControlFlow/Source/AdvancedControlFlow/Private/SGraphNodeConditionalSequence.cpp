@@ -9,6 +9,7 @@
 
 #include "SGraphNodeConditionalSequence.h"
 
+#include "K2Node_BitmaskConditionalSequence.h"
 #include "K2Node_ConditionalSequence.h"
 #include "KismetPins/SGraphPinExec.h"
 #include "NodeFactory.h"
@@ -32,6 +33,7 @@ public:
 void SGraphNodeConditionalSequence::Construct(const FArguments& InArgs, UK2Node_ConditionalSequence* InNode)
 {
 	this->GraphNode = InNode;
+	this->bShowCaseHitCounts = true;
 	this->SetCursor(EMouseCursor::CardinalCross);
 	this->UpdateGraphNode();
 }
@@ -42,13 +44,18 @@ void SGraphNodeConditionalSequence::CreatePinWidgets()
 	UEdGraphPin* DefaultPin = ConditionalSequence->GetDefaultExecPin();
 
 	RightNodeBox->AddSlot().AutoHeight()[SNew(STextBlock).LineHeightPercentage(2.0f)];
+	if (Cast<UK2Node_BitmaskConditionalSequence>(GraphNode) != nullptr)
+	{
+		// Align the case execution pins with the case bit pins which follow the bitmask pin.
+		RightNodeBox->AddSlot().AutoHeight()[SNew(STextBlock).LineHeightPercentage(2.0f)];
+	}
 
 	for (auto It = GraphNode->Pins.CreateConstIterator(); It; ++It)
 	{
 		UEdGraphPin* Pin = *It;
-		if ((!Pin->bHidden) && (Pin != DefaultPin))
+		if ((!Pin->bHidden) && (Pin != DefaultPin) && !IsCasePinCollapsed(Pin))
 		{
-			TSharedPtr<SGraphPin> NewPin = FNodeFactory::CreatePinWidget(Pin);
+			TSharedPtr<SGraphPin> NewPin = CreateCasePinWidget(Pin);
 			check(NewPin.IsValid());
 
 			this->AddPin(NewPin.ToSharedRef());
@@ -26,7 +26,7 @@ void SGraphNodeMultiConditionalSelect::CreatePinWidgets()
 	for (auto It = GraphNode->Pins.CreateConstIterator(); It; ++It)
 	{
 		UEdGraphPin* Pin = *It;
-		if (!Pin->bHidden)
+		if ((!Pin->bHidden) && !IsCasePinCollapsed(Pin))
 		{
 			TSharedPtr<SGraphPin> NewPin = FNodeFactory::CreatePinWidget(Pin);
 			check(NewPin.IsValid());
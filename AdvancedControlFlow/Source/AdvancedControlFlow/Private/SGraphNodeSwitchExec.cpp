@@ -0,0 +1,77 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "SGraphNodeSwitchExec.h"
+
+#include "K2Node_SwitchExec.h"
+#include "KismetPins/SGraphPinExec.h"
+#include "NodeFactory.h"
+
+class SGraphPinExecSwitchExec : public SGraphPinExec
+{
+public:
+	SLATE_BEGIN_ARGS(SGraphPinExecSwitchExec)
+	{
+	}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, UEdGraphPin* InPin)
+	{
+		SGraphPin::Construct(SGraphPin::FArguments().PinLabelStyle(FName("Graph.Node.DefaultPinName")), InPin);
+
+		CachePinIcons();
+	}
+};
+
+void SGraphNodeSwitchExec::Construct(const FArguments& InArgs, UK2Node_SwitchExec* InNode)
+{
+	this->GraphNode = InNode;
+	this->SetCursor(EMouseCursor::CardinalCross);
+	this->UpdateGraphNode();
+}
+
+void SGraphNodeSwitchExec::CreatePinWidgets()
+{
+	UK2Node_SwitchExec* SwitchExec = CastChecked<UK2Node_SwitchExec>(GraphNode);
+	UEdGraphPin* DefaultPin = SwitchExec->GetDefaultExecPin();
+
+	// Align the case execution pins with the case value pins, which are placed after the execution and selection pins.
+	RightNodeBox->AddSlot().AutoHeight()[SNew(STextBlock).LineHeightPercentage(2.0f)];
+	RightNodeBox->AddSlot().AutoHeight()[SNew(STextBlock).LineHeightPercentage(2.0f)];
+
+	for (auto It = GraphNode->Pins.CreateConstIterator(); It; ++It)
+	{
+		UEdGraphPin* Pin = *It;
+		if ((!Pin->bHidden) && (Pin != DefaultPin) && !IsCasePinCollapsed(Pin))
+		{
+			TSharedPtr<SGraphPin> NewPin = FNodeFactory::CreatePinWidget(Pin);
+			check(NewPin.IsValid());
+
+			this->AddPin(NewPin.ToSharedRef());
+		}
+	}
+
+	if (DefaultPin != nullptr)
+	{
+		RightNodeBox->AddSlot()
+			.AutoHeight()
+			.HAlign(HAlign_Right)
+			.VAlign(VAlign_Center)
+			.Padding(1.0f)[
+#if UE_VERSION_NEWER_THAN(5, 1, 0)
+				SNew(SImage).Image(FAppStyle::GetBrush("Graph.Pin.DefaultPinSeparator"))
+#else
+				SNew(SImage).Image(FEditorStyle::GetBrush("Graph.Pin.DefaultPinSeparator"))
+#endif
+		];
+
+		TSharedPtr<SGraphPin> NewPin = SNew(SGraphPinExecSwitchExec, DefaultPin);
+		this->AddPin(NewPin.ToSharedRef());
+	}
+}
\ No newline at end of file
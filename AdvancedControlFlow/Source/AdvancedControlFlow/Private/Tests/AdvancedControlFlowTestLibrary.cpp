@@ -0,0 +1,33 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowTestLibrary.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+TArray<int32> UAdvancedControlFlowTestLibrary::Records;
+
+bool UAdvancedControlFlowTestLibrary::RecordBool(int32 Id, bool bValue)
+{
+	Records.Add(Id);
+	return bValue;
+}
+
+int32 UAdvancedControlFlowTestLibrary::RecordInt(int32 Id, int32 Value)
+{
+	Records.Add(Id);
+	return Value;
+}
+
+void UAdvancedControlFlowTestLibrary::RecordExec(int32 Id)
+{
+	Records.Add(Id);
+}
+
+#endif
@@ -0,0 +1,41 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "AdvancedControlFlowTestLibrary.generated.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Functions called from the Blueprints built by the automation tests.
+// Each call appends the ID to Records so that the tests can check which nodes are executed and in which order.
+UCLASS()
+class UAdvancedControlFlowTestLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Used as the pure node which computes the condition.
+	UFUNCTION(BlueprintPure, Category = "AdvancedControlFlow|Test", meta = (BlueprintInternalUseOnly = "true"))
+	static bool RecordBool(int32 Id, bool bValue);
+
+	// Used as the pure node which computes the option.
+	UFUNCTION(BlueprintPure, Category = "AdvancedControlFlow|Test", meta = (BlueprintInternalUseOnly = "true"))
+	static int32 RecordInt(int32 Id, int32 Value);
+
+	// Used as the body of the cases.
+	UFUNCTION(BlueprintCallable, Category = "AdvancedControlFlow|Test", meta = (BlueprintInternalUseOnly = "true"))
+	static void RecordExec(int32 Id);
+
+	static TArray<int32> Records;
+};
+
+#endif
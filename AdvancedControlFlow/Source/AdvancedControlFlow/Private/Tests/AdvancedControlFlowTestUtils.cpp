@@ -0,0 +1,208 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AdvancedControlFlowTestLibrary.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_FunctionEntry.h"
+#include "K2Node_FunctionResult.h"
+#include "K2Node_MultiBranch.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "UObject/Script.h"
+
+const FName FAdvancedControlFlowTestBlueprint::TestFunctionName(TEXT("Test"));
+const FName FAdvancedControlFlowTestBlueprint::InputParamName(TEXT("Input"));
+const FName FAdvancedControlFlowTestBlueprint::ReturnValueParamName(TEXT("ReturnValue"));
+
+FAdvancedControlFlowTestBlueprint::FAdvancedControlFlowTestBlueprint(const FString& BaseName)
+{
+	Blueprint = FAdvancedControlFlowBenchmarkUtils::CreateTransientBlueprint(BaseName);
+	Graph = FAdvancedControlFlowBenchmarkUtils::AddFunctionGraph(Blueprint, TestFunctionName, EntryNode, ResultNode);
+}
+
+FAdvancedControlFlowTestBlueprint::~FAdvancedControlFlowTestBlueprint()
+{
+	FAdvancedControlFlowBenchmarkUtils::DiscardBlueprint(Blueprint);
+}
+
+UBlueprint* FAdvancedControlFlowTestBlueprint::GetBlueprint() const
+{
+	return Blueprint;
+}
+
+UEdGraph* FAdvancedControlFlowTestBlueprint::GetGraph() const
+{
+	return Graph;
+}
+
+UEdGraphPin* FAdvancedControlFlowTestBlueprint::GetEntryThenPin() const
+{
+	return EntryNode->FindPinChecked(UEdGraphSchema_K2::PN_Then);
+}
+
+UEdGraphPin* FAdvancedControlFlowTestBlueprint::GetResultExecPin() const
+{
+	return ResultNode->GetExecPin();
+}
+
+UEdGraphPin* FAdvancedControlFlowTestBlueprint::AddInput(const FEdGraphPinType& PinType)
+{
+	return EntryNode->CreateUserDefinedPin(InputParamName, PinType, EGPD_Output);
+}
+
+UEdGraphPin* FAdvancedControlFlowTestBlueprint::AddReturnValue(const FEdGraphPinType& PinType)
+{
+	return ResultNode->CreateUserDefinedPin(ReturnValueParamName, PinType, EGPD_Input);
+}
+
+UEdGraphPin* FAdvancedControlFlowTestBlueprint::SpawnRecordBool(int32 Id, bool bValue)
+{
+	UK2Node_CallFunction* Node = FAdvancedControlFlowBenchmarkUtils::SpawnCallFunctionNode(Graph,
+		UAdvancedControlFlowTestLibrary::StaticClass(), GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowTestLibrary, RecordBool));
+	SetDefaultValue(Node->FindPinChecked(TEXT("Id")), FString::FromInt(Id));
+	SetDefaultValue(Node->FindPinChecked(TEXT("bValue")), bValue ? TEXT("true") : TEXT("false"));
+
+	return Node->GetReturnValuePin();
+}
+
+UEdGraphPin* FAdvancedControlFlowTestBlueprint::SpawnRecordInt(int32 Id, int32 Value)
+{
+	UK2Node_CallFunction* Node = FAdvancedControlFlowBenchmarkUtils::SpawnCallFunctionNode(Graph,
+		UAdvancedControlFlowTestLibrary::StaticClass(), GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowTestLibrary, RecordInt));
+	SetDefaultValue(Node->FindPinChecked(TEXT("Id")), FString::FromInt(Id));
+	SetDefaultValue(Node->FindPinChecked(TEXT("Value")), FString::FromInt(Value));
+
+	return Node->GetReturnValuePin();
+}
+
+UEdGraphPin* FAdvancedControlFlowTestBlueprint::SpawnRecordExec(int32 Id)
+{
+	UK2Node_CallFunction* Node = FAdvancedControlFlowBenchmarkUtils::SpawnCallFunctionNode(Graph,
+		UAdvancedControlFlowTestLibrary::StaticClass(), GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowTestLibrary, RecordExec));
+	SetDefaultValue(Node->FindPinChecked(TEXT("Id")), FString::FromInt(Id));
+
+	return Node->GetExecPin();
+}
+
+UEdGraphPin* FAdvancedControlFlowTestBlueprint::SpawnNot(UEdGraphPin* Pin)
+{
+	UK2Node_CallFunction* Node = FAdvancedControlFlowBenchmarkUtils::SpawnCallFunctionNode(
+		Graph, UKismetMathLibrary::StaticClass(), GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Not_PreBool));
+	Link(Pin, Node->FindPinChecked(TEXT("A")));
+
+	return Node->GetReturnValuePin();
+}
+
+UK2Node_MultiBranch* FAdvancedControlFlowTestBlueprint::SpawnMultiBranch(int32 CaseCount)
+{
+	UK2Node_MultiBranch* Node = SpawnNode<UK2Node_MultiBranch>();
+	Node->SetCasePinCount(CaseCount);
+	Link(GetEntryThenPin(), Node->GetExecPin());
+
+	const TArray<CasePinPair> CasePairs = Node->GetCasePinPairs();
+	for (int32 CaseIndex = 0; CaseIndex < CasePairs.Num(); ++CaseIndex)
+	{
+		Link(CasePairs[CaseIndex].Value, SpawnRecordExec(10 + CaseIndex));
+	}
+	Link(Node->GetDefaultExecPin(), SpawnRecordExec(99));
+
+	return Node;
+}
+
+bool FAdvancedControlFlowTestBlueprint::Link(UEdGraphPin* OutputPin, UEdGraphPin* InputPin) const
+{
+	return GetDefault<UEdGraphSchema_K2>()->TryCreateConnection(OutputPin, InputPin);
+}
+
+void FAdvancedControlFlowTestBlueprint::SetDefaultValue(UEdGraphPin* Pin, const FString& Value) const
+{
+	GetDefault<UEdGraphSchema_K2>()->TrySetDefaultValue(*Pin, Value);
+}
+
+bool FAdvancedControlFlowTestBlueprint::Compile()
+{
+	FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::SkipGarbageCollection, &Results);
+
+	return Blueprint->Status != BS_Error;
+}
+
+const FCompilerResultsLog& FAdvancedControlFlowTestBlueprint::GetResults() const
+{
+	return Results;
+}
+
+int32 FAdvancedControlFlowTestBlueprint::CountMessages(EMessageSeverity::Type Severity, const FString& Text) const
+{
+	int32 Count = 0;
+	for (const TSharedRef<FTokenizedMessage>& Message : Results.Messages)
+	{
+		if ((Message->GetSeverity() == Severity) && Message->ToText().ToString().Contains(Text))
+		{
+			++Count;
+		}
+	}
+
+	return Count;
+}
+
+FString FAdvancedControlFlowTestBlueprint::Run()
+{
+	return RunFunction(nullptr, nullptr);
+}
+
+FString FAdvancedControlFlowTestBlueprint::RunFunction(const void* Input, void* OutReturnValue)
+{
+	UAdvancedControlFlowTestLibrary::Records.Reset();
+
+	UFunction* Function =
+		(Blueprint->GeneratedClass != nullptr) ? Blueprint->GeneratedClass->FindFunctionByName(TestFunctionName) : nullptr;
+	if (Function == nullptr)
+	{
+		return TEXT("Not compiled");
+	}
+
+	// Call the function in the same way as the functional tests (ProcessEvent with the parameter buffer).
+	UObject* Object = NewObject<UObject>(GetTransientPackage(), Blueprint->GeneratedClass);
+	uint8* Params = static_cast<uint8*>(FMemory::Malloc(FMath::Max(Function->ParmsSize, 1), Function->GetMinAlignment()));
+	Function->InitializeStruct(Params);
+	FProperty* InputProperty = Function->FindPropertyByName(InputParamName);
+	if ((Input != nullptr) && (InputProperty != nullptr))
+	{
+		InputProperty->CopyCompleteValue(InputProperty->ContainerPtrToValuePtr<void>(Params), Input);
+	}
+
+	{
+		FEditorScriptExecutionGuard ScriptGuard;
+		Object->ProcessEvent(Function, Params);
+	}
+
+	FProperty* ReturnValueProperty = Function->FindPropertyByName(ReturnValueParamName);
+	if ((OutReturnValue != nullptr) && (ReturnValueProperty != nullptr))
+	{
+		ReturnValueProperty->CopyCompleteValue(OutReturnValue, ReturnValueProperty->ContainerPtrToValuePtr<void>(Params));
+	}
+	Function->DestroyStruct(Params);
+	FMemory::Free(Params);
+
+	TArray<FString> Records;
+	for (int32 Id : UAdvancedControlFlowTestLibrary::Records)
+	{
+		Records.Add(FString::FromInt(Id));
+	}
+
+	return FString::Join(Records, TEXT(","));
+}
+
+#endif
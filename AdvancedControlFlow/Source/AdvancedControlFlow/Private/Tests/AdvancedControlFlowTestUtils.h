@@ -0,0 +1,106 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AdvancedControlFlowBenchmarkUtils.h"
+#include "Kismet2/CompilerResultsLog.h"
+
+class UBlueprint;
+class UK2Node_FunctionEntry;
+class UK2Node_FunctionResult;
+class UK2Node_MultiBranch;
+
+// Blueprint which has the function "Test" to be built and run by the automation tests.
+// The Blueprint is discarded when this object is destroyed.
+class FAdvancedControlFlowTestBlueprint
+{
+public:
+	static const FName TestFunctionName;
+	static const FName InputParamName;
+	static const FName ReturnValueParamName;
+
+	explicit FAdvancedControlFlowTestBlueprint(const FString& BaseName);
+	~FAdvancedControlFlowTestBlueprint();
+
+	UBlueprint* GetBlueprint() const;
+	UEdGraph* GetGraph() const;
+	UEdGraphPin* GetEntryThenPin() const;
+	UEdGraphPin* GetResultExecPin() const;
+
+	// Add the parameter "Input" to the function, and return the pin on the function entry.
+	UEdGraphPin* AddInput(const FEdGraphPinType& PinType);
+
+	// Add the return value to the function, and return the pin on the function result.
+	UEdGraphPin* AddReturnValue(const FEdGraphPinType& PinType);
+
+	template <typename NodeType>
+	NodeType* SpawnNode()
+	{
+		return FAdvancedControlFlowBenchmarkUtils::SpawnNode<NodeType>(Graph);
+	}
+
+	// Spawn the nodes of UAdvancedControlFlowTestLibrary, and return the return value pin (RecordBool, RecordInt) or the
+	// execution pin (RecordExec).
+	UEdGraphPin* SpawnRecordBool(int32 Id, bool bValue);
+	UEdGraphPin* SpawnRecordInt(int32 Id, int32 Value);
+	UEdGraphPin* SpawnRecordExec(int32 Id);
+
+	// Spawn NOT Boolean whose input is linked to the pin, and return the return value pin.
+	UEdGraphPin* SpawnNot(UEdGraphPin* Pin);
+
+	// Spawn Multi-Branch executed from the function entry. The condition pins are left unlinked.
+	//   Entry -> Multi-Branch -[Case N]-> RecordExec(10 + N)
+	//                         -[Default]-> RecordExec(99)
+	UK2Node_MultiBranch* SpawnMultiBranch(int32 CaseCount);
+
+	bool Link(UEdGraphPin* OutputPin, UEdGraphPin* InputPin) const;
+	void SetDefaultValue(UEdGraphPin* Pin, const FString& Value) const;
+
+	// Return false if the compilation fails.
+	bool Compile();
+	const FCompilerResultsLog& GetResults() const;
+
+	// Count the compiler messages which contain the text.
+	int32 CountMessages(EMessageSeverity::Type Severity, const FString& Text) const;
+
+	// Call the function, and return the IDs recorded by UAdvancedControlFlowTestLibrary (e.g. "1,2,10").
+	// Input and OutReturnValue must have the same type as the parameters.
+	FString Run();
+	template <typename InputType>
+	FString Run(const InputType& Input)
+	{
+		return RunFunction(&Input, nullptr);
+	}
+	template <typename InputType, typename ReturnValueType>
+	FString Run(const InputType& Input, ReturnValueType& OutReturnValue)
+	{
+		return RunFunction(&Input, &OutReturnValue);
+	}
+	template <typename ReturnValueType>
+	FString RunWithReturnValue(ReturnValueType& OutReturnValue)
+	{
+		return RunFunction(nullptr, &OutReturnValue);
+	}
+
+private:
+	FString RunFunction(const void* Input, void* OutReturnValue);
+
+	UBlueprint* Blueprint = nullptr;
+	UEdGraph* Graph = nullptr;
+	UK2Node_FunctionEntry* EntryNode = nullptr;
+	UK2Node_FunctionResult* ResultNode = nullptr;
+	FCompilerResultsLog Results;
+};
+
+#endif
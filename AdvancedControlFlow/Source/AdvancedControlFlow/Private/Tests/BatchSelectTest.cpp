@@ -0,0 +1,297 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowBatchLibrary.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/KismetStringLibrary.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBatchSelectLaneRemainderTest, "AdvancedControlFlow.Runtime.BatchSelect.LaneRemainder",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBatchSelectParallelChunkTest, "AdvancedControlFlow.Runtime.BatchSelect.ParallelChunk",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBatchSelectMismatchedLengthTest, "AdvancedControlFlow.Runtime.BatchSelect.MismatchedLength",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBatchSelectNonPlainOldDataTest, "AdvancedControlFlow.Runtime.BatchSelect.NonPlainOldData",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+namespace
+{
+// Same as AdvancedControlFlowBatchLibrary.cpp.
+const int32 BatchSelectChunkSize = 4096;
+
+// Set ACF.BatchSelectParallelThreshold while the object is alive.
+class FScopedParallelThreshold
+{
+public:
+	explicit FScopedParallelThreshold(int32 Threshold)
+		: Variable(IConsoleManager::Get().FindConsoleVariable(TEXT("ACF.BatchSelectParallelThreshold")))
+	{
+		check(Variable != nullptr);
+		OldThreshold = Variable->GetInt();
+		Variable->Set(Threshold, ECVF_SetByCode);
+	}
+
+	~FScopedParallelThreshold()
+	{
+		Variable->Set(OldThreshold, ECVF_SetByCode);
+	}
+
+private:
+	IConsoleVariable* Variable;
+	int32 OldThreshold = 0;
+};
+
+// The parameters of the native functions are used as the array properties of the elements.
+//   Integer: Result of OverwriteSelectedElements, String: SourceArray of JoinStringArray
+const FArrayProperty* FindArrayProperty(UClass* Class, const FName& FunctionName, const FName& ParamName)
+{
+	UFunction* Function = Class->FindFunctionByName(FunctionName);
+	return (Function != nullptr) ? CastField<FArrayProperty>(Function->FindPropertyByName(ParamName)) : nullptr;
+}
+
+const FArrayProperty* GetIntArrayProperty()
+{
+	return FindArrayProperty(UAdvancedControlFlowBatchLibrary::StaticClass(),
+		GET_FUNCTION_NAME_CHECKED(UAdvancedControlFlowBatchLibrary, OverwriteSelectedElements), TEXT("Result"));
+}
+
+const FArrayProperty* GetStringArrayProperty()
+{
+	return FindArrayProperty(UKismetStringLibrary::StaticClass(),
+		GET_FUNCTION_NAME_CHECKED(UKismetStringLibrary, JoinStringArray), TEXT("SourceArray"));
+}
+
+template <typename ElementType>
+void OverwriteSelectedElements(const FArrayProperty* Property, TArray<ElementType>& Result, const TArray<bool>& Conditions,
+	const TArray<ElementType>& Options)
+{
+	UAdvancedControlFlowBatchLibrary::GenericOverwriteSelectedElements(&Result, Property, Conditions, &Options, Property);
+}
+
+// The result which is computed one by one.
+template <typename ElementType>
+TArray<ElementType> OverwriteSelectedElementsReference(
+	const TArray<ElementType>& Result, const TArray<bool>& Conditions, const TArray<ElementType>& Options)
+{
+	TArray<ElementType> Expected = Result;
+	const int32 Count = FMath::Min3(Result.Num(), Conditions.Num(), Options.Num());
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		if (Conditions[Index])
+		{
+			Expected[Index] = Options[Index];
+		}
+	}
+	return Expected;
+}
+
+// The lanes of 8 conditions are all false, all true, random or mixed in turn.
+TArray<bool> MakeConditions(int32 Count, int32 Seed)
+{
+	FRandomStream Random(Seed);
+	TArray<bool> Conditions;
+	Conditions.SetNumUninitialized(Count);
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		switch ((Index / 8) % 4)
+		{
+			case 0:
+				Conditions[Index] = false;
+				break;
+			case 1:
+				Conditions[Index] = true;
+				break;
+			case 2:
+				Conditions[Index] = Random.RandRange(0, 1) == 1;
+				break;
+			default:
+				Conditions[Index] = (Index % 3) == 0;
+				break;
+		}
+	}
+	return Conditions;
+}
+
+TArray<int32> MakeIntArray(int32 Count, int32 Base)
+{
+	TArray<int32> Array;
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		Array.Add(Base + Index);
+	}
+	return Array;
+}
+
+TArray<FString> MakeStringArray(int32 Count, const TCHAR* Prefix)
+{
+	TArray<FString> Array;
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		// Long enough not to be stored inline.
+		Array.Add(FString::Printf(TEXT("%s_%d_0123456789abcdef"), Prefix, Index));
+	}
+	return Array;
+}
+}	 // namespace
+
+bool FBatchSelectLaneRemainderTest::RunTest(const FString& Parameters)
+{
+	// The elements after the last full lane of 8 conditions are tested one by one.
+	const FArrayProperty* Property = GetIntArrayProperty();
+	if (!TestNotNull(TEXT("The array property should be found"), Property))
+	{
+		return false;
+	}
+
+	for (int32 Count : {0, 1, 7, 8, 9, 15, 16, 17, 31, 33, 63, 65, 100})
+	{
+		for (int32 Seed = 0; Seed < 4; ++Seed)
+		{
+			// Shift the pattern so that the all false/true lanes also come at the end.
+			TArray<bool> Conditions = MakeConditions(Count + Seed * 8, Seed);
+			Conditions.RemoveAt(0, Seed * 8);
+
+			TArray<int32> Result = MakeIntArray(Count, 0);
+			const TArray<int32> Options = MakeIntArray(Count, 1000);
+			const TArray<int32> Expected = OverwriteSelectedElementsReference(Result, Conditions, Options);
+			OverwriteSelectedElements(Property, Result, Conditions, Options);
+			TestTrue(FString::Printf(TEXT("%d elements (seed %d) should be selected"), Count, Seed), Result == Expected);
+		}
+	}
+
+	return true;
+}
+
+bool FBatchSelectParallelChunkTest::RunTest(const FString& Parameters)
+{
+	const FArrayProperty* Property = GetIntArrayProperty();
+	if (!TestNotNull(TEXT("The array property should be found"), Property))
+	{
+		return false;
+	}
+
+	// Split every array into the tasks. The last chunk is not full and not a multiple of 8.
+	FScopedParallelThreshold ScopedThreshold(1);
+	for (int32 Count : {BatchSelectChunkSize - 1, BatchSelectChunkSize, BatchSelectChunkSize + 1, BatchSelectChunkSize * 3 + 5})
+	{
+		TArray<bool> Conditions = MakeConditions(Count, Count);
+		// The elements next to the chunk boundaries are selected, and the others in the same lane are not.
+		for (int32 Boundary = BatchSelectChunkSize; Boundary < Count; Boundary += BatchSelectChunkSize)
+		{
+			for (int32 Index = Boundary - 8; Index < FMath::Min(Boundary + 8, Count); ++Index)
+			{
+				Conditions[Index] = (Index == Boundary - 1) || (Index == Boundary);
+			}
+		}
+
+		TArray<int32> Result = MakeIntArray(Count, 0);
+		const TArray<int32> Options = MakeIntArray(Count, 100000);
+		const TArray<int32> Expected = OverwriteSelectedElementsReference(Result, Conditions, Options);
+		OverwriteSelectedElements(Property, Result, Conditions, Options);
+		TestTrue(FString::Printf(TEXT("%d elements should be selected across the chunks"), Count), Result == Expected);
+	}
+
+	return true;
+}
+
+bool FBatchSelectMismatchedLengthTest::RunTest(const FString& Parameters)
+{
+	// The elements beyond the shortest array are not changed, and the length of Result is kept.
+	const FArrayProperty* Property = GetIntArrayProperty();
+	if (!TestNotNull(TEXT("The array property should be found"), Property))
+	{
+		return false;
+	}
+
+	struct FLengths
+	{
+		int32 Result;
+		int32 Conditions;
+		int32 Options;
+	};
+	const TArray<FLengths> LengthSets = {
+		{20, 13, 17},
+		{20, 17, 13},
+		{5, 20, 20},
+		{20, 0, 20},
+		{20, 20, 0},
+		{0, 20, 20},
+		{BatchSelectChunkSize * 2 + 3, BatchSelectChunkSize + 9, BatchSelectChunkSize * 2 + 3},
+	};
+	for (int32 Threshold : {0, 1})
+	{
+		FScopedParallelThreshold ScopedThreshold(Threshold);
+		for (const FLengths& Lengths : LengthSets)
+		{
+			TArray<bool> Conditions;
+			Conditions.Init(true, Lengths.Conditions);
+			TArray<int32> Result = MakeIntArray(Lengths.Result, 0);
+			const TArray<int32> Options = MakeIntArray(Lengths.Options, 100000);
+			const TArray<int32> Expected = OverwriteSelectedElementsReference(Result, Conditions, Options);
+			OverwriteSelectedElements(Property, Result, Conditions, Options);
+			TestTrue(FString::Printf(TEXT("Threshold %d: Result %d, Conditions %d, Options %d"), Threshold, Lengths.Result,
+						 Lengths.Conditions, Lengths.Options),
+				Result == Expected);
+		}
+	}
+
+	// The options of the other type are ignored.
+	const FArrayProperty* StringProperty = GetStringArrayProperty();
+	if (TestNotNull(TEXT("The string array property should be found"), StringProperty))
+	{
+		TArray<bool> Conditions;
+		Conditions.Init(true, 4);
+		TArray<int32> Result = MakeIntArray(4, 0);
+		const TArray<FString> Options = MakeStringArray(4, TEXT("Option"));
+		UAdvancedControlFlowBatchLibrary::GenericOverwriteSelectedElements(
+			&Result, Property, Conditions, &Options, StringProperty);
+		TestTrue(TEXT("The options of the other type should not be selected"), Result == MakeIntArray(4, 0));
+	}
+
+	return true;
+}
+
+bool FBatchSelectNonPlainOldDataTest::RunTest(const FString& Parameters)
+{
+	// The strings are copied by the property on the caller even if the number of the elements is over the threshold.
+	const FArrayProperty* Property = GetStringArrayProperty();
+	if (!TestNotNull(TEXT("The string array property should be found"), Property))
+	{
+		return false;
+	}
+
+	FScopedParallelThreshold ScopedThreshold(1);
+	for (int32 Count : {9, BatchSelectChunkSize + 1})
+	{
+		const TArray<bool> Conditions = MakeConditions(Count, Count);
+		TArray<FString> Result = MakeStringArray(Count, TEXT("Result"));
+		const TArray<FString> Options = MakeStringArray(Count, TEXT("Option"));
+		const TArray<FString> Expected = OverwriteSelectedElementsReference(Result, Conditions, Options);
+		OverwriteSelectedElements(Property, Result, Conditions, Options);
+		TestTrue(FString::Printf(TEXT("%d strings should be selected"), Count), Result == Expected);
+		TestTrue(
+			FString::Printf(TEXT("%d options should not be moved"), Count), Options == MakeStringArray(Count, TEXT("Option")));
+
+		// The selected string must be the copy, not the shared buffer of the option.
+		const int32 SelectedIndex = Conditions.Find(true);
+		if (TestTrue(TEXT("Some elements should be selected"), SelectedIndex != INDEX_NONE))
+		{
+			TestTrue(TEXT("The selected string should have its own buffer"),
+				*Result[SelectedIndex] != *Options[SelectedIndex]);
+		}
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,237 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowTestUtils.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_BitmaskConditionalSequence.h"
+#include "K2Node_BitmaskMultiBranch.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBitmaskMultiBranchBitOrderTest, "AdvancedControlFlow.Compiler.BitmaskMultiBranch.BitOrder",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBitmaskMultiBranchBitBoundaryTest,
+	"AdvancedControlFlow.Compiler.BitmaskMultiBranch.BitBoundary",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBitmaskConditionalSequenceBitOrderTest,
+	"AdvancedControlFlow.Compiler.BitmaskConditionalSequence.BitOrder",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBitmaskConditionalSequenceBitBoundaryTest,
+	"AdvancedControlFlow.Compiler.BitmaskConditionalSequence.BitBoundary",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBitmaskDefaultCaseBitTest, "AdvancedControlFlow.Editor.Bitmask.DefaultCaseBit",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+namespace
+{
+// Entry -> Bitmask Multi-Branch/Conditional Sequence (Bitmask: Input) -[Case N]-> RecordExec(10 + N)
+//                                                                     -[Default]-> RecordExec(99)
+template <typename NodeType>
+NodeType* SpawnBitmaskNode(FAdvancedControlFlowTestBlueprint& Blueprint, const FName& PinCategory, const TArray<int32>& CaseBits)
+{
+	UEdGraphPin* InputPin = Blueprint.AddInput(FAdvancedControlFlowBenchmarkUtils::MakePinType(PinCategory));
+
+	NodeType* Node = Blueprint.SpawnNode<NodeType>();
+	Node->SetCasePinCount(CaseBits.Num());
+	Blueprint.Link(Blueprint.GetEntryThenPin(), Node->GetExecPin());
+	Blueprint.Link(InputPin, Node->GetBitmaskPin());
+
+	const TArray<CasePinPair> CasePairs = Node->GetCasePinPairs();
+	for (int32 CaseIndex = 0; CaseIndex < CasePairs.Num(); ++CaseIndex)
+	{
+		Blueprint.SetDefaultValue(CasePairs[CaseIndex].Key, FString::FromInt(CaseBits[CaseIndex]));
+		Blueprint.Link(CasePairs[CaseIndex].Value, Blueprint.SpawnRecordExec(10 + CaseIndex));
+	}
+	Blueprint.Link(Node->GetDefaultExecPin(), Blueprint.SpawnRecordExec(99));
+
+	return Node;
+}
+
+int32 MakeBitmask(const TArray<int32>& Bits)
+{
+	uint32 Bitmask = 0;
+	for (int32 Bit : Bits)
+	{
+		Bitmask |= 1u << Bit;
+	}
+	return static_cast<int32>(Bitmask);
+}
+
+int64 MakeBitmask64(const TArray<int32>& Bits)
+{
+	uint64 Bitmask = 0;
+	for (int32 Bit : Bits)
+	{
+		Bitmask |= 1ull << Bit;
+	}
+	return static_cast<int64>(Bitmask);
+}
+}	 // namespace
+
+bool FBitmaskMultiBranchBitOrderTest::RunTest(const FString& Parameters)
+{
+	// The case bits are not sorted so that the cases are tested in the order of the bit position, not the pin order.
+	//   Case 0: Bit 5, Case 1: Bit 0, Case 2: Bit 3
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestBitmaskMultiBranchBitOrder"));
+	SpawnBitmaskNode<UK2Node_BitmaskMultiBranch>(Blueprint, UEdGraphSchema_K2::PC_Int, {5, 0, 3});
+	if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+	{
+		return false;
+	}
+
+	const TArray<TPair<TArray<int32>, FString>> Bitmasks = {
+		{{5}, TEXT("10")},
+		{{0}, TEXT("11")},
+		{{3}, TEXT("12")},
+		{{3, 5}, TEXT("12")},
+		{{0, 3, 5}, TEXT("11")},
+		{{1, 2, 5}, TEXT("10")},
+		{{1, 2, 4, 6, 31}, TEXT("99")},
+		{{}, TEXT("99")},
+	};
+	for (const TPair<TArray<int32>, FString>& Bitmask : Bitmasks)
+	{
+		const int32 Value = MakeBitmask(Bitmask.Key);
+		TestEqual(FString::Printf(TEXT("0x%08x should go to %s"), Value, *Bitmask.Value), Blueprint.Run(Value), Bitmask.Value);
+	}
+
+	return true;
+}
+
+bool FBitmaskMultiBranchBitBoundaryTest::RunTest(const FString& Parameters)
+{
+	{
+		// Bit 31 is the sign bit of Integer.
+		FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestBitmaskMultiBranchBitBoundary32"));
+		SpawnBitmaskNode<UK2Node_BitmaskMultiBranch>(Blueprint, UEdGraphSchema_K2::PC_Int, {31, 30});
+		if (TestTrue(TEXT("The Blueprint with Integer should be compiled"), Blueprint.Compile()))
+		{
+			TestEqual(TEXT("Bit 31 should go to case 0"), Blueprint.Run(MIN_int32), FString(TEXT("10")));
+			TestEqual(TEXT("All bits should go to case 1"), Blueprint.Run(-1), FString(TEXT("11")));
+			TestEqual(TEXT("The other bits should go to the default"), Blueprint.Run(MAX_int32 >> 2), FString(TEXT("99")));
+		}
+	}
+
+	{
+		// Bit 31 and 32 are in the different halves of Integer64, and bit 63 is the sign bit.
+		FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestBitmaskMultiBranchBitBoundary64"));
+		SpawnBitmaskNode<UK2Node_BitmaskMultiBranch>(Blueprint, UEdGraphSchema_K2::PC_Int64, {63, 32, 31});
+		if (TestTrue(TEXT("The Blueprint with Integer64 should be compiled"), Blueprint.Compile()))
+		{
+			TestEqual(TEXT("Bit 63 should go to case 0"), Blueprint.Run(MIN_int64), FString(TEXT("10")));
+			TestEqual(TEXT("Bit 32 should go to case 1"), Blueprint.Run(MakeBitmask64({32, 63})), FString(TEXT("11")));
+			TestEqual(TEXT("Bit 31 should go to case 2"), Blueprint.Run(MakeBitmask64({31, 32, 63})), FString(TEXT("12")));
+			TestEqual(TEXT("The lower half should not be truncated"), Blueprint.Run(MakeBitmask64({0, 30})), FString(TEXT("99")));
+		}
+	}
+
+	{
+		// The bit beyond the width of the bitmask must be the compile error.
+		AddExpectedError(TEXT("must be the bit position from 0 to 31"), EAutomationExpectedErrorFlags::Contains, 0);
+		FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestBitmaskMultiBranchBitBoundaryInvalid"));
+		SpawnBitmaskNode<UK2Node_BitmaskMultiBranch>(Blueprint, UEdGraphSchema_K2::PC_Int, {32});
+		TestFalse(TEXT("The Blueprint with bit 32 on Integer should not be compiled"), Blueprint.Compile());
+	}
+
+	return true;
+}
+
+bool FBitmaskConditionalSequenceBitOrderTest::RunTest(const FString& Parameters)
+{
+	//   Case 0: Bit 5, Case 1: Bit 0, Case 2: Bit 3
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestBitmaskConditionalSequenceBitOrder"));
+	SpawnBitmaskNode<UK2Node_BitmaskConditionalSequence>(Blueprint, UEdGraphSchema_K2::PC_Int, {5, 0, 3});
+	if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+	{
+		return false;
+	}
+
+	const TArray<TPair<TArray<int32>, FString>> Bitmasks = {
+		{{0, 3, 5}, TEXT("11,12,10,99")},
+		{{3, 5}, TEXT("12,10,99")},
+		{{1, 2, 5, 31}, TEXT("10,99")},
+		{{1, 2}, TEXT("99")},
+		{{}, TEXT("99")},
+	};
+	for (const TPair<TArray<int32>, FString>& Bitmask : Bitmasks)
+	{
+		const int32 Value = MakeBitmask(Bitmask.Key);
+		TestEqual(FString::Printf(TEXT("0x%08x should execute %s"), Value, *Bitmask.Value), Blueprint.Run(Value),
+			Bitmask.Value);
+	}
+
+	return true;
+}
+
+bool FBitmaskConditionalSequenceBitBoundaryTest::RunTest(const FString& Parameters)
+{
+	{
+		FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestBitmaskConditionalSequenceBitBoundary32"));
+		SpawnBitmaskNode<UK2Node_BitmaskConditionalSequence>(Blueprint, UEdGraphSchema_K2::PC_Int, {31, 0});
+		if (TestTrue(TEXT("The Blueprint with Integer should be compiled"), Blueprint.Compile()))
+		{
+			// The walk must stop after the sign bit.
+			TestEqual(TEXT("All bits should execute both cases"), Blueprint.Run(-1), FString(TEXT("11,10,99")));
+			TestEqual(TEXT("Bit 31 should execute case 0"), Blueprint.Run(MIN_int32), FString(TEXT("10,99")));
+		}
+	}
+
+	{
+		FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestBitmaskConditionalSequenceBitBoundary64"));
+		SpawnBitmaskNode<UK2Node_BitmaskConditionalSequence>(Blueprint, UEdGraphSchema_K2::PC_Int64, {63, 32, 31});
+		if (TestTrue(TEXT("The Blueprint with Integer64 should be compiled"), Blueprint.Compile()))
+		{
+			TestEqual(TEXT("All bits should execute the cases in the bit order"), Blueprint.Run(static_cast<int64>(-1)),
+				FString(TEXT("12,11,10,99")));
+			TestEqual(TEXT("Bit 32 and 63 should execute case 1 and 0"), Blueprint.Run(MakeBitmask64({32, 63})),
+				FString(TEXT("11,10,99")));
+			TestEqual(TEXT("The upper half should not be truncated"), Blueprint.Run(MakeBitmask64({0, 62})),
+				FString(TEXT("99")));
+		}
+	}
+
+	return true;
+}
+
+bool FBitmaskDefaultCaseBitTest::RunTest(const FString& Parameters)
+{
+	// The added case gets the lowest unused bit within the width of the bitmask.
+	const TArray<TPair<FName, int32>> PinTypes = {
+		{UEdGraphSchema_K2::PC_Wildcard, 32},
+		{UEdGraphSchema_K2::PC_Int, 32},
+		{UEdGraphSchema_K2::PC_Int64, 64},
+	};
+	for (const TPair<FName, int32>& PinType : PinTypes)
+	{
+		const int32 BitCount = PinType.Value;
+		FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestBitmaskDefaultCaseBit"));
+		UK2Node_BitmaskMultiBranch* Node = Blueprint.SpawnNode<UK2Node_BitmaskMultiBranch>();
+		if (PinType.Key != UEdGraphSchema_K2::PC_Wildcard)
+		{
+			Blueprint.Link(Blueprint.AddInput(FAdvancedControlFlowBenchmarkUtils::MakePinType(PinType.Key)), Node->GetBitmaskPin());
+		}
+		Node->SetCasePinCount(BitCount + 1);
+
+		const TArray<CasePinPair> CasePairs = Node->GetCasePinPairs();
+		for (int32 CaseIndex = 0; CaseIndex < BitCount; ++CaseIndex)
+		{
+			TestEqual(FString::Printf(TEXT("%s: Case %d should get bit %d"), *PinType.Key.ToString(), CaseIndex, CaseIndex),
+				CasePairs[CaseIndex].Key->DefaultValue, FString::FromInt(CaseIndex));
+		}
+
+		// Bit 32 would be the compile error on Integer.
+		TestEqual(FString::Printf(TEXT("%s: The case should get bit 0 if all bits are used"), *PinType.Key.ToString()),
+			CasePairs[BitCount].Key->DefaultValue, FString(TEXT("0")));
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,144 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowTestUtils.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_MultiBranch.h"
+#include "K2Node_MultiConditionalSelect.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCaseConditionNegationTest, "AdvancedControlFlow.Compiler.CaseCondition.Negation",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCaseConditionSharedNetWithNegationTest,
+	"AdvancedControlFlow.Compiler.CaseCondition.SharedNetWithNegation",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCaseConditionNegationUsedByOthersTest,
+	"AdvancedControlFlow.Compiler.CaseCondition.NegationUsedByOthers",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCaseConditionSelectSharedNetWithNegationTest,
+	"AdvancedControlFlow.Compiler.CaseCondition.SelectSharedNetWithNegation",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+bool FCaseConditionNegationTest::RunTest(const FString& Parameters)
+{
+	// The NOT Boolean nodes are removed and the cases test their inputs.
+	//   Case 0: NOT RecordBool(1, true), Case 1: NOT RecordBool(2, false), Case 2: NOT RecordBool(3, false)
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestCaseConditionNegation"));
+	const TArray<CasePinPair> CasePairs = Blueprint.SpawnMultiBranch(3)->GetCasePinPairs();
+	Blueprint.Link(Blueprint.SpawnNot(Blueprint.SpawnRecordBool(1, true)), CasePairs[0].Key);
+	Blueprint.Link(Blueprint.SpawnNot(Blueprint.SpawnRecordBool(2, false)), CasePairs[1].Key);
+	Blueprint.Link(Blueprint.SpawnNot(Blueprint.SpawnRecordBool(3, false)), CasePairs[2].Key);
+	if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("The first case whose input of NOT is false should be executed"), Blueprint.Run(), FString(TEXT("1,2,11")));
+
+	return true;
+}
+
+bool FCaseConditionSharedNetWithNegationTest::RunTest(const FString& Parameters)
+{
+	// One condition feeds the cases directly and through NOT Boolean.
+	//   Case 0: NOT Shared, Case 1: RecordBool(2, false), Case 2: Shared
+	for (bool bSharedValue : {true, false})
+	{
+		FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestCaseConditionSharedNetWithNegation"));
+		const TArray<CasePinPair> CasePairs = Blueprint.SpawnMultiBranch(3)->GetCasePinPairs();
+		UEdGraphPin* SharedPin = Blueprint.SpawnRecordBool(1, bSharedValue);
+		Blueprint.Link(Blueprint.SpawnNot(SharedPin), CasePairs[0].Key);
+		Blueprint.Link(Blueprint.SpawnRecordBool(2, false), CasePairs[1].Key);
+		Blueprint.Link(SharedPin, CasePairs[2].Key);
+		if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+		{
+			continue;
+		}
+
+		// The shared condition is evaluated only once at the first case which uses it.
+		if (bSharedValue)
+		{
+			TestEqual(TEXT("The case which uses the shared condition directly should be executed"), Blueprint.Run(),
+				FString(TEXT("1,2,12")));
+		}
+		else
+		{
+			TestEqual(TEXT("The case which uses the negated shared condition should be executed"), Blueprint.Run(),
+				FString(TEXT("1,10")));
+		}
+	}
+
+	return true;
+}
+
+bool FCaseConditionNegationUsedByOthersTest::RunTest(const FString& Parameters)
+{
+	// NOT Boolean whose output is also used by the function result must not be removed.
+	//   Case 0: NOT RecordBool(1, false) -> RecordExec(10) -> Result (Return Value: NOT RecordBool(1, false))
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestCaseConditionNegationUsedByOthers"));
+	const TArray<CasePinPair> CasePairs = Blueprint.SpawnMultiBranch(1)->GetCasePinPairs();
+	UEdGraphPin* ReturnValuePin =
+		Blueprint.AddReturnValue(FAdvancedControlFlowBenchmarkUtils::MakePinType(UEdGraphSchema_K2::PC_Boolean));
+	UEdGraphPin* NotPin = Blueprint.SpawnNot(Blueprint.SpawnRecordBool(1, false));
+	Blueprint.Link(NotPin, CasePairs[0].Key);
+	Blueprint.Link(NotPin, ReturnValuePin);
+	UEdGraphNode* CaseExecNode = CasePairs[0].Value->LinkedTo[0]->GetOwningNode();
+	Blueprint.Link(CaseExecNode->FindPinChecked(UEdGraphSchema_K2::PN_Then), Blueprint.GetResultExecPin());
+	if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+	{
+		return false;
+	}
+
+	bool bReturnValue = false;
+	const FString Records = Blueprint.RunWithReturnValue(bReturnValue);
+	TestTrue(TEXT("The case should be executed"), Records.Contains(TEXT("10")) && !Records.Contains(TEXT("99")));
+	TestTrue(TEXT("The output of NOT Boolean should be kept for the function result"), bReturnValue);
+
+	return true;
+}
+
+bool FCaseConditionSelectSharedNetWithNegationTest::RunTest(const FString& Parameters)
+{
+	// Multi-Conditional Select -> Return Value
+	//   Option 0: RecordInt(10, 100), Condition 0: NOT Shared
+	//   Option 1: RecordInt(11, 101), Condition 1: Shared
+	//   Default: RecordInt(19, 999)
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestCaseConditionSelectSharedNetWithNegation"));
+	UEdGraphPin* ReturnValuePin =
+		Blueprint.AddReturnValue(FAdvancedControlFlowBenchmarkUtils::MakePinType(UEdGraphSchema_K2::PC_Int));
+	Blueprint.Link(Blueprint.GetEntryThenPin(), Blueprint.GetResultExecPin());
+
+	UK2Node_MultiConditionalSelect* Node = Blueprint.SpawnNode<UK2Node_MultiConditionalSelect>();
+	Node->SetCasePinCount(2);
+	// Fix the type of the options at first.
+	Blueprint.Link(Node->GetReturnValuePin(), ReturnValuePin);
+
+	const TArray<CasePinPair> CasePairs = Node->GetCasePinPairs();
+	UEdGraphPin* SharedPin = Blueprint.SpawnRecordBool(1, true);
+	Blueprint.Link(Blueprint.SpawnRecordInt(10, 100), CasePairs[0].Key);
+	Blueprint.Link(Blueprint.SpawnNot(SharedPin), CasePairs[0].Value);
+	Blueprint.Link(Blueprint.SpawnRecordInt(11, 101), CasePairs[1].Key);
+	Blueprint.Link(SharedPin, CasePairs[1].Value);
+	Blueprint.Link(Blueprint.SpawnRecordInt(19, 999), Node->GetDefaultOptionPin());
+	if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+	{
+		return false;
+	}
+
+	int32 ReturnValue = 0;
+	const FString Records = Blueprint.RunWithReturnValue(ReturnValue);
+	TestEqual(TEXT("The option of the shared condition should be selected"), ReturnValue, 101);
+	TestEqual(TEXT("The shared condition should be evaluated once"), Records, FString(TEXT("1,11")));
+
+	return true;
+}
+
+#endif
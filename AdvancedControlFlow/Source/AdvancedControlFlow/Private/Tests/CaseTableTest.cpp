@@ -0,0 +1,203 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowTestUtils.h"
+#include "K2Node_MultiBranch.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCaseTableUpgradeFromPinNamesTest, "AdvancedControlFlow.Editor.CaseTable.UpgradeFromPinNames",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCaseTableUpgradeFromPinIdsTest, "AdvancedControlFlow.Editor.CaseTable.UpgradeFromPinIds",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCaseTableGuidFallbackTest, "AdvancedControlFlow.Editor.CaseTable.GuidFallback",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCaseTableIndexValidationTest, "AdvancedControlFlow.Editor.CaseTable.IndexValidation",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+// Access to the case table of the node. It must be in the global namespace to be the friend of the node.
+struct FCasePairedPinsNodeTestAccessor
+{
+	static TArray<FCasePinPairEntry>& GetCaseTable(UK2Node_CasePairedPinsNode* Node)
+	{
+		return Node->CasePinPairEntries;
+	}
+
+	static int32& GetCaseTableVersion(UK2Node_CasePairedPinsNode* Node)
+	{
+		return Node->CaseTableVersion;
+	}
+
+	static bool ResolveByPinIndices(UK2Node_CasePairedPinsNode* Node)
+	{
+		return Node->ResolveCasePinPairEntriesByPinIndices();
+	}
+
+	// Call PostLoad in the same way as the node is loaded from the package. The resolved pins are not serialized, so they
+	// are cleared at first.
+	static void Load(UK2Node_CasePairedPinsNode* Node)
+	{
+		for (FCasePinPairEntry& Entry : Node->CasePinPairEntries)
+		{
+			Entry.KeyPin = nullptr;
+			Entry.ValuePin = nullptr;
+		}
+		Node->SetFlags(RF_NeedPostLoad);
+		Node->ConditionalPostLoad();
+	}
+};
+
+namespace
+{
+// Move the pins so that the pin indices in the case table become stale.
+void SwapPins(UEdGraphNode* Node, const UEdGraphPin* PinA, const UEdGraphPin* PinB)
+{
+	Node->Pins.Swap(Node->Pins.IndexOfByKey(PinA), Node->Pins.IndexOfByKey(PinB));
+}
+
+bool HasSameCasePinPairs(FAutomationTestBase& Test, const FString& What, const UK2Node_CasePairedPinsNode* Node,
+	const TArray<CasePinPair>& Expected)
+{
+	const TArray<CasePinPair> Actual = Node->GetCasePinPairs();
+	if (!Test.TestEqual(FString::Printf(TEXT("%s: The number of the cases"), *What), Actual.Num(), Expected.Num()))
+	{
+		return false;
+	}
+
+	bool bSame = true;
+	for (int32 CaseIndex = 0; CaseIndex < Expected.Num(); ++CaseIndex)
+	{
+		bSame &= Test.TestTrue(FString::Printf(TEXT("%s: Case %d should be paired with the same pins"), *What, CaseIndex),
+			(Actual[CaseIndex].Key == Expected[CaseIndex].Key) && (Actual[CaseIndex].Value == Expected[CaseIndex].Value));
+	}
+	return bSame;
+}
+
+void TestUpgradedToLatestVersion(FAutomationTestBase& Test, const FString& What, UK2Node_CasePairedPinsNode* Node)
+{
+	Test.TestEqual(FString::Printf(TEXT("%s: The case table should be upgraded"), *What),
+		FCasePairedPinsNodeTestAccessor::GetCaseTableVersion(Node), static_cast<int32>(ECaseTableVersion::LatestVersion));
+	Test.TestTrue(FString::Printf(TEXT("%s: The pin indices should be valid for the next load"), *What),
+		FCasePairedPinsNodeTestAccessor::ResolveByPinIndices(Node));
+}
+}	 // namespace
+
+bool FCaseTableUpgradeFromPinNamesTest::RunTest(const FString& Parameters)
+{
+	// The node saved before the case table was introduced has only the pins named CaseCond_N and CaseExec_N.
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestCaseTableUpgradeFromPinNames"));
+	UK2Node_MultiBranch* Node = Blueprint.SpawnMultiBranch(3);
+	const TArray<CasePinPair> Expected = Node->GetCasePinPairs();
+
+	FCasePairedPinsNodeTestAccessor::GetCaseTable(Node).Reset();
+	FCasePairedPinsNodeTestAccessor::GetCaseTableVersion(Node) = static_cast<int32>(ECaseTableVersion::None);
+	// The pairs are found by the number in the pin names, not by the order of the pins.
+	SwapPins(Node, Expected[0].Key, Expected[2].Value);
+	FCasePairedPinsNodeTestAccessor::Load(Node);
+
+	if (HasSameCasePinPairs(*this, TEXT("PinNames"), Node, Expected))
+	{
+		TestUpgradedToLatestVersion(*this, TEXT("PinNames"), Node);
+	}
+
+	// The case table is rebuilt only if every case has both pins.
+	Expected[1].Value->PinName = TEXT("Renamed");
+	FCasePairedPinsNodeTestAccessor::GetCaseTable(Node).Reset();
+	FCasePairedPinsNodeTestAccessor::GetCaseTableVersion(Node) = static_cast<int32>(ECaseTableVersion::None);
+	FCasePairedPinsNodeTestAccessor::Load(Node);
+	TestEqual(TEXT("The broken pin names should not make the partial case table"), Node->GetCasePinCount(), 0);
+
+	return true;
+}
+
+bool FCaseTableUpgradeFromPinIdsTest::RunTest(const FString& Parameters)
+{
+	// The node saved by the version which had no pin indices.
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestCaseTableUpgradeFromPinIds"));
+	UK2Node_MultiBranch* Node = Blueprint.SpawnMultiBranch(3);
+	const TArray<CasePinPair> Expected = Node->GetCasePinPairs();
+
+	for (FCasePinPairEntry& Entry : FCasePairedPinsNodeTestAccessor::GetCaseTable(Node))
+	{
+		Entry.KeyPinIndex = INDEX_NONE;
+		Entry.ValuePinIndex = INDEX_NONE;
+	}
+	FCasePairedPinsNodeTestAccessor::GetCaseTableVersion(Node) = static_cast<int32>(ECaseTableVersion::PinIds);
+	FCasePairedPinsNodeTestAccessor::Load(Node);
+
+	if (HasSameCasePinPairs(*this, TEXT("PinIds"), Node, Expected))
+	{
+		TestUpgradedToLatestVersion(*this, TEXT("PinIds"), Node);
+	}
+
+	return true;
+}
+
+bool FCaseTableGuidFallbackTest::RunTest(const FString& Parameters)
+{
+	// The pins are moved after the node was saved, so the pin indices do not match and the pins are found by the IDs.
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestCaseTableGuidFallback"));
+	UK2Node_MultiBranch* Node = Blueprint.SpawnMultiBranch(3);
+	const TArray<CasePinPair> Expected = Node->GetCasePinPairs();
+
+	SwapPins(Node, Expected[0].Key, Expected[1].Key);
+	SwapPins(Node, Expected[1].Value, Expected[2].Value);
+	// The names are not used if the IDs are found.
+	for (const CasePinPair& Pair : Expected)
+	{
+		Pair.Key->PinName = TEXT("Renamed");
+		Pair.Value->PinName = TEXT("Renamed");
+	}
+	TestFalse(TEXT("The stale pin indices should be detected"), FCasePairedPinsNodeTestAccessor::ResolveByPinIndices(Node));
+	FCasePairedPinsNodeTestAccessor::Load(Node);
+
+	if (HasSameCasePinPairs(*this, TEXT("Guid"), Node, Expected))
+	{
+		TestUpgradedToLatestVersion(*this, TEXT("Guid"), Node);
+	}
+
+	return true;
+}
+
+bool FCaseTableIndexValidationTest::RunTest(const FString& Parameters)
+{
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestCaseTableIndexValidation"));
+	UK2Node_MultiBranch* Node = Blueprint.SpawnMultiBranch(3);
+	const TArray<CasePinPair> Expected = Node->GetCasePinPairs();
+	TArray<FCasePinPairEntry>& CaseTable = FCasePairedPinsNodeTestAccessor::GetCaseTable(Node);
+
+	TestTrue(TEXT("The pin indices of the new node should be valid"), FCasePairedPinsNodeTestAccessor::ResolveByPinIndices(Node));
+	FCasePairedPinsNodeTestAccessor::Load(Node);
+	HasSameCasePinPairs(*this, TEXT("Valid"), Node, Expected);
+
+	// Each broken table is rejected by the validation and repaired by the fallback.
+	const TArray<TPair<FString, TFunction<void(FCasePinPairEntry&)>>> Corruptions = {
+		{TEXT("OutOfRange"), [Node](FCasePinPairEntry& Entry) { Entry.KeyPinIndex = Node->Pins.Num(); }},
+		{TEXT("Negative"), [](FCasePinPairEntry& Entry) { Entry.ValuePinIndex = INDEX_NONE; }},
+		{TEXT("KeyAndValueSwapped"), [](FCasePinPairEntry& Entry) { Swap(Entry.KeyPinIndex, Entry.ValuePinIndex); }},
+		{TEXT("OtherPinId"), [](FCasePinPairEntry& Entry) { Entry.KeyPinId = FGuid::NewGuid(); }},
+	};
+	for (const TPair<FString, TFunction<void(FCasePinPairEntry&)>>& Corruption : Corruptions)
+	{
+		Corruption.Value(CaseTable[1]);
+		TestFalse(FString::Printf(TEXT("%s: The case table should be rejected"), *Corruption.Key),
+			FCasePairedPinsNodeTestAccessor::ResolveByPinIndices(Node));
+		FCasePairedPinsNodeTestAccessor::Load(Node);
+
+		if (HasSameCasePinPairs(*this, Corruption.Key, Node, Expected))
+		{
+			TestUpgradedToLatestVersion(*this, Corruption.Key, Node);
+		}
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,50 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowTestUtils.h"
+#include "K2Node_ConditionalSequence.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FConditionalSequenceOrderTest, "AdvancedControlFlow.Compiler.ConditionalSequence.Order",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+bool FConditionalSequenceOrderTest::RunTest(const FString& Parameters)
+{
+	// Entry -> Conditional Sequence -[Case N]-> RecordExec(10 + N)
+	//                               -[Default]-> RecordExec(99)
+	//   Condition N: RecordBool(1 + N, Conds[N])
+	const TArray<bool> Conds = {true, false, true, true};
+
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestConditionalSequenceOrder"));
+	UK2Node_ConditionalSequence* Node = Blueprint.SpawnNode<UK2Node_ConditionalSequence>();
+	Node->SetCasePinCount(Conds.Num());
+	Blueprint.Link(Blueprint.GetEntryThenPin(), Node->GetExecPin());
+
+	const TArray<CasePinPair> CasePairs = Node->GetCasePinPairs();
+	for (int32 CaseIndex = 0; CaseIndex < CasePairs.Num(); ++CaseIndex)
+	{
+		Blueprint.Link(Blueprint.SpawnRecordBool(1 + CaseIndex, Conds[CaseIndex]), CasePairs[CaseIndex].Key);
+		Blueprint.Link(CasePairs[CaseIndex].Value, Blueprint.SpawnRecordExec(10 + CaseIndex));
+	}
+	Blueprint.Link(Node->GetDefaultExecPin(), Blueprint.SpawnRecordExec(99));
+	if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+	{
+		return false;
+	}
+
+	// Each condition is evaluated after the previous case is executed, and the default is executed at last.
+	TestEqual(
+		TEXT("The cases should be executed in the pin order"), Blueprint.Run(), FString(TEXT("1,10,2,3,12,4,13,99")));
+
+	return true;
+}
+
+#endif
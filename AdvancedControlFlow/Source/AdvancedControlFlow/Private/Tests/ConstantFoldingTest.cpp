@@ -0,0 +1,117 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowTestUtils.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_Knot.h"
+#include "K2Node_MultiBranch.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FConstantFoldingAlwaysFalseTest, "AdvancedControlFlow.Compiler.ConstantFolding.AlwaysFalse",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FConstantFoldingAlwaysTrueTest, "AdvancedControlFlow.Compiler.ConstantFolding.AlwaysTrue",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+namespace
+{
+// The forms of the constant which are folded by the compiler.
+enum class EConstantForm
+{
+	Literal,
+	MakeLiteralBool,
+	Knot,
+};
+
+const TArray<TPair<EConstantForm, FString>> ConstantForms = {
+	{EConstantForm::Literal, TEXT("Literal")},
+	{EConstantForm::MakeLiteralBool, TEXT("MakeLiteralBool")},
+	{EConstantForm::Knot, TEXT("Knot")},
+};
+
+// Give the constant to the condition pin.
+//   Literal: The default value of the unlinked pin
+//   MakeLiteralBool: Make Literal Bool -> Condition
+//   Knot: Make Literal Bool -> Reroute -> Condition
+void SetConstantCondition(FAdvancedControlFlowTestBlueprint& Blueprint, UEdGraphPin* CondPin, EConstantForm Form, bool bValue)
+{
+	const FString Value = bValue ? TEXT("true") : TEXT("false");
+	if (Form == EConstantForm::Literal)
+	{
+		Blueprint.SetDefaultValue(CondPin, Value);
+		return;
+	}
+
+	UK2Node_CallFunction* MakeLiteralNode = FAdvancedControlFlowBenchmarkUtils::SpawnCallFunctionNode(Blueprint.GetGraph(),
+		UKismetSystemLibrary::StaticClass(), GET_FUNCTION_NAME_CHECKED(UKismetSystemLibrary, MakeLiteralBool));
+	Blueprint.SetDefaultValue(MakeLiteralNode->FindPinChecked(TEXT("Value")), Value);
+	if (Form == EConstantForm::MakeLiteralBool)
+	{
+		Blueprint.Link(MakeLiteralNode->GetReturnValuePin(), CondPin);
+		return;
+	}
+
+	UK2Node_Knot* KnotNode = Blueprint.SpawnNode<UK2Node_Knot>();
+	Blueprint.Link(MakeLiteralNode->GetReturnValuePin(), KnotNode->GetInputPin());
+	Blueprint.Link(KnotNode->GetOutputPin(), CondPin);
+}
+}	 // namespace
+
+bool FConstantFoldingAlwaysFalseTest::RunTest(const FString& Parameters)
+{
+	for (const TPair<EConstantForm, FString>& Form : ConstantForms)
+	{
+		// Case 0: false (constant), Case 1: RecordBool(2, true)
+		FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestConstantFoldingAlwaysFalse"));
+		const TArray<CasePinPair> CasePairs = Blueprint.SpawnMultiBranch(2)->GetCasePinPairs();
+		SetConstantCondition(Blueprint, CasePairs[0].Key, Form.Key, false);
+		Blueprint.Link(Blueprint.SpawnRecordBool(2, true), CasePairs[1].Key);
+		if (!TestTrue(FString::Printf(TEXT("%s: The Blueprint should be compiled"), *Form.Value), Blueprint.Compile()))
+		{
+			continue;
+		}
+
+		TestEqual(FString::Printf(TEXT("%s: The case should be removed"), *Form.Value),
+			Blueprint.CountMessages(EMessageSeverity::Info, TEXT("is always false")), 1);
+		TestEqual(FString::Printf(TEXT("%s: The next case should be executed"), *Form.Value), Blueprint.Run(),
+			FString(TEXT("2,11")));
+	}
+
+	return true;
+}
+
+bool FConstantFoldingAlwaysTrueTest::RunTest(const FString& Parameters)
+{
+	for (const TPair<EConstantForm, FString>& Form : ConstantForms)
+	{
+		// Case 0: RecordBool(1, false), Case 1: true (constant), Case 2: RecordBool(3, true)
+		FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestConstantFoldingAlwaysTrue"));
+		const TArray<CasePinPair> CasePairs = Blueprint.SpawnMultiBranch(3)->GetCasePinPairs();
+		Blueprint.Link(Blueprint.SpawnRecordBool(1, false), CasePairs[0].Key);
+		SetConstantCondition(Blueprint, CasePairs[1].Key, Form.Key, true);
+		Blueprint.Link(Blueprint.SpawnRecordBool(3, true), CasePairs[2].Key);
+		if (!TestTrue(FString::Printf(TEXT("%s: The Blueprint should be compiled"), *Form.Value), Blueprint.Compile()))
+		{
+			continue;
+		}
+
+		TestEqual(FString::Printf(TEXT("%s: The following cases should be removed"), *Form.Value),
+			Blueprint.CountMessages(EMessageSeverity::Info, TEXT("is always true")), 1);
+
+		// RecordBool(3) would be evaluated before the node if its statements were left in the pure node.
+		TestEqual(FString::Printf(TEXT("%s: The pure nodes of the removed cases should not be evaluated"), *Form.Value),
+			Blueprint.Run(), FString(TEXT("1,11")));
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,61 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowCppExporter.h"
+#include "AdvancedControlFlowTestUtils.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/EngineBaseTypes.h"
+#include "K2Node_SwitchExec.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCppExporterEnumClassParameterTest, "AdvancedControlFlow.Exporter.EnumClassParameter",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+bool FCppExporterEnumClassParameterTest::RunTest(const FString& Parameters)
+{
+	// Entry (Input: EMouseCaptureMode) -> Switch Exec (Selection: Input)
+	UEnum* Enum = StaticEnum<EMouseCaptureMode>();
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestCppExporterEnumClassParameter"));
+	UEdGraphPin* InputPin = Blueprint.AddInput(FAdvancedControlFlowBenchmarkUtils::MakePinType(UEdGraphSchema_K2::PC_Byte, Enum));
+
+	UK2Node_SwitchExec* Node = Blueprint.SpawnNode<UK2Node_SwitchExec>();
+	Node->SetCasePinCount(2);
+	Blueprint.Link(Blueprint.GetEntryThenPin(), Node->GetExecPin());
+	Blueprint.Link(InputPin, Node->GetSelectionPin());
+	const TArray<CasePinPair> CasePairs = Node->GetCasePinPairs();
+	for (int32 CaseIndex = 0; CaseIndex < CasePairs.Num(); ++CaseIndex)
+	{
+		Blueprint.SetDefaultValue(CasePairs[CaseIndex].Key, Enum->GetNameStringByIndex(CaseIndex));
+	}
+
+	FAdvancedControlFlowCppExporter Exporter(TEXT("ACFTestModule"), TEXT("ACFTestLibrary"));
+	if (!TestTrue(TEXT("The function should be exported"), Exporter.AddFunction(Blueprint.GetBlueprint(), Blueprint.GetGraph())))
+	{
+		for (const FString& Error : Exporter.GetErrors())
+		{
+			AddInfo(Error);
+		}
+		return false;
+	}
+	const TMap<FString, FString> Files = Exporter.GenerateFiles();
+
+	// The enum class can not be converted from uint8 implicitly, so uint8 must not be used for the parameter.
+	TestTrue(TEXT("The parameter should have the enum type"),
+		Files.FindRef(TEXT("Public/ACFTestLibrary.h")).Contains(TEXT("Test(EMouseCaptureMode Input)")));
+	TestTrue(TEXT("The selection should be converted for the integer case labels"),
+		Files.FindRef(TEXT("Private/ACFTestLibrary.cpp")).Contains(TEXT("switch (static_cast<uint8>(Input))")));
+	TestTrue(TEXT("The candidate values should be converted to the enum type"),
+		Files.FindRef(TEXT("Private/ACFTestLibraryRoundTripTest.cpp")).Contains(TEXT("static_cast<EMouseCaptureMode>((uint8)")));
+
+	return true;
+}
+
+#endif
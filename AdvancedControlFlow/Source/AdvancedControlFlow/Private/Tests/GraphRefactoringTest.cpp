@@ -0,0 +1,276 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowGraphRefactoring.h"
+#include "AdvancedControlFlowTestUtils.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_IfThenElse.h"
+#include "K2Node_MultiBranch.h"
+#include "K2Node_MultiConditionalSelect.h"
+#include "K2Node_Select.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphRefactoringFindBranchChainTest,
+	"AdvancedControlFlow.Editor.GraphRefactoring.FindBranchChain",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphRefactoringBrokenChainTest, "AdvancedControlFlow.Editor.GraphRefactoring.BrokenChain",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphRefactoringCollapseBranchChainTest,
+	"AdvancedControlFlow.Editor.GraphRefactoring.CollapseBranchChain",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGraphRefactoringCollapseSelectChainTest,
+	"AdvancedControlFlow.Editor.GraphRefactoring.CollapseSelectChain",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+namespace
+{
+// Entry -> Branch 0 -[False]-> Branch 1 -[False]-> ... Branch N-1 -[False]-> RecordExec(99)
+//   Branch N: Condition: RecordBool(1 + N, N == TrueIndex), True -> RecordExec(10 + N)
+TArray<UEdGraphNode*> SpawnBranchChain(FAdvancedControlFlowTestBlueprint& Blueprint, int32 Length, int32 TrueIndex)
+{
+	TArray<UEdGraphNode*> Chain;
+	UEdGraphPin* PrevFalsePin = Blueprint.GetEntryThenPin();
+	for (int32 Index = 0; Index < Length; ++Index)
+	{
+		UK2Node_IfThenElse* BranchNode = Blueprint.SpawnNode<UK2Node_IfThenElse>();
+		Blueprint.Link(PrevFalsePin, BranchNode->GetExecPin());
+		Blueprint.Link(Blueprint.SpawnRecordBool(1 + Index, Index == TrueIndex), BranchNode->GetConditionPin());
+		Blueprint.Link(BranchNode->GetThenPin(), Blueprint.SpawnRecordExec(10 + Index));
+		PrevFalsePin = BranchNode->GetElsePin();
+		Chain.Add(BranchNode);
+	}
+	Blueprint.Link(PrevFalsePin, Blueprint.SpawnRecordExec(99));
+
+	return Chain;
+}
+
+TArray<int32> GetChainLengths(const TArray<TArray<UEdGraphNode*>>& Chains)
+{
+	TArray<int32> Lengths;
+	for (const TArray<UEdGraphNode*>& Chain : Chains)
+	{
+		Lengths.Add(Chain.Num());
+	}
+	return Lengths;
+}
+
+template <typename NodeType>
+TArray<NodeType*> GetNodesOfClass(UEdGraph* Graph)
+{
+	TArray<NodeType*> Nodes;
+	Graph->GetNodesOfClass(Nodes);
+	return Nodes;
+}
+}	 // namespace
+
+bool FGraphRefactoringFindBranchChainTest::RunTest(const FString& Parameters)
+{
+	// The chain is split from the head into the chains of 3 nodes in the free version, and the last node left alone is not a
+	// chain.
+	const TArray<TPair<int32, TArray<int32>>> TestCases = {
+		{1, {}},
+		{2, {2}},
+		{3, {3}},
+#ifdef ACF_FREE_VERSION
+		{4, {3}},
+		{7, {3, 3}},
+#else
+		{4, {4}},
+		{7, {7}},
+#endif
+	};
+
+	for (const TPair<int32, TArray<int32>>& TestCase : TestCases)
+	{
+		const int32 Length = TestCase.Key;
+		FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestGraphRefactoringFindBranchChain"));
+		const TArray<UEdGraphNode*> Chain = SpawnBranchChain(Blueprint, Length, INDEX_NONE);
+
+		TArray<TArray<UEdGraphNode*>> Chains;
+		FAdvancedControlFlowGraphRefactoring::FindChains(Blueprint.GetGraph(), Chains);
+		TestTrue(FString::Printf(TEXT("%d nodes should be found as %d chain(s)"), Length, TestCase.Value.Num()),
+			GetChainLengths(Chains) == TestCase.Value);
+
+		// The chains are the pieces of the nodes from the head, and each node finds the piece which contains it.
+		int32 Offset = 0;
+		for (int32 ChainLength : TestCase.Value)
+		{
+			const TArray<UEdGraphNode*> ExpectedChain(Chain.GetData() + Offset, ChainLength);
+			for (int32 Index = Offset; Index < Offset + ChainLength; ++Index)
+			{
+				TestTrue(FString::Printf(TEXT("Node %d of %d should find its chain"), Index, Length),
+					FAdvancedControlFlowGraphRefactoring::FindChain(Chain[Index]) == ExpectedChain);
+			}
+			Offset += ChainLength;
+		}
+		for (int32 Index = Offset; Index < Chain.Num(); ++Index)
+		{
+			TestEqual(FString::Printf(TEXT("Node %d of %d should not be in any chain"), Index, Length),
+				FAdvancedControlFlowGraphRefactoring::FindChain(Chain[Index]).Num(), 0);
+		}
+
+		if (TestCase.Value != TArray<int32>({Length}))
+		{
+			TestTrue(FString::Printf(TEXT("%d nodes should not be collapsed into one node"), Length),
+				FAdvancedControlFlowGraphRefactoring::CollapseChain(Chain) == nullptr);
+		}
+	}
+
+	return true;
+}
+
+bool FGraphRefactoringBrokenChainTest::RunTest(const FString& Parameters)
+{
+	{
+		// The node which is also executed from the other node is the head of the new chain.
+		FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestGraphRefactoringBrokenChainJoin"));
+		const TArray<UEdGraphNode*> Chain = SpawnBranchChain(Blueprint, 4, INDEX_NONE);
+		Blueprint.Link(
+			CastChecked<UK2Node_IfThenElse>(Chain[0])->GetThenPin(), CastChecked<UK2Node_IfThenElse>(Chain[2])->GetExecPin());
+		TestTrue(TEXT("The chain should be broken at the joined node"),
+			FAdvancedControlFlowGraphRefactoring::FindChain(Chain[0]) == TArray<UEdGraphNode*>({Chain[0], Chain[1]}));
+		TestTrue(TEXT("The joined node should be the head"),
+			FAdvancedControlFlowGraphRefactoring::FindChain(Chain[3]) == TArray<UEdGraphNode*>({Chain[2], Chain[3]}));
+	}
+
+	{
+		// The disabled node is not collapsed.
+		FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestGraphRefactoringBrokenChainDisabled"));
+		const TArray<UEdGraphNode*> Chain = SpawnBranchChain(Blueprint, 3, INDEX_NONE);
+		Chain[1]->SetEnabledState(ENodeEnabledState::Disabled);
+		TArray<TArray<UEdGraphNode*>> Chains;
+		FAdvancedControlFlowGraphRefactoring::FindChains(Blueprint.GetGraph(), Chains);
+		TestEqual(TEXT("The chain should be broken at the disabled node"), Chains.Num(), 0);
+	}
+
+	{
+		// The nodes linked in a loop have no head.
+		FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestGraphRefactoringBrokenChainLoop"));
+		UK2Node_IfThenElse* BranchNodeA = Blueprint.SpawnNode<UK2Node_IfThenElse>();
+		UK2Node_IfThenElse* BranchNodeB = Blueprint.SpawnNode<UK2Node_IfThenElse>();
+		Blueprint.Link(BranchNodeA->GetElsePin(), BranchNodeB->GetExecPin());
+		Blueprint.Link(BranchNodeB->GetElsePin(), BranchNodeA->GetExecPin());
+		TArray<TArray<UEdGraphNode*>> Chains;
+		FAdvancedControlFlowGraphRefactoring::FindChains(Blueprint.GetGraph(), Chains);
+		TestEqual(TEXT("The loop should not be found as the chain"), Chains.Num(), 0);
+		TestEqual(TEXT("The loop should not be the chain of the node"),
+			FAdvancedControlFlowGraphRefactoring::FindChain(BranchNodeA).Num(), 0);
+		TestTrue(TEXT("The loop should not be collapsed"),
+			FAdvancedControlFlowGraphRefactoring::CollapseChain({BranchNodeA, BranchNodeB}) == nullptr);
+	}
+
+	return true;
+}
+
+bool FGraphRefactoringCollapseBranchChainTest::RunTest(const FString& Parameters)
+{
+	for (int32 Length : {2, 4, 7})
+	{
+		for (int32 TrueIndex : {0, Length - 1, INDEX_NONE})
+		{
+			FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestGraphRefactoringCollapseBranchChain"));
+			const TArray<UEdGraphNode*> Chain = SpawnBranchChain(Blueprint, Length, TrueIndex);
+			if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+			{
+				continue;
+			}
+			const FString ExpectedRecords = Blueprint.Run();
+
+			TArray<TArray<UEdGraphNode*>> Chains;
+			FAdvancedControlFlowGraphRefactoring::FindChains(Blueprint.GetGraph(), Chains);
+			const FAdvancedControlFlowCollapseResult Result =
+				FAdvancedControlFlowGraphRefactoring::CollapseChains(Blueprint.GetBlueprint(), Chains);
+			const FString What = FString::Printf(TEXT("%d nodes (True: %d)"), Length, TrueIndex);
+			TestEqual(FString::Printf(TEXT("%s: All chains should be collapsed"), *What), Result.BranchChainCount, Chains.Num());
+
+			for (const UK2Node_MultiBranch* Node : GetNodesOfClass<UK2Node_MultiBranch>(Blueprint.GetGraph()))
+			{
+				TestTrue(FString::Printf(TEXT("%s: The new node should not exceed the number of the cases"), *What),
+					Node->GetCasePinCount() <= FAdvancedControlFlowGraphRefactoring::MaxChainLength);
+			}
+
+			// The conditions are evaluated in the same order, so the records must be the same.
+			if (TestTrue(FString::Printf(TEXT("%s: The collapsed Blueprint should be compiled"), *What), Blueprint.Compile()))
+			{
+				TestEqual(FString::Printf(TEXT("%s: The behavior should be kept"), *What), Blueprint.Run(), ExpectedRecords);
+			}
+		}
+	}
+
+	return true;
+}
+
+bool FGraphRefactoringCollapseSelectChainTest::RunTest(const FString& Parameters)
+{
+	// Select 0 (True: RecordInt(10, 100), Index: RecordBool(1, false)) -> Return Value
+	//   False: Select 1 (True: RecordInt(11, 101), Index: RecordBool(2, false))
+	//     False: ... Select N-1 (True: RecordInt(10 + N-1, 100 + N-1), False: RecordInt(19, 999))
+	const int32 Length = 4;
+	for (int32 TrueIndex : {1, Length - 1, INDEX_NONE})
+	{
+		FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestGraphRefactoringCollapseSelectChain"));
+		UEdGraphPin* PrevFalsePin =
+			Blueprint.AddReturnValue(FAdvancedControlFlowBenchmarkUtils::MakePinType(UEdGraphSchema_K2::PC_Int));
+		Blueprint.Link(Blueprint.GetEntryThenPin(), Blueprint.GetResultExecPin());
+		for (int32 Index = 0; Index < Length; ++Index)
+		{
+			UK2Node_Select* SelectNode = Blueprint.SpawnNode<UK2Node_Select>();
+			Blueprint.Link(Blueprint.SpawnRecordBool(1 + Index, Index == TrueIndex), SelectNode->GetIndexPin());
+			Blueprint.Link(SelectNode->GetReturnValuePin(), PrevFalsePin);
+
+			// The option pins are [False, True] when the index pin is Boolean.
+			TArray<UEdGraphPin*> OptionPins;
+			SelectNode->GetOptionPins(OptionPins);
+			Blueprint.Link(Blueprint.SpawnRecordInt(10 + Index, 100 + Index), OptionPins[1]);
+			PrevFalsePin = OptionPins[0];
+		}
+		Blueprint.Link(Blueprint.SpawnRecordInt(19, 999), PrevFalsePin);
+		if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+		{
+			continue;
+		}
+		int32 ExpectedReturnValue = 0;
+		Blueprint.RunWithReturnValue(ExpectedReturnValue);
+
+		TArray<TArray<UEdGraphNode*>> Chains;
+		FAdvancedControlFlowGraphRefactoring::FindChains(Blueprint.GetGraph(), Chains);
+#ifdef ACF_FREE_VERSION
+		// The last node left alone is not collapsed.
+		const TArray<int32> ExpectedChainLengths = {3};
+#else
+		const TArray<int32> ExpectedChainLengths = {4};
+#endif
+		TestTrue(FString::Printf(TEXT("True %d: The chains should be found"), TrueIndex),
+			GetChainLengths(Chains) == ExpectedChainLengths);
+		const FAdvancedControlFlowCollapseResult Result =
+			FAdvancedControlFlowGraphRefactoring::CollapseChains(Blueprint.GetBlueprint(), Chains);
+		TestEqual(
+			FString::Printf(TEXT("True %d: All chains should be collapsed"), TrueIndex), Result.SelectChainCount, Chains.Num());
+
+		for (const UK2Node_MultiConditionalSelect* Node : GetNodesOfClass<UK2Node_MultiConditionalSelect>(Blueprint.GetGraph()))
+		{
+			TestTrue(FString::Printf(TEXT("True %d: The new node should not exceed the number of the cases"), TrueIndex),
+				Node->GetCasePinCount() <= FAdvancedControlFlowGraphRefactoring::MaxChainLength);
+		}
+
+		if (TestTrue(FString::Printf(TEXT("True %d: The collapsed Blueprint should be compiled"), TrueIndex), Blueprint.Compile()))
+		{
+			int32 ReturnValue = 0;
+			Blueprint.RunWithReturnValue(ReturnValue);
+			TestEqual(FString::Printf(TEXT("True %d: The same option should be selected"), TrueIndex), ReturnValue,
+				ExpectedReturnValue);
+		}
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,244 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowCaseHitCounter.h"
+#include "AdvancedControlFlowTestUtils.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "K2Node_MultiBranch.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Misc/AutomationTest.h"
+#include "ScriptDisassembler.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMultiBranchFusedGotoIfNotTest, "AdvancedControlFlow.Compiler.MultiBranch.FusedGotoIfNot",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMultiBranchOldFunctionPinTest, "AdvancedControlFlow.Compiler.MultiBranch.OldFunctionPin",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMultiBranchLazyConditionTest, "AdvancedControlFlow.Compiler.MultiBranch.LazyCondition",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMultiBranchSharedConditionTest, "AdvancedControlFlow.Compiler.MultiBranch.SharedCondition",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMultiBranchHitCountOrderTest, "AdvancedControlFlow.Compiler.MultiBranch.HitCountOrder",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+namespace
+{
+class FDisassemblyOutputDevice : public FOutputDevice
+{
+public:
+	virtual void Serialize(const TCHAR* V, ELogVerbosity::Type Verbosity, const FName& Category) override
+	{
+		Text += V;
+		Text += TEXT("\n");
+	}
+
+	FString Text;
+};
+
+FString DisassembleTestFunction(const FAdvancedControlFlowTestBlueprint& Blueprint)
+{
+	UClass* GeneratedClass = Blueprint.GetBlueprint()->GeneratedClass;
+	if (GeneratedClass == nullptr)
+	{
+		return FString();
+	}
+	UFunction* Function = GeneratedClass->FindFunctionByName(FAdvancedControlFlowTestBlueprint::TestFunctionName);
+	if (Function == nullptr)
+	{
+		return FString();
+	}
+
+	FDisassemblyOutputDevice Output;
+	FKismetBytecodeDisassembler Disassembler(Output);
+	Disassembler.DisassembleStructure(Function);
+	return Output.Text;
+}
+}	 // namespace
+
+bool FMultiBranchFusedGotoIfNotTest::RunTest(const FString& Parameters)
+{
+	// Condition N: RecordBool(1 + N, Conds[N])
+	struct FTestCase
+	{
+		TArray<bool> Conds;
+		FString ExpectedCase;
+	};
+	const TArray<FTestCase> TestCases = {
+		{{true, false, false}, TEXT("10")},
+		{{false, true, true}, TEXT("11")},
+		{{false, false, true}, TEXT("12")},
+		{{false, false, false}, TEXT("99")},
+	};
+
+	for (const FTestCase& TestCase : TestCases)
+	{
+		FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestMultiBranchFusedGotoIfNot"));
+		UK2Node_MultiBranch* Node = Blueprint.SpawnMultiBranch(TestCase.Conds.Num());
+		const TArray<CasePinPair> CasePairs = Node->GetCasePinPairs();
+		for (int32 CaseIndex = 0; CaseIndex < CasePairs.Num(); ++CaseIndex)
+		{
+			Blueprint.Link(Blueprint.SpawnRecordBool(1 + CaseIndex, TestCase.Conds[CaseIndex]), CasePairs[CaseIndex].Key);
+		}
+		if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+		{
+			continue;
+		}
+
+		// Each case jumps on the condition itself, so the condition is not inverted by Not_PreBool.
+		const FString Disassembly = DisassembleTestFunction(Blueprint);
+		TestTrue(TEXT("The conditions should be called"), Disassembly.Contains(TEXT("RecordBool")));
+		TestFalse(TEXT("The conditions should not be inverted"),
+			Disassembly.Contains(GET_FUNCTION_NAME_STRING_CHECKED(UKismetMathLibrary, Not_PreBool)));
+
+		const FString Records = Blueprint.Run();
+		TestTrue(FString::Printf(TEXT("The first true case should be executed (%s)"), *Records),
+			Records.EndsWith(FString::Printf(TEXT(",%s"), *TestCase.ExpectedCase)));
+	}
+
+	return true;
+}
+
+bool FMultiBranchOldFunctionPinTest::RunTest(const FString& Parameters)
+{
+	// The node saved by the old version has the hidden pin of Not_PreBool before the execution pin.
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestMultiBranchOldFunctionPin"));
+	UK2Node_MultiBranch* Node = Blueprint.SpawnMultiBranch(2);
+	const TArray<CasePinPair> CasePairs = Node->GetCasePinPairs();
+	Blueprint.Link(Blueprint.SpawnRecordBool(1, false), CasePairs[0].Key);
+	Blueprint.Link(Blueprint.SpawnRecordBool(2, true), CasePairs[1].Key);
+
+	const FName FunctionPinName = GET_FUNCTION_NAME_CHECKED(UKismetMathLibrary, Not_PreBool);
+	FCreatePinParams Params;
+	Params.Index = 0;
+	UEdGraphPin* FunctionPin =
+		Node->CreatePin(EGPD_Input, UEdGraphSchema_K2::PC_Object, UKismetMathLibrary::StaticClass(), FunctionPinName, Params);
+	FunctionPin->bDefaultValueIsReadOnly = true;
+	FunctionPin->bNotConnectable = true;
+	FunctionPin->bHidden = true;
+
+	Node->ReconstructNode();
+
+	TestNull(TEXT("The old function pin should be discarded"), Node->FindPin(FunctionPinName));
+	TestEqual(TEXT("The node should have the execution pins and the case pins"), Node->Pins.Num(), 2 + 2 * 2);
+	TestTrue(TEXT("The execution pin should be the first pin"), Node->Pins[0]->PinName == UEdGraphSchema_K2::PN_Execute);
+	const TArray<CasePinPair> NewCasePairs = Node->GetCasePinPairs();
+	if (TestEqual(TEXT("The number of the cases should be kept"), NewCasePairs.Num(), 2))
+	{
+		for (int32 CaseIndex = 0; CaseIndex < NewCasePairs.Num(); ++CaseIndex)
+		{
+			TestTrue(FString::Printf(TEXT("The links of Case %d should be kept"), CaseIndex),
+				(NewCasePairs[CaseIndex].Key->LinkedTo.Num() == 1) && (NewCasePairs[CaseIndex].Value->LinkedTo.Num() == 1));
+		}
+	}
+
+	if (TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+	{
+		TestTrue(TEXT("The true case should be executed"), Blueprint.Run().EndsWith(TEXT(",11")));
+	}
+
+	return true;
+}
+
+bool FMultiBranchLazyConditionTest::RunTest(const FString& Parameters)
+{
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestMultiBranchLazy"));
+	UK2Node_MultiBranch* Node = Blueprint.SpawnMultiBranch(3);
+	const TArray<CasePinPair> CasePairs = Node->GetCasePinPairs();
+	Blueprint.Link(Blueprint.SpawnRecordBool(1, false), CasePairs[0].Key);
+	Blueprint.Link(Blueprint.SpawnRecordBool(2, true), CasePairs[1].Key);
+	Blueprint.Link(Blueprint.SpawnRecordBool(3, true), CasePairs[2].Key);
+	if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+	{
+		return false;
+	}
+
+	// RecordBool(3) is behind the case which is never reached.
+	TestEqual(TEXT("The conditions after the true one should not be evaluated"), Blueprint.Run(), FString(TEXT("1,2,11")));
+
+	return true;
+}
+
+bool FMultiBranchSharedConditionTest::RunTest(const FString& Parameters)
+{
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestMultiBranchShared"));
+	UK2Node_MultiBranch* Node = Blueprint.SpawnMultiBranch(3);
+	const TArray<CasePinPair> CasePairs = Node->GetCasePinPairs();
+	UEdGraphPin* SharedPin = Blueprint.SpawnRecordBool(1, false);
+	Blueprint.Link(SharedPin, CasePairs[0].Key);
+	Blueprint.Link(Blueprint.SpawnRecordBool(2, false), CasePairs[1].Key);
+	Blueprint.Link(SharedPin, CasePairs[2].Key);
+	if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("The shared condition should be evaluated once"), Blueprint.Run(), FString(TEXT("1,2,99")));
+
+	return true;
+}
+
+bool FMultiBranchHitCountOrderTest::RunTest(const FString& Parameters)
+{
+	// Case 2 has the most hits, so the conditions are tested in the order of Case 2, 0, 1.
+	//   Condition N: RecordBool(1 + N, Conds[N])
+	struct FTestCase
+	{
+		TArray<bool> Conds;
+		FString Expected;
+		FString ExpectedInPinOrder;
+	};
+	const TArray<FTestCase> TestCases = {
+		// The hot case is taken after one evaluation.
+		{{false, false, true}, TEXT("3,12"), TEXT("1,2,3,12")},
+		{{true, false, false}, TEXT("3,1,10"), TEXT("1,10")},
+		{{false, true, false}, TEXT("3,1,2,11"), TEXT("1,2,11")},
+		{{false, false, false}, TEXT("3,1,2,99"), TEXT("1,2,3,99")},
+	};
+
+	for (const FTestCase& TestCase : TestCases)
+	{
+		// The hit counts are used only if the node is marked as mutually exclusive.
+		for (bool bConditionsMutuallyExclusive : {true, false})
+		{
+			FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestMultiBranchHitCountOrder"));
+			UK2Node_MultiBranch* Node = Blueprint.SpawnMultiBranch(TestCase.Conds.Num());
+			Node->bConditionsMutuallyExclusive = bConditionsMutuallyExclusive;
+			const TArray<CasePinPair> CasePairs = Node->GetCasePinPairs();
+			for (int32 CaseIndex = 0; CaseIndex < CasePairs.Num(); ++CaseIndex)
+			{
+				Blueprint.Link(Blueprint.SpawnRecordBool(1 + CaseIndex, TestCase.Conds[CaseIndex]), CasePairs[CaseIndex].Key);
+			}
+
+			const FString NodeId = Node->NodeGuid.ToString(EGuidFormats::Digits);
+			FAdvancedControlFlowCaseHitCounter::Get().SetHitCounts(NodeId, {1, 0, 100});
+			const bool bCompiled = Blueprint.Compile();
+			FAdvancedControlFlowCaseHitCounter::Get().SetHitCounts(NodeId, {});
+			if (!TestTrue(TEXT("The Blueprint should be compiled"), bCompiled))
+			{
+				continue;
+			}
+
+			if (bConditionsMutuallyExclusive)
+			{
+				TestEqual(TEXT("The conditions should be tested in the hit count order"), Blueprint.Run(), TestCase.Expected);
+			}
+			else
+			{
+				TestEqual(
+					TEXT("The conditions should be tested in the pin order"), Blueprint.Run(), TestCase.ExpectedInPinOrder);
+			}
+		}
+	}
+
+	return true;
+}
+
+#endif
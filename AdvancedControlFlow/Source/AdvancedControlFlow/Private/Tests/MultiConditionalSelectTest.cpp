@@ -0,0 +1,112 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowTestUtils.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_MultiConditionalSelect.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMultiConditionalSelectFirstMatchTest,
+	"AdvancedControlFlow.Compiler.MultiConditionalSelect.FirstMatch",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMultiConditionalSelectDefaultTest, "AdvancedControlFlow.Compiler.MultiConditionalSelect.Default",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMultiConditionalSelectRepeatedReadTest,
+	"AdvancedControlFlow.Compiler.MultiConditionalSelect.RepeatedRead",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+namespace
+{
+// Multi-Conditional Select -> Return Value
+//   Option N: RecordInt(10 + N, 100 + N), Condition N: RecordBool(1 + N, Conds[N])
+//   Default: RecordInt(19, 999)
+UK2Node_MultiConditionalSelect* SpawnMultiConditionalSelect(FAdvancedControlFlowTestBlueprint& Blueprint, const TArray<bool>& Conds)
+{
+	UEdGraphPin* ReturnValuePin =
+		Blueprint.AddReturnValue(FAdvancedControlFlowBenchmarkUtils::MakePinType(UEdGraphSchema_K2::PC_Int));
+	Blueprint.Link(Blueprint.GetEntryThenPin(), Blueprint.GetResultExecPin());
+
+	UK2Node_MultiConditionalSelect* Node = Blueprint.SpawnNode<UK2Node_MultiConditionalSelect>();
+	Node->SetCasePinCount(Conds.Num());
+	// Fix the type of the options at first.
+	Blueprint.Link(Node->GetReturnValuePin(), ReturnValuePin);
+
+	const TArray<CasePinPair> CasePairs = Node->GetCasePinPairs();
+	for (int32 CaseIndex = 0; CaseIndex < CasePairs.Num(); ++CaseIndex)
+	{
+		Blueprint.Link(Blueprint.SpawnRecordInt(10 + CaseIndex, 100 + CaseIndex), CasePairs[CaseIndex].Key);
+		Blueprint.Link(Blueprint.SpawnRecordBool(1 + CaseIndex, Conds[CaseIndex]), CasePairs[CaseIndex].Value);
+	}
+	Blueprint.Link(Blueprint.SpawnRecordInt(19, 999), Node->GetDefaultOptionPin());
+
+	return Node;
+}
+}	 // namespace
+
+bool FMultiConditionalSelectFirstMatchTest::RunTest(const FString& Parameters)
+{
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestMultiConditionalSelectFirstMatch"));
+	SpawnMultiConditionalSelect(Blueprint, {false, true, true});
+	if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+	{
+		return false;
+	}
+
+	int32 ReturnValue = 0;
+	const FString Records = Blueprint.RunWithReturnValue(ReturnValue);
+	TestEqual(TEXT("The option of the first true condition should be selected"), ReturnValue, 101);
+	TestEqual(TEXT("Only the selected option and the conditions until the first true one should be evaluated"), Records,
+		FString(TEXT("1,2,11")));
+
+	return true;
+}
+
+bool FMultiConditionalSelectDefaultTest::RunTest(const FString& Parameters)
+{
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestMultiConditionalSelectDefault"));
+	SpawnMultiConditionalSelect(Blueprint, {false, false});
+	if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+	{
+		return false;
+	}
+
+	int32 ReturnValue = 0;
+	const FString Records = Blueprint.RunWithReturnValue(ReturnValue);
+	TestEqual(TEXT("The default option should be selected"), ReturnValue, 999);
+	TestEqual(TEXT("Only the default option should be evaluated"), Records, FString(TEXT("1,2,19")));
+
+	return true;
+}
+
+bool FMultiConditionalSelectRepeatedReadTest::RunTest(const FString& Parameters)
+{
+	// Entry -> RecordExec(Multi-Conditional Select) -> Result (Return Value: Multi-Conditional Select)
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestMultiConditionalSelectRepeatedRead"));
+	UK2Node_MultiConditionalSelect* Node = SpawnMultiConditionalSelect(Blueprint, {false, true});
+	UEdGraphNode* RecordExecNode = Blueprint.SpawnRecordExec(0)->GetOwningNode();
+	Blueprint.Link(Blueprint.GetEntryThenPin(), RecordExecNode->FindPinChecked(UEdGraphSchema_K2::PN_Execute));
+	Blueprint.Link(RecordExecNode->FindPinChecked(UEdGraphSchema_K2::PN_Then), Blueprint.GetResultExecPin());
+	Blueprint.Link(Node->GetReturnValuePin(), RecordExecNode->FindPinChecked(TEXT("Id")));
+	if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+	{
+		return false;
+	}
+
+	// The pure node is evaluated again for each node which reads the output.
+	int32 ReturnValue = 0;
+	const FString Records = Blueprint.RunWithReturnValue(ReturnValue);
+	TestEqual(TEXT("The second read should return the same option"), ReturnValue, 101);
+	TestEqual(TEXT("Each read should select the option again"), Records, FString(TEXT("1,2,11,101,1,2,11")));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,158 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowTestUtils.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_SwitchExec.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSwitchExecDispatchTest, "AdvancedControlFlow.Compiler.SwitchExec.Dispatch",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSwitchExecDuplicatedCaseValueTest, "AdvancedControlFlow.Compiler.SwitchExec.DuplicatedCaseValue",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSwitchExecCaseValueLiteralTest, "AdvancedControlFlow.Compiler.SwitchExec.CaseValueLiteral",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+namespace
+{
+// Entry -> Switch Exec (Selection: Input) -[Case N]-> RecordExec(10 + N)
+//                                         -[Default]-> RecordExec(99)
+UK2Node_SwitchExec* SpawnSwitchExec(FAdvancedControlFlowTestBlueprint& Blueprint, const TArray<int32>& CaseValues)
+{
+	UEdGraphPin* InputPin = Blueprint.AddInput(FAdvancedControlFlowBenchmarkUtils::MakePinType(UEdGraphSchema_K2::PC_Int));
+
+	UK2Node_SwitchExec* Node = Blueprint.SpawnNode<UK2Node_SwitchExec>();
+	Node->SetCasePinCount(CaseValues.Num());
+	Blueprint.Link(Blueprint.GetEntryThenPin(), Node->GetExecPin());
+	// Fix the type of the case values at first.
+	Blueprint.Link(InputPin, Node->GetSelectionPin());
+
+	const TArray<CasePinPair> CasePairs = Node->GetCasePinPairs();
+	for (int32 CaseIndex = 0; CaseIndex < CasePairs.Num(); ++CaseIndex)
+	{
+		Blueprint.SetDefaultValue(CasePairs[CaseIndex].Key, FString::FromInt(CaseValues[CaseIndex]));
+		Blueprint.Link(CasePairs[CaseIndex].Value, Blueprint.SpawnRecordExec(10 + CaseIndex));
+	}
+	Blueprint.Link(Node->GetDefaultExecPin(), Blueprint.SpawnRecordExec(99));
+
+	return Node;
+}
+}	 // namespace
+
+bool FSwitchExecDispatchTest::RunTest(const FString& Parameters)
+{
+	// The case values are not sorted so that the sorting for the binary decision tree is also tested.
+	// The leaf of the tree tests 3 cases or less one by one, so 4 and 7 cases are split.
+	const TArray<TArray<int32>> CaseValueSets = {
+		{9, -7, 0},
+		{8, -1, 3, -2},
+		{MAX_int32, -1000, 64, -1, 0, MIN_int32, 2},
+	};
+
+	for (const TArray<int32>& CaseValues : CaseValueSets)
+	{
+		FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestSwitchExecDispatch"));
+		SpawnSwitchExec(Blueprint, CaseValues);
+		if (!TestTrue(FString::Printf(TEXT("The Blueprint with %d cases should be compiled"), CaseValues.Num()),
+				Blueprint.Compile()))
+		{
+			continue;
+		}
+
+		TSet<int32> NonCaseValues;
+		for (int32 CaseIndex = 0; CaseIndex < CaseValues.Num(); ++CaseIndex)
+		{
+			const int32 Value = CaseValues[CaseIndex];
+			TestEqual(FString::Printf(TEXT("%d should go to case %d"), Value, CaseIndex), Blueprint.Run(Value),
+				FString::FromInt(10 + CaseIndex));
+
+			// The values next to the case values check the boundaries of the decision tree.
+			if (Value > MIN_int32)
+			{
+				NonCaseValues.Add(Value - 1);
+			}
+			if (Value < MAX_int32)
+			{
+				NonCaseValues.Add(Value + 1);
+			}
+		}
+		for (int32 Value : NonCaseValues)
+		{
+			if (!CaseValues.Contains(Value))
+			{
+				TestEqual(FString::Printf(TEXT("%d should go to the default"), Value), Blueprint.Run(Value), FString(TEXT("99")));
+			}
+		}
+	}
+
+	return true;
+}
+
+bool FSwitchExecDuplicatedCaseValueTest::RunTest(const FString& Parameters)
+{
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestSwitchExecDuplicatedCaseValue"));
+	SpawnSwitchExec(Blueprint, {1, 2, 1});
+	if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("The duplicated case value should be warned"),
+		Blueprint.CountMessages(EMessageSeverity::Warning, TEXT("has the same value as the previous case")), 1);
+	TestEqual(TEXT("The first case should win"), Blueprint.Run(1), FString(TEXT("10")));
+	TestEqual(TEXT("The other case should not be affected"), Blueprint.Run(2), FString(TEXT("11")));
+	TestEqual(TEXT("The other value should go to the default"), Blueprint.Run(3), FString(TEXT("99")));
+
+	return true;
+}
+
+bool FSwitchExecCaseValueLiteralTest::RunTest(const FString& Parameters)
+{
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestSwitchExecCaseValueLiteral"));
+	UK2Node_SwitchExec* Node = SpawnSwitchExec(Blueprint, {0});
+	UEdGraphPin* CaseKeyPin = Node->GetCasePinPairs()[0].Key;
+
+	const TArray<TPair<FString, int64>> ValidLiterals = {
+		{TEXT("0"), 0},
+		{TEXT("-5"), -5},
+		{TEXT("+5"), 5},
+		{TEXT("2147483647"), MAX_int32},
+		{TEXT("-2147483648"), MIN_int32},
+	};
+	for (const TPair<FString, int64>& Literal : ValidLiterals)
+	{
+		CaseKeyPin->DefaultValue = Literal.Key;
+		int64 Value = 0;
+		if (TestTrue(FString::Printf(TEXT("\"%s\" should be accepted"), *Literal.Key), Node->GetCaseValue(CaseKeyPin, Value)))
+		{
+			TestEqual(FString::Printf(TEXT("\"%s\" should be parsed"), *Literal.Key), Value, Literal.Value);
+		}
+	}
+
+	const TArray<FString> InvalidLiterals = {
+		TEXT(""), TEXT("-"), TEXT("1.5"), TEXT("1.0"), TEXT(".5"), TEXT("1e3"), TEXT("0x10"), TEXT(" 1"), TEXT("2147483648"),
+		TEXT("-2147483649"), TEXT("99999999999999999999")};
+	for (const FString& Literal : InvalidLiterals)
+	{
+		CaseKeyPin->DefaultValue = Literal;
+		int64 Value = 0;
+		TestFalse(FString::Printf(TEXT("\"%s\" should be rejected"), *Literal), Node->GetCaseValue(CaseKeyPin, Value));
+	}
+
+	// The value which was truncated to 1 before must be the compile error.
+	AddExpectedError(TEXT("has an invalid case value"), EAutomationExpectedErrorFlags::Contains, 0);
+	CaseKeyPin->DefaultValue = TEXT("1.5");
+	TestFalse(TEXT("The Blueprint with the invalid case value should not be compiled"), Blueprint.Compile());
+
+	return true;
+}
+
+#endif
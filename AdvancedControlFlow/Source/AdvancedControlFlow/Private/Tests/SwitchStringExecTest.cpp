@@ -0,0 +1,244 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowSwitchLibrary.h"
+#include "AdvancedControlFlowTestUtils.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_SwitchStringExec.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSwitchStringExecIgnoreCaseTest, "AdvancedControlFlow.Compiler.SwitchStringExec.IgnoreCase",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSwitchStringExecCaseSensitiveTest,
+	"AdvancedControlFlow.Compiler.SwitchStringExec.CaseSensitive",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSwitchStringExecNameTest, "AdvancedControlFlow.Compiler.SwitchStringExec.Name",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSwitchStringExecCollidingCasesTest,
+	"AdvancedControlFlow.Compiler.SwitchStringExec.CollidingCases",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSwitchStringExecDuplicatedCaseValueTest,
+	"AdvancedControlFlow.Compiler.SwitchStringExec.DuplicatedCaseValue",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSwitchStringExecCaseFoldingTest, "AdvancedControlFlow.Runtime.SwitchStringExec.CaseFolding",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter);
+
+namespace
+{
+// Entry -> Switch Exec on String/Name (Selection: Input) -[Case N]-> RecordExec(10 + N)
+//                                                        -[Default]-> RecordExec(99)
+UK2Node_SwitchStringExec* SpawnSwitchStringExec(FAdvancedControlFlowTestBlueprint& Blueprint, const FName& PinCategory,
+	const TArray<FString>& CaseValues, bool bCaseSensitive)
+{
+	UEdGraphPin* InputPin = Blueprint.AddInput(FAdvancedControlFlowBenchmarkUtils::MakePinType(PinCategory));
+
+	UK2Node_SwitchStringExec* Node = Blueprint.SpawnNode<UK2Node_SwitchStringExec>();
+	Node->bCaseSensitive = bCaseSensitive;
+	Node->SetCasePinCount(CaseValues.Num());
+	Blueprint.Link(Blueprint.GetEntryThenPin(), Node->GetExecPin());
+	// Fix the type of the case values at first.
+	Blueprint.Link(InputPin, Node->GetSelectionPin());
+
+	const TArray<CasePinPair> CasePairs = Node->GetCasePinPairs();
+	for (int32 CaseIndex = 0; CaseIndex < CasePairs.Num(); ++CaseIndex)
+	{
+		Blueprint.SetDefaultValue(CasePairs[CaseIndex].Key, CaseValues[CaseIndex]);
+		Blueprint.Link(CasePairs[CaseIndex].Value, Blueprint.SpawnRecordExec(10 + CaseIndex));
+	}
+	Blueprint.Link(Node->GetDefaultExecPin(), Blueprint.SpawnRecordExec(99));
+
+	return Node;
+}
+
+// Same as FKCHandler_SwitchStringExec.
+int32 GetBucketCount(int32 CaseCount)
+{
+	return FMath::RoundUpToPowerOfTwo(FMath::Max(CaseCount * ((CaseCount <= 16) ? 4 : 2), 1));
+}
+}	 // namespace
+
+bool FSwitchStringExecIgnoreCaseTest::RunTest(const FString& Parameters)
+{
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestSwitchStringExecIgnoreCase"));
+	SpawnSwitchStringExec(Blueprint, UEdGraphSchema_K2::PC_String, {TEXT("Apple"), TEXT("Banana"), TEXT("Cherry")}, false);
+	if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+	{
+		return false;
+	}
+
+	const TArray<TPair<FString, FString>> Selections = {
+		{TEXT("Apple"), TEXT("10")},
+		{TEXT("apple"), TEXT("10")},
+		{TEXT("BANANA"), TEXT("11")},
+		{TEXT("cHeRrY"), TEXT("12")},
+		{TEXT("Durian"), TEXT("99")},
+		{TEXT(""), TEXT("99")},
+		{TEXT("Apple "), TEXT("99")},
+		{TEXT("Appl"), TEXT("99")},
+	};
+	for (const TPair<FString, FString>& Selection : Selections)
+	{
+		TestEqual(FString::Printf(TEXT("\"%s\" should go to %s"), *Selection.Key, *Selection.Value), Blueprint.Run(Selection.Key),
+			Selection.Value);
+	}
+
+	return true;
+}
+
+bool FSwitchStringExecCaseSensitiveTest::RunTest(const FString& Parameters)
+{
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestSwitchStringExecCaseSensitive"));
+	SpawnSwitchStringExec(Blueprint, UEdGraphSchema_K2::PC_String, {TEXT("Apple"), TEXT("apple")}, true);
+	if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("The values which differ only in case should not be duplicated"),
+		Blueprint.CountMessages(EMessageSeverity::Warning, TEXT("has the same value as the previous case")), 0);
+	TestEqual(TEXT("\"Apple\" should go to case 0"), Blueprint.Run(FString(TEXT("Apple"))), FString(TEXT("10")));
+	TestEqual(TEXT("\"apple\" should go to case 1"), Blueprint.Run(FString(TEXT("apple"))), FString(TEXT("11")));
+	TestEqual(TEXT("\"APPLE\" should go to the default"), Blueprint.Run(FString(TEXT("APPLE"))), FString(TEXT("99")));
+
+	return true;
+}
+
+bool FSwitchStringExecNameTest::RunTest(const FString& Parameters)
+{
+	// The names are always compared without case even if bCaseSensitive is true.
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestSwitchStringExecName"));
+	SpawnSwitchStringExec(Blueprint, UEdGraphSchema_K2::PC_Name, {TEXT("Apple"), TEXT("Banana_1"), TEXT("None")}, true);
+	if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("Apple should go to case 0"), Blueprint.Run(FName(TEXT("APPLE"))), FString(TEXT("10")));
+	TestEqual(TEXT("The number of the name should be compared"), Blueprint.Run(FName(TEXT("banana_1"))), FString(TEXT("11")));
+	TestEqual(TEXT("The other number should go to the default"), Blueprint.Run(FName(TEXT("Banana_2"))), FString(TEXT("99")));
+	TestEqual(TEXT("None should go to case 2"), Blueprint.Run(FName()), FString(TEXT("12")));
+	TestEqual(TEXT("The other name should go to the default"), Blueprint.Run(FName(TEXT("Cherry"))), FString(TEXT("99")));
+
+	return true;
+}
+
+bool FSwitchStringExecCollidingCasesTest::RunTest(const FString& Parameters)
+{
+	// The buckets have more than one case for every seed, so the seed search fails and the values in the bucket must be
+	// compared one by one.
+	const int32 CaseCount = 100;
+	TArray<FString> CaseValues;
+	for (int32 CaseIndex = 0; CaseIndex < CaseCount; ++CaseIndex)
+	{
+		CaseValues.Add(FString::Printf(TEXT("Case%d"), CaseIndex));
+	}
+
+	const uint32 BucketMask = GetBucketCount(CaseCount) - 1;
+	bool bPerfectHashFound = false;
+	for (int32 Seed = 0; Seed < 256 && !bPerfectHashFound; ++Seed)
+	{
+		TSet<uint32> UsedBuckets;
+		bPerfectHashFound = true;
+		for (const FString& Value : CaseValues)
+		{
+			bool bAlreadyUsed = false;
+			UsedBuckets.Add(
+				UAdvancedControlFlowSwitchLibrary::HashCaseValue(*Value, Value.Len(), Seed, false) & BucketMask, &bAlreadyUsed);
+			bPerfectHashFound &= !bAlreadyUsed;
+		}
+	}
+	if (!TestFalse(TEXT("The case values should collide for every seed"), bPerfectHashFound))
+	{
+		return false;
+	}
+
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestSwitchStringExecCollidingCases"));
+	SpawnSwitchStringExec(Blueprint, UEdGraphSchema_K2::PC_String, CaseValues, false);
+	if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+	{
+		return false;
+	}
+
+	for (int32 CaseIndex = 0; CaseIndex < CaseCount; ++CaseIndex)
+	{
+		const FString Expected = FString::FromInt(10 + CaseIndex);
+		TestEqual(FString::Printf(TEXT("%s should go to case %d"), *CaseValues[CaseIndex], CaseIndex),
+			Blueprint.Run(CaseValues[CaseIndex]), Expected);
+		TestEqual(FString::Printf(TEXT("%s in upper case should go to case %d"), *CaseValues[CaseIndex], CaseIndex),
+			Blueprint.Run(CaseValues[CaseIndex].ToUpper()), Expected);
+	}
+	TestEqual(TEXT("The other value should go to the default"), Blueprint.Run(FString::Printf(TEXT("Case%d"), CaseCount)),
+		FString(TEXT("99")));
+
+	return true;
+}
+
+bool FSwitchStringExecDuplicatedCaseValueTest::RunTest(const FString& Parameters)
+{
+	FAdvancedControlFlowTestBlueprint Blueprint(TEXT("ACFTestSwitchStringExecDuplicatedCaseValue"));
+	SpawnSwitchStringExec(Blueprint, UEdGraphSchema_K2::PC_String, {TEXT("Apple"), TEXT("Banana"), TEXT("APPLE")}, false);
+	if (!TestTrue(TEXT("The Blueprint should be compiled"), Blueprint.Compile()))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("The value which differs only in case should be warned"),
+		Blueprint.CountMessages(EMessageSeverity::Warning, TEXT("has the same value as the previous case")), 1);
+	TestEqual(TEXT("The first case should win"), Blueprint.Run(FString(TEXT("apple"))), FString(TEXT("10")));
+	TestEqual(TEXT("The other case should not be affected"), Blueprint.Run(FString(TEXT("banana"))), FString(TEXT("11")));
+
+	return true;
+}
+
+bool FSwitchStringExecCaseFoldingTest::RunTest(const FString& Parameters)
+{
+	// The values which are equal by the comparison must have the same hash, or the selection goes to the wrong bucket.
+	const TArray<TPair<FString, FString>> Pairs = {
+		{TEXT("Apple"), TEXT("aPPLE")},
+		{TEXT("Z@[`{"), TEXT("z@[`{")},
+		{TEXT("\u00C4pfel"), TEXT("\u00E4pfel")},
+		{TEXT("Stra\u00DFe"), TEXT("STRASSE")},
+		{TEXT(""), TEXT("")},
+	};
+	for (const TPair<FString, FString>& Pair : Pairs)
+	{
+		const bool bEqual = !UAdvancedControlFlowSwitchLibrary::NotEqualStringIgnoreCase(Pair.Key, Pair.Value);
+		TestEqual(FString::Printf(TEXT("The names \"%s\" and \"%s\" should be compared as the strings"), *Pair.Key, *Pair.Value),
+			!UAdvancedControlFlowSwitchLibrary::NotEqualNameIgnoreCase(FName(*Pair.Key), FName(*Pair.Value)), bEqual);
+		if (!bEqual)
+		{
+			continue;
+		}
+
+		for (int32 Seed = 0; Seed < 256; ++Seed)
+		{
+			if (UAdvancedControlFlowSwitchLibrary::HashCaseValue(*Pair.Key, Pair.Key.Len(), Seed, false) !=
+				UAdvancedControlFlowSwitchLibrary::HashCaseValue(*Pair.Value, Pair.Value.Len(), Seed, false))
+			{
+				AddError(FString::Printf(
+					TEXT("\"%s\" and \"%s\" should have the same hash with seed %d"), *Pair.Key, *Pair.Value, Seed));
+				break;
+			}
+		}
+	}
+
+	// Only ASCII letters are folded.
+	TestFalse(TEXT("ASCII letters should be folded"),
+		UAdvancedControlFlowSwitchLibrary::NotEqualStringIgnoreCase(TEXT("Apple"), TEXT("aPPLE")));
+	TestTrue(TEXT("The symbols next to the letters should not be folded"),
+		UAdvancedControlFlowSwitchLibrary::NotEqualStringIgnoreCase(TEXT("@"), TEXT("`")));
+	TestTrue(TEXT("Non-ASCII letters should not be folded"),
+		UAdvancedControlFlowSwitchLibrary::NotEqualStringIgnoreCase(TEXT("\u00C4"), TEXT("\u00E4")));
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,55 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/EngineVersionComparison.h"
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+#include "AssetData.h"
+#else
+#include "AssetRegistry/AssetData.h"
+#endif
+
+class UBlueprint;
+
+// Statistics of the nodes of this plugin in a Blueprint.
+struct FAdvancedControlFlowNodeStatistics
+{
+	int32 NodeCount = 0;
+	int32 MaxCaseCount = 0;
+	TMap<FString, int32> NodeCountsPerType;
+
+	// "MultiBranch=2,SwitchExec=1"
+	FString GetNodeCountsPerTypeString() const;
+};
+
+// Add the statistics of the nodes as the asset registry tags of the Blueprints when they are saved.
+// The Blueprints which use the nodes can be found without loading them (e.g. to validate the plugin upgrade).
+class FAdvancedControlFlowAssetRegistryTags
+{
+public:
+	static const FName NodeCountTagName;
+	static const FName MaxCaseCountTagName;
+	static const FName NodeCountsPerTypeTagName;
+
+	static void Register();
+	static void Unregister();
+
+	static FAdvancedControlFlowNodeStatistics GetNodeStatistics(const UBlueprint* Blueprint);
+
+	// Find the Blueprints under the package paths (all paths if empty) and with the package names (all names if empty).
+	// The Blueprints which have no tags do not use the nodes, or were saved before the tags were introduced.
+	// The results are sorted by the package names.
+	static void FindBlueprints(const TArray<FString>& Paths, const TArray<FString>& PackageNames,
+		TArray<FAssetData>& OutTaggedAssets, TArray<FAssetData>& OutUntaggedAssets);
+
+private:
+	static FDelegateHandle OnGetExtraObjectTagsHandle;
+};
@@ -0,0 +1,59 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphPin.h"
+
+class UBlueprint;
+class UK2Node_CallFunction;
+class UK2Node_FunctionEntry;
+class UK2Node_FunctionResult;
+
+// Helper functions to build the Blueprints for the benchmark commandlets.
+struct FAdvancedControlFlowBenchmarkUtils
+{
+	// Create a Blueprint (parent class is UObject) in the transient package.
+	static UBlueprint* CreateTransientBlueprint(const FString& BaseName);
+
+	// Add a function graph which has both entry node and result node.
+	static UEdGraph* AddFunctionGraph(UBlueprint* Blueprint, const FName& FunctionName, UK2Node_FunctionEntry*& OutEntryNode,
+		UK2Node_FunctionResult*& OutResultNode);
+
+	template <typename NodeType>
+	static NodeType* SpawnNode(UEdGraph* Graph, UClass* NodeClass = NodeType::StaticClass())
+	{
+		NodeType* Node = NewObject<NodeType>(Graph, NodeClass);
+		Graph->AddNode(Node, false, false);
+		Node->CreateNewGuid();
+		Node->PostPlacedNewNode();
+		Node->AllocateDefaultPins();
+
+		return Node;
+	}
+
+	static UK2Node_CallFunction* SpawnCallFunctionNode(UEdGraph* Graph, UClass* FunctionClass, const FName& FunctionName);
+
+	static FEdGraphPinType MakePinType(const FName& PinCategory, UObject* PinSubCategoryObject = nullptr,
+		EPinContainerType ContainerType = EPinContainerType::None);
+
+	// Make the Blueprint collectable and run the garbage collection.
+	static void DiscardBlueprint(UBlueprint* Blueprint);
+
+	// Parse the comma separated integer list (e.g. -CaseCounts=2,8,32).
+	static TArray<int32> ParseIntList(const FString& Params, const TCHAR* Key, const TArray<int32>& DefaultValues);
+	static TArray<FString> ParseStringList(const FString& Params, const TCHAR* Key, const TArray<FString>& DefaultValues);
+
+	static double GetMedian(TArray<double> Values);
+
+	// Quote the field of the CSV report.
+	static FString EscapeCsvField(const FString& Field);
+};
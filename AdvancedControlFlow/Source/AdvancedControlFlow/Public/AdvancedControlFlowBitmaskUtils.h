@@ -0,0 +1,46 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdGraph/EdGraphPin.h"
+
+class UEdGraphNode;
+struct FCasePinPairEntry;
+
+// Helper functions of the nodes whose cases are the bit positions of the bitmask (Bitmask Multi-Branch, Bitmask
+// Conditional Sequence).
+struct FAdvancedControlFlowBitmaskUtils
+{
+	static const FName BitmaskPinName;
+
+	// Create the Bitmask pin (In, Integer/Integer64). The type follows the connected pin.
+	static UEdGraphPin* CreateBitmaskPin(UEdGraphNode* Node, int32 PinIndex);
+
+	// Create the case bit pin (In, Integer, Literal only). The Bitmask pin must be created before to limit the default bit.
+	static UEdGraphPin* CreateCaseBitPin(UEdGraphNode* Node, const FString& PinName, const FString& PinFriendlyName,
+		int32 PinIndex, const TArray<FCasePinPairEntry>& CasePinPairEntries, bool bReallocatingCasePinPairs);
+
+	// Restore the type of the Bitmask pin from the old pins during the reconstruction.
+	static void RestoreBitmaskPinType(UEdGraphPin* BitmaskPin, const TArray<UEdGraphPin*>& OldPins);
+
+	// Determine the type of the Bitmask pin from the connected pin. Return true if the type is changed.
+	static bool ResolveBitmaskPinType(UEdGraphPin* BitmaskPin);
+
+	// Only Integer and Integer64 (including Bitmask enum) can be connected to the Bitmask pin.
+	static bool IsBitmaskConnectionDisallowed(
+		const UEdGraphPin* BitmaskPin, const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason);
+
+	// The number of the bits of the Bitmask pin. 0 if the type is undetermined.
+	static int32 GetBitCount(const UEdGraphPin* BitmaskPin);
+
+	// Get the bit position from the literal on the case bit pin.
+	static bool GetCaseBit(const UEdGraphPin* CaseKeyPin, int32& OutBit);
+};
@@ -0,0 +1,35 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "AdvancedControlFlowCollapseChainsCommandlet.generated.h"
+
+// Collapse the Branch/Select chains of the Blueprints into Multi-Branch/Multi-Conditional Select nodes (see
+// FAdvancedControlFlowGraphRefactoring), and report the node count and the bytecode size before and after it as CSV.
+//
+// Usage:
+//   UnrealEditor-Cmd <Project> -run=AdvancedControlFlowCollapseChains -nullrhi -unattended
+//     [-Output=<CSV file path>] [-Paths=/Game,/MyPlugin] [-Save]
+//
+// The Blueprints are not saved unless -Save is specified (dry run).
+// The Blueprints which fail to compile after collapsing the chains are never saved.
+UCLASS()
+class UAdvancedControlFlowCollapseChainsCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAdvancedControlFlowCollapseChainsCommandlet(const FObjectInitializer& ObjectInitializer);
+
+	// Override from UCommandlet
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,32 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "AdvancedControlFlowCompileBenchmarkCommandlet.generated.h"
+
+// Measure the compile cost of the Blueprints which are built from the nodes of this plugin.
+//
+// Usage:
+//   UnrealEditor-Cmd <Project> -run=AdvancedControlFlowCompileBenchmark -nullrhi -unattended
+//     [-Output=<JSON file path>] [-NodeTypes=MultiBranch,ConditionalSequence,MultiConditionalSelect]
+//     [-CaseCounts=2,8,32,128,512] [-NodeCounts=1,10,100,1000] [-Iterations=5] [-MaxCasesPerGraph=65536]
+UCLASS()
+class UAdvancedControlFlowCompileBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAdvancedControlFlowCompileBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer);
+
+	// Override from UCommandlet
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,36 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "AdvancedControlFlowCompileCheckCommandlet.generated.h"
+
+// Compile the Blueprints which use the nodes of this plugin, and report the result of each Blueprint as CSV.
+// The Blueprints are found by the asset registry tags (see FAdvancedControlFlowAssetRegistryTags) without loading them,
+// and are compiled in batches by the engine's Blueprint compilation manager.
+//
+// Usage:
+//   UnrealEditor-Cmd <Project> -run=AdvancedControlFlowCompileCheck -nullrhi -unattended
+//     [-Output=<CSV file path>] [-Paths=/Game,/MyPlugin] [-BatchSize=32] [-IncludeUntagged]
+//
+// -IncludeUntagged also compiles the Blueprints which have no tags (i.e. saved before the tags were introduced).
+// The compile time is measured per batch. Specify -BatchSize=1 to measure the compile time of each Blueprint.
+UCLASS()
+class UAdvancedControlFlowCompileCheckCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAdvancedControlFlowCompileCheckCommandlet(const FObjectInitializer& ObjectInitializer);
+
+	// Override from UCommandlet
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,106 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdGraph/EdGraphPin.h"
+
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+class UK2Node_CallFunction;
+
+// Translate the function graphs into the static UFUNCTIONs of a UBlueprintFunctionLibrary in a C++ module.
+//
+// Supported nodes:
+//   Execution: Function Entry/Result, Multi-Branch, Conditional Sequence, Switch Exec, Switch Exec on String/Name,
+//              Branch, Sequence, Reroute, Call Function (static native functions)
+//   Pure:      Multi-Conditional Select, Reroute, Call Function (static native functions)
+// Supported types: Boolean, Byte/Enum, Integer, Integer64, Float/Double, String, Name
+//
+// The execution flow is emitted as the structured code (if/else if/switch), so the graphs which have a loop in the
+// execution flow are not supported. The execution pins which are linked to the same node are emitted more than once.
+class FAdvancedControlFlowCppExporter
+{
+public:
+	FAdvancedControlFlowCppExporter(const FString& InModuleName, const FString& InClassName);
+
+	// Translate the function graph. Return false if the graph has unsupported nodes or pins (see GetErrors()).
+	bool AddFunction(UBlueprint* Blueprint, UEdGraph* Graph);
+
+	// Generated files. The paths are relative to the module directory.
+	TMap<FString, FString> GenerateFiles() const;
+
+	const TArray<FString>& GetErrors() const
+	{
+		return Errors;
+	}
+
+private:
+	struct FParam
+	{
+		FString Name;
+		FName PinName;
+		FEdGraphPinType PinType;
+		FString CppType;
+	};
+
+	struct FExportedFunction
+	{
+		FString Name;
+		FString BlueprintClassPath;
+		FName BlueprintFunctionName;
+		TArray<FParam> Inputs;
+		TArray<FParam> Outputs;
+		bool bHasReturnValue = false;
+		TArray<FString> BodyLines;
+	};
+
+	// State while translating one function graph.
+	struct FFunctionContext
+	{
+		FExportedFunction* Function = nullptr;
+		TMap<const UEdGraphPin*, FString> PinVariableMap;
+		TSet<const UEdGraphNode*> VisitingNodes;
+		int32 Indent = 1;
+		bool bFailed = false;
+	};
+
+	FString GenerateBuildRules() const;
+	FString GenerateModuleSource() const;
+	FString GenerateHeader() const;
+	FString GenerateSource() const;
+	FString GenerateRoundTripTestSource() const;
+	FString GetFunctionSignature(const FExportedFunction& Function, bool bWithClassName) const;
+
+	// Statements
+	void EmitLine(FFunctionContext& Context, const FString& Line) const;
+	void EmitExecChain(FFunctionContext& Context, const UEdGraphPin* ExecOutputPin);
+	void EmitExecNode(FFunctionContext& Context, UEdGraphNode* Node);
+	void EmitBlock(FFunctionContext& Context, const FString& Header, const UEdGraphPin* ExecOutputPin);
+
+	// Expressions
+	FString GetInputExpression(FFunctionContext& Context, const UEdGraphPin* InputPin);
+	FString GetOutputExpression(FFunctionContext& Context, const UEdGraphPin* OutputPin);
+	FString GetCallExpression(FFunctionContext& Context, UK2Node_CallFunction* CallNode);
+	FString GetLiteral(FFunctionContext& Context, const UEdGraphPin* Pin);
+
+	bool GetCppType(const FEdGraphPinType& PinType, FString& OutCppType);
+	void AddEnumDependency(const UEnum* Enum);
+	void AddError(FFunctionContext& Context, const UEdGraphNode* Node, const FString& Message);
+
+	FString ModuleName;
+	FString ClassName;
+	TArray<FExportedFunction> Functions;
+	TSet<FString> Includes;
+	TSet<FString> HeaderIncludes;
+	TSet<FString> ModuleDependencies;
+	TArray<FString> Errors;
+};
@@ -0,0 +1,35 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "AdvancedControlFlowExportCommandlet.generated.h"
+
+// Export the function graphs of the Blueprint to a C++ module (see FAdvancedControlFlowCppExporter).
+// The module also contains the automation test which compares the exported functions with the Blueprint functions.
+//
+// Usage:
+//   UnrealEditor-Cmd <Project> -run=AdvancedControlFlowExport -nullrhi -unattended -Blueprint=<Blueprint path>
+//     [-Functions=<Function1>,<Function2>] [-Module=AdvancedControlFlowExported] [-ClassName=<Blueprint name>Native]
+//     [-Output=<Module directory>] [-Verify]
+//
+// -Verify does not write the files, but fails if the exported files are different from the existing files.
+UCLASS()
+class UAdvancedControlFlowExportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAdvancedControlFlowExportCommandlet(const FObjectInitializer& ObjectInitializer);
+
+	// Override from UCommandlet
+	virtual int32 Main(const FString& Params) override;
+};
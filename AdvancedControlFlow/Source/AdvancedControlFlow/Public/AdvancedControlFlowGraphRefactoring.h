@@ -0,0 +1,75 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+
+// Size of a Blueprint before or after the refactoring.
+struct FAdvancedControlFlowBlueprintSize
+{
+	int32 NodeCount = 0;
+	// Total size of the bytecode of the functions in the generated class. -1 if the Blueprint failed to compile.
+	int32 BytecodeSize = -1;
+};
+
+struct FAdvancedControlFlowCollapseResult
+{
+	int32 BranchChainCount = 0;
+	int32 SelectChainCount = 0;
+	FAdvancedControlFlowBlueprintSize Before;
+	FAdvancedControlFlowBlueprintSize After;
+
+	// "Collapsed 2 Branch chains and 1 Select chain (Nodes: 40 -> 31, Bytecode: 2048 -> 1536 bytes)"
+	FText ToText() const;
+};
+
+// Rewrite the chains of the engine nodes into the nodes of this plugin.
+//   Branch chain: Branch nodes whose False pin is linked only to the next Branch node -> Multi-Branch
+//   Select chain: Select nodes (Boolean index) whose False option is linked only to the next Select node
+//                 -> Multi-Conditional Select
+// The links, the default values of the unlinked pins and the node comments are taken over by the new node.
+class FAdvancedControlFlowGraphRefactoring
+{
+public:
+	// The chains which have fewer nodes are not collapsed.
+	static constexpr int32 MinChainLength = 2;
+
+	// The longer chains are split from the head into the chains of this length, because the nodes of the free version
+	// have up to 3 cases.
+#ifdef ACF_FREE_VERSION
+	static constexpr int32 MaxChainLength = 3;
+#else
+	static constexpr int32 MaxChainLength = MAX_int32;
+#endif
+
+	// Get the chain which contains the node ordered from the head. Empty if the node is not in a chain.
+	static TArray<UEdGraphNode*> FindChain(UEdGraphNode* Node);
+
+	// Find all chains in the graph.
+	static void FindChains(UEdGraph* Graph, TArray<TArray<UEdGraphNode*>>& OutChains);
+	static void FindChains(UBlueprint* Blueprint, TArray<TArray<UEdGraphNode*>>& OutChains);
+
+	// Replace the chain with one node. Return the new node, or nullptr if the nodes are not a chain.
+	static UEdGraphNode* CollapseChain(const TArray<UEdGraphNode*>& Chain);
+
+	// Collapse the chains in one transaction. The Blueprint is compiled before and after collapsing them to measure the size.
+	static FAdvancedControlFlowCollapseResult CollapseChains(UBlueprint* Blueprint, const TArray<TArray<UEdGraphNode*>>& Chains);
+
+	// Compile the Blueprint and measure the size.
+	static FAdvancedControlFlowBlueprintSize MeasureBlueprint(UBlueprint* Blueprint);
+
+	// Add the menu entries to the context menu of Branch and Select nodes.
+	static void RegisterMenus();
+	static void UnregisterMenus();
+};
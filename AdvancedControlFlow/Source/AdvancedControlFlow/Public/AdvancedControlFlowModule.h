@@ -18,6 +18,7 @@ class FGraphPanelNodeFactory_AdvancedControlFlow;
 class FAdvancedControlFlowModule : public IModuleInterface
 {
 	TSharedPtr<FGraphPanelNodeFactory_AdvancedControlFlow> GraphPanelNodeFactory_AdvancedControlFlow;
+	FDelegateHandle EndPIEHandle;
 
 public:
 	virtual void StartupModule() override;
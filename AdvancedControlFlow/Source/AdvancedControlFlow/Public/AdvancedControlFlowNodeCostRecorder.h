@@ -0,0 +1,63 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UBlueprint;
+class UEdGraphNode;
+struct FBlueprintCompiledStatement;
+struct FKismetFunctionContext;
+
+// Compile cost of a node of this plugin.
+struct FAdvancedControlFlowNodeCost
+{
+	// The number of the compiled copies of the node (e.g. the node in the macro which is used several times).
+	int32 InstanceCount = 0;
+	// Including the statements of the pure nodes which are moved into the node.
+	int32 StatementCount = 0;
+	int32 FunctionCallCount = 0;
+	int32 LocalCount = 0;
+	// The maximum number of the conditional jumps on a path through the statements of the node.
+	int32 WorstCaseTestCount = 0;
+	// Filled by FAdvancedControlFlowNodeCostRecorder::CollectBytecodeSizes().
+	int32 BytecodeSize = 0;
+};
+
+// Record the statements which the handlers of the nodes emit while the Blueprints are compiled, and attribute them to the
+// source node (the node placed in the Blueprint, not the copy in the intermediate graph).
+// Used by AdvancedControlFlowNodeCostReport commandlet. Nothing is recorded unless StartRecording() is called.
+class FAdvancedControlFlowNodeCostRecorder
+{
+public:
+	static FAdvancedControlFlowNodeCostRecorder& Get();
+
+	// Discard the recorded costs and start recording.
+	void StartRecording();
+	void StopRecording();
+	bool IsRecording() const;
+
+	// Called by the handlers after all statements of the node are appended.
+	void RecordNode(FKismetFunctionContext& Context, UEdGraphNode* Node);
+
+	// Attribute the bytecode of the generated class to the recorded nodes by the debug data.
+	// Must be called after the Blueprint is compiled.
+	void CollectBytecodeSizes(UBlueprint* Blueprint);
+
+	const TMap<UEdGraphNode*, FAdvancedControlFlowNodeCost>& GetNodeCosts() const;
+
+	// Get the maximum number of the conditional jumps on a path from the first statement. The jumps to the outside of the
+	// statements and the backward jumps end the path.
+	static int32 GetWorstCaseTestCount(const TArray<FBlueprintCompiledStatement*>& Statements);
+
+private:
+	bool bRecording = false;
+	TMap<UEdGraphNode*, FAdvancedControlFlowNodeCost> NodeCosts;
+};
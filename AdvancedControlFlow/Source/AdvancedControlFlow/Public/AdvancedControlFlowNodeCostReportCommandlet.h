@@ -0,0 +1,38 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "AdvancedControlFlowNodeCostReportCommandlet.generated.h"
+
+// Compile the Blueprints which use the nodes of this plugin, and report the compile cost of each node as JSON.
+// The cost is the number of the statements, the function calls, the local variables, the worst-case tests per
+// dispatch and the size of the bytecode which are attributed to the node (see FAdvancedControlFlowNodeCostRecorder).
+//
+// Usage:
+//   UnrealEditor-Cmd <Project> -run=AdvancedControlFlowNodeCostReport -nullrhi -unattended
+//     [-Output=<JSON file path>] [-Paths=/Game,/MyPlugin] [-Assets=/Game/BP_A,/Game/BP_B]
+//     [-MaxWorstCaseTests=<N>] [-MaxBytecodeSize=<N>]
+//
+// -Assets limits the Blueprints by the package names. The requested Blueprints are reported even if they have no tags, and
+// the Blueprints which are not found make the commandlet fail.
+// The nodes which exceed -MaxWorstCaseTests or -MaxBytecodeSize are marked as over budget, and the commandlet fails.
+UCLASS()
+class UAdvancedControlFlowNodeCostReportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAdvancedControlFlowNodeCostReportCommandlet(const FObjectInitializer& ObjectInitializer);
+
+	// Override from UCommandlet
+	virtual int32 Main(const FString& Params) override;
+};
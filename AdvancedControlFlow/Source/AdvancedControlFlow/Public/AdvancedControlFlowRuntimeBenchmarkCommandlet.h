@@ -0,0 +1,48 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "AdvancedControlFlowRuntimeBenchmarkCommandlet.generated.h"
+
+// Measure the execution cost of the nodes of this plugin on the Blueprint VM, and compare with the equivalent graphs which are
+// built from the engine nodes (Branch, Sequence and Select).
+//
+// Usage:
+//   UnrealEditor-Cmd <Project> -run=AdvancedControlFlowRuntimeBenchmark -nullrhi -unattended
+//     [-Output=<CSV file path>] [-NodeTypes=MultiBranch,ConditionalSequence,MultiConditionalSelect]
+//     [-CaseCounts=2,8,32,128] [-OptionTypes=Int,Vector,Transform,IntArray] [-Iterations=10000]
+UCLASS()
+class UAdvancedControlFlowRuntimeBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAdvancedControlFlowRuntimeBenchmarkCommandlet(const FObjectInitializer& ObjectInitializer);
+
+	// Override from UCommandlet
+	virtual int32 Main(const FString& Params) override;
+};
+
+// Functions called from the Blueprints built by the runtime benchmark.
+UCLASS()
+class UAdvancedControlFlowBenchmarkLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Used as the body of the cases.
+	UFUNCTION(BlueprintCallable, Category = "AdvancedControlFlow|Benchmark", meta = (BlueprintInternalUseOnly = "true"))
+	static void CountUp();
+
+	static int32 Count;
+};
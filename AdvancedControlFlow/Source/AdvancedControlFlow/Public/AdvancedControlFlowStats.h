@@ -0,0 +1,62 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Stats/Stats.h"
+
+// Stats of the editor-side operations of this plugin.
+// Use "stat AdvancedControlFlow" in the editor. The cycle counters are also shown in Unreal Insights (CPU track).
+DECLARE_STATS_GROUP(TEXT("AdvancedControlFlow"), STATGROUP_AdvancedControlFlow, STATCAT_Advanced);
+
+// Case pin operations.
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Add Case Pin Pair"), STAT_ACF_AddCasePinPair, STATGROUP_AdvancedControlFlow, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Remove Case Pin Pairs"), STAT_ACF_RemoveCasePinPairs, STATGROUP_AdvancedControlFlow, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Reorder Case Pin Pairs"), STAT_ACF_ReorderCasePinPairs, STATGROUP_AdvancedControlFlow, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Get Case Pin Pairs"), STAT_ACF_GetCasePinPairs, STATGROUP_AdvancedControlFlow, );
+DECLARE_CYCLE_STAT_EXTERN(
+	TEXT("Resolve Case Pin Pair Entries"), STAT_ACF_ResolveCasePinPairEntries, STATGROUP_AdvancedControlFlow, );
+DECLARE_CYCLE_STAT_EXTERN(
+	TEXT("Reallocate Pins During Reconstruction"), STAT_ACF_ReallocatePinsDuringReconstruction, STATGROUP_AdvancedControlFlow, );
+
+// Compilation.
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Compile Multi-Branch"), STAT_ACF_CompileMultiBranch, STATGROUP_AdvancedControlFlow, );
+DECLARE_CYCLE_STAT_EXTERN(
+	TEXT("Compile Conditional Sequence"), STAT_ACF_CompileConditionalSequence, STATGROUP_AdvancedControlFlow, );
+DECLARE_CYCLE_STAT_EXTERN(
+	TEXT("Compile Multi-Conditional Select"), STAT_ACF_CompileMultiConditionalSelect, STATGROUP_AdvancedControlFlow, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Compile Switch Exec"), STAT_ACF_CompileSwitchExec, STATGROUP_AdvancedControlFlow, );
+DECLARE_CYCLE_STAT_EXTERN(
+	TEXT("Compile Switch Exec on String/Name"), STAT_ACF_CompileSwitchStringExec, STATGROUP_AdvancedControlFlow, );
+
+// Counters. They are accumulated during the editor session.
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Case Pins Created"), STAT_ACF_NumCasePinsCreated, STATGROUP_AdvancedControlFlow, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(
+	TEXT("Case Pins Destroyed"), STAT_ACF_NumCasePinsDestroyed, STATGROUP_AdvancedControlFlow, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Nodes Compiled"), STAT_ACF_NumNodesCompiled, STATGROUP_AdvancedControlFlow, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(
+	TEXT("Statements Emitted"), STAT_ACF_NumStatementsEmitted, STATGROUP_AdvancedControlFlow, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(
+	TEXT("Pure Node Statements Inlined"), STAT_ACF_NumStatementsInlined, STATGROUP_AdvancedControlFlow, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(
+	TEXT("Cases Pruned by Constant Folding"), STAT_ACF_NumCasesPruned, STATGROUP_AdvancedControlFlow, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(
+	TEXT("Case Tables Rebuilt on Load"), STAT_ACF_NumCaseTablesRebuilt, STATGROUP_AdvancedControlFlow, );
+
+// Allocations in the scope are attributed to the "AdvancedControlFlow" tag of LLM (-llm).
+// The custom tags of LLM are not available on UE 4.
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+#define ACF_LLM_SCOPE()
+#else
+LLM_DECLARE_TAG(AdvancedControlFlow);
+#define ACF_LLM_SCOPE() LLM_SCOPE_BYTAG(AdvancedControlFlow)
+#endif
@@ -0,0 +1,42 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "IDetailCustomization.h"
+
+class IDetailLayoutBuilder;
+class UK2Node_CasePairedPinsNode;
+
+class FCasePairedPinsNodeDetails : public IDetailCustomization
+{
+	TWeakObjectPtr<UK2Node_CasePairedPinsNode> Node;
+	TWeakPtr<IDetailLayoutBuilder> DetailBuilder;
+
+public:
+	static TSharedRef<IDetailCustomization> MakeInstance();
+
+	virtual void CustomizeDetails(IDetailLayoutBuilder& InDetailBuilder) override;
+	virtual void CustomizeDetails(const TSharedPtr<IDetailLayoutBuilder>& InDetailBuilder) override;
+
+private:
+	TOptional<int32> GetCasePinCount() const;
+	TOptional<int32> GetMaxCasePinCount() const;
+	bool CanAddCasePin() const;
+	FText GetCaseLabel(int32 CaseIndex) const;
+
+	void OnCasePinCountCommitted(int32 NewCount, ETextCommit::Type CommitType);
+	void OnAddCasePinLast();
+	void OnRemoveAllCasePins();
+	void OnInsertCasePin(int32 CaseIndex);
+	void OnRemoveCasePin(int32 CaseIndex);
+	FReply OnMoveCasePin(int32 CaseIndex, int32 Offset);
+
+	void RefreshDetails();
+};
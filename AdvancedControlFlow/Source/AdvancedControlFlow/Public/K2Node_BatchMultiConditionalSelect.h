@@ -0,0 +1,38 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "K2Node_MultiConditionalSelect.h"
+
+#include "K2Node_BatchMultiConditionalSelect.generated.h"
+
+// Multi-Conditional Select over the arrays. The options and the conditions are the arrays which have the same number of the
+// elements, and each element of Return Value is selected from the options of the same index.
+UCLASS(MinimalAPI, meta = (Keywords = "Select MultiConditionalSelect Batch Array"))
+class UK2Node_BatchMultiConditionalSelect : public UK2Node_MultiConditionalSelect
+{
+	GENERATED_BODY()
+
+	// Override from UEdGraphNode
+	virtual FText GetTooltipText() const override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+
+	// Override from UK2Node
+	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
+
+protected:
+	// Override from UK2Node_MultiConditionalSelect
+	virtual void CreateDefaultOptionPin() override;
+	virtual void CreateReturnValuePin() override;
+	virtual CasePinPair CreateCasePinPair(int32 CaseIndex) override;
+
+public:
+	UK2Node_BatchMultiConditionalSelect(const FObjectInitializer& ObjectInitializer);
+};
@@ -0,0 +1,39 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "K2Node_MultiBranch.h"
+
+#include "K2Node_BitmaskMultiBranch.generated.h"
+
+// The cases are always tested in the order of the bit position, so bConditionsMutuallyExclusive is hidden.
+UCLASS(MinimalAPI, HideCategories = ("Optimization"), meta = (Keywords = "If ElseIf Else Branch MultiBranch Bitmask Flags"))
+class UK2Node_BitmaskMultiBranch : public UK2Node_MultiBranch
+{
+	GENERATED_BODY()
+
+	// Override from UEdGraphNode
+	virtual void AllocateDefaultPins() override;
+	virtual FText GetTooltipText() const override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual void PinConnectionListChanged(UEdGraphPin* Pin) override;
+
+	// Override from UK2Node
+	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
+	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
+	virtual bool IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const override;
+
+	virtual CasePinPair CreateCasePinPair(int32 CaseIndex) override;
+
+public:
+	UK2Node_BitmaskMultiBranch(const FObjectInitializer& ObjectInitializer);
+
+	UEdGraphPin* GetBitmaskPin() const;
+};
@@ -19,12 +19,59 @@ typedef TPair<UEdGraphPin*, UEdGraphPin*> CasePinPair;
 extern const FName DefaultExecPinName;
 extern const FName DefaultExecPinFriendlyName;
 
+USTRUCT()
+struct FCasePinPairEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FGuid KeyPinId;
+
+	UPROPERTY()
+	FGuid ValuePinId;
+
+	// Indices of the pins in Pins when the node was saved. The case table is validated by comparing the pin IDs at these
+	// indices instead of searching the pins.
+	UPROPERTY()
+	int32 KeyPinIndex = INDEX_NONE;
+
+	UPROPERTY()
+	int32 ValuePinIndex = INDEX_NONE;
+
+	// Resolved from the pin IDs. Not serialized.
+	UEdGraphPin* KeyPin = nullptr;
+	UEdGraphPin* ValuePin = nullptr;
+};
+
+// Version of the serialized case table (CasePinPairEntries).
+enum class ECaseTableVersion : int32
+{
+	// The case table is not saved. The case pin pairs are found by the pin names.
+	None = 0,
+	// The pin IDs of the case pin pairs are saved.
+	PinIds,
+	// The indices of the pins are also saved.
+	PinIndices,
+
+	VersionPlusOne,
+	LatestVersion = VersionPlusOne - 1
+};
+
 UCLASS(MinimalAPI)
 class UK2Node_CasePairedPinsNode : public UK2Node
 {
 	GENERATED_BODY()
 
 protected:
+	// Override from UObject
+	virtual void Serialize(FArchive& Ar) override;
+	virtual void PostLoad() override;
+	virtual void PostEditUndo() override;
+	virtual void PostDuplicate(bool bDuplicateForPIE) override;
+
+	// Override from UEdGraphNode
+	virtual void PostPasteNode() override;
+
 	// Override from UK2Node
 	virtual void GetNodeContextMenuActions(class UToolMenu* Menu, class UGraphNodeContextMenuContext* Context) const override;
 	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
@@ -45,32 +92,39 @@ protected:
 	UEdGraphPin* GetCaseKeyPinFromCaseIndex(int32 CaseIndex) const;
 	UEdGraphPin* GetCaseValuePinFromCaseIndex(int32 CaseIndex) const;
 
-	int32 GetCaseIndexFromCasePin(UEdGraphPin* Pin) const;
-	int32 GetCaseIndexFromCasePin(const FString& Prefix, UEdGraphPin* Pin) const;
-	int32 GetCaseIndexFromCaseKeyPin(UEdGraphPin* Pin) const;
-	int32 GetCaseIndexFromCaseValuePin(UEdGraphPin* Pin) const;
+	int32 GetCaseIndexFromCasePin(const UEdGraphPin* Pin) const;
+	int32 GetCaseIndexFromCaseKeyPin(const UEdGraphPin* Pin) const;
+	int32 GetCaseIndexFromCaseValuePin(const UEdGraphPin* Pin) const;
 
 	CasePinPair GetCasePinPair(UEdGraphPin* Pin) const;
-	TArray<CasePinPair> GetCasePinPairs() const;
 
 	FString GetCasePinName(const FString& Prefix, int32 CaseIndex) const;
 	FString GetCasePinFriendlyName(const FString& Prefix, int32 CaseIndex) const;
+	void RenameCasePinPairs(int32 StartCaseIndex);
 
-	virtual CasePinPair AddCasePinPair(int32 CaseIndex)
+	// Create the pins of the case pin pair. AddCasePinPair() registers them to the case table.
+	virtual CasePinPair CreateCasePinPair(int32 CaseIndex)
 	{
 		return CasePinPair();
 	}
+	CasePinPair AddCasePinPair(int32 CaseIndex);
 	void AddCasePinAfter(UEdGraphPin* Pin);
 	void AddCasePinBefore(UEdGraphPin* Pin);
 	void RemoveCasePinAt(UEdGraphPin* Pin);
 	void RemoveCasePinAt(int32 CaseIndex);
 	void RemoveFirstCasePin();
 	void RemoveLastCasePin();
+	void DestroyCasePinPair(int32 CaseIndex);
 
 	bool IsCasePin(const UEdGraphPin* Pin) const;
 	bool IsCaseKeyPin(const UEdGraphPin* Pin) const;
 	bool IsCaseValuePin(const UEdGraphPin* Pin) const;
 
+	void ResolveCasePinPairEntries();
+	bool ResolveCasePinPairEntriesByPinIndices();
+	void UpdateCasePinIndices();
+	bool BuildCasePinPairsFromPinNames(const TArray<UEdGraphPin*>& InPins, TArray<CasePinPair>& OutPairs) const;
+
 	FName NodeContextMenuSectionName;
 	FText NodeContextMenuSectionLabel;
 	FName CaseKeyPinNamePrefix;
@@ -78,12 +132,42 @@ protected:
 	FName CaseKeyPinFriendlyNamePrefix;
 	FName CaseValuePinFriendlyNamePrefix;
 
+	// Case pin pairs ordered by the case index.
+	UPROPERTY()
+	TArray<FCasePinPairEntry> CasePinPairEntries;
+
+	// ECaseTableVersion of CasePinPairEntries. The case table of the older version is upgraded when the node is loaded.
+	UPROPERTY()
+	int32 CaseTableVersion = static_cast<int32>(ECaseTableVersion::None);
+
+	// True while the case pin pairs are recreated in ReallocatePinsDuringReconstruction().
+	// The engine moves the default values and the links from the old pins afterwards.
+	bool bReallocatingCasePinPairs = false;
+
+#if WITH_DEV_AUTOMATION_TESTS
+	// The automation tests rewrite the case table to emulate the assets saved by the older versions.
+	friend struct FCasePairedPinsNodeTestAccessor;
+#endif
+
 public:
 	UK2Node_CasePairedPinsNode(const FObjectInitializer& ObjectInitializer);
 
 	UEdGraphPin* GetCaseValuePinFromCaseKeyPin(const UEdGraphPin* CondPin) const;
 	UEdGraphPin* GetCaseKeyPinFromCaseValuePin(const UEdGraphPin* ExecPin) const;
 
+	TArray<CasePinPair> GetCasePinPairs() const;
 	int32 GetCasePinCount() const;
 	void AddCasePinLast();
+
+	// Batch editing of the case pin pairs.
+	// Each call modifies the node once and marks the Blueprint as structurally modified once.
+	void InsertCasePinPairs(int32 CaseIndex, int32 Count);
+	void RemoveCasePinPairs(const TArray<int32>& CaseIndices);
+	void ReorderCasePinPairs(const TArray<int32>& NewOrder);
+	void MoveCasePinPair(int32 FromCaseIndex, int32 ToCaseIndex);
+	void SetCasePinCount(int32 Count);
+
+	// Show the pins of all cases even if the node has more cases than ACF.CollapseCasePinsThreshold.
+	UPROPERTY()
+	bool bShowAllCasePins = false;
 };
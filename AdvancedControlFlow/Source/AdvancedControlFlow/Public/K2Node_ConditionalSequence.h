@@ -29,11 +29,12 @@ class UK2Node_ConditionalSequence : public UK2Node_CasePairedPinsNode
 	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
 	virtual FText GetMenuCategory() const override;
 	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
-	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
 
+protected:
 	void CreateExecTriggeringPin();
 	void CreateDefaultExecPin();
-	virtual CasePinPair AddCasePinPair(int32 CaseIndex) override;
+	virtual CasePinPair CreateCasePinPair(int32 CaseIndex) override;
 
 public:
 	UK2Node_ConditionalSequence(const FObjectInitializer& ObjectInitializer);
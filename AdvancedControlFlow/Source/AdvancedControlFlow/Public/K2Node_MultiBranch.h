@@ -26,23 +26,28 @@ class UK2Node_MultiBranch : public UK2Node_CasePairedPinsNode
 	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
 	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
 
+	// Override from UObject
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
 	// Override from UK2Node
 	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
 	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
 	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
 	virtual FText GetMenuCategory() const override;
 
-	void CreateFunctionPin();
+protected:
 	void CreateExecTriggeringPin();
 	void CreateDefaultExecPin();
-	virtual CasePinPair AddCasePinPair(int32 CaseIndex) override;
-
-	TSubclassOf<class UObject> ConditionPreProcessFuncClass;
-	FName ConditionPreProcessFuncName;
+	virtual CasePinPair CreateCasePinPair(int32 CaseIndex) override;
 
 public:
 	UK2Node_MultiBranch(const FObjectInitializer& ObjectInitializer);
 
 	UEdGraphPin* GetDefaultExecPin() const;
-	UEdGraphPin* GetFunctionPin() const;
+
+	// If true, at most one condition is true at the same time and the conditions have no side effects.
+	// The compiler tests the conditions in the order of the hit counts recorded with ACF.ProfileCaseHits instead of the
+	// pin order. This is not checked: if the conditions overlap, the case which is taken depends on the recorded order.
+	UPROPERTY(EditAnywhere, Category = "Optimization")
+	bool bConditionsMutuallyExclusive = false;
 };
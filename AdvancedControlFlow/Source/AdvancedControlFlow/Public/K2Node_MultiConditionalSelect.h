@@ -31,20 +31,22 @@ class UK2Node_MultiConditionalSelect : public UK2Node_CasePairedPinsNode
 	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
 	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
 	virtual FText GetMenuCategory() const override;
-	virtual void ExpandNode(FKismetCompilerContext& CompilerContext, UEdGraph* SourceGraph) override;
+	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
 	virtual bool IsNodePure() const override
 	{
 		return true;
 	}
 	virtual bool IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const;
 
+protected:
 	// Internal functions.
-	void CreateDefaultOptionPin();
-	void CreateReturnValuePin();
-	UEdGraphPin* GetDefaultOptionPin() const;
-	UEdGraphPin* GetReturnValuePin() const;
-	virtual CasePinPair AddCasePinPair(int32 CaseIndex) override;
+	virtual void CreateDefaultOptionPin();
+	virtual void CreateReturnValuePin();
+	virtual CasePinPair CreateCasePinPair(int32 CaseIndex) override;
 
 public:
 	UK2Node_MultiConditionalSelect(const FObjectInitializer& ObjectInitializer);
+
+	UEdGraphPin* GetDefaultOptionPin() const;
+	UEdGraphPin* GetReturnValuePin() const;
 };
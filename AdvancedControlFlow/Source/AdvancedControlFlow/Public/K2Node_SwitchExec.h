@@ -0,0 +1,54 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "BlueprintActionDatabaseRegistrar.h"
+#include "K2Node_CasePairedPinsNode.h"
+
+#include "K2Node_SwitchExec.generated.h"
+
+UCLASS(MinimalAPI, meta = (Keywords = "Switch Integer Enum SwitchExec"))
+class UK2Node_SwitchExec : public UK2Node_CasePairedPinsNode
+{
+	GENERATED_BODY()
+
+	// Override from UEdGraphNode
+	virtual void AllocateDefaultPins() override;
+	virtual FText GetTooltipText() const override;
+	virtual FLinearColor GetNodeTitleColor() const override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FSlateIcon GetIconAndTint(FLinearColor& OutColor) const override;
+	virtual void PinConnectionListChanged(UEdGraphPin* Pin) override;
+
+	// Override from UK2Node
+	virtual void ReallocatePinsDuringReconstruction(TArray<UEdGraphPin*>& OldPins) override;
+	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
+	virtual void GetMenuActions(FBlueprintActionDatabaseRegistrar& ActionRegistrar) const override;
+	virtual FText GetMenuCategory() const override;
+	virtual bool IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const override;
+
+protected:
+	// Internal functions.
+	void CreateExecTriggeringPin();
+	void CreateSelectionPin();
+	void CreateDefaultExecPin();
+	virtual CasePinPair CreateCasePinPair(int32 CaseIndex) override;
+	virtual FString GetUnusedCaseValue() const;
+
+public:
+	UK2Node_SwitchExec(const FObjectInitializer& ObjectInitializer);
+
+	UEdGraphPin* GetSelectionPin() const;
+	UEdGraphPin* GetDefaultExecPin() const;
+
+	// Get the value of the case from the literal on the case key pin (Integer or Enum).
+	// Return false if the literal is not the integer in the range of the type (e.g. "1.5", "256" for Byte).
+	bool GetCaseValue(const UEdGraphPin* CaseKeyPin, int64& OutValue) const;
+};
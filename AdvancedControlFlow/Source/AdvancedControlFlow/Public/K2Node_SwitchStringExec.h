@@ -0,0 +1,44 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "K2Node_SwitchExec.h"
+
+#include "K2Node_SwitchStringExec.generated.h"
+
+UCLASS(MinimalAPI, meta = (Keywords = "Switch String Name SwitchExec"))
+class UK2Node_SwitchStringExec : public UK2Node_SwitchExec
+{
+	GENERATED_BODY()
+
+	// Override from UEdGraphNode
+	virtual FText GetTooltipText() const override;
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+
+	// Override from UObject
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	// Override from UK2Node
+	virtual class FNodeHandlingFunctor* CreateNodeHandler(class FKismetCompilerContext& CompilerContext) const override;
+	virtual bool IsConnectionDisallowed(const UEdGraphPin* MyPin, const UEdGraphPin* OtherPin, FString& OutReason) const override;
+
+	// Override from UK2Node_SwitchExec
+	virtual FString GetUnusedCaseValue() const override;
+
+public:
+	UK2Node_SwitchStringExec(const FObjectInitializer& ObjectInitializer);
+
+	// Get the value of the case from the literal on the case key pin. The name is converted to the string.
+	bool GetCaseString(const UEdGraphPin* CaseKeyPin, FString& OutValue) const;
+
+	// If false, the strings are compared without case. The names are always compared without case.
+	UPROPERTY(EditAnywhere, Category = "Switch")
+	bool bCaseSensitive = false;
+};
@@ -0,0 +1,154 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "KismetCompilerMisc.h"
+
+struct FBlueprintCompiledStatement;
+struct FKismetFunctionContext;
+
+class FKCHandler_CasePairedPinsNode : public FNodeHandlingFunctor
+{
+public:
+	FKCHandler_CasePairedPinsNode(FKismetCompilerContext& InCompilerContext);
+
+	// Override from FNodeHandlingFunctor
+	virtual void RegisterNets(FKismetFunctionContext& Context, UEdGraphNode* Node) override;
+
+protected:
+	// Condition of the case.
+	struct FCaseCondition
+	{
+		// The net to be tested.
+		UEdGraphPin* Net = nullptr;
+		// The pin whose links compute the net. This is the input pin of NOT Boolean node if the condition is negated.
+		UEdGraphPin* SourcePin = nullptr;
+		// If true, the condition is NOT Boolean of the net. The node must jump to the case when the net is false.
+		bool bNegated = false;
+	};
+
+	// Conditions of all cases of a node.
+	// The conditions which have the same net are evaluated only once at the first case which uses it, and the later cases
+	// reuse the term.
+	struct FCaseConditions
+	{
+		TArray<FCaseCondition> Conditions;
+		TMap<UEdGraphPin*, TArray<UEdGraphPin*>> SourcePinsPerNet;
+		TSet<UEdGraphPin*> EvaluatedNets;
+	};
+
+	// Case which is dispatched by the integer selection.
+	struct FIntegerCase
+	{
+		int64 Value = 0;
+		FBPTerminal* ValueTerm = nullptr;
+		// The jump goes to the pin. If nullptr, the caller sets the target label of GotoStatement.
+		UEdGraphPin* ExecPin = nullptr;
+		FBlueprintCompiledStatement* GotoStatement = nullptr;
+	};
+
+	// Build the conditions from the condition pins ordered by the case index.
+	// The NOT Boolean nodes which are only used by the condition pins are removed, and their inputs are tested instead.
+	void AnalyzeCaseConditions(
+		FKismetFunctionContext& Context, const TArray<UEdGraphPin*>& CondPins, FCaseConditions& OutConditions);
+
+	// Append the statements of the pure nodes which compute the condition if it is not evaluated yet, and return the term.
+	FBPTerminal* AppendCaseConditionStatements(
+		FKismetFunctionContext& Context, UEdGraphNode* Node, FCaseConditions& Conditions, int32 CaseIndex);
+
+	// Move the statements of the pure nodes which are only used to compute the net of the pin to the end of the node's
+	// statements. The moved statements are evaluated only when the execution reaches there.
+	void AppendLazyStatements(FKismetFunctionContext& Context, UEdGraphNode* Node, UEdGraphPin* Pin);
+	void AppendLazyStatements(FKismetFunctionContext& Context, UEdGraphNode* Node, const TArray<UEdGraphPin*>& Pins);
+
+	// Append the copy of the statements of all pure nodes which the pin depends on. The pure nodes are evaluated again at
+	// this point even if they were already evaluated before.
+	void AppendCopiedStatements(FKismetFunctionContext& Context, UEdGraphNode* Node, UEdGraphPin* Pin);
+
+	// Append the statements to jump to the case whose value is equal to the selection (Integer, Integer64 or Byte), or to
+	// the default execution pin. The cases must be sorted by the value and must not have the same value.
+	// The cases are dispatched by the binary decision tree, and the leaf which has MaxLinearCaseCount cases or less tests
+	// the cases one by one. BoolTerm is a local term which is registered in RegisterNets().
+	void AppendIntegerDispatchStatements(FKismetFunctionContext& Context, UEdGraphNode* Node, FBPTerminal* SelectionTerm,
+		FBPTerminal* BoolTerm, TArray<FIntegerCase>& Cases, UEdGraphPin* DefaultExecPin);
+
+	// Append the call to the static function of the function library. Args are passed in the order of the parameters.
+	void AppendCallFunctionStatement(FKismetFunctionContext& Context, UEdGraphNode* Node, UFunction* Function,
+		const TArray<FBPTerminal*>& Args, FBPTerminal* ReturnValueTerm = nullptr);
+
+	// Append a statement which does nothing but can be used as a jump target.
+	FBlueprintCompiledStatement& AppendJumpTargetStatement(FKismetFunctionContext& Context, UEdGraphNode* Node);
+
+	// Collect the pure nodes which the pins depend on in the order of the linear execution list.
+	// If bOnlyUsedByPins is true, the pure nodes whose outputs are also used by the other pins are excluded.
+	void CollectPureNodes(FKismetFunctionContext& Context, const TArray<UEdGraphPin*>& Pins, bool bOnlyUsedByPins,
+		TArray<UEdGraphNode*>& OutNodes) const;
+
+	// Remove the statements of the nodes so that they are not prepended to the impure nodes.
+	void DiscardStatements(FKismetFunctionContext& Context, const TArray<UEdGraphNode*>& Nodes);
+
+	// Remove the statements of the pure nodes which are only used to compute the net of the pin.
+	// Used when the pin is never evaluated (e.g. the case is pruned by the constant folding).
+	void DiscardLazyStatements(FKismetFunctionContext& Context, UEdGraphPin* Pin);
+
+	// Return true if the value of the Boolean pin is known at compile time.
+	// Supported: the unlinked pin (literal), Make Literal Bool node and the reroute nodes to them.
+	bool GetConstantBool(FKismetFunctionContext& Context, UEdGraphPin* Pin, bool& bOutValue) const;
+
+	// Return true if the nodes are compiled with the call to record the hit counts of the cases (ACF.ProfileCaseHits).
+	// The call is not compiled at all if false.
+	static bool IsCaseHitProfilingEnabled();
+
+	// Identifier of the node which is used as the key of the hit counts (GUID of the source node).
+	FString GetCaseHitNodeId(UEdGraphNode* Node) const;
+
+	// Append the call to record the hit of the case.
+	void AppendRecordCaseHitStatement(
+		FKismetFunctionContext& Context, UEdGraphNode* Node, const FString& NodeId, int32 CaseIndex, int32 CaseCount);
+
+	// Get the case indices ordered by the recorded hit counts in descending order.
+	// Return false if the hit counts of the node are not recorded or do not match the number of the cases.
+	bool GetCaseOrderByHitCounts(const FString& NodeId, int32 CaseCount, TArray<int32>& OutCaseOrder) const;
+
+	// Return true if the nodes are compiled with the calls to output the trace events to ACFChannel
+	// (ACF.TraceNodeExecution). The calls are not compiled at all if false.
+	bool IsNodeTraceEnabled() const;
+
+	// Start measuring the node execution. Must be called again when the execution comes back to the node.
+	void AppendBeginNodeTraceStatement(FKismetFunctionContext& Context, UEdGraphNode* Node);
+
+	// Output the trace event of the node execution. INDEX_NONE means the default.
+	void AppendEndNodeTraceStatement(FKismetFunctionContext& Context, UEdGraphNode* Node, int32 CaseIndex);
+
+	// Set to true by the handlers which support ACF.TraceNodeExecution.
+	bool bSupportsNodeTrace = false;
+
+	// Record the statements of the node to FAdvancedControlFlowNodeCostRecorder. Must be called at the end of Compile().
+	void RecordNodeCost(FKismetFunctionContext& Context, UEdGraphNode* Node);
+
+	// Create the literal term of the value (e.g. PC_Int and "1").
+	FBPTerminal* CreateLiteralTerm(FKismetFunctionContext& Context, const FName& PinCategory, const FString& Value) const;
+
+private:
+	// The number of the comparisons in a leaf is almost same as the ones to split the leaf further.
+	static constexpr int32 MaxLinearCaseCount = 3;
+
+	void AppendIntegerDecisionTree(FKismetFunctionContext& Context, UEdGraphNode* Node, FBPTerminal* SelectionTerm,
+		FBPTerminal* BoolTerm, TArray<FIntegerCase>& Cases, int32 Begin, int32 End, UEdGraphPin* DefaultExecPin,
+		UFunction* LessFunction, UFunction* NotEqualFunction);
+
+	// Append the call to the internal function of UAdvancedControlFlowProfilingLibrary.
+	void AppendProfilingCallStatement(FKismetFunctionContext& Context, UEdGraphNode* Node, const FName& FunctionName,
+		const TArray<FBPTerminal*>& Args, FBPTerminal* ReturnValueTerm = nullptr);
+
+	// Local variables to keep the start time of the node execution.
+	TMap<UEdGraphNode*, FBPTerminal*> NodeTraceStartTerms;
+};
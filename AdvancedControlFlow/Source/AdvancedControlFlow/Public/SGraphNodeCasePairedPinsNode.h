@@ -22,8 +22,43 @@ class SGraphNodeCasePairedPinsNode : public SGraphNodeK2Base
 
 	void Construct(const FArguments& InArgs, UK2Node_CasePairedPinsNode* InNode);
 
+public:
+	// Override from SGraphNode
+	virtual void UpdateGraphNode() override;
+
 protected:
 	virtual void CreateOutputSideAddButton(TSharedPtr<SVerticalBox> OutputBox) override;
 	virtual EVisibility IsAddPinButtonVisible() const override;
 	virtual FReply OnAddPin() override;
+
+	// The nodes which have more cases than ACF.CollapseCasePinsThreshold do not create the widgets of the unlinked cases
+	// until the user shows all cases.
+	bool IsCasePinCollapsed(const UEdGraphPin* Pin) const;
+
+	// Create the widget of the pin. If bShowCaseHitCounts is true, the case execution pins show the hit counts recorded
+	// with ACF.ProfileCaseHits in this session, and the last taken case is highlighted.
+	TSharedPtr<SGraphPin> CreateCasePinWidget(UEdGraphPin* Pin);
+	bool bShowCaseHitCounts = false;
+
+private:
+	void UpdateCollapsedCasePins();
+	FReply OnToggleShowAllCasePins();
+	FText GetToggleShowAllCasePinsText() const;
+
+	// Insert the widgets of the new case after the widgets of the previous case instead of rebuilding all pin widgets.
+	// Return false if the widgets must be rebuilt.
+	bool InsertCasePinWidgets(int32 CaseIndex);
+	bool InsertCasePinWidget(UEdGraphPin* Pin, UEdGraphPin* PrevPin);
+
+	// The hit counts are fetched once per frame for all pins.
+	void UpdateCaseHitCounts() const;
+	FText GetCaseHitCountText(const UEdGraphPin* Pin) const;
+	FSlateColor GetCaseHitCountColor(const UEdGraphPin* Pin) const;
+
+	TSet<const UEdGraphPin*> CollapsedCasePins;
+	int32 CollapsedCaseCount = 0;
+
+	mutable TMap<const UEdGraphPin*, int64> CaseHitCounts;
+	mutable const UEdGraphPin* LastTakenCasePin = nullptr;
+	mutable uint64 CaseHitCountsFrame = 0;
 };
\ No newline at end of file
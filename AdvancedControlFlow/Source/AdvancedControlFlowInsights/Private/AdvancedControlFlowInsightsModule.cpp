@@ -0,0 +1,34 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowInsightsModule.h"
+
+#include "AdvancedControlFlowTraceModule.h"
+#include "Features/IModularFeatures.h"
+
+void FAdvancedControlFlowInsightsModule::StartupModule()
+{
+#if ACF_INSIGHTS_ENABLED
+	TraceModule = MakeShared<FAdvancedControlFlowTraceModule>();
+	IModularFeatures::Get().RegisterModularFeature(TraceServices::ModuleFeatureName, TraceModule.Get());
+#endif
+}
+
+void FAdvancedControlFlowInsightsModule::ShutdownModule()
+{
+#if ACF_INSIGHTS_ENABLED
+	if (TraceModule.IsValid())
+	{
+		IModularFeatures::Get().UnregisterModularFeature(TraceServices::ModuleFeatureName, TraceModule.Get());
+		TraceModule.Reset();
+	}
+#endif
+}
+
+IMPLEMENT_MODULE(FAdvancedControlFlowInsightsModule, AdvancedControlFlowInsights);
@@ -0,0 +1,54 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowTraceAnalyzer.h"
+
+#if ACF_INSIGHTS_ENABLED
+
+#include "AdvancedControlFlowTraceProvider.h"
+#include "TraceServices/Model/AnalysisSession.h"
+
+FAdvancedControlFlowTraceAnalyzer::FAdvancedControlFlowTraceAnalyzer(
+	TraceServices::IAnalysisSession& InSession, FAdvancedControlFlowTraceProvider& InProvider, const FString& InReportFilePath)
+	: Session(InSession), Provider(InProvider), ReportFilePath(InReportFilePath)
+{
+}
+
+void FAdvancedControlFlowTraceAnalyzer::OnAnalysisBegin(const FOnAnalysisContext& Context)
+{
+	Context.InterfaceBuilder.RouteEvent(RouteId_NodeExecution, "AdvancedControlFlow", "NodeExecution");
+}
+
+void FAdvancedControlFlowTraceAnalyzer::OnAnalysisEnd()
+{
+	TraceServices::FAnalysisSessionReadScope SessionReadScope(Session);
+	Provider.WriteReport(ReportFilePath);
+}
+
+bool FAdvancedControlFlowTraceAnalyzer::OnEvent(uint16 RouteId, EStyle Style, const FOnEventContext& Context)
+{
+	if (RouteId != RouteId_NodeExecution)
+	{
+		return true;
+	}
+
+	const FEventData& EventData = Context.EventData;
+	const FGuid NodeGuid(EventData.GetValue<uint32>("NodeGuidA"), EventData.GetValue<uint32>("NodeGuidB"),
+		EventData.GetValue<uint32>("NodeGuidC"), EventData.GetValue<uint32>("NodeGuidD"));
+	const int32 CaseIndex = EventData.GetValue<int32>("CaseIndex");
+	const double StartTime = Context.EventTime.AsSeconds(EventData.GetValue<uint64>("StartCycle"));
+	const double EndTime = Context.EventTime.AsSeconds(EventData.GetValue<uint64>("EndCycle"));
+
+	TraceServices::FAnalysisSessionEditScope SessionEditScope(Session);
+	Provider.AddNodeExecution(NodeGuid, CaseIndex, FMath::Max(EndTime - StartTime, 0.0));
+
+	return true;
+}
+
+#endif
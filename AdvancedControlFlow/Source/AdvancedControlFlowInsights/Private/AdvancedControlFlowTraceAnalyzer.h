@@ -0,0 +1,48 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "AdvancedControlFlowTraceModule.h"
+
+#if ACF_INSIGHTS_ENABLED
+
+#include "Trace/Analyzer.h"
+
+class FAdvancedControlFlowTraceProvider;
+
+namespace TraceServices
+{
+class IAnalysisSession;
+}
+
+// Aggregate the AdvancedControlFlow.NodeExecution events by node, and write the report to ReportFilePath when the analysis
+// ends.
+class FAdvancedControlFlowTraceAnalyzer : public UE::Trace::IAnalyzer
+{
+	enum : uint16
+	{
+		RouteId_NodeExecution
+	};
+
+	TraceServices::IAnalysisSession& Session;
+	FAdvancedControlFlowTraceProvider& Provider;
+	FString ReportFilePath;
+
+public:
+	FAdvancedControlFlowTraceAnalyzer(
+		TraceServices::IAnalysisSession& InSession, FAdvancedControlFlowTraceProvider& InProvider, const FString& InReportFilePath);
+
+	// Override from UE::Trace::IAnalyzer
+	virtual void OnAnalysisBegin(const FOnAnalysisContext& Context) override;
+	virtual void OnAnalysisEnd() override;
+	virtual bool OnEvent(uint16 RouteId, EStyle Style, const FOnEventContext& Context) override;
+};
+
+#endif
@@ -0,0 +1,90 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowTraceModule.h"
+
+#if ACF_INSIGHTS_ENABLED
+
+#include "AdvancedControlFlowTraceAnalyzer.h"
+#include "AdvancedControlFlowTraceProvider.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "TraceServices/Model/AnalysisSession.h"
+
+namespace
+{
+const TCHAR* ReportFileName = TEXT("ACFNodeExecution.csv");
+
+// Unreal Insights is a program, so its saved directory is not the one of the project.
+// The report is written to the path given by -ACFTraceReport=<FilePath>, or next to the trace file by default.
+FString GetReportFilePath(const TraceServices::IAnalysisSession& Session)
+{
+	FString FilePath;
+	if (FParse::Value(FCommandLine::Get(), TEXT("ACFTraceReport="), FilePath))
+	{
+		return FilePath;
+	}
+
+	const FString TraceFilePath = Session.GetName();
+	if (FPaths::GetExtension(TraceFilePath) == TEXT("utrace"))
+	{
+		return FPaths::Combine(FPaths::GetPath(TraceFilePath),
+			FString::Printf(TEXT("%s_%s"), *FPaths::GetBaseFilename(TraceFilePath), ReportFileName));
+	}
+
+	// The live session has no trace file.
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AdvancedControlFlow"), ReportFileName);
+}
+}	 // namespace
+
+void FAdvancedControlFlowTraceModule::GetModuleInfo(TraceServices::FModuleInfo& OutModuleInfo)
+{
+	OutModuleInfo.Name = TEXT("AdvancedControlFlow");
+	OutModuleInfo.DisplayName = TEXT("Advanced Control Flow");
+}
+
+void FAdvancedControlFlowTraceModule::OnAnalysisBegin(TraceServices::IAnalysisSession& InSession)
+{
+	// The session owns the provider and the analyzer.
+#if UE_VERSION_OLDER_THAN(5, 1, 0)
+	FAdvancedControlFlowTraceProvider* Provider = new FAdvancedControlFlowTraceProvider();
+	InSession.AddProvider(FAdvancedControlFlowTraceProvider::ProviderName, Provider);
+#else
+	TSharedPtr<FAdvancedControlFlowTraceProvider> SharedProvider = MakeShared<FAdvancedControlFlowTraceProvider>();
+	InSession.AddProvider(FAdvancedControlFlowTraceProvider::ProviderName, SharedProvider);
+	FAdvancedControlFlowTraceProvider* Provider = SharedProvider.Get();
+#endif
+	InSession.AddAnalyzer(new FAdvancedControlFlowTraceAnalyzer(InSession, *Provider, GetReportFilePath(InSession)));
+}
+
+void FAdvancedControlFlowTraceModule::GetLoggers(TArray<const TCHAR*>& OutLoggers)
+{
+	OutLoggers.Add(TEXT("AdvancedControlFlow"));
+}
+
+void FAdvancedControlFlowTraceModule::GenerateReports(
+	const TraceServices::IAnalysisSession& Session, const TCHAR* CmdLine, const TCHAR* OutputDirectory)
+{
+	TraceServices::FAnalysisSessionReadScope SessionReadScope(Session);
+
+	const FAdvancedControlFlowTraceProvider* Provider =
+		Session.ReadProvider<FAdvancedControlFlowTraceProvider>(FAdvancedControlFlowTraceProvider::ProviderName);
+	if (Provider != nullptr)
+	{
+		Provider->WriteReport(FPaths::Combine(OutputDirectory, ReportFileName));
+	}
+}
+
+const TCHAR* FAdvancedControlFlowTraceModule::GetCommandLineArgument()
+{
+	return TEXT("acftrace");
+}
+
+#endif
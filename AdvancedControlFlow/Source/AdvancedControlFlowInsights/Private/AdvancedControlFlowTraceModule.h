@@ -0,0 +1,44 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/EngineVersionComparison.h"
+
+// The analysis API of Unreal Insights is different on UE 4.
+#if UE_VERSION_OLDER_THAN(5, 0, 0)
+#define ACF_INSIGHTS_ENABLED 0
+#else
+#define ACF_INSIGHTS_ENABLED 1
+#endif
+
+#if ACF_INSIGHTS_ENABLED
+
+#include "TraceServices/ModuleService.h"
+
+class FAdvancedControlFlowTraceModule : public TraceServices::IModule
+{
+public:
+	// Override from TraceServices::IModule
+	virtual void GetModuleInfo(TraceServices::FModuleInfo& OutModuleInfo) override;
+	virtual void OnAnalysisBegin(TraceServices::IAnalysisSession& InSession) override;
+	virtual void GetLoggers(TArray<const TCHAR*>& OutLoggers) override;
+	virtual void GenerateReports(
+		const TraceServices::IAnalysisSession& Session, const TCHAR* CmdLine, const TCHAR* OutputDirectory) override;
+	virtual const TCHAR* GetCommandLineArgument() override;
+};
+
+#else
+
+class FAdvancedControlFlowTraceModule
+{
+};
+
+#endif
@@ -0,0 +1,89 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowTraceProvider.h"
+
+#if ACF_INSIGHTS_ENABLED
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAdvancedControlFlowInsights, Log, All);
+
+namespace
+{
+// The number of nodes which are written to the log.
+const int32 MaxLoggedNodes = 20;
+}	 // namespace
+
+const FName FAdvancedControlFlowTraceProvider::ProviderName(TEXT("AdvancedControlFlowTraceProvider"));
+
+void FAdvancedControlFlowTraceProvider::AddNodeExecution(const FGuid& NodeGuid, int32 CaseIndex, double ElapsedSeconds)
+{
+	FNodeStatistics& Statistics = NodeStatistics.FindOrAdd(NodeGuid);
+	Statistics.Count++;
+	Statistics.TotalSeconds += ElapsedSeconds;
+	Statistics.MaxSeconds = FMath::Max(Statistics.MaxSeconds, ElapsedSeconds);
+	Statistics.CaseCounts.FindOrAdd(CaseIndex)++;
+}
+
+bool FAdvancedControlFlowTraceProvider::WriteReport(const FString& FilePath) const
+{
+	if (NodeStatistics.Num() == 0)
+	{
+		return false;
+	}
+
+	TArray<FGuid> NodeGuids;
+	NodeStatistics.GetKeys(NodeGuids);
+	NodeGuids.Sort([this](const FGuid& A, const FGuid& B)
+		{ return NodeStatistics[A].TotalSeconds > NodeStatistics[B].TotalSeconds; });
+
+	FString Csv = TEXT("NodeGuid,Count,TotalMs,AverageUs,MaxUs,CaseCounts\n");
+	for (int32 Index = 0; Index < NodeGuids.Num(); ++Index)
+	{
+		const FGuid& NodeGuid = NodeGuids[Index];
+		const FNodeStatistics& Statistics = NodeStatistics[NodeGuid];
+		const double AverageSeconds = Statistics.TotalSeconds / Statistics.Count;
+
+		TArray<int32> CaseIndices;
+		Statistics.CaseCounts.GetKeys(CaseIndices);
+		CaseIndices.Sort();
+		TArray<FString> CaseCounts;
+		for (int32 CaseIndex : CaseIndices)
+		{
+			CaseCounts.Add(FString::Printf(TEXT("%d:%llu"), CaseIndex, Statistics.CaseCounts[CaseIndex]));
+		}
+
+		Csv += FString::Printf(TEXT("%s,%llu,%.4f,%.4f,%.4f,%s\n"), *NodeGuid.ToString(EGuidFormats::Digits),
+			Statistics.Count, Statistics.TotalSeconds * 1000.0, AverageSeconds * 1000000.0, Statistics.MaxSeconds * 1000000.0,
+			*FString::Join(CaseCounts, TEXT(";")));
+
+		if (Index < MaxLoggedNodes)
+		{
+			UE_LOG(LogAdvancedControlFlowInsights, Log, TEXT("%s: %llu executions, %.4f ms total, %.4f us max"),
+				*NodeGuid.ToString(EGuidFormats::Digits), Statistics.Count, Statistics.TotalSeconds * 1000.0,
+				Statistics.MaxSeconds * 1000000.0);
+		}
+	}
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+	if (!FFileHelper::SaveStringToFile(Csv, *FilePath))
+	{
+		UE_LOG(LogAdvancedControlFlowInsights, Warning, TEXT("Failed to write the node execution report to %s"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogAdvancedControlFlowInsights, Display, TEXT("Wrote the node execution report of %d nodes to %s"),
+		NodeGuids.Num(), *FPaths::ConvertRelativePathToFull(FilePath));
+	return true;
+}
+
+#endif
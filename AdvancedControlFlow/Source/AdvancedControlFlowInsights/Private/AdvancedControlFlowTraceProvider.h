@@ -0,0 +1,43 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "AdvancedControlFlowTraceModule.h"
+
+#if ACF_INSIGHTS_ENABLED
+
+#include "TraceServices/Model/AnalysisSession.h"
+
+// Statistics of the AdvancedControlFlow.NodeExecution events aggregated by node.
+// The analyzer adds the events, and the report is written when the analysis ends or Unreal Insights generates the reports.
+class FAdvancedControlFlowTraceProvider : public TraceServices::IProvider
+{
+public:
+	static const FName ProviderName;
+
+	void AddNodeExecution(const FGuid& NodeGuid, int32 CaseIndex, double ElapsedSeconds);
+
+	// Write the statistics to the CSV file. Nothing is written if no events were recorded.
+	bool WriteReport(const FString& FilePath) const;
+
+private:
+	struct FNodeStatistics
+	{
+		uint64 Count = 0;
+		double TotalSeconds = 0.0;
+		double MaxSeconds = 0.0;
+		// Key is the case index. INDEX_NONE is the default case.
+		TMap<int32, uint64> CaseCounts;
+	};
+
+	TMap<FGuid, FNodeStatistics> NodeStatistics;
+};
+
+#endif
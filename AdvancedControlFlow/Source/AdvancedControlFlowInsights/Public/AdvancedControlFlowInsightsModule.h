@@ -0,0 +1,24 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "Modules/ModuleManager.h"
+
+class FAdvancedControlFlowTraceModule;
+
+// Analyze the trace events of ACFChannel in Unreal Insights.
+class FAdvancedControlFlowInsightsModule : public IModuleInterface
+{
+	TSharedPtr<FAdvancedControlFlowTraceModule> TraceModule;
+
+public:
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+};
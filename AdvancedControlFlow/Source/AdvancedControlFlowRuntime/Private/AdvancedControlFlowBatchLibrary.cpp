@@ -0,0 +1,131 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowBatchLibrary.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/EngineVersionComparison.h"
+
+namespace
+{
+TAutoConsoleVariable<int32> CVarBatchSelectParallelThreshold(TEXT("ACF.BatchSelectParallelThreshold"), 16384,
+	TEXT("Batch Multi-Conditional Select splits the elements into the tasks when the number of the elements is this number or\n")
+		TEXT("more. 0 or less never splits them. The elements which are not plain old data are always processed on the caller."),
+	ECVF_Default);
+
+// The number of the elements processed by one task.
+const int32 BatchSelectChunkSize = 4096;
+
+// The number of the conditions tested at once.
+const int32 LaneCount = 8;
+
+// Copy the elements in [Begin, End) whose condition is true. The conditions are tested 8 lanes at once, and the lanes which are
+// all false or all true are skipped or copied in a block.
+void OverwriteSelectedRange(
+	uint8* ResultData, const uint8* OptionsData, const bool* Conditions, int32 ElementSize, int32 Begin, int32 End)
+{
+	static_assert(sizeof(bool) == 1, "The conditions are loaded as bytes.");
+	const uint64 AllTrueLanes = 0x0101010101010101ull;
+
+	int32 Index = Begin;
+	for (; Index + LaneCount <= End; Index += LaneCount)
+	{
+		uint64 Lanes;
+		FMemory::Memcpy(&Lanes, Conditions + Index, LaneCount);
+		if (Lanes == 0)
+		{
+			continue;
+		}
+		else if (Lanes == AllTrueLanes)
+		{
+			FMemory::Memcpy(ResultData + Index * ElementSize, OptionsData + Index * ElementSize, LaneCount * ElementSize);
+			continue;
+		}
+
+		for (int32 Lane = Index; Lane < Index + LaneCount; ++Lane)
+		{
+			if (Conditions[Lane])
+			{
+				FMemory::Memcpy(ResultData + Lane * ElementSize, OptionsData + Lane * ElementSize, ElementSize);
+			}
+		}
+	}
+	for (; Index < End; ++Index)
+	{
+		if (Conditions[Index])
+		{
+			FMemory::Memcpy(ResultData + Index * ElementSize, OptionsData + Index * ElementSize, ElementSize);
+		}
+	}
+}
+}	 // namespace
+
+void UAdvancedControlFlowBatchLibrary::OverwriteSelectedElements(
+	TArray<int32>& Result, const TArray<bool>& Conditions, const TArray<int32>& Options)
+{
+	// Never called. The function is called through execOverwriteSelectedElements.
+	check(0);
+}
+
+void UAdvancedControlFlowBatchLibrary::GenericOverwriteSelectedElements(void* ResultAddr, const FArrayProperty* ResultProperty,
+	const TArray<bool>& Conditions, const void* OptionsAddr, const FArrayProperty* OptionsProperty)
+{
+	const FProperty* InnerProperty = ResultProperty->Inner;
+	if (!InnerProperty->SameType(OptionsProperty->Inner))
+	{
+		return;
+	}
+
+	FScriptArrayHelper ResultHelper(ResultProperty, ResultAddr);
+	FScriptArrayHelper OptionsHelper(OptionsProperty, OptionsAddr);
+	const int32 Count = FMath::Min3(ResultHelper.Num(), OptionsHelper.Num(), Conditions.Num());
+	if (Count == 0)
+	{
+		return;
+	}
+
+#if UE_VERSION_OLDER_THAN(5, 5, 0)
+	const int32 ElementSize = InnerProperty->ElementSize;
+#else
+	const int32 ElementSize = InnerProperty->GetElementSize();
+#endif
+	uint8* ResultData = ResultHelper.GetRawPtr();
+	const uint8* OptionsData = OptionsHelper.GetRawPtr();
+	const bool* ConditionData = Conditions.GetData();
+
+	if (!InnerProperty->HasAnyPropertyFlags(CPF_IsPlainOldData))
+	{
+		// The copy of the element may allocate or touch the objects, so it is done on the caller.
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			if (ConditionData[Index])
+			{
+				InnerProperty->CopySingleValue(ResultData + Index * ElementSize, OptionsData + Index * ElementSize);
+			}
+		}
+		return;
+	}
+
+	const int32 ParallelThreshold = CVarBatchSelectParallelThreshold.GetValueOnAnyThread();
+	if ((ParallelThreshold <= 0) || (Count < ParallelThreshold))
+	{
+		OverwriteSelectedRange(ResultData, OptionsData, ConditionData, ElementSize, 0, Count);
+		return;
+	}
+
+	const int32 ChunkCount = FMath::DivideAndRoundUp(Count, BatchSelectChunkSize);
+	ParallelFor(ChunkCount,
+		[&](int32 ChunkIndex)
+		{
+			const int32 Begin = ChunkIndex * BatchSelectChunkSize;
+			const int32 End = FMath::Min(Begin + BatchSelectChunkSize, Count);
+			OverwriteSelectedRange(ResultData, OptionsData, ConditionData, ElementSize, Begin, End);
+		});
+}
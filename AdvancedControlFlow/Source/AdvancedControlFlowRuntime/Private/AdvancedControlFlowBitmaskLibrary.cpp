@@ -0,0 +1,54 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowBitmaskLibrary.h"
+
+int32 UAdvancedControlFlowBitmaskLibrary::FindLowestSetBit(int32 Bitmask, int32 CaseMask)
+{
+	const uint32 Bits = static_cast<uint32>(Bitmask & CaseMask);
+	return (Bits == 0) ? INDEX_NONE : static_cast<int32>(FMath::CountTrailingZeros(Bits));
+}
+
+int32 UAdvancedControlFlowBitmaskLibrary::FindLowestSetBit64(int64 Bitmask, int64 CaseMask)
+{
+	const uint64 Bits = static_cast<uint64>(Bitmask & CaseMask);
+	return (Bits == 0) ? INDEX_NONE : static_cast<int32>(FMath::CountTrailingZeros64(Bits));
+}
+
+int32 UAdvancedControlFlowBitmaskLibrary::PopLowestSetBit(int32& Bitmask, int32 CaseMask)
+{
+	uint32 Bits = static_cast<uint32>(Bitmask & CaseMask);
+	if (Bits == 0)
+	{
+		Bitmask = 0;
+		return INDEX_NONE;
+	}
+
+	const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros(Bits));
+	Bits &= Bits - 1;
+	Bitmask = static_cast<int32>(Bits);
+
+	return Bit;
+}
+
+int32 UAdvancedControlFlowBitmaskLibrary::PopLowestSetBit64(int64& Bitmask, int64 CaseMask)
+{
+	uint64 Bits = static_cast<uint64>(Bitmask & CaseMask);
+	if (Bits == 0)
+	{
+		Bitmask = 0;
+		return INDEX_NONE;
+	}
+
+	const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(Bits));
+	Bits &= Bits - 1;
+	Bitmask = static_cast<int64>(Bits);
+
+	return Bit;
+}
@@ -0,0 +1,274 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowCaseHitCounter.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAdvancedControlFlowCaseHitCounter, Log, All);
+
+static FAutoConsoleCommand FlushCaseHitCountsCommand(TEXT("ACF.FlushCaseHitCounts"),
+	TEXT("Save the hit counts of the cases recorded by the nodes compiled with ACF.ProfileCaseHits."),
+	FConsoleCommandDelegate::CreateLambda([]() { FAdvancedControlFlowCaseHitCounter::Get().Flush(); }));
+
+static FAutoConsoleCommand DumpCaseHitCountsCommand(TEXT("ACF.DumpCaseHitCounts"),
+	TEXT("Write the hit counts of the cases recorded in this session to the CSV file.\n")
+		TEXT("Usage: ACF.DumpCaseHitCounts [FilePath] (Default: Saved/AdvancedControlFlow/CaseHitCounts.csv)"),
+	FConsoleCommandWithArgsDelegate::CreateLambda(
+		[](const TArray<FString>& Args)
+		{
+			FString FilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AdvancedControlFlow"), TEXT("CaseHitCounts.csv"));
+			if (Args.Num() > 0)
+			{
+				FilePath = Args[0];
+			}
+			FAdvancedControlFlowCaseHitCounter::Get().DumpToCsv(FilePath);
+		}));
+
+FAdvancedControlFlowCaseHitCounter& FAdvancedControlFlowCaseHitCounter::Get()
+{
+	static FAdvancedControlFlowCaseHitCounter Instance;
+	return Instance;
+}
+
+FString FAdvancedControlFlowCaseHitCounter::GetFilePath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AdvancedControlFlow"), TEXT("CaseHitCounts.json"));
+}
+
+void FAdvancedControlFlowCaseHitCounter::RecordHit(FName NodeId, int32 CaseIndex, int32 CaseCount)
+{
+	if ((CaseIndex < 0) || (CaseIndex >= CaseCount))
+	{
+		return;
+	}
+
+	FScopeLock Lock(&CriticalSection);
+
+	int32* NodeIndex = NodeIndices.Find(NodeId);
+	if (NodeIndex == nullptr)
+	{
+		NodeIndex = &NodeIndices.Add(NodeId, Nodes.Num());
+		FNodeCaseHits& NewNode = Nodes.AddDefaulted_GetRef();
+		NewNode.NodeId = NodeId;
+	}
+
+	FNodeCaseHits& Node = Nodes[*NodeIndex];
+	if (Node.HitCounts.Num() < CaseCount)
+	{
+		Node.HitCounts.SetNumZeroed(CaseCount);
+	}
+	Node.HitCounts[CaseIndex]++;
+	Node.LastCaseIndex = CaseIndex;
+}
+
+bool FAdvancedControlFlowCaseHitCounter::GetSessionHitCounts(
+	FName NodeId, TArray<int64>& OutHitCounts, int32& OutLastCaseIndex) const
+{
+	FScopeLock Lock(&CriticalSection);
+
+	const int32* NodeIndex = NodeIndices.Find(NodeId);
+	if (NodeIndex == nullptr)
+	{
+		return false;
+	}
+
+	OutHitCounts = Nodes[*NodeIndex].HitCounts;
+	OutLastCaseIndex = Nodes[*NodeIndex].LastCaseIndex;
+	return true;
+}
+
+bool FAdvancedControlFlowCaseHitCounter::DumpToCsv(const FString& FilePath) const
+{
+	FString Csv = TEXT("NodeId,CaseIndex,HitCount,LastTaken\n");
+	{
+		FScopeLock Lock(&CriticalSection);
+
+		for (const FNodeCaseHits& Node : Nodes)
+		{
+			const FString NodeIdString = Node.NodeId.ToString();
+			for (int32 CaseIndex = 0; CaseIndex < Node.HitCounts.Num(); ++CaseIndex)
+			{
+				Csv += FString::Printf(TEXT("%s,%d,%lld,%d\n"), *NodeIdString, CaseIndex, Node.HitCounts[CaseIndex],
+					(CaseIndex == Node.LastCaseIndex) ? 1 : 0);
+			}
+		}
+	}
+
+	if (!FFileHelper::SaveStringToFile(Csv, *FilePath))
+	{
+		UE_LOG(LogAdvancedControlFlowCaseHitCounter, Warning, TEXT("Failed to save %s"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogAdvancedControlFlowCaseHitCounter, Display, TEXT("Saved the hit counts to %s"), *FilePath);
+	return true;
+}
+
+void FAdvancedControlFlowCaseHitCounter::Flush()
+{
+	FScopeLock Lock(&CriticalSection);
+
+	// Other processes (e.g. standalone game) may update the file.
+	LoadFile();
+
+	bool bUpdated = false;
+	for (const FNodeCaseHits& Node : Nodes)
+	{
+		TArray<int64>& HitCounts = SavedHitCounts.FindOrAdd(Node.NodeId.ToString());
+		if (HitCounts.Num() != Node.HitCounts.Num())
+		{
+			// The cases of the node were changed.
+			HitCounts.Reset();
+			HitCounts.SetNumZeroed(Node.HitCounts.Num());
+		}
+		for (int32 CaseIndex = 0; CaseIndex < Node.HitCounts.Num(); ++CaseIndex)
+		{
+			const int64 Flushed = Node.FlushedHitCounts.IsValidIndex(CaseIndex) ? Node.FlushedHitCounts[CaseIndex] : 0;
+			HitCounts[CaseIndex] += Node.HitCounts[CaseIndex] - Flushed;
+			bUpdated |= (Node.HitCounts[CaseIndex] != Flushed);
+		}
+	}
+	if (!bUpdated)
+	{
+		return;
+	}
+
+	if (SaveFile())
+	{
+		for (FNodeCaseHits& Node : Nodes)
+		{
+			Node.FlushedHitCounts = Node.HitCounts;
+		}
+		SavedFileTimeStamp = IFileManager::Get().GetTimeStamp(*GetFilePath());
+	}
+}
+
+bool FAdvancedControlFlowCaseHitCounter::GetHitCounts(const FString& NodeId, TArray<int64>& OutHitCounts)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	if (IFileManager::Get().GetTimeStamp(*GetFilePath()) != SavedFileTimeStamp)
+	{
+		LoadFile();
+	}
+
+	const TArray<int64>* HitCounts = SavedHitCounts.Find(NodeId);
+	if (HitCounts == nullptr)
+	{
+		return false;
+	}
+
+	OutHitCounts = *HitCounts;
+	return true;
+}
+
+void FAdvancedControlFlowCaseHitCounter::SetHitCounts(const FString& NodeId, const TArray<int64>& HitCounts)
+{
+	FScopeLock Lock(&CriticalSection);
+
+	// Load the file at first, otherwise GetHitCounts reloads it and drops the overridden hit counts.
+	if (IFileManager::Get().GetTimeStamp(*GetFilePath()) != SavedFileTimeStamp)
+	{
+		LoadFile();
+	}
+
+	if (HitCounts.Num() == 0)
+	{
+		SavedHitCounts.Remove(NodeId);
+		return;
+	}
+	SavedHitCounts.Add(NodeId, HitCounts);
+}
+
+void FAdvancedControlFlowCaseHitCounter::LoadFile()
+{
+	const FString FilePath = GetFilePath();
+
+	SavedHitCounts.Reset();
+	SavedFileTimeStamp = IFileManager::Get().GetTimeStamp(*FilePath);
+
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *FilePath))
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonObject> RootObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+	if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
+	{
+		UE_LOG(LogAdvancedControlFlowCaseHitCounter, Warning, TEXT("Failed to parse %s"), *FilePath);
+		return;
+	}
+
+	const TSharedPtr<FJsonObject>* NodesObject = nullptr;
+	if (!RootObject->TryGetObjectField(TEXT("Nodes"), NodesObject))
+	{
+		return;
+	}
+
+	for (const auto& Pair : (*NodesObject)->Values)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+		if (!Pair.Value.IsValid() || !Pair.Value->TryGetArray(Values))
+		{
+			continue;
+		}
+
+		TArray<int64>& HitCounts = SavedHitCounts.Add(Pair.Key);
+		HitCounts.Reserve(Values->Num());
+		for (const TSharedPtr<FJsonValue>& Value : *Values)
+		{
+			HitCounts.Add(static_cast<int64>(Value->AsNumber()));
+		}
+	}
+}
+
+bool FAdvancedControlFlowCaseHitCounter::SaveFile() const
+{
+	TSharedRef<FJsonObject> NodesObject = MakeShared<FJsonObject>();
+	for (const auto& Pair : SavedHitCounts)
+	{
+		TArray<TSharedPtr<FJsonValue>> Values;
+		Values.Reserve(Pair.Value.Num());
+		for (int64 HitCount : Pair.Value)
+		{
+			Values.Add(MakeShared<FJsonValueNumber>(static_cast<double>(HitCount)));
+		}
+		NodesObject->SetArrayField(Pair.Key, Values);
+	}
+
+	TSharedRef<FJsonObject> RootObject = MakeShared<FJsonObject>();
+	RootObject->SetObjectField(TEXT("Nodes"), NodesObject);
+
+	FString JsonString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
+	if (!FJsonSerializer::Serialize(RootObject, Writer))
+	{
+		return false;
+	}
+
+	const FString FilePath = GetFilePath();
+	if (!FFileHelper::SaveStringToFile(JsonString, *FilePath))
+	{
+		UE_LOG(LogAdvancedControlFlowCaseHitCounter, Warning, TEXT("Failed to save %s"), *FilePath);
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,31 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowProfilingLibrary.h"
+
+#include "AdvancedControlFlowCaseHitCounter.h"
+#include "AdvancedControlFlowTrace.h"
+#include "HAL/PlatformTime.h"
+
+void UAdvancedControlFlowProfilingLibrary::RecordCaseHit(FName NodeId, int32 CaseIndex, int32 CaseCount)
+{
+	FAdvancedControlFlowCaseHitCounter::Get().RecordHit(NodeId, CaseIndex, CaseCount);
+}
+
+int64 UAdvancedControlFlowProfilingLibrary::BeginNodeTrace()
+{
+	return static_cast<int64>(FPlatformTime::Cycles64());
+}
+
+void UAdvancedControlFlowProfilingLibrary::EndNodeTrace(
+	int32 NodeGuidA, int32 NodeGuidB, int32 NodeGuidC, int32 NodeGuidD, int32 CaseIndex, int64 StartCycle)
+{
+	FAdvancedControlFlowTrace::OutputNodeExecution(FGuid(NodeGuidA, NodeGuidB, NodeGuidC, NodeGuidD), CaseIndex,
+		static_cast<uint64>(StartCycle), FPlatformTime::Cycles64());
+}
@@ -0,0 +1,29 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowRuntimeModule.h"
+
+#include "AdvancedControlFlowCaseHitCounter.h"
+
+void FAdvancedControlFlowRuntimeModule::StartupModule()
+{
+}
+
+void FAdvancedControlFlowRuntimeModule::ShutdownModule()
+{
+	// Save the hit counts recorded in the game.
+	FAdvancedControlFlowCaseHitCounter::Get().Flush();
+}
+
+bool FAdvancedControlFlowRuntimeModule::SupportsDynamicReloading()
+{
+	return true;
+}
+
+IMPLEMENT_MODULE(FAdvancedControlFlowRuntimeModule, AdvancedControlFlowRuntime);
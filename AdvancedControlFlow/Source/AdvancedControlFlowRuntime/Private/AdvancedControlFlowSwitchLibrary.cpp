@@ -0,0 +1,90 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowSwitchLibrary.h"
+
+#include "Misc/StringBuilder.h"
+#include "UObject/NameTypes.h"
+
+uint32 UAdvancedControlFlowSwitchLibrary::HashCaseValue(const TCHAR* Value, int32 Length, int32 Seed, bool bCaseSensitive)
+{
+	// FNV-1a with the seed, and the finalizer of MurmurHash3 to spread the lower bits which are used as the bucket.
+	uint32 Hash = 2166136261u ^ static_cast<uint32>(Seed);
+	for (int32 Index = 0; Index < Length; ++Index)
+	{
+		const TCHAR Char = bCaseSensitive ? Value[Index] : FoldCaseChar(Value[Index]);
+		Hash = (Hash ^ static_cast<uint32>(Char)) * 16777619u;
+	}
+	Hash ^= Hash >> 16;
+	Hash *= 0x85ebca6bu;
+	Hash ^= Hash >> 13;
+	Hash *= 0xc2b2ae35u;
+	Hash ^= Hash >> 16;
+
+	return Hash;
+}
+
+TCHAR UAdvancedControlFlowSwitchLibrary::FoldCaseChar(TCHAR Char)
+{
+	return ((Char >= TEXT('A')) && (Char <= TEXT('Z'))) ? static_cast<TCHAR>(Char - TEXT('A') + TEXT('a')) : Char;
+}
+
+bool UAdvancedControlFlowSwitchLibrary::EqualCaseValue(
+	const TCHAR* A, int32 LengthA, const TCHAR* B, int32 LengthB, bool bCaseSensitive)
+{
+	if (LengthA != LengthB)
+	{
+		return false;
+	}
+	for (int32 Index = 0; Index < LengthA; ++Index)
+	{
+		if (bCaseSensitive ? (A[Index] != B[Index]) : (FoldCaseChar(A[Index]) != FoldCaseChar(B[Index])))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int32 UAdvancedControlFlowSwitchLibrary::GetStringBucket(
+	const FString& Selection, int32 Seed, int32 BucketMask, bool bCaseSensitive)
+{
+	return static_cast<int32>(HashCaseValue(*Selection, Selection.Len(), Seed, bCaseSensitive) & BucketMask);
+}
+
+int32 UAdvancedControlFlowSwitchLibrary::GetNameBucket(FName Selection, int32 Seed, int32 BucketMask)
+{
+	// Avoid the allocation of FString.
+	FNameBuilder Builder;
+	Selection.AppendString(Builder);
+
+	return static_cast<int32>(HashCaseValue(Builder.ToString(), Builder.Len(), Seed, false) & BucketMask);
+}
+
+bool UAdvancedControlFlowSwitchLibrary::NotEqualStringIgnoreCase(const FString& A, const FString& B)
+{
+	return !EqualCaseValue(*A, A.Len(), *B, B.Len(), false);
+}
+
+bool UAdvancedControlFlowSwitchLibrary::NotEqualNameIgnoreCase(FName A, FName B)
+{
+	// Same index means the same string.
+	if (A.IsEqual(B, ENameCase::CaseSensitive))
+	{
+		return false;
+	}
+
+	FNameBuilder BuilderA;
+	A.AppendString(BuilderA);
+	FNameBuilder BuilderB;
+	B.AppendString(BuilderB);
+
+	return !EqualCaseValue(BuilderA.ToString(), BuilderA.Len(), BuilderB.ToString(), BuilderB.Len(), false);
+}
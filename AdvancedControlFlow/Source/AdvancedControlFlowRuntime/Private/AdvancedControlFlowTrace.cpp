@@ -0,0 +1,34 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#include "AdvancedControlFlowTrace.h"
+
+#if ACF_TRACE_ENABLED
+UE_TRACE_CHANNEL_DEFINE(ACFChannel);
+
+UE_TRACE_EVENT_BEGIN(AdvancedControlFlow, NodeExecution)
+	UE_TRACE_EVENT_FIELD(uint64, StartCycle)
+	UE_TRACE_EVENT_FIELD(uint64, EndCycle)
+	UE_TRACE_EVENT_FIELD(uint32, NodeGuidA)
+	UE_TRACE_EVENT_FIELD(uint32, NodeGuidB)
+	UE_TRACE_EVENT_FIELD(uint32, NodeGuidC)
+	UE_TRACE_EVENT_FIELD(uint32, NodeGuidD)
+	UE_TRACE_EVENT_FIELD(int32, CaseIndex)
+UE_TRACE_EVENT_END()
+#endif
+
+void FAdvancedControlFlowTrace::OutputNodeExecution(const FGuid& NodeGuid, int32 CaseIndex, uint64 StartCycle, uint64 EndCycle)
+{
+#if ACF_TRACE_ENABLED
+	UE_TRACE_LOG(AdvancedControlFlow, NodeExecution, ACFChannel)
+		<< NodeExecution.StartCycle(StartCycle) << NodeExecution.EndCycle(EndCycle) << NodeExecution.NodeGuidA(NodeGuid.A)
+		<< NodeExecution.NodeGuidB(NodeGuid.B) << NodeExecution.NodeGuidC(NodeGuid.C) << NodeExecution.NodeGuidD(NodeGuid.D)
+		<< NodeExecution.CaseIndex(CaseIndex);
+#endif
+}
@@ -0,0 +1,61 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "AdvancedControlFlowBatchLibrary.generated.h"
+
+// Called from Batch Multi-Conditional Select.
+UCLASS(MinimalAPI)
+class UAdvancedControlFlowBatchLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Overwrite the elements of Result with the elements of Options whose condition is true.
+	// The elements beyond the length of Conditions or Options are not changed (the condition is regarded as false).
+	UFUNCTION(BlueprintCallable, CustomThunk,
+		meta = (BlueprintInternalUseOnly = "true", ArrayParm = "Result,Options", ArrayTypeDependentParams = "Options"))
+	static ADVANCEDCONTROLFLOWRUNTIME_API void OverwriteSelectedElements(
+		UPARAM(ref) TArray<int32>& Result, const TArray<bool>& Conditions, const TArray<int32>& Options);
+
+	static ADVANCEDCONTROLFLOWRUNTIME_API void GenericOverwriteSelectedElements(void* ResultAddr,
+		const FArrayProperty* ResultProperty, const TArray<bool>& Conditions, const void* OptionsAddr,
+		const FArrayProperty* OptionsProperty);
+
+	DECLARE_FUNCTION(execOverwriteSelectedElements)
+	{
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		void* ResultAddr = Stack.MostRecentPropertyAddress;
+		FArrayProperty* ResultProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		P_GET_TARRAY_REF(bool, Conditions);
+
+		Stack.MostRecentProperty = nullptr;
+		Stack.StepCompiledIn<FArrayProperty>(nullptr);
+		void* OptionsAddr = Stack.MostRecentPropertyAddress;
+		FArrayProperty* OptionsProperty = CastField<FArrayProperty>(Stack.MostRecentProperty);
+
+		P_FINISH;
+
+		if ((ResultProperty == nullptr) || (OptionsProperty == nullptr))
+		{
+			Stack.bArrayContextFailed = true;
+			return;
+		}
+
+		P_NATIVE_BEGIN;
+		GenericOverwriteSelectedElements(ResultAddr, ResultProperty, Conditions, OptionsAddr, OptionsProperty);
+		P_NATIVE_END;
+	}
+};
@@ -0,0 +1,38 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "AdvancedControlFlowBitmaskLibrary.generated.h"
+
+// Called from Bitmask Multi-Branch and Bitmask Conditional Sequence.
+UCLASS(MinimalAPI)
+class UAdvancedControlFlowBitmaskLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Return the position of the lowest bit which is set in both Bitmask and CaseMask, or -1 if no bit is set.
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static ADVANCEDCONTROLFLOWRUNTIME_API int32 FindLowestSetBit(int32 Bitmask, int32 CaseMask);
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static ADVANCEDCONTROLFLOWRUNTIME_API int32 FindLowestSetBit64(int64 Bitmask, int64 CaseMask);
+
+	// Same as FindLowestSetBit, but clear the found bit and the bits which are not in CaseMask from Bitmask.
+	// Calling repeatedly walks the set bits from the lowest one.
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static ADVANCEDCONTROLFLOWRUNTIME_API int32 PopLowestSetBit(UPARAM(ref) int32& Bitmask, int32 CaseMask);
+
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static ADVANCEDCONTROLFLOWRUNTIME_API int32 PopLowestSetBit64(UPARAM(ref) int64& Bitmask, int64 CaseMask);
+};
@@ -0,0 +1,64 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Hit counts of the cases of the nodes which are compiled with the profiling mode (ACF.ProfileCaseHits).
+// The hit counts are accumulated to the sidecar file (Saved/AdvancedControlFlow/CaseHitCounts.json) when they are flushed,
+// and the compiler orders the condition tests of the nodes by them.
+class ADVANCEDCONTROLFLOWRUNTIME_API FAdvancedControlFlowCaseHitCounter
+{
+public:
+	static FAdvancedControlFlowCaseHitCounter& Get();
+
+	static FString GetFilePath();
+
+	void RecordHit(FName NodeId, int32 CaseIndex, int32 CaseCount);
+
+	// Get the hit counts and the last taken case of the node recorded in this session.
+	bool GetSessionHitCounts(FName NodeId, TArray<int64>& OutHitCounts, int32& OutLastCaseIndex) const;
+
+	// Write the hit counts recorded in this session to the CSV file.
+	bool DumpToCsv(const FString& FilePath) const;
+
+	// Add the hit counts recorded since the last flush to the sidecar file.
+	void Flush();
+
+	// Get the hit counts of the node in the sidecar file. The file is reloaded when it is updated.
+	bool GetHitCounts(const FString& NodeId, TArray<int64>& OutHitCounts);
+
+	// Override the hit counts of the node without saving them to the sidecar file (e.g. for the tests).
+	// The empty hit counts remove the node.
+	void SetHitCounts(const FString& NodeId, const TArray<int64>& HitCounts);
+
+private:
+	struct FNodeCaseHits
+	{
+		FName NodeId;
+		TArray<int64> HitCounts;
+		// Hit counts which were already added to the sidecar file.
+		TArray<int64> FlushedHitCounts;
+		int32 LastCaseIndex = INDEX_NONE;
+	};
+
+	void LoadFile();
+	bool SaveFile() const;
+
+	mutable FCriticalSection CriticalSection;
+
+	// Recorded in this session. The index of the node is looked up by the name to keep the table compact.
+	TMap<FName, int32> NodeIndices;
+	TArray<FNodeCaseHits> Nodes;
+
+	// Loaded from the sidecar file.
+	TMap<FString, TArray<int64>> SavedHitCounts;
+	FDateTime SavedFileTimeStamp = FDateTime::MinValue();
+};
@@ -0,0 +1,36 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "AdvancedControlFlowProfilingLibrary.generated.h"
+
+UCLASS(MinimalAPI)
+class UAdvancedControlFlowProfilingLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Called from the cases of the nodes which are compiled with the profiling mode.
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static ADVANCEDCONTROLFLOWRUNTIME_API void RecordCaseHit(FName NodeId, int32 CaseIndex, int32 CaseCount);
+
+	// Called at the start of the nodes which are compiled with ACF.TraceNodeExecution. Return the current cycles.
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static ADVANCEDCONTROLFLOWRUNTIME_API int64 BeginNodeTrace();
+
+	// Called when the nodes which are compiled with ACF.TraceNodeExecution take the case.
+	// The event is output only when the trace channel "ACF" is enabled.
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static ADVANCEDCONTROLFLOWRUNTIME_API void EndNodeTrace(
+		int32 NodeGuidA, int32 NodeGuidB, int32 NodeGuidC, int32 NodeGuidD, int32 CaseIndex, int64 StartCycle);
+};
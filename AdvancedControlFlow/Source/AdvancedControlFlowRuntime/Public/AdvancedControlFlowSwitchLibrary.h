@@ -0,0 +1,52 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+
+#include "AdvancedControlFlowSwitchLibrary.generated.h"
+
+UCLASS(MinimalAPI)
+class UAdvancedControlFlowSwitchLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Hash of the case value of Switch Exec on String/Name.
+	// The compiler builds the hash table with this function, so the result must not be changed between the versions.
+	static ADVANCEDCONTROLFLOWRUNTIME_API uint32 HashCaseValue(const TCHAR* Value, int32 Length, int32 Seed, bool bCaseSensitive);
+
+	// Fold the case of the character for the hash and the comparison of the case values.
+	// Only ASCII letters are folded, so the result does not depend on the engine version or the locale.
+	static ADVANCEDCONTROLFLOWRUNTIME_API TCHAR FoldCaseChar(TCHAR Char);
+
+	// Compare the case values with the same folding as HashCaseValue. The equal values always have the same hash.
+	static ADVANCEDCONTROLFLOWRUNTIME_API bool EqualCaseValue(
+		const TCHAR* A, int32 LengthA, const TCHAR* B, int32 LengthB, bool bCaseSensitive);
+
+	// Called from Switch Exec on String/Name. Return the bucket of the selection in the hash table which has
+	// (BucketMask + 1) buckets.
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static ADVANCEDCONTROLFLOWRUNTIME_API int32 GetStringBucket(
+		const FString& Selection, int32 Seed, int32 BucketMask, bool bCaseSensitive);
+
+	// Names are compared without case like the other nodes.
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true"))
+	static ADVANCEDCONTROLFLOWRUNTIME_API int32 GetNameBucket(FName Selection, int32 Seed, int32 BucketMask);
+
+	// Called from Switch Exec on String/Name to compare the selection with the case value in the bucket.
+	// The case sensitive strings are compared by NotEqual_StrStr because they are not folded.
+	UFUNCTION(BlueprintPure, meta = (BlueprintInternalUseOnly = "true"))
+	static ADVANCEDCONTROLFLOWRUNTIME_API bool NotEqualStringIgnoreCase(const FString& A, const FString& B);
+
+	UFUNCTION(BlueprintPure, meta = (BlueprintInternalUseOnly = "true"))
+	static ADVANCEDCONTROLFLOWRUNTIME_API bool NotEqualNameIgnoreCase(FName A, FName B);
+};
@@ -0,0 +1,38 @@
+/*!
+ * AdvancedControlFlow
+ *
+ * Copyright (c) 2022-2023 Colory Games
+ *
+ * This software is released under the MIT License.
+ * https://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/EngineVersionComparison.h"
+#include "Trace/Trace.h"
+
+// The trace channel API is different on UE 4.
+#if UE_TRACE_ENABLED && !UE_VERSION_OLDER_THAN(5, 0, 0)
+#define ACF_TRACE_ENABLED 1
+#else
+#define ACF_TRACE_ENABLED 0
+#endif
+
+#if ACF_TRACE_ENABLED
+// Enable by "-trace=ACF" or "Trace.Enable ACF".
+UE_TRACE_CHANNEL_EXTERN(ACFChannel, ADVANCEDCONTROLFLOWRUNTIME_API);
+#endif
+
+// Trace events of the nodes which are compiled with ACF.TraceNodeExecution.
+//
+// AdvancedControlFlow.NodeExecution
+//   StartCycle, EndCycle: Cycles of the node execution (from the node entry to the taken case)
+//   NodeGuidA-D:          GUID of the source node
+//   CaseIndex:            Taken case (-1: Default)
+class ADVANCEDCONTROLFLOWRUNTIME_API FAdvancedControlFlowTrace
+{
+public:
+	static void OutputNodeExecution(const FGuid& NodeGuid, int32 CaseIndex, uint64 StartCycle, uint64 EndCycle);
+};
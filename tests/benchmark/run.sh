@@ -0,0 +1,33 @@
+#!/bin/bash
+
+if [ $# -lt 3 ]; then
+    echo "Usage: run.sh <UnrealEditor-Cmd path> <project file> <compile|runtime> [commandlet options...]"
+    echo "Example: run.sh ~/UnrealEngine/Engine/Binaries/Linux/UnrealEditor-Cmd FunctionalTest.uproject compile -Output=/tmp/compile.json"
+    exit 1
+fi
+
+readonly EDITOR_CMD=${1}
+readonly PROJECT_FILE=${2}
+readonly BENCHMARK=${3}
+shift 3
+
+case ${BENCHMARK} in
+    compile)
+        readonly COMMANDLET=AdvancedControlFlowCompileBenchmark
+        ;;
+    runtime)
+        readonly COMMANDLET=AdvancedControlFlowRuntimeBenchmark
+        ;;
+    *)
+        echo "Error: Unknown benchmark '${BENCHMARK}'."
+        exit 1
+        ;;
+esac
+
+${EDITOR_CMD} ${PROJECT_FILE} -run=${COMMANDLET} -nullrhi -unattended -nopause -nosplash "$@"
+if [ ${?} -ne 0 ]; then
+    echo "Error: The ${BENCHMARK} benchmark failed."
+    exit 1
+fi
+
+exit 0
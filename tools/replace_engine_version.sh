@@ -34,5 +34,9 @@ fi
 
 for file in `find ${source_dir} -name "*.uplugin"`; do
     sed -i -e "s/\"EngineVersion\": \"5.7.0\",/\"EngineVersion\": \"${engine_version}\",/g" ${file}
+    # UE 4 reads the program allow list of the module by the old name.
+    if [[ ${engine_version} == 4.* ]]; then
+        sed -i -e "s/\"ProgramAllowList\":/\"WhitelistPrograms\":/g" ${file}
+    fi
     echo "Replaced engine version in ${file}"
 done